@@ -336,12 +336,36 @@ namespace vikunja::MemAccess
 #    endif
 #endif // defined(ALPAKA_ACC_GPU_HIP_ENABLED)
 
+
+        /**
+         * The memory access policy getter trait by accelerator. Uses the policy of the platform, if the accelerator
+         * is not specialized.
+         * @tparam TAcc The accelerator type.
+         * @tparam TSfinae
+         */
+        template<typename TAcc, typename TSfinae = void>
+        struct GetMemAccessPolicyByAcc
+        {
+            using type = typename GetMemAccessPolicyByPltf<alpaka::Pltf<alpaka::Dev<TAcc>>>::type;
+        };
+
+#if defined(ALPAKA_ACC_CPU_B_TBB_T_SEQ_ENABLED)
+        /**
+         * On TBB, each block is a task, which processes a contiguous chunk of the memory.
+         */
+        template<typename... TArgs>
+        struct GetMemAccessPolicyByAcc<alpaka::AccCpuTbbBlocks<TArgs...>>
+        {
+            using type = policies::LinearMemAccessPolicy;
+        };
+#endif // defined(ALPAKA_ACC_CPU_B_TBB_T_SEQ_ENABLED)
+
     } // namespace traits
 
     /**
      * Shortcut to derive memory access policy from accelerator.
      */
     template<typename TAcc>
-    using MemAccessPolicy = typename traits::GetMemAccessPolicyByPltf<alpaka::Pltf<alpaka::Dev<TAcc>>>::type;
+    using MemAccessPolicy = typename traits::GetMemAccessPolicyByAcc<TAcc>::type;
 
 } // namespace vikunja::MemAccess
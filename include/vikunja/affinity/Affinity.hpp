@@ -0,0 +1,465 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <alpaka/alpaka.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#    include <pthread.h>
+#    include <sched.h>
+#endif
+
+#ifdef _OPENMP
+#    include <omp.h>
+#endif
+
+namespace vikunja
+{
+    namespace affinity
+    {
+        namespace traits
+        {
+            /**
+             * True for the accelerators, whose threads are OpenMP threads of the host.
+             * @tparam TAcc The alpaka accelerator type.
+             */
+            template<typename TAcc, typename TSfinae = void>
+            struct IsOmpAcc : std::false_type
+            {
+            };
+#ifdef _OPENMP
+#    ifdef ALPAKA_ACC_CPU_B_OMP2_T_SEQ_ENABLED
+            template<typename... TArgs>
+            struct IsOmpAcc<alpaka::AccCpuOmp2Blocks<TArgs...>> : std::true_type
+            {
+            };
+#    endif
+#    ifdef ALPAKA_ACC_CPU_B_SEQ_T_OMP2_ENABLED
+            template<typename... TArgs>
+            struct IsOmpAcc<alpaka::AccCpuOmp2Threads<TArgs...>> : std::true_type
+            {
+            };
+#    endif
+#endif
+        } // namespace traits
+
+        namespace detail
+        {
+            //! Topology information of a logical CPU.
+            struct CpuInfo
+            {
+                int cpu;
+                int package;
+                int core;
+            };
+
+            inline int readTopologyValue(int const cpu, char const* name, int const fallback)
+            {
+                std::ifstream file(
+                    "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/" + std::string(name));
+                int value = fallback;
+                if(!(file >> value))
+                {
+                    return fallback;
+                }
+                return value;
+            }
+
+            /**
+             * Returns the logical CPUs, on which the process is allowed to run, sorted by package, physical core and
+             * logical CPU. The result is determined at the first call.
+             */
+            inline std::vector<CpuInfo> const& getAvailableCpus()
+            {
+                static std::vector<CpuInfo> const cpus = []
+                {
+                    std::vector<CpuInfo> result;
+#if defined(__linux__)
+                    cpu_set_t cpuSet;
+                    CPU_ZERO(&cpuSet);
+                    if(sched_getaffinity(0, sizeof(cpu_set_t), &cpuSet) == 0)
+                    {
+                        for(int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+                        {
+                            if(CPU_ISSET(cpu, &cpuSet))
+                            {
+                                result.push_back(
+                                    {cpu,
+                                     readTopologyValue(cpu, "physical_package_id", 0),
+                                     readTopologyValue(cpu, "core_id", cpu)});
+                            }
+                        }
+                    }
+#endif
+                    std::sort(
+                        result.begin(),
+                        result.end(),
+                        [](CpuInfo const& a, CpuInfo const& b)
+                        { return std::tie(a.package, a.core, a.cpu) < std::tie(b.package, b.core, b.cpu); });
+                    return result;
+                }();
+                return cpus;
+            }
+
+            /**
+             * Returns true, if cpu is a logical CPU id, which can be stored in a cpu_set_t.
+             */
+            inline bool isValidCpu(int const cpu)
+            {
+#if defined(__linux__)
+                return cpu >= 0 && cpu < CPU_SETSIZE;
+#else
+                return cpu >= 0;
+#endif
+            }
+
+            /**
+             * Orders the logical CPUs, so that consecutive entries are spread over the packages first, then over the
+             * physical cores of a package and at last over the hardware threads of a physical core.
+             * @param cpus Logical CPUs sorted by package, physical core and logical CPU.
+             */
+            inline std::vector<int> scatterOrder(std::vector<CpuInfo> const& cpus)
+            {
+                // (hardware thread rank in core, core rank in package, package, cpu)
+                std::vector<std::tuple<int, int, int, int>> keys;
+                int coreRank = -1;
+                int threadRank = 0;
+                for(std::size_t i = 0; i < cpus.size(); ++i)
+                {
+                    bool const newPackage = i == 0 || cpus[i].package != cpus[i - 1].package;
+                    bool const newCore = newPackage || cpus[i].core != cpus[i - 1].core;
+                    coreRank = newPackage ? 0 : (newCore ? coreRank + 1 : coreRank);
+                    threadRank = newCore ? 0 : threadRank + 1;
+                    keys.emplace_back(threadRank, coreRank, cpus[i].package, cpus[i].cpu);
+                }
+                std::sort(keys.begin(), keys.end());
+                std::vector<int> result;
+                for(auto const& key : keys)
+                {
+                    result.push_back(std::get<3>(key));
+                }
+                return result;
+            }
+        } // namespace detail
+
+        /**
+         * Describes, on which logical CPU the thread with a given index is pinned. The thread indices are the
+         * indices of the OpenMP threads and of the tasks of the host thread pool. With the LinearMemAccessPolicy,
+         * thread i processes the i-th contiguous chunk of the input, therefore the chunk stays in the caches of the
+         * same core across repeated calls.
+         */
+        class AffinityPolicy
+        {
+        public:
+            enum class Kind
+            {
+                none,
+                compact,
+                scatter,
+                list
+            };
+
+        private:
+            Kind m_kind;
+            std::vector<int> m_cpus;
+
+            AffinityPolicy(Kind const kind, std::vector<int> cpus) : m_kind(kind), m_cpus(std::move(cpus))
+            {
+            }
+
+        public:
+            /**
+             * Threads are not pinned.
+             */
+            static AffinityPolicy none()
+            {
+                return AffinityPolicy(Kind::none, {});
+            }
+
+            /**
+             * Consecutive threads are pinned to neighbouring logical CPUs. The hardware threads of a physical core
+             * and the cores of a package are filled first, so neighbouring chunks share the caches of a package.
+             */
+            static AffinityPolicy compact()
+            {
+                std::vector<int> cpus;
+                for(auto const& info : detail::getAvailableCpus())
+                {
+                    cpus.push_back(info.cpu);
+                }
+                return AffinityPolicy(Kind::compact, cpus);
+            }
+
+            /**
+             * Consecutive threads are spread over the packages and physical cores, to maximize the available memory
+             * bandwidth and cache size per thread.
+             */
+            static AffinityPolicy scatter()
+            {
+                return AffinityPolicy(Kind::scatter, detail::scatterOrder(detail::getAvailableCpus()));
+            }
+
+            /**
+             * Thread i is pinned to cpus[i % cpus.size()]. Negative ids and ids, which do not fit into a cpu_set_t,
+             * are removed. If no id is left, threads are not pinned.
+             * @param cpus List of logical CPU ids.
+             */
+            static AffinityPolicy list(std::vector<int> cpus)
+            {
+                cpus.erase(
+                    std::remove_if(cpus.begin(), cpus.end(), [](int const cpu) { return !detail::isValidCpu(cpu); }),
+                    cpus.end());
+                return AffinityPolicy(Kind::list, std::move(cpus));
+            }
+
+            /**
+             * Creates a policy from its text representation: "none", "compact", "scatter" or a comma separated list
+             * of logical CPU ids, like "0,2,4,6". Unknown values and lists with an invalid CPU id result in none.
+             * @param value Text representation of the policy.
+             */
+            static AffinityPolicy fromString(std::string const& value)
+            {
+                if(value == "compact")
+                {
+                    return compact();
+                }
+                if(value == "scatter")
+                {
+                    return scatter();
+                }
+                std::vector<int> cpus;
+                std::stringstream stream(value);
+                std::string entry;
+                while(std::getline(stream, entry, ','))
+                {
+                    // the length limit avoids the overflow of std::stoi
+                    if(entry.empty() || entry.size() > 9 || entry.find_first_not_of("0123456789") != std::string::npos)
+                    {
+                        return none();
+                    }
+                    int const cpu = std::stoi(entry);
+                    if(!detail::isValidCpu(cpu))
+                    {
+                        return none();
+                    }
+                    cpus.push_back(cpu);
+                }
+                return cpus.empty() ? none() : list(cpus);
+            }
+
+            Kind getKind() const
+            {
+                return m_kind;
+            }
+
+            /**
+             * Returns the logical CPU of the thread with index threadIndex or nothing, if the thread is not pinned.
+             * @param threadIndex Index of the thread.
+             */
+            std::optional<int> getCpu(std::size_t const threadIndex) const
+            {
+                if(m_cpus.empty())
+                {
+                    return std::nullopt;
+                }
+                return m_cpus[threadIndex % m_cpus.size()];
+            }
+        };
+
+        /**
+         * The groups of host threads, which are pinned by vikunja. They differ in the policy, which is used, if no
+         * policy is set explicitly.
+         */
+        enum class ThreadKind
+        {
+            //! The OpenMP threads of the OpenMP accelerators and reductions. They are not pinned by default.
+            omp,
+            //! The workers of the host thread pool. They are pinned with AffinityPolicy::compact() by default.
+            threadPool
+        };
+
+        namespace detail
+        {
+            //! Process wide affinity policy. Each change increments the generation.
+            struct AffinityState
+            {
+                std::mutex mutex;
+                AffinityPolicy policy = AffinityPolicy::none();
+                //! True, if the policy was set by VIKUNJA_AFFINITY or setAffinityPolicy().
+                bool isSet = false;
+                std::atomic<std::uint64_t> generation{1};
+
+                static AffinityState& instance()
+                {
+                    static AffinityState state;
+                    return state;
+                }
+
+            private:
+                AffinityState()
+                {
+                    char const* envValue = std::getenv("VIKUNJA_AFFINITY");
+                    if(envValue != nullptr)
+                    {
+                        policy = AffinityPolicy::fromString(envValue);
+                        isSet = true;
+                    }
+                }
+            };
+        } // namespace detail
+
+        /**
+         * Returns the process wide affinity policy of a group of threads. The initial policy is read from the
+         * environment variable VIKUNJA_AFFINITY (see AffinityPolicy::fromString()). If the variable is not set and
+         * setAffinityPolicy() was not called, the OpenMP threads are not pinned and the workers of the host thread
+         * pool are pinned compact.
+         * @param kind The group of threads.
+         */
+        inline AffinityPolicy getAffinityPolicy(ThreadKind const kind = ThreadKind::omp)
+        {
+            auto& state = detail::AffinityState::instance();
+            std::lock_guard<std::mutex> lock(state.mutex);
+            if(!state.isSet && kind == ThreadKind::threadPool)
+            {
+                return AffinityPolicy::compact();
+            }
+            return state.policy;
+        }
+
+        /**
+         * Changes the process wide affinity policy of all groups of threads. The threads are pinned again at their
+         * next launch.
+         * @param policy The new affinity policy.
+         */
+        inline void setAffinityPolicy(AffinityPolicy const& policy)
+        {
+            auto& state = detail::AffinityState::instance();
+            std::lock_guard<std::mutex> lock(state.mutex);
+            state.policy = policy;
+            state.isSet = true;
+            state.generation.fetch_add(1, std::memory_order_acq_rel);
+        }
+
+        /**
+         * Pins the calling thread according to the affinity policy of its group. The system call is only executed,
+         * if the policy or the thread index changed since the last call of this thread.
+         * @param threadIndex Index of the calling thread.
+         * @param kind The group of the calling thread.
+         */
+        inline void pinCurrentThread(std::size_t const threadIndex, ThreadKind const kind = ThreadKind::omp)
+        {
+            thread_local std::uint64_t appliedGeneration = 0;
+            thread_local std::size_t appliedIndex = 0;
+            thread_local ThreadKind appliedKind = ThreadKind::omp;
+            thread_local bool pinned = false;
+
+            auto& state = detail::AffinityState::instance();
+            std::uint64_t const generation = state.generation.load(std::memory_order_acquire);
+            if(generation == appliedGeneration && threadIndex == appliedIndex && kind == appliedKind)
+            {
+                return;
+            }
+            appliedGeneration = generation;
+            appliedIndex = threadIndex;
+            appliedKind = kind;
+
+#if defined(__linux__)
+            std::optional<int> const cpu = getAffinityPolicy(kind).getCpu(threadIndex);
+            cpu_set_t cpuSet;
+            CPU_ZERO(&cpuSet);
+            if(cpu)
+            {
+                CPU_SET(*cpu, &cpuSet);
+            }
+            else if(pinned)
+            {
+                // release the thread to the CPUs of the process
+                for(auto const& info : detail::getAvailableCpus())
+                {
+                    CPU_SET(info.cpu, &cpuSet);
+                }
+            }
+            else
+            {
+                return;
+            }
+            // pinning is an optimization, therefore errors are ignored
+            pinned = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet) == 0 && cpu.has_value();
+#endif
+        }
+
+        /**
+         * Pins the calling OpenMP thread according to the affinity policy. Must be called inside a parallel region.
+         * The master thread is the calling thread of the application and keeps its affinity mask.
+         */
+        inline void pinOmpThread()
+        {
+#ifdef _OPENMP
+            int const threadIndex = omp_get_thread_num();
+            if(threadIndex != 0)
+            {
+                pinCurrentThread(static_cast<std::size_t>(threadIndex));
+            }
+#endif
+        }
+
+        /**
+         * Pins the OpenMP threads of the host according to the affinity policy, except of the master thread. The
+         * OpenMP runtime reuses its threads for all parallel regions, therefore a parallel region is only started,
+         * if the policy changed.
+         */
+        inline void pinOmpThreads()
+        {
+#ifdef _OPENMP
+            static std::atomic<std::uint64_t> appliedGeneration{0};
+            std::uint64_t const generation
+                = detail::AffinityState::instance().generation.load(std::memory_order_acquire);
+            if(appliedGeneration.load(std::memory_order_acquire) == generation)
+            {
+                return;
+            }
+#    pragma omp parallel
+            {
+                pinOmpThread();
+            }
+            appliedGeneration.store(generation, std::memory_order_release);
+#endif
+        }
+
+        /**
+         * Applies the affinity policy to the host threads of the accelerator before vikunja launches work on it.
+         * Only the OpenMP accelerators are supported, because the other CPU accelerators of alpaka start new
+         * threads for each kernel.
+         * @tparam TAcc The alpaka accelerator type.
+         */
+        template<typename TAcc>
+        void applyAffinity()
+        {
+            if constexpr(traits::IsOmpAcc<TAcc>::value)
+            {
+                pinOmpThreads();
+            }
+        }
+    } // namespace affinity
+} // namespace vikunja
@@ -0,0 +1,216 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/access/BlockStrategy.hpp>
+#include <vikunja/workdiv/BlockBasedWorkDiv.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+#include <algorithm>
+#include <ratio>
+#include <string>
+#include <tuple>
+#include <utility>
+
+namespace vikunja
+{
+    namespace autotune
+    {
+        namespace policies
+        {
+            /**
+             * Work division policy that scales the block and grid size of another work division policy. It is used
+             * to span the search space of the autotuner around the default policy of an accelerator.
+             * @tparam TBasePolicy The work division policy which is scaled.
+             * @tparam TBlockRatio std::ratio, which is multiplied with the block size of TBasePolicy.
+             * @tparam TGridRatio std::ratio, which is multiplied with the grid size of TBasePolicy.
+             */
+            template<typename TBasePolicy, typename TBlockRatio, typename TGridRatio>
+            struct ScaledWorkDivPolicy
+            {
+                template<typename TAcc, typename TIdx = alpaka::Idx<TAcc>>
+                static constexpr TIdx getBlockSize() noexcept
+                {
+                    constexpr TIdx baseBlockSize = TBasePolicy::template getBlockSize<TAcc, TIdx>();
+                    constexpr TIdx blockSize
+                        = static_cast<TIdx>((baseBlockSize * TBlockRatio::num) / TBlockRatio::den);
+                    return (blockSize > 0) ? blockSize : static_cast<TIdx>(1);
+                }
+
+                template<typename TAcc, typename TDevAcc, typename TIdx = alpaka::Idx<TAcc>>
+                static TIdx getGridSize(TDevAcc const& devAcc)
+                {
+                    TIdx const baseGridSize = TBasePolicy::template getGridSize<TAcc, TDevAcc, TIdx>(devAcc);
+                    TIdx const gridSize = static_cast<TIdx>((baseGridSize * TGridRatio::num) / TGridRatio::den);
+                    return std::max(static_cast<TIdx>(1), gridSize);
+                }
+            };
+        } // namespace policies
+
+        /**
+         * A single point of the search space of the autotuner.
+         * @tparam TWorkDivPolicy The work division policy. For the API of this, see workdiv/BlockBasedWorkDiv.hpp
+         * @tparam TMemAccessPolicy The memory access policy. For the API of this, see access/BlockStrategy.hpp
+         */
+        template<typename TWorkDivPolicy, typename TMemAccessPolicy>
+        struct Candidate
+        {
+            using WorkDivPolicy = TWorkDivPolicy;
+            using MemAccessPolicy = TMemAccessPolicy;
+
+            /**
+             * Returns a name, which identifies the candidate in the tuning cache.
+             * @tparam TAcc The alpaka accelerator type.
+             * @param devAcc The alpaka accelerator.
+             */
+            template<typename TAcc, typename TDevAcc>
+            static std::string getName(TDevAcc const& devAcc)
+            {
+                using Idx = alpaka::Idx<TAcc>;
+                return "block=" + std::to_string(TWorkDivPolicy::template getBlockSize<TAcc, Idx>())
+                    + ",grid=" + std::to_string(TWorkDivPolicy::template getGridSize<TAcc, TDevAcc, Idx>(devAcc))
+                    + "," + TMemAccessPolicy::getName();
+            }
+        };
+
+        namespace detail
+        {
+            template<typename TBasePolicy, typename TBlockRatio, typename TGridRatio, typename TMemAccessPolicies>
+            struct CandidatesForWorkDiv;
+
+            template<typename TBasePolicy, typename TBlockRatio, typename TGridRatio, typename... TMemAccessPolicies>
+            struct CandidatesForWorkDiv<TBasePolicy, TBlockRatio, TGridRatio, std::tuple<TMemAccessPolicies...>>
+            {
+                using type = std::tuple<Candidate<
+                    policies::ScaledWorkDivPolicy<TBasePolicy, TBlockRatio, TGridRatio>,
+                    TMemAccessPolicies>...>;
+            };
+
+            template<typename TBasePolicy, typename TBlockRatio, typename TGridRatios, typename TMemAccessPolicies>
+            struct CandidatesForBlockRatio;
+
+            template<typename TBasePolicy, typename TBlockRatio, typename... TGridRatios, typename TMemAccessPolicies>
+            struct CandidatesForBlockRatio<TBasePolicy, TBlockRatio, std::tuple<TGridRatios...>, TMemAccessPolicies>
+            {
+                using type = decltype(std::tuple_cat(
+                    std::declval<typename CandidatesForWorkDiv<
+                        TBasePolicy,
+                        TBlockRatio,
+                        TGridRatios,
+                        TMemAccessPolicies>::type>()...));
+            };
+
+            template<typename TBasePolicy, typename TBlockRatios, typename TGridRatios, typename TMemAccessPolicies>
+            struct CandidateProduct;
+
+            template<typename TBasePolicy, typename... TBlockRatios, typename TGridRatios, typename TMemAccessPolicies>
+            struct CandidateProduct<TBasePolicy, std::tuple<TBlockRatios...>, TGridRatios, TMemAccessPolicies>
+            {
+                using type = decltype(std::tuple_cat(
+                    std::declval<typename CandidatesForBlockRatio<
+                        TBasePolicy,
+                        TBlockRatios,
+                        TGridRatios,
+                        TMemAccessPolicies>::type>()...));
+            };
+        } // namespace detail
+
+        namespace traits
+        {
+            /**
+             * Describes the search space of the autotuner for an accelerator. The candidates are the cartesian
+             * product of the block size ratios, grid size ratios and memory access policies. The ratios are applied
+             * to the default work division policy of the accelerator.
+             * Specialize this trait to change the search space of an accelerator.
+             * @tparam TAcc The alpaka accelerator type.
+             * @tparam TSfinae
+             */
+            template<typename TAcc, typename TSfinae = void>
+            struct GetTuningSpace
+            {
+                // changing the block size is only useful, if the accelerator parallelizes on the thread level
+                using BlockRatios = std::tuple<std::ratio<1>>;
+                using GridRatios = std::tuple<std::ratio<1>, std::ratio<2>, std::ratio<4>>;
+                using MemAccessPolicies = std::tuple<
+                    vikunja::MemAccess::policies::LinearMemAccessPolicy,
+                    vikunja::MemAccess::policies::GridStridingMemAccessPolicy>;
+            };
+#ifdef ALPAKA_ACC_CPU_B_SEQ_T_OMP2_ENABLED
+            template<typename... TArgs>
+            struct GetTuningSpace<alpaka::AccCpuOmp2Threads<TArgs...>>
+            {
+                // the default block size is already at the thread limit of the CPU accelerators
+                using BlockRatios = std::tuple<std::ratio<1, 4>, std::ratio<1, 2>, std::ratio<1>>;
+                using GridRatios = std::tuple<std::ratio<1>>;
+                using MemAccessPolicies = std::tuple<
+                    vikunja::MemAccess::policies::LinearMemAccessPolicy,
+                    vikunja::MemAccess::policies::GridStridingMemAccessPolicy>;
+            };
+#endif
+#ifdef ALPAKA_ACC_CPU_B_SEQ_T_THREADS_ENABLED
+            template<typename... TArgs>
+            struct GetTuningSpace<alpaka::AccCpuThreads<TArgs...>>
+            {
+                // the default block size is already at the thread limit of the CPU accelerators
+                using BlockRatios = std::tuple<std::ratio<1, 4>, std::ratio<1, 2>, std::ratio<1>>;
+                using GridRatios = std::tuple<std::ratio<1>>;
+                using MemAccessPolicies = std::tuple<
+                    vikunja::MemAccess::policies::LinearMemAccessPolicy,
+                    vikunja::MemAccess::policies::GridStridingMemAccessPolicy>;
+            };
+#endif
+#ifdef ALPAKA_ACC_GPU_CUDA_ENABLED
+            template<typename... TArgs>
+            struct GetTuningSpace
+#    if ALPAKA_VERSION_MAJOR >= 1
+                <alpaka::AccGpuUniformCudaHipRt<alpaka::ApiCudaRt, TArgs...>>
+#    else
+                <alpaka::AccGpuCudaRt<TArgs...>>
+#    endif
+            {
+                // block sizes from 128 to 1024 threads, if the default block size is 256
+                using BlockRatios = std::tuple<std::ratio<1, 2>, std::ratio<1>, std::ratio<2>, std::ratio<4>>;
+                using GridRatios = std::tuple<std::ratio<1, 2>, std::ratio<1>, std::ratio<2>>;
+                using MemAccessPolicies = std::tuple<
+                    vikunja::MemAccess::policies::GridStridingMemAccessPolicy,
+                    vikunja::MemAccess::policies::LinearMemAccessPolicy>;
+            };
+#endif
+#ifdef ALPAKA_ACC_GPU_HIP_ENABLED
+            template<typename... TArgs>
+            struct GetTuningSpace
+#    if ALPAKA_VERSION_MAJOR >= 1
+                <alpaka::AccGpuUniformCudaHipRt<alpaka::ApiHipRt, TArgs...>>
+#    else
+                <alpaka::AccGpuHipRt<TArgs...>>
+#    endif
+            {
+                // block sizes from 128 to 1024 threads, if the default block size is 256
+                using BlockRatios = std::tuple<std::ratio<1, 2>, std::ratio<1>, std::ratio<2>, std::ratio<4>>;
+                using GridRatios = std::tuple<std::ratio<1, 2>, std::ratio<1>, std::ratio<2>>;
+                using MemAccessPolicies = std::tuple<
+                    vikunja::MemAccess::policies::GridStridingMemAccessPolicy,
+                    vikunja::MemAccess::policies::LinearMemAccessPolicy>;
+            };
+#endif
+        } // namespace traits
+
+        /**
+         * Shortcut for the default candidates of an accelerator. The type is a std::tuple of Candidate.
+         */
+        template<typename TAcc>
+        using DefaultCandidates = typename detail::CandidateProduct<
+            vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename traits::GetTuningSpace<TAcc>::BlockRatios,
+            typename traits::GetTuningSpace<TAcc>::GridRatios,
+            typename traits::GetTuningSpace<TAcc>::MemAccessPolicies>::type;
+    } // namespace autotune
+} // namespace vikunja
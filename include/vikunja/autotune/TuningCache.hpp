@@ -0,0 +1,147 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace vikunja
+{
+    namespace autotune
+    {
+        /**
+         * Process wide cache of the autotuning results, which is backed by a file. Each line of the file contains a
+         * key and the name of the winning candidate, separated by a tab. New results are appended to the file, so
+         * that later processes can reuse them.
+         *
+         * The file path is taken from the environment variable VIKUNJA_AUTOTUNE_CACHE. If the variable is not set,
+         * the file vikunja_autotune.cache in the current working directory is used.
+         */
+        class TuningCache
+        {
+        private:
+            std::mutex m_mutex;
+            std::string m_path;
+            std::map<std::string, std::string> m_entries;
+            bool m_loaded = false;
+
+            TuningCache()
+            {
+                char const* envPath = std::getenv("VIKUNJA_AUTOTUNE_CACHE");
+                m_path = (envPath != nullptr) ? std::string(envPath) : std::string("vikunja_autotune.cache");
+            }
+
+            // requires a locked m_mutex
+            void load()
+            {
+                if(m_loaded)
+                {
+                    return;
+                }
+                m_loaded = true;
+                std::ifstream file(m_path);
+                std::string line;
+                while(std::getline(file, line))
+                {
+                    auto const separator = line.rfind('\t');
+                    if(separator == std::string::npos || separator == 0 || separator + 1 == line.size())
+                    {
+                        // ignore broken lines
+                        continue;
+                    }
+                    // if a key exists twice, the last entry wins
+                    m_entries[line.substr(0, separator)] = line.substr(separator + 1);
+                }
+            }
+
+        public:
+            TuningCache(TuningCache const&) = delete;
+            TuningCache& operator=(TuningCache const&) = delete;
+
+            /**
+             * Returns the process wide instance.
+             */
+            static TuningCache& instance()
+            {
+                static TuningCache cache;
+                return cache;
+            }
+
+            /**
+             * Returns the path of the cache file.
+             */
+            std::string getPath()
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                return m_path;
+            }
+
+            /**
+             * Changes the path of the cache file. The entries of the new file are loaded on the next access.
+             * @param path Path of the cache file.
+             */
+            void setPath(std::string const& path)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_path = path;
+                m_entries.clear();
+                m_loaded = false;
+            }
+
+            /**
+             * Drops all entries in memory. The entries of the cache file are loaded again on the next access.
+             */
+            void reload()
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_entries.clear();
+                m_loaded = false;
+            }
+
+            /**
+             * Returns the name of the stored candidate for key, if exists.
+             * @param key Identifier of the tuning problem.
+             */
+            std::optional<std::string> get(std::string const& key)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                load();
+                auto const entry = m_entries.find(key);
+                if(entry == m_entries.end())
+                {
+                    return std::nullopt;
+                }
+                return entry->second;
+            }
+
+            /**
+             * Stores the name of a candidate for key and appends it to the cache file. If the cache file is not
+             * writeable, the entry is only kept in memory.
+             * @param key Identifier of the tuning problem.
+             * @param candidateName Name of the candidate.
+             */
+            void set(std::string const& key, std::string const& candidateName)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                load();
+                m_entries[key] = candidateName;
+                std::ofstream file(m_path, std::ios::app);
+                if(file)
+                {
+                    file << key << '\t' << candidateName << '\n';
+                }
+            }
+        };
+    } // namespace autotune
+} // namespace vikunja
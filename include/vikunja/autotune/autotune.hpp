@@ -0,0 +1,445 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/autotune/Candidates.hpp>
+#include <vikunja/autotune/TuningCache.hpp>
+#include <vikunja/reduce/reduce.hpp>
+#include <vikunja/transform/transform.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+namespace vikunja
+{
+    /**
+     * The vikunja::autotune namespace provides versions of the vikunja algorithms, which choose the work division
+     * policy and memory access policy at runtime. On the first call for a combination of algorithm, data type,
+     * problem size bucket and accelerator, all candidates are measured and the fastest one is stored in the
+     * vikunja::autotune::TuningCache. Later calls, also from other processes, reuse the stored candidate.
+     */
+    namespace autotune
+    {
+        namespace detail
+        {
+            //! Number of measured executions per candidate. The fastest execution is used.
+            constexpr int tuningRepetitions = 3;
+
+            /**
+             * Returns the index of the highest set bit of n. Problem sizes with the same bucket share the tuning
+             * result.
+             */
+            template<typename TIdx>
+            inline std::uint32_t getSizeBucket(TIdx n)
+            {
+                std::uint32_t bucket = 0;
+                while(n > 1)
+                {
+                    n /= 2;
+                    ++bucket;
+                }
+                return bucket;
+            }
+
+            template<typename TAcc, typename TDevAcc, typename TIdx>
+            std::string getKey(std::string const& primitive, std::string const& types, TDevAcc const& devAcc, TIdx n)
+            {
+                return primitive + "|" + types + "|" + std::to_string(getSizeBucket(n)) + "|"
+                    + alpaka::getAccName<TAcc>() + "|" + alpaka::getName(devAcc);
+            }
+
+            /**
+             * Calls func with a default constructed object of the candidate at position index of TCandidates.
+             */
+            template<typename TCandidates, typename TFunc, std::size_t... TIndices>
+            void visitCandidate(std::size_t const index, TFunc&& func, std::index_sequence<TIndices...>)
+            {
+                ((index == TIndices ? (func(std::tuple_element_t<TIndices, TCandidates>{}), 0) : 0), ...);
+            }
+
+            template<typename TCandidates, typename TFunc>
+            void visitCandidate(std::size_t const index, TFunc&& func)
+            {
+                visitCandidate<TCandidates>(
+                    index,
+                    std::forward<TFunc>(func),
+                    std::make_index_sequence<std::tuple_size_v<TCandidates>>{});
+            }
+
+            template<typename TAcc, typename TCandidates, typename TDevAcc>
+            std::optional<std::size_t> findCandidate(std::string const& name, TDevAcc const& devAcc)
+            {
+                std::optional<std::size_t> found;
+                for(std::size_t i = 0; i < std::tuple_size_v<TCandidates>; ++i)
+                {
+                    visitCandidate<TCandidates>(
+                        i,
+                        [&](auto candidate)
+                        {
+                            if(!found && decltype(candidate)::template getName<TAcc>(devAcc) == name)
+                            {
+                                found = i;
+                            }
+                        });
+                }
+                return found;
+            }
+
+            /**
+             * Returns the index of the candidate, which should be used for key. If no valid result is stored in the
+             * tuning cache, each candidate is executed via run and the fastest one is stored.
+             * @param run Functor, which executes the algorithm with a candidate and waits for the result.
+             */
+            template<typename TAcc, typename TCandidates, typename TDevAcc, typename TRun>
+            std::size_t selectCandidate(std::string const& key, TDevAcc const& devAcc, TRun&& run)
+            {
+                static_assert(std::tuple_size_v<TCandidates> > 0, "The tuning space must not be empty.");
+                TuningCache& cache = TuningCache::instance();
+                if(auto const cachedName = cache.get(key))
+                {
+                    // if the search space has changed, the stored candidate could not exist anymore
+                    if(auto const cachedIndex = findCandidate<TAcc, TCandidates>(*cachedName, devAcc))
+                    {
+                        return *cachedIndex;
+                    }
+                }
+
+                std::size_t bestIndex = 0;
+                auto bestTime = std::chrono::steady_clock::duration::max();
+                for(std::size_t i = 0; i < std::tuple_size_v<TCandidates>; ++i)
+                {
+                    visitCandidate<TCandidates>(
+                        i,
+                        [&](auto candidate)
+                        {
+                            // warm up
+                            run(candidate);
+                            for(int r = 0; r < tuningRepetitions; ++r)
+                            {
+                                auto const start = std::chrono::steady_clock::now();
+                                run(candidate);
+                                auto const time = std::chrono::steady_clock::now() - start;
+                                if(time < bestTime)
+                                {
+                                    bestTime = time;
+                                    bestIndex = i;
+                                }
+                            }
+                        });
+                }
+
+                visitCandidate<TCandidates>(
+                    bestIndex,
+                    [&](auto candidate) { cache.set(key, decltype(candidate)::template getName<TAcc>(devAcc)); });
+                return bestIndex;
+            }
+        } // namespace detail
+
+        /**
+         * Autotuned version of vikunja::reduce::deviceTransformReduce.
+         * @see vikunja::reduce::deviceTransformReduce
+         * @tparam TAcc The alpaka accelerator type to use.
+         * @tparam TCandidates std::tuple of vikunja::autotune::Candidate, which is searched for the fastest
+         * combination of work division and memory access policy. Defaults to a search space depending on the
+         * accelerator.
+         * @param devAcc The alpaka accelerator.
+         * @param devHost The alpaka host.
+         * @param queue The alpaka queue.
+         * @param n The number of input elements. Must be of type TIdx.
+         * @param buffer The input iterator. Should be a pointer-like object.
+         * @param transformFunc The transform operator.
+         * @param reduceFunc The reduce operator.
+         * @return Value of the combined transform/reduce operation.
+         */
+        template<
+            typename TAcc,
+            typename TCandidates = DefaultCandidates<TAcc>,
+            typename TTransformFunc,
+            typename TReduceFunc,
+            typename TInputIterator,
+            typename TDevAcc,
+            typename TDevHost,
+            typename TQueue,
+            typename TIdx,
+            typename TTransformOperator = vikunja::operators::
+                UnaryOp<TAcc, TTransformFunc, typename std::iterator_traits<TInputIterator>::value_type>,
+            typename TReduceOperator = vikunja::operators::
+                BinaryOp<TAcc, TReduceFunc, typename TTransformOperator::TRed, typename TTransformOperator::TRed>,
+            typename TRed = typename TReduceOperator::TRed>
+        auto deviceTransformReduce(
+            TDevAcc& devAcc,
+            TDevHost& devHost,
+            TQueue& queue,
+            TIdx const& n,
+            TInputIterator const& buffer,
+            TTransformFunc const& transformFunc,
+            TReduceFunc const& reduceFunc) -> TRed
+        {
+            auto run = [&](auto candidate) -> TRed
+            {
+                using Candidate = decltype(candidate);
+                return vikunja::reduce::deviceTransformReduce<
+                    TAcc,
+                    typename Candidate::WorkDivPolicy,
+                    typename Candidate::MemAccessPolicy>(
+                    devAcc,
+                    devHost,
+                    queue,
+                    n,
+                    buffer,
+                    transformFunc,
+                    reduceFunc);
+            };
+
+            std::string const key = detail::getKey<TAcc>(
+                "transformReduce",
+                std::string(typeid(typename std::iterator_traits<TInputIterator>::value_type).name()) + ","
+                    + typeid(TRed).name(),
+                devAcc,
+                n);
+            std::size_t const index = detail::selectCandidate<TAcc, TCandidates>(key, devAcc, run);
+
+            TRed result{};
+            detail::visitCandidate<TCandidates>(index, [&](auto candidate) { result = run(candidate); });
+            return result;
+        }
+
+        /**
+         * Autotuned version of vikunja::reduce::deviceTransformReduce.
+         * @see vikunja::reduce::deviceTransformReduce
+         * @param bufferBegin The begin pointer of the input buffer.
+         * @param bufferEnd The end pointer of the input buffer.
+         */
+        template<
+            typename TAcc,
+            typename TCandidates = DefaultCandidates<TAcc>,
+            typename TTransformFunc,
+            typename TReduceFunc,
+            typename TInputIterator,
+            typename TDevAcc,
+            typename TDevHost,
+            typename TQueue,
+            typename TTransformOperator = vikunja::operators::
+                UnaryOp<TAcc, TTransformFunc, typename std::iterator_traits<TInputIterator>::value_type>,
+            typename TReduceOperator = vikunja::operators::
+                BinaryOp<TAcc, TReduceFunc, typename TTransformOperator::TRed, typename TTransformOperator::TRed>,
+            typename TRed = typename TReduceOperator::TRed>
+        auto deviceTransformReduce(
+            TDevAcc& devAcc,
+            TDevHost& devHost,
+            TQueue& queue,
+            TInputIterator const& bufferBegin,
+            TInputIterator const& bufferEnd,
+            TTransformFunc const& transformFunc,
+            TReduceFunc const& reduceFunc) -> TRed
+        {
+            assert(bufferEnd >= bufferBegin);
+            auto size = static_cast<typename alpaka::trait::IdxType<TAcc>::type>(bufferEnd - bufferBegin);
+            return deviceTransformReduce<TAcc, TCandidates>(
+                devAcc,
+                devHost,
+                queue,
+                size,
+                bufferBegin,
+                transformFunc,
+                reduceFunc);
+        }
+
+        /**
+         * Autotuned version of vikunja::reduce::deviceReduce.
+         * @see vikunja::reduce::deviceReduce
+         */
+        template<
+            typename TAcc,
+            typename TCandidates = DefaultCandidates<TAcc>,
+            typename TFunc,
+            typename TInputIterator,
+            typename TDevAcc,
+            typename TDevHost,
+            typename TQueue,
+            typename TIdx,
+            typename TOperator = vikunja::operators::BinaryOp<
+                TAcc,
+                TFunc,
+                typename std::iterator_traits<TInputIterator>::value_type,
+                typename std::iterator_traits<TInputIterator>::value_type>,
+            typename TRed = typename TOperator::TRed>
+        auto deviceReduce(
+            TDevAcc& devAcc,
+            TDevHost& devHost,
+            TQueue& queue,
+            TIdx const& n,
+            TInputIterator const& buffer,
+            TFunc const& func) -> TRed
+        {
+            return deviceTransformReduce<TAcc, TCandidates>(
+                devAcc,
+                devHost,
+                queue,
+                n,
+                buffer,
+                vikunja::reduce::detail::Identity<TRed>(),
+                func);
+        }
+
+        /**
+         * Autotuned version of vikunja::reduce::deviceReduce.
+         * @see vikunja::reduce::deviceReduce
+         * @param bufferBegin The begin pointer of the input buffer.
+         * @param bufferEnd The end pointer of the input buffer.
+         */
+        template<
+            typename TAcc,
+            typename TCandidates = DefaultCandidates<TAcc>,
+            typename TFunc,
+            typename TInputIterator,
+            typename TDevAcc,
+            typename TDevHost,
+            typename TQueue,
+            typename TOperator = vikunja::operators::BinaryOp<
+                TAcc,
+                TFunc,
+                typename std::iterator_traits<TInputIterator>::value_type,
+                typename std::iterator_traits<TInputIterator>::value_type>,
+            typename TRed = typename TOperator::TRed>
+        auto deviceReduce(
+            TDevAcc& devAcc,
+            TDevHost& devHost,
+            TQueue& queue,
+            TInputIterator const& bufferBegin,
+            TInputIterator const& bufferEnd,
+            TFunc const& func) -> TRed
+        {
+            assert(bufferEnd >= bufferBegin);
+            auto size = static_cast<typename alpaka::trait::IdxType<TAcc>::type>(bufferEnd - bufferBegin);
+            return deviceReduce<TAcc, TCandidates>(devAcc, devHost, queue, size, bufferBegin, func);
+        }
+
+        /**
+         * Autotuned version of vikunja::transform::deviceTransform.
+         * The candidates are only measured, if source and destination are pointers to non-overlapping memory,
+         * because the measurement executes the transform several times. Otherwise, the stored candidate is used, if
+         * available, or the default policies of the accelerator.
+         * @see vikunja::transform::deviceTransform
+         * @tparam TAcc The alpaka accelerator type.
+         * @tparam TCandidates std::tuple of vikunja::autotune::Candidate, which is searched for the fastest
+         * combination of work division and memory access policy. Defaults to a search space depending on the
+         * accelerator.
+         * @param devAcc The alpaka accelerator.
+         * @param queue The alpaka queue.
+         * @param n The number of input elements. Must be of type TIdx.
+         * @param source The input iterator. Should be pointer-like.
+         * @param destination The output iterator. Should be pointer-like.
+         * @param func The transform operator.
+         */
+        template<
+            typename TAcc,
+            typename TCandidates = DefaultCandidates<TAcc>,
+            typename TFunc,
+            typename TInputIterator,
+            typename TOutputIterator,
+            typename TDevAcc,
+            typename TQueue,
+            typename TIdx>
+        auto deviceTransform(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            TIdx const& n,
+            TInputIterator const& source,
+            TOutputIterator const& destination,
+            TFunc const& func) -> void
+        {
+            auto run = [&](auto candidate)
+            {
+                using Candidate = decltype(candidate);
+                vikunja::transform::deviceTransform<
+                    TAcc,
+                    typename Candidate::WorkDivPolicy,
+                    typename Candidate::MemAccessPolicy>(devAcc, queue, n, source, destination, func);
+                alpaka::wait(queue);
+            };
+
+            std::string const key = detail::getKey<TAcc>(
+                "transform",
+                std::string(typeid(typename std::iterator_traits<TInputIterator>::value_type).name()) + ","
+                    + typeid(typename std::iterator_traits<TOutputIterator>::value_type).name(),
+                devAcc,
+                n);
+
+            bool canMeasure = false;
+            if constexpr(std::is_pointer_v<TInputIterator> && std::is_pointer_v<TOutputIterator>)
+            {
+                auto const sourceBegin = reinterpret_cast<std::uintptr_t>(source);
+                auto const sourceEnd = reinterpret_cast<std::uintptr_t>(source + n);
+                auto const destinationBegin = reinterpret_cast<std::uintptr_t>(destination);
+                auto const destinationEnd = reinterpret_cast<std::uintptr_t>(destination + n);
+                canMeasure = sourceEnd <= destinationBegin || destinationEnd <= sourceBegin;
+            }
+
+            if(!canMeasure)
+            {
+                auto const cachedName = TuningCache::instance().get(key);
+                auto const cachedIndex = cachedName
+                    ? detail::findCandidate<TAcc, TCandidates>(*cachedName, devAcc)
+                    : std::optional<std::size_t>{};
+                if(cachedIndex)
+                {
+                    detail::visitCandidate<TCandidates>(*cachedIndex, run);
+                }
+                else
+                {
+                    vikunja::transform::deviceTransform<TAcc>(devAcc, queue, n, source, destination, func);
+                }
+                return;
+            }
+
+            std::size_t const index = detail::selectCandidate<TAcc, TCandidates>(key, devAcc, run);
+            detail::visitCandidate<TCandidates>(index, run);
+        }
+
+        /**
+         * Autotuned version of vikunja::transform::deviceTransform.
+         * @see vikunja::autotune::deviceTransform
+         * @param sourceBegin The begin pointer of the input buffer.
+         * @param sourceEnd The end pointer of the input buffer.
+         */
+        template<
+            typename TAcc,
+            typename TCandidates = DefaultCandidates<TAcc>,
+            typename TFunc,
+            typename TInputIterator,
+            typename TOutputIterator,
+            typename TDevAcc,
+            typename TQueue>
+        auto deviceTransform(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            TInputIterator const& sourceBegin,
+            TInputIterator const& sourceEnd,
+            TOutputIterator const& destination,
+            TFunc const& func) -> void
+        {
+            assert(sourceEnd >= sourceBegin);
+            auto size = static_cast<typename alpaka::trait::IdxType<TAcc>::type>(sourceEnd - sourceBegin);
+            deviceTransform<TAcc, TCandidates>(devAcc, queue, size, sourceBegin, destination, func);
+        }
+    } // namespace autotune
+} // namespace vikunja
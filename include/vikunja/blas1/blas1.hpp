@@ -0,0 +1,313 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/access/BlockStrategy.hpp>
+#include <vikunja/blas1/detail/Blas1Func.hpp>
+#include <vikunja/mem/iterator.hpp>
+#include <vikunja/operators/functors.hpp>
+#include <vikunja/operators/operators.hpp>
+#include <vikunja/reduce/reduce.hpp>
+#include <vikunja/transform/transform.hpp>
+#include <vikunja/workdiv/BlockBasedWorkDiv.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+#include <cmath>
+#include <iterator>
+
+namespace vikunja
+{
+    /**
+     * The vikunja::blas1 namespace contains the vector operations of the BLAS level 1. Each operation reads and
+     * writes its vectors in a single pass: the element wise operations run through the transform kernel, the
+     * reductions through the transform reduce, whose transform reads all input vectors at the same index. The
+     * reductions are marked as associative, so that the OpenMP backends use their native reduction.
+     */
+    namespace blas1
+    {
+        /**
+         * Scales a vector in place: x = alpha * x.
+         * @tparam TAcc The alpaka accelerator type to use.
+         * @tparam WorkDivPolicy The working division policy. Defaults to a templated value depending on the
+         * accelerator. For the API of this, see workdiv/BlockBasedWorkDiv.hpp
+         * @tparam MemAccessPolicy The memory access policy. Defaults to a templated value depending on the
+         * accelerator. For the API of this, see vikunja::MemAccess::PolicyBasedBlockStrategy
+         * @param devAcc The alpaka accelerator.
+         * @param queue The alpaka queue.
+         * @param n The size of the vector.
+         * @param alpha The factor.
+         * @param x The vector.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename MemAccessPolicy = vikunja::MemAccess::MemAccessPolicy<TAcc>,
+            typename TIterator,
+            typename TDevAcc,
+            typename TQueue,
+            typename TIdx,
+            typename TValue = typename std::iterator_traits<TIterator>::value_type>
+        auto deviceScal(TDevAcc& devAcc, TQueue& queue, TIdx const& n, TValue const& alpha, TIterator const& x)
+            -> void
+        {
+            vikunja::transform::deviceTransform<TAcc, WorkDivPolicy, MemAccessPolicy>(
+                devAcc,
+                queue,
+                n,
+                x,
+                x,
+                detail::ScalFunc<TValue>{alpha});
+        }
+
+        /**
+         * Adds a scaled vector to a vector: y = alpha * x + y.
+         * @see deviceScal
+         * @param n The size of the vectors.
+         * @param alpha The factor of x.
+         * @param x The first vector.
+         * @param y The second vector, which is overwritten.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename MemAccessPolicy = vikunja::MemAccess::MemAccessPolicy<TAcc>,
+            typename TIteratorX,
+            typename TIteratorY,
+            typename TDevAcc,
+            typename TQueue,
+            typename TIdx,
+            typename TValue = typename std::iterator_traits<TIteratorX>::value_type>
+        auto deviceAxpy(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            TIdx const& n,
+            TValue const& alpha,
+            TIteratorX const& x,
+            TIteratorY const& y) -> void
+        {
+            vikunja::transform::deviceTransform<TAcc, WorkDivPolicy, MemAccessPolicy>(
+                devAcc,
+                queue,
+                n,
+                x,
+                y,
+                y,
+                detail::AxpyFunc<TValue>{alpha});
+        }
+
+        /**
+         * Adds two scaled vectors: y = alpha * x + beta * y. If beta is zero, y is only written.
+         * @see deviceScal
+         * @param n The size of the vectors.
+         * @param alpha The factor of x.
+         * @param x The first vector.
+         * @param beta The factor of y.
+         * @param y The second vector, which is overwritten.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename MemAccessPolicy = vikunja::MemAccess::MemAccessPolicy<TAcc>,
+            typename TIteratorX,
+            typename TIteratorY,
+            typename TDevAcc,
+            typename TQueue,
+            typename TIdx,
+            typename TValue = typename std::iterator_traits<TIteratorX>::value_type>
+        auto deviceAxpby(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            TIdx const& n,
+            TValue const& alpha,
+            TIteratorX const& x,
+            TValue const& beta,
+            TIteratorY const& y) -> void
+        {
+            vikunja::transform::deviceTransform<TAcc, WorkDivPolicy, MemAccessPolicy>(
+                devAcc,
+                queue,
+                n,
+                x,
+                y,
+                y,
+                detail::AxpbyFunc<TValue>{alpha, beta});
+        }
+
+        /**
+         * Returns the dot product of two vectors. Both vectors are read in a single transform reduce.
+         * @tparam TAcc The alpaka accelerator type to use.
+         * @tparam WorkDivPolicy The working division policy. Defaults to a templated value depending on the
+         * accelerator. For the API of this, see workdiv/BlockBasedWorkDiv.hpp
+         * @tparam MemAccessPolicy The memory access policy. Defaults to a templated value depending on the
+         * accelerator. For the API of this, see vikunja::MemAccess::PolicyBasedBlockStrategy
+         * @param devAcc The alpaka accelerator.
+         * @param devHost The alpaka host.
+         * @param queue The alpaka queue.
+         * @param n The size of the vectors.
+         * @param x The first vector.
+         * @param y The second vector.
+         * @return The dot product. 0, if n is 0.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename MemAccessPolicy = vikunja::MemAccess::MemAccessPolicy<TAcc>,
+            typename TIteratorX,
+            typename TIteratorY,
+            typename TDevAcc,
+            typename TDevHost,
+            typename TQueue,
+            typename TIdx,
+            typename TValue = typename std::iterator_traits<TIteratorX>::value_type>
+        auto deviceDot(
+            TDevAcc& devAcc,
+            TDevHost& devHost,
+            TQueue& queue,
+            TIdx const& n,
+            TIteratorX const& x,
+            TIteratorY const& y) -> TValue
+        {
+            if(n == 0)
+            {
+                return TValue{0};
+            }
+            return vikunja::reduce::deviceTransformReduce<TAcc, WorkDivPolicy, MemAccessPolicy>(
+                devAcc,
+                devHost,
+                queue,
+                n,
+                vikunja::mem::iterator::CountingIterator<TIdx>{},
+                detail::DotFunc<TIteratorX, TIteratorY>{x, y},
+                vikunja::operators::associative(vikunja::operators::Plus<TValue>()));
+        }
+
+        /**
+         * Fused axpy and dot product, like in the conjugate gradient method: y = alpha * x + y and returns the dot
+         * product of the new y with z. z can be the same vector as y, e.g. to compute the squared norm of the
+         * updated residual. All vectors are read and y is written in a single pass.
+         * @see deviceDot
+         * @param n The size of the vectors.
+         * @param alpha The factor of x.
+         * @param x The first vector.
+         * @param y The second vector, which is overwritten.
+         * @param z The third vector.
+         * @return The dot product of the new y and z. 0, if n is 0.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename MemAccessPolicy = vikunja::MemAccess::MemAccessPolicy<TAcc>,
+            typename TIteratorX,
+            typename TIteratorY,
+            typename TIteratorZ,
+            typename TDevAcc,
+            typename TDevHost,
+            typename TQueue,
+            typename TIdx,
+            typename TValue = typename std::iterator_traits<TIteratorX>::value_type>
+        auto deviceAxpyDot(
+            TDevAcc& devAcc,
+            TDevHost& devHost,
+            TQueue& queue,
+            TIdx const& n,
+            TValue const& alpha,
+            TIteratorX const& x,
+            TIteratorY const& y,
+            TIteratorZ const& z) -> TValue
+        {
+            if(n == 0)
+            {
+                return TValue{0};
+            }
+            return vikunja::reduce::deviceTransformReduce<TAcc, WorkDivPolicy, MemAccessPolicy>(
+                devAcc,
+                devHost,
+                queue,
+                n,
+                vikunja::mem::iterator::CountingIterator<TIdx>{},
+                detail::AxpyDotFunc<TValue, TIteratorX, TIteratorY, TIteratorZ>{alpha, x, y, z},
+                vikunja::operators::associative(vikunja::operators::Plus<TValue>()));
+        }
+
+        /**
+         * Returns the sum of the absolute values of a vector.
+         * @see deviceDot
+         * @param n The size of the vector.
+         * @param x The vector.
+         * @return The sum of the absolute values. 0, if n is 0.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename MemAccessPolicy = vikunja::MemAccess::MemAccessPolicy<TAcc>,
+            typename TIterator,
+            typename TDevAcc,
+            typename TDevHost,
+            typename TQueue,
+            typename TIdx,
+            typename TValue = typename std::iterator_traits<TIterator>::value_type>
+        auto deviceAsum(TDevAcc& devAcc, TDevHost& devHost, TQueue& queue, TIdx const& n, TIterator const& x)
+            -> TValue
+        {
+            if(n == 0)
+            {
+                return TValue{0};
+            }
+            return vikunja::reduce::deviceTransformReduce<TAcc, WorkDivPolicy, MemAccessPolicy>(
+                devAcc,
+                devHost,
+                queue,
+                n,
+                x,
+                detail::AbsFunc<TValue>(),
+                vikunja::operators::associative(vikunja::operators::Plus<TValue>()));
+        }
+
+        /**
+         * Returns the euclidean norm of a floating point vector. The squares are summed relative to the largest
+         * absolute value of the partial sum, like in the reference BLAS, therefore the result neither overflows nor
+         * underflows, if the norm itself is representable. The scale and the scaled square sum are reduced together
+         * in a single pass.
+         * @see deviceDot
+         * @param n The size of the vector.
+         * @param x The vector.
+         * @return The euclidean norm. 0, if n is 0.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename MemAccessPolicy = vikunja::MemAccess::MemAccessPolicy<TAcc>,
+            typename TIterator,
+            typename TDevAcc,
+            typename TDevHost,
+            typename TQueue,
+            typename TIdx,
+            typename TValue = typename std::iterator_traits<TIterator>::value_type>
+        auto deviceNrm2(TDevAcc& devAcc, TDevHost& devHost, TQueue& queue, TIdx const& n, TIterator const& x)
+            -> TValue
+        {
+            if(n == 0)
+            {
+                return TValue{0};
+            }
+            detail::ScaledSquareSum<TValue> const result
+                = vikunja::reduce::deviceTransformReduce<TAcc, WorkDivPolicy, MemAccessPolicy>(
+                    devAcc,
+                    devHost,
+                    queue,
+                    n,
+                    x,
+                    detail::ScaledSquareFunc<TValue>(),
+                    detail::ScaledSquareSumCombine<TValue>());
+            return result.scale * std::sqrt(result.sumOfSquares);
+        }
+    } // namespace blas1
+} // namespace vikunja
@@ -0,0 +1,175 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <alpaka/alpaka.hpp>
+
+namespace vikunja
+{
+    namespace blas1
+    {
+        namespace detail
+        {
+            /**
+             * Absolute value, which can be used in kernels.
+             */
+            template<typename T>
+            constexpr ALPAKA_FN_HOST_ACC T absolute(T const& value)
+            {
+                return (value < T{0}) ? -value : value;
+            }
+
+            /**
+             * Transform functor of the scal: returns alpha * x.
+             */
+            template<typename T>
+            struct ScalFunc
+            {
+                T alpha;
+
+                constexpr ALPAKA_FN_HOST_ACC T operator()(T const& x) const
+                {
+                    return alpha * x;
+                }
+            };
+
+            /**
+             * Transform functor of the axpy: returns alpha * x + y.
+             */
+            template<typename T>
+            struct AxpyFunc
+            {
+                T alpha;
+
+                constexpr ALPAKA_FN_HOST_ACC T operator()(T const& x, T const& y) const
+                {
+                    return alpha * x + y;
+                }
+            };
+
+            /**
+             * Transform functor of the axpby: returns alpha * x + beta * y. If beta is zero, y is ignored, so that
+             * an uninitialized y does not propagate NaN values.
+             */
+            template<typename T>
+            struct AxpbyFunc
+            {
+                T alpha;
+                T beta;
+
+                constexpr ALPAKA_FN_HOST_ACC T operator()(T const& x, T const& y) const
+                {
+                    return (beta == T{0}) ? alpha * x : alpha * x + beta * y;
+                }
+            };
+
+            /**
+             * Transform functor of the dot product, which is applied to the index of the element, so that both
+             * vectors are read in the single pass of the transform reduce.
+             */
+            template<typename TIteratorX, typename TIteratorY>
+            struct DotFunc
+            {
+                TIteratorX x;
+                TIteratorY y;
+
+                template<typename TIdx>
+                constexpr ALPAKA_FN_HOST_ACC auto operator()(TIdx const& i) const
+                {
+                    return x[i] * y[i];
+                }
+            };
+
+            /**
+             * Transform functor of the fused axpy and dot product: writes y[i] = alpha * x[i] + y[i] and returns
+             * y[i] * z[i] with the new value of y[i]. z can be the same vector as y.
+             */
+            template<typename T, typename TIteratorX, typename TIteratorY, typename TIteratorZ>
+            struct AxpyDotFunc
+            {
+                T alpha;
+                TIteratorX x;
+                TIteratorY y;
+                TIteratorZ z;
+
+                template<typename TIdx>
+                ALPAKA_FN_HOST_ACC T operator()(TIdx const& i) const
+                {
+                    T const value = alpha * x[i] + y[i];
+                    y[i] = value;
+                    return value * z[i];
+                }
+            };
+
+            /**
+             * Transform functor of the asum: returns the absolute value.
+             */
+            template<typename T>
+            struct AbsFunc
+            {
+                constexpr ALPAKA_FN_HOST_ACC T operator()(T const& x) const
+                {
+                    return absolute(x);
+                }
+            };
+
+            /**
+             * Partial result of the euclidean norm, which represents scale * sqrt(sumOfSquares). The squares are
+             * summed relative to the largest absolute value, therefore neither overflow nor underflow, if the norm
+             * itself is representable.
+             */
+            template<typename T>
+            struct ScaledSquareSum
+            {
+                T scale;
+                T sumOfSquares;
+            };
+
+            /**
+             * Transform functor of the nrm2: returns the scaled square sum of a single element.
+             */
+            template<typename T>
+            struct ScaledSquareFunc
+            {
+                constexpr ALPAKA_FN_HOST_ACC ScaledSquareSum<T> operator()(T const& x) const
+                {
+                    T const value = absolute(x);
+                    return (value == T{0}) ? ScaledSquareSum<T>{T{0}, T{0}} : ScaledSquareSum<T>{value, T{1}};
+                }
+            };
+
+            /**
+             * Reduce functor of the nrm2: rescales both square sums to the larger scale and adds them.
+             */
+            template<typename T>
+            struct ScaledSquareSumCombine
+            {
+                static constexpr bool isAssociative = true;
+
+                constexpr ALPAKA_FN_HOST_ACC ScaledSquareSum<T> operator()(
+                    ScaledSquareSum<T> const& a,
+                    ScaledSquareSum<T> const& b) const
+                {
+                    T const scale = (a.scale < b.scale) ? b.scale : a.scale;
+                    if(scale == T{0})
+                    {
+                        return ScaledSquareSum<T>{T{0}, T{0}};
+                    }
+                    // comparing the scales first keeps infinite values infinite instead of NaN
+                    T const ratioA = (a.scale == scale) ? T{1} : a.scale / scale;
+                    T const ratioB = (b.scale == scale) ? T{1} : b.scale / scale;
+                    return ScaledSquareSum<T>{
+                        scale,
+                        a.sumOfSquares * ratioA * ratioA + b.sumOfSquares * ratioB * ratioB};
+                }
+            };
+        } // namespace detail
+    } // namespace blas1
+} // namespace vikunja
@@ -0,0 +1,314 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/affinity/Affinity.hpp>
+#include <vikunja/compact/detail/BlockThreadCompactKernel.hpp>
+#include <vikunja/operators/functors.hpp>
+#include <vikunja/operators/operators.hpp>
+#include <vikunja/scan/detail/BlockThreadScanKernel.hpp>
+#include <vikunja/workdiv/BlockBasedWorkDiv.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+#include <cassert>
+#include <iterator>
+#include <type_traits>
+
+namespace vikunja
+{
+    namespace compact
+    {
+        namespace detail
+        {
+            /**
+             * Implementation of the stream compaction. Each thread of the grid owns a contiguous chunk of the input.
+             * The first kernel counts the selected elements of each chunk, the second kernel scans the counts in a
+             * single block and the third kernel writes the selected elements of each chunk contiguously to the
+             * output. Only the selected elements are written to global memory.
+             * @tparam TWriteIndex If true, the indices of the selected elements are written, otherwise the elements.
+             * @return The number of selected elements.
+             */
+            template<
+                typename TAcc,
+                typename WorkDivPolicy,
+                bool TWriteIndex,
+                typename TPredicateOperator,
+                typename TDevAcc,
+                typename TDevHost,
+                typename TQueue,
+                typename TIdx,
+                typename TInputIterator,
+                typename TOutputIterator,
+                typename TPredicate>
+            auto compactImpl(
+                TDevAcc& devAcc,
+                TDevHost& devHost,
+                TQueue& queue,
+                TIdx const& n,
+                TInputIterator const& source,
+                TOutputIterator const& destination,
+                TPredicate const& predicate) -> TIdx
+            {
+                if(n == 0)
+                {
+                    return 0;
+                }
+                vikunja::affinity::applyAffinity<TAcc>();
+                constexpr uint64_t blockSize = WorkDivPolicy::template getBlockSize<TAcc>();
+                using Dim = alpaka::Dim<TAcc>;
+                using WorkDiv = alpaka::WorkDivMembers<Dim, TIdx>;
+                using Vec = alpaka::Vec<Dim, TIdx>;
+                constexpr TIdx xIndex = Dim::value - 1u;
+
+                Vec const elementsPerThread(Vec::all(static_cast<TIdx>(1u)));
+                Vec threadsPerBlock(Vec::all(static_cast<TIdx>(1u)));
+                Vec blocksPerGrid(Vec::all(static_cast<TIdx>(1u)));
+
+                Vec const countExtent(Vec::all(static_cast<TIdx>(1u)));
+                auto countBuffer = alpaka::allocBuf<TIdx, TIdx>(devAcc, countExtent);
+                auto countView = alpaka::allocBuf<TIdx, TIdx>(devHost, countExtent);
+
+                if(n < static_cast<TIdx>(blockSize))
+                {
+                    // the small problem is compacted by a single thread
+                    WorkDiv const singleThreadWorkDiv{blocksPerGrid, threadsPerBlock, elementsPerThread};
+                    ChunkCompactKernel<1u, TWriteIndex, TPredicateOperator> kernel;
+                    alpaka::exec<TAcc>(
+                        queue,
+                        singleThreadWorkDiv,
+                        kernel,
+                        source,
+                        destination,
+                        static_cast<TIdx*>(nullptr),
+                        alpaka::getPtrNative(countBuffer),
+                        n,
+                        predicate);
+                    alpaka::memcpy(queue, countView, countBuffer, countExtent);
+                    alpaka::wait(queue);
+                    return alpaka::getPtrNative(countView)[0];
+                }
+
+                // each chunk needs at least one element
+                TIdx gridSize = WorkDivPolicy::template getGridSize<TAcc>(devAcc);
+                TIdx const maxGridSize = n / static_cast<TIdx>(blockSize);
+                if(gridSize > maxGridSize)
+                {
+                    gridSize = maxGridSize;
+                }
+                TIdx const numChunks = gridSize * static_cast<TIdx>(blockSize);
+
+                blocksPerGrid[xIndex] = gridSize;
+                threadsPerBlock[xIndex] = static_cast<TIdx>(blockSize);
+                Vec const singleBlocksPerGrid(Vec::all(static_cast<TIdx>(1u)));
+
+                WorkDiv const multiBlockWorkDiv{blocksPerGrid, threadsPerBlock, elementsPerThread};
+                WorkDiv const singleBlockWorkDiv{singleBlocksPerGrid, threadsPerBlock, elementsPerThread};
+
+                Vec chunkCountsExtent(Vec::all(static_cast<TIdx>(1u)));
+                chunkCountsExtent[xIndex] = numChunks;
+                auto chunkCounts = alpaka::allocBuf<TIdx, TIdx>(devAcc, chunkCountsExtent);
+
+                using PlusOperator = vikunja::operators::BinaryOp<TAcc, vikunja::operators::Plus<TIdx>, TIdx, TIdx>;
+                ChunkCountKernel<blockSize, TPredicateOperator> chunkCountKernel;
+                vikunja::scan::detail::ChunkSumScanKernel<blockSize, TIdx, PlusOperator> chunkCountScanKernel;
+                ChunkCompactKernel<blockSize, TWriteIndex, TPredicateOperator> chunkCompactKernel;
+
+                alpaka::exec<TAcc>(
+                    queue,
+                    multiBlockWorkDiv,
+                    chunkCountKernel,
+                    source,
+                    alpaka::getPtrNative(chunkCounts),
+                    n,
+                    predicate);
+                alpaka::exec<TAcc>(
+                    queue,
+                    singleBlockWorkDiv,
+                    chunkCountScanKernel,
+                    alpaka::getPtrNative(chunkCounts),
+                    numChunks,
+                    vikunja::operators::Plus<TIdx>());
+                alpaka::exec<TAcc>(
+                    queue,
+                    multiBlockWorkDiv,
+                    chunkCompactKernel,
+                    source,
+                    destination,
+                    alpaka::getPtrNative(chunkCounts),
+                    alpaka::getPtrNative(countBuffer),
+                    n,
+                    predicate);
+                alpaka::memcpy(queue, countView, countBuffer, countExtent);
+                // the helper memory must not be freed before the kernels are finished
+                alpaka::wait(queue);
+                return alpaka::getPtrNative(countView)[0];
+            }
+        } // namespace detail
+
+        /**
+         * Copies the elements of the input, which fulfill the predicate, to the output and keeps their order, i.e.
+         * if one has the array [1,2,3,4,5] and the predicate (x) -> x % 2 == 1, the output will contain [1,3,5] and
+         * 3 is returned.
+         * The output must be big enough for all selected elements and must not overlap with the input.
+         * @tparam TAcc The alpaka accelerator type to use.
+         * @tparam WorkDivPolicy The working division policy. Defaults to a templated value depending on the
+         * accelerator. Each thread needs a contiguous chunk of the input, therefore the linear memory access policy
+         * is always used.
+         * @tparam TPredicate Type of the predicate.
+         * @tparam TInputIterator Type of the input iterator. Should be a pointer-like type.
+         * @tparam TOutputIterator Type of the output iterator. Should be a pointer-like type.
+         * @tparam TDevAcc The type of the alpaka accelerator.
+         * @tparam TDevHost The type of the alpaka host.
+         * @tparam TQueue The type of the alpaka queue.
+         * @tparam TIdx The index type to use.
+         * @tparam TPredicateOperator The vikunja::operators type of the predicate.
+         * @param devAcc The alpaka accelerator.
+         * @param devHost The alpaka host.
+         * @param queue The alpaka queue.
+         * @param n The number of elements in the input.
+         * @param source The input iterator.
+         * @param destination The output iterator.
+         * @param predicate The predicate, which returns true for the elements to copy.
+         * @return The number of copied elements.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TPredicate,
+            typename TInputIterator,
+            typename TOutputIterator,
+            typename TDevAcc,
+            typename TDevHost,
+            typename TQueue,
+            typename TIdx,
+            typename TPredicateOperator = vikunja::operators::
+                UnaryOp<TAcc, TPredicate, typename std::iterator_traits<TInputIterator>::value_type>>
+        auto deviceCopyIf(
+            TDevAcc& devAcc,
+            TDevHost& devHost,
+            TQueue& queue,
+            TIdx const& n,
+            TInputIterator const& source,
+            TOutputIterator const& destination,
+            TPredicate const& predicate) -> TIdx
+        {
+            return detail::compactImpl<TAcc, WorkDivPolicy, false, TPredicateOperator>(
+                devAcc,
+                devHost,
+                queue,
+                n,
+                source,
+                destination,
+                predicate);
+        }
+
+        /**
+         * Copy if with begin and end iterator of the input.
+         * @see deviceCopyIf
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TPredicate,
+            typename TInputIterator,
+            typename TOutputIterator,
+            typename TDevAcc,
+            typename TDevHost,
+            typename TQueue>
+        auto deviceCopyIf(
+            TDevAcc& devAcc,
+            TDevHost& devHost,
+            TQueue& queue,
+            TInputIterator const& sourceBegin,
+            TInputIterator const& sourceEnd,
+            TOutputIterator const& destination,
+            TPredicate const& predicate)
+        {
+            assert(sourceEnd >= sourceBegin);
+            auto size = static_cast<typename alpaka::trait::IdxType<TAcc>::type>(sourceEnd - sourceBegin);
+            return deviceCopyIf<TAcc, WorkDivPolicy>(
+                devAcc,
+                devHost,
+                queue,
+                size,
+                sourceBegin,
+                destination,
+                predicate);
+        }
+
+        /**
+         * Writes the indices of the elements of the input, which fulfill the predicate, in ascending order to the
+         * output, i.e. if one has the array [1,2,3,4,5] and the predicate (x) -> x % 2 == 1, the output will contain
+         * [0,2,4] and 3 is returned.
+         * The output must be big enough for all selected indices and must not overlap with the input.
+         * @see deviceCopyIf
+         * @param indices The output iterator for the indices.
+         * @return The number of selected elements.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TPredicate,
+            typename TInputIterator,
+            typename TIndexIterator,
+            typename TDevAcc,
+            typename TDevHost,
+            typename TQueue,
+            typename TIdx,
+            typename TPredicateOperator = vikunja::operators::
+                UnaryOp<TAcc, TPredicate, typename std::iterator_traits<TInputIterator>::value_type>>
+        auto deviceWhere(
+            TDevAcc& devAcc,
+            TDevHost& devHost,
+            TQueue& queue,
+            TIdx const& n,
+            TInputIterator const& source,
+            TIndexIterator const& indices,
+            TPredicate const& predicate) -> TIdx
+        {
+            return detail::compactImpl<TAcc, WorkDivPolicy, true, TPredicateOperator>(
+                devAcc,
+                devHost,
+                queue,
+                n,
+                source,
+                indices,
+                predicate);
+        }
+
+        /**
+         * Where with begin and end iterator of the input.
+         * @see deviceWhere
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TPredicate,
+            typename TInputIterator,
+            typename TIndexIterator,
+            typename TDevAcc,
+            typename TDevHost,
+            typename TQueue>
+        auto deviceWhere(
+            TDevAcc& devAcc,
+            TDevHost& devHost,
+            TQueue& queue,
+            TInputIterator const& sourceBegin,
+            TInputIterator const& sourceEnd,
+            TIndexIterator const& indices,
+            TPredicate const& predicate)
+        {
+            assert(sourceEnd >= sourceBegin);
+            auto size = static_cast<typename alpaka::trait::IdxType<TAcc>::type>(sourceEnd - sourceBegin);
+            return deviceWhere<TAcc, WorkDivPolicy>(devAcc, devHost, queue, size, sourceBegin, indices, predicate);
+        }
+    } // namespace compact
+} // namespace vikunja
@@ -0,0 +1,138 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/access/BlockStrategy.hpp>
+#include <vikunja/scan/detail/BlockThreadScanKernel.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+namespace vikunja
+{
+    namespace compact
+    {
+        namespace detail
+        {
+            /**
+             * First phase of the compaction: each thread counts the elements of its chunk, which fulfill the
+             * predicate. The chunk of each thread must contain at least one element.
+             * @tparam TBlockSize The block size of this kernel.
+             * @tparam TPredicateOperator The vikunja::operators type of the predicate.
+             */
+            template<uint64_t TBlockSize, typename TPredicateOperator>
+            struct ChunkCountKernel
+            {
+                /**
+                 * @param acc The alpaka accelerator.
+                 * @param source The input iterator.
+                 * @param chunkCounts The output iterator with one element per thread of the grid.
+                 * @param n The size of the input iterator.
+                 * @param predicate The predicate.
+                 */
+                template<
+                    typename TAcc,
+                    typename TIdx,
+                    typename TInputIterator,
+                    typename TCountIterator,
+                    typename TPredicate>
+                ALPAKA_FN_ACC void operator()(
+                    TAcc const& acc,
+                    TInputIterator const& source,
+                    TCountIterator const& chunkCounts,
+                    TIdx const& n,
+                    TPredicate const& predicate) const
+                {
+                    constexpr TIdx xIndex = alpaka::Dim<TAcc>::value - 1u;
+                    auto const globalThreadIndex = alpaka::getIdx<alpaka::Grid, alpaka::Threads>(acc)[xIndex];
+
+                    using MemIndex = vikunja::MemAccess::BlockStrategy<vikunja::scan::detail::ChunkPolicy, TAcc, TIdx>;
+                    TIdx count = 0;
+                    for(MemIndex iter(acc, n, TBlockSize), end = iter.end(); iter < end; ++iter)
+                    {
+                        if(TPredicateOperator::run(acc, predicate, source[*iter]))
+                        {
+                            ++count;
+                        }
+                    }
+                    chunkCounts[globalThreadIndex] = count;
+                }
+            };
+
+            /**
+             * Last phase of the compaction: each thread writes the elements or indices of its chunk, which fulfill
+             * the predicate, to the output, starting at the offset of its chunk. The last thread of the grid writes
+             * the total number of selected elements.
+             * @tparam TBlockSize The block size of this kernel.
+             * @tparam TWriteIndex If true, the index of the selected elements is written, otherwise the element.
+             * @tparam TPredicateOperator The vikunja::operators type of the predicate.
+             */
+            template<uint64_t TBlockSize, bool TWriteIndex, typename TPredicateOperator>
+            struct ChunkCompactKernel
+            {
+                /**
+                 * @param acc The alpaka accelerator.
+                 * @param source The input iterator.
+                 * @param destination The output iterator.
+                 * @param chunkOffsets The exclusive prefix of the chunk counts. The value of the first chunk is not
+                 * used.
+                 * @param count Output iterator for the total number of selected elements.
+                 * @param n The size of the input iterator.
+                 * @param predicate The predicate.
+                 */
+                template<
+                    typename TAcc,
+                    typename TIdx,
+                    typename TInputIterator,
+                    typename TOutputIterator,
+                    typename TOffsetIterator,
+                    typename TCountIterator,
+                    typename TPredicate>
+                ALPAKA_FN_ACC void operator()(
+                    TAcc const& acc,
+                    TInputIterator const& source,
+                    TOutputIterator const& destination,
+                    TOffsetIterator const& chunkOffsets,
+                    TCountIterator const& count,
+                    TIdx const& n,
+                    TPredicate const& predicate) const
+                {
+                    constexpr TIdx xIndex = alpaka::Dim<TAcc>::value - 1u;
+                    auto const globalThreadIndex = alpaka::getIdx<alpaka::Grid, alpaka::Threads>(acc)[xIndex];
+                    auto const globalThreadCount = alpaka::getWorkDiv<alpaka::Grid, alpaka::Threads>(acc)[xIndex];
+
+                    TIdx offset = (globalThreadIndex == 0) ? 0 : chunkOffsets[globalThreadIndex];
+
+                    using MemIndex = vikunja::MemAccess::BlockStrategy<vikunja::scan::detail::ChunkPolicy, TAcc, TIdx>;
+                    for(MemIndex iter(acc, n, TBlockSize), end = iter.end(); iter < end; ++iter)
+                    {
+                        auto const& value = source[*iter];
+                        if(TPredicateOperator::run(acc, predicate, value))
+                        {
+                            if constexpr(TWriteIndex)
+                            {
+                                destination[offset] = *iter;
+                            }
+                            else
+                            {
+                                destination[offset] = value;
+                            }
+                            ++offset;
+                        }
+                    }
+
+                    if(globalThreadIndex == globalThreadCount - 1)
+                    {
+                        *count = offset;
+                    }
+                }
+            };
+        } // namespace detail
+    } // namespace compact
+} // namespace vikunja
@@ -0,0 +1,199 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/operators/operators.hpp>
+#include <vikunja/scatter/detail/ScatterReduceFunc.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+#include <cstdint>
+#include <type_traits>
+
+namespace vikunja
+{
+    namespace hash
+    {
+        /**
+         * Default hash function of the hash table. Mixes the bits of integral keys with the finalizer of
+         * MurmurHash3.
+         * @tparam TKey The key type.
+         */
+        template<typename TKey>
+        struct MurmurHash
+        {
+            static_assert(std::is_integral_v<TKey>, "The default hash function supports only integral keys.");
+
+            constexpr ALPAKA_FN_HOST_ACC uint64_t operator()(TKey const& key) const
+            {
+                uint64_t h = static_cast<uint64_t>(key);
+                h ^= h >> 33u;
+                h *= 0xff51afd7ed558ccdull;
+                h ^= h >> 33u;
+                h *= 0xc4ceb9fe1a85ec53ull;
+                h ^= h >> 33u;
+                return h;
+            }
+        };
+
+        /**
+         * Non owning view of an open addressing hash table. The slots are stored in a key and a value buffer with
+         * capacity elements each, an empty slot contains the empty key. The view is passed by value to the
+         * kernels.
+         * @tparam TKey The key type. Must be supported by the alpaka compare and swap operation.
+         * @tparam TValue The value type.
+         * @tparam TIdx The index type.
+         * @tparam THash The type of the hash function, which maps a key to an unsigned 64 bit integer.
+         */
+        template<typename TKey, typename TValue, typename TIdx, typename THash = MurmurHash<TKey>>
+        struct HashTable
+        {
+            //! The keys of the slots.
+            TKey* keys;
+            //! The values of the slots.
+            TValue* values;
+            //! The number of slots. Must be greater than the number of distinct keys.
+            TIdx capacity;
+            //! The key of an empty slot. Must not be inserted.
+            TKey emptyKey;
+            //! The hash function.
+            THash hash = THash{};
+        };
+
+        namespace detail
+        {
+            /**
+             * Probes the slots of a key. The probing is linear, consecutive slots share cache lines, therefore most
+             * probes of a key hit an already loaded cache line. If the key is not found, the key is inserted into
+             * the first empty slot with a compare and swap operation.
+             * @tparam TInsert If false, empty slots are not claimed.
+             * @param claimed Set to true, if this call inserted the key.
+             * @return The slot of the key or capacity, if the key is not found or the table is full.
+             */
+            template<bool TInsert, typename TAcc, typename TKey, typename TValue, typename TIdx, typename THash>
+            ALPAKA_FN_HOST_ACC TIdx probe(
+                TAcc const& acc,
+                HashTable<TKey, TValue, TIdx, THash> const& table,
+                TKey const& key,
+                bool& claimed)
+            {
+                claimed = false;
+                TIdx slot = static_cast<TIdx>(table.hash(key) % static_cast<uint64_t>(table.capacity));
+                for(TIdx i = 0; i < table.capacity; ++i)
+                {
+                    TKey const slotKey = table.keys[slot];
+                    if(slotKey == key)
+                    {
+                        return slot;
+                    }
+                    if(slotKey == table.emptyKey)
+                    {
+                        if constexpr(!TInsert)
+                        {
+                            return table.capacity;
+                        }
+                        else
+                        {
+                            TKey const old = alpaka::atomicOp<alpaka::AtomicCas>(
+                                acc,
+                                &table.keys[slot],
+                                table.emptyKey,
+                                key,
+                                alpaka::hierarchy::Grids{});
+                            claimed = old == table.emptyKey;
+                            // another thread can claim the slot for the same key at the same time
+                            if(claimed || old == key)
+                            {
+                                return slot;
+                            }
+                        }
+                    }
+                    slot = (slot + 1 == table.capacity) ? 0 : slot + 1;
+                }
+                return table.capacity;
+            }
+
+            /**
+             * Transform functor, which inserts a key value pair. If the key is already in the table, its value is not
+             * changed. If several threads insert the same key at the same time, the value of the thread, which
+             * claims the slot, is written.
+             * @return True, if the key is in the table afterwards.
+             */
+            template<typename TKey, typename TValue, typename TIdx, typename THash>
+            struct InsertFunc
+            {
+                HashTable<TKey, TValue, TIdx, THash> table;
+
+                template<typename TAcc>
+                ALPAKA_FN_HOST_ACC bool operator()(TAcc const& acc, TKey const& key, TValue const& value) const
+                {
+                    bool claimed = false;
+                    TIdx const slot = probe<true>(acc, table, key, claimed);
+                    // only the thread, which inserted the key, writes the value
+                    if(claimed)
+                    {
+                        table.values[slot] = value;
+                    }
+                    return slot != table.capacity;
+                }
+            };
+
+            /**
+             * Transform functor, which inserts a key and reduces its value with the value in the table. The values
+             * of the table must be initialized with the identity of the reduction. A sum is reduced with an atomic
+             * add, all other functions with a compare and swap loop.
+             * @tparam TReduceOperator The vikunja::operators type of the reduce function.
+             */
+            template<
+                typename TReduceOperator,
+                typename TKey,
+                typename TValue,
+                typename TIdx,
+                typename THash,
+                typename TReduce>
+            struct InsertOrReduceFunc
+            {
+                HashTable<TKey, TValue, TIdx, THash> table;
+                TReduce reduce;
+
+                template<typename TAcc>
+                ALPAKA_FN_HOST_ACC bool operator()(TAcc const& acc, TKey const& key, TValue const& value) const
+                {
+                    bool claimed = false;
+                    TIdx const slot = probe<true>(acc, table, key, claimed);
+                    if(slot == table.capacity)
+                    {
+                        return false;
+                    }
+                    vikunja::scatter::detail::atomicReduce<TReduceOperator>(acc, &table.values[slot], value, reduce);
+                    return true;
+                }
+            };
+
+            /**
+             * Transform functor, which returns the value of a key or the not found value.
+             */
+            template<typename TKey, typename TValue, typename TIdx, typename THash>
+            struct FindFunc
+            {
+                HashTable<TKey, TValue, TIdx, THash> table;
+                TValue notFound;
+
+                template<typename TAcc>
+                ALPAKA_FN_HOST_ACC TValue operator()(TAcc const& acc, TKey const& key) const
+                {
+                    bool claimed = false;
+                    TIdx const slot = probe<false>(acc, table, key, claimed);
+                    return (slot == table.capacity) ? notFound : table.values[slot];
+                }
+            };
+        } // namespace detail
+    } // namespace hash
+} // namespace vikunja
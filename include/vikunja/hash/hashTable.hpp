@@ -0,0 +1,200 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/access/BlockStrategy.hpp>
+#include <vikunja/hash/detail/HashTableFunc.hpp>
+#include <vikunja/mem/iterator.hpp>
+#include <vikunja/operators/functors.hpp>
+#include <vikunja/operators/operators.hpp>
+#include <vikunja/reduce/reduce.hpp>
+#include <vikunja/transform/transform.hpp>
+#include <vikunja/workdiv/BlockBasedWorkDiv.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+namespace vikunja
+{
+    namespace hash
+    {
+        /**
+         * Empties all slots of the hash table and sets all values to the initial value. Must be called before the
+         * first insert. For deviceHashInsertOrReduce, the initial value must be the identity of the reduction.
+         * @tparam TAcc The alpaka accelerator type to use.
+         * @tparam WorkDivPolicy The working division policy. Defaults to a templated value depending on the
+         * accelerator. For the API of this, see workdiv/BlockBasedWorkDiv.hpp
+         * @tparam MemAccessPolicy The memory access policy. Defaults to a templated value depending on the
+         * accelerator. For the API of this, see vikunja::MemAccess::PolicyBasedBlockStrategy
+         * @param devAcc The alpaka accelerator.
+         * @param queue The alpaka queue.
+         * @param table The hash table.
+         * @param initValue The value of all slots.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename MemAccessPolicy = vikunja::MemAccess::MemAccessPolicy<TAcc>,
+            typename TKey,
+            typename TValue,
+            typename TIdx,
+            typename THash,
+            typename TDevAcc,
+            typename TQueue>
+        auto deviceHashTableClear(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            HashTable<TKey, TValue, TIdx, THash> const& table,
+            TValue const& initValue = TValue{}) -> void
+        {
+            vikunja::transform::deviceTransform<TAcc, WorkDivPolicy, MemAccessPolicy>(
+                devAcc,
+                queue,
+                table.capacity,
+                table.keys,
+                table.keys,
+                vikunja::reduce::detail::Fill<TKey>{table.emptyKey});
+            vikunja::transform::deviceTransform<TAcc, WorkDivPolicy, MemAccessPolicy>(
+                devAcc,
+                queue,
+                table.capacity,
+                table.values,
+                table.values,
+                vikunja::reduce::detail::Fill<TValue>{initValue});
+        }
+
+        /**
+         * Inserts n key value pairs into the hash table. If a key is already in the table, its value is not changed.
+         * If a key occurs several times in the input, it is not defined, which of its values is inserted.
+         * The pairs are inserted in parallel by the transform kernel: each key probes the slots linearly, beginning
+         * at the slot of its hash, and claims the first empty slot with a compare and swap operation. The table must
+         * have more slots than distinct keys, keys without a free slot are not inserted.
+         * @tparam TAcc The alpaka accelerator type to use.
+         * @tparam WorkDivPolicy The working division policy. Defaults to a templated value depending on the
+         * accelerator. For the API of this, see workdiv/BlockBasedWorkDiv.hpp
+         * @tparam MemAccessPolicy The memory access policy. Defaults to a templated value depending on the
+         * accelerator. For the API of this, see vikunja::MemAccess::PolicyBasedBlockStrategy
+         * @param devAcc The alpaka accelerator.
+         * @param queue The alpaka queue.
+         * @param table The hash table.
+         * @param n The number of pairs.
+         * @param keys The keys to insert. Must not contain the empty key.
+         * @param values The values of the keys.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename MemAccessPolicy = vikunja::MemAccess::MemAccessPolicy<TAcc>,
+            typename TKey,
+            typename TValue,
+            typename TIdx,
+            typename THash,
+            typename TKeyIterator,
+            typename TValueIterator,
+            typename TDevAcc,
+            typename TQueue>
+        auto deviceHashInsert(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            HashTable<TKey, TValue, TIdx, THash> const& table,
+            TIdx const& n,
+            TKeyIterator const& keys,
+            TValueIterator const& values) -> void
+        {
+            vikunja::transform::deviceTransform<TAcc, WorkDivPolicy, MemAccessPolicy>(
+                devAcc,
+                queue,
+                n,
+                keys,
+                values,
+                vikunja::mem::iterator::DiscardIterator{},
+                detail::InsertFunc<TKey, TValue, TIdx, THash>{table});
+        }
+
+        /**
+         * Inserts n key value pairs into the hash table and reduces the values of equal keys with the value in the
+         * table, e.g. to aggregate the values of each key without sorting. The values of the table must be
+         * initialized with the identity of the reduction, see deviceHashTableClear. The reduction must be
+         * associative and commutative. Sums, i.e. vikunja::operators::Plus, are reduced with an atomic add, all
+         * other functions with an atomic compare and swap loop, which requires a value type supported by the alpaka
+         * compare and swap operation.
+         * @see deviceHashInsert
+         * @param reduce The reduce function.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename MemAccessPolicy = vikunja::MemAccess::MemAccessPolicy<TAcc>,
+            typename TKey,
+            typename TValue,
+            typename TIdx,
+            typename THash,
+            typename TKeyIterator,
+            typename TValueIterator,
+            typename TReduce,
+            typename TDevAcc,
+            typename TQueue,
+            typename TReduceOperator = vikunja::operators::BinaryOp<TAcc, TReduce, TValue, TValue>>
+        auto deviceHashInsertOrReduce(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            HashTable<TKey, TValue, TIdx, THash> const& table,
+            TIdx const& n,
+            TKeyIterator const& keys,
+            TValueIterator const& values,
+            TReduce const& reduce) -> void
+        {
+            vikunja::transform::deviceTransform<TAcc, WorkDivPolicy, MemAccessPolicy>(
+                devAcc,
+                queue,
+                n,
+                keys,
+                values,
+                vikunja::mem::iterator::DiscardIterator{},
+                detail::InsertOrReduceFunc<TReduceOperator, TKey, TValue, TIdx, THash, TReduce>{table, reduce});
+        }
+
+        /**
+         * Looks up n keys in the hash table and writes the value of each key or the not found value to the output.
+         * @see deviceHashInsert
+         * @param queries The keys to look up.
+         * @param destination The output iterator of the values.
+         * @param notFound The value of keys, which are not in the table.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename MemAccessPolicy = vikunja::MemAccess::MemAccessPolicy<TAcc>,
+            typename TKey,
+            typename TValue,
+            typename TIdx,
+            typename THash,
+            typename TQueryIterator,
+            typename TOutputIterator,
+            typename TDevAcc,
+            typename TQueue>
+        auto deviceHashFind(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            HashTable<TKey, TValue, TIdx, THash> const& table,
+            TIdx const& n,
+            TQueryIterator const& queries,
+            TOutputIterator const& destination,
+            TValue const& notFound) -> void
+        {
+            vikunja::transform::deviceTransform<TAcc, WorkDivPolicy, MemAccessPolicy>(
+                devAcc,
+                queue,
+                n,
+                queries,
+                destination,
+                detail::FindFunc<TKey, TValue, TIdx, THash>{table, notFound});
+        }
+    } // namespace hash
+} // namespace vikunja
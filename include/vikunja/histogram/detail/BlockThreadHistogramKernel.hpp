@@ -0,0 +1,192 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/access/BlockStrategy.hpp>
+#include <vikunja/operators/functors.hpp>
+#include <vikunja/operators/operators.hpp>
+#include <vikunja/reduce/detail/BlockThreadReduceKernel.hpp>
+#include <vikunja/search/detail/BlockThreadSearchKernel.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+#include <cstdint>
+#include <type_traits>
+
+namespace vikunja
+{
+    namespace histogram
+    {
+        namespace detail
+        {
+            //! Maximum number of bins, which are privatized in the shared memory of a block.
+            constexpr uint64_t sharedHistogramBins = 1024u;
+
+            /**
+             * Maps a sample to one of numBins bins of equal width between lower and upper. Samples outside of
+             * [lower, upper) are mapped to numBins.
+             * @tparam TLevel The type of the bin boundaries.
+             * @tparam TIdx The index type.
+             */
+            template<typename TLevel, typename TIdx>
+            struct EvenBin
+            {
+                TLevel lower;
+                TLevel upper;
+                TIdx numBins;
+
+                template<typename TAcc, typename TSample>
+                ALPAKA_FN_HOST_ACC TIdx operator()(TAcc const&, TSample const& sample) const
+                {
+                    if(!(sample >= lower && sample < upper))
+                    {
+                        return numBins;
+                    }
+                    if constexpr(std::is_floating_point_v<TLevel>)
+                    {
+                        TIdx const bin = static_cast<TIdx>((sample - lower) / (upper - lower) * numBins);
+                        // rounding can move samples close to the upper level out of the last bin
+                        return (bin < numBins) ? bin : numBins - 1;
+                    }
+                    else
+                    {
+                        return static_cast<TIdx>(
+                            static_cast<uint64_t>(sample - lower) * static_cast<uint64_t>(numBins)
+                            / static_cast<uint64_t>(upper - lower));
+                    }
+                }
+            };
+
+            /**
+             * Maps a sample to the bin i with levels[i] <= sample < levels[i + 1] with a binary search. Samples
+             * outside of [levels[0], levels[numBins]) are mapped to numBins.
+             * @tparam TLevelIterator The type of the sorted bin boundaries.
+             * @tparam TIdx The index type.
+             */
+            template<typename TLevelIterator, typename TIdx>
+            struct RangeBin
+            {
+                TLevelIterator levels;
+                TIdx numBins;
+
+                template<typename TAcc, typename TSample>
+                ALPAKA_FN_HOST_ACC TIdx operator()(TAcc const& acc, TSample const& sample) const
+                {
+                    using TLevel = std::decay_t<decltype(levels[0])>;
+                    using LessOperator
+                        = vikunja::operators::BinaryOp<TAcc, vikunja::operators::Less<TLevel>, TLevel, TLevel>;
+                    TLevel const value = static_cast<TLevel>(sample);
+                    if(!(value >= levels[0] && value < levels[numBins]))
+                    {
+                        return numBins;
+                    }
+                    TIdx const upperBound = vikunja::search::detail::boundSearch<true, LessOperator>(
+                        acc,
+                        levels,
+                        static_cast<TIdx>(1u),
+                        numBins,
+                        value,
+                        vikunja::operators::Less<TLevel>());
+                    return upperBound - 1;
+                }
+            };
+
+            /**
+             * Counts the samples of each bin. If TPrivate is true, each block counts its samples in private bins in
+             * the shared memory with atomic operations on the block level and adds its bins to the global histogram
+             * at the end. On the CPU accelerators with one thread per block, the private bins are per thread and the
+             * shared memory atomics are uncontended. Otherwise, each sample is counted with an atomic operation on
+             * the global histogram, which is used for more bins than fit in the shared memory.
+             * @tparam TBlockSize The block size of this kernel.
+             * @tparam TMemAccessPolicy The memory access policy of the samples.
+             * @tparam TPrivate If true, the bins are privatized per block. Requires at most sharedHistogramBins bins.
+             * @tparam TCount The type of the bin counters.
+             */
+            template<uint64_t TBlockSize, typename TMemAccessPolicy, bool TPrivate, typename TCount>
+            struct HistogramKernel
+            {
+                /**
+                 * @param acc The alpaka accelerator.
+                 * @param samples The input samples.
+                 * @param histogram The zero initialized histogram with numBins counters.
+                 * @param n The number of samples.
+                 * @param numBins The number of bins.
+                 * @param binFunc The functor, which maps a sample to its bin or to numBins.
+                 */
+                template<typename TAcc, typename TIdx, typename TSampleIterator, typename TBinFunc>
+                ALPAKA_FN_ACC void operator()(
+                    TAcc const& acc,
+                    TSampleIterator const& samples,
+                    TCount* const histogram,
+                    TIdx const& n,
+                    TIdx const& numBins,
+                    TBinFunc const& binFunc) const
+                {
+                    using MemIndex = vikunja::MemAccess::BlockStrategy<TMemAccessPolicy, TAcc, TIdx>;
+                    if constexpr(TPrivate)
+                    {
+                        using SharedArray = vikunja::reduce::detail::sharedStaticArray<TCount, sharedHistogramBins>;
+                        auto& bins(alpaka::declareSharedVar<SharedArray, __COUNTER__>(acc));
+
+                        constexpr TIdx xIndex = alpaka::Dim<TAcc>::value - 1u;
+                        auto const threadIndex = alpaka::getIdx<alpaka::Block, alpaka::Threads>(acc)[xIndex];
+                        for(TIdx i = threadIndex; i < numBins; i += static_cast<TIdx>(TBlockSize))
+                        {
+                            bins[i] = 0;
+                        }
+                        alpaka::syncBlockThreads(acc);
+
+                        for(MemIndex iter(acc, n, TBlockSize), end = iter.end(); iter < end; ++iter)
+                        {
+                            TIdx const bin = binFunc(acc, samples[*iter]);
+                            if(bin < numBins)
+                            {
+                                alpaka::atomicOp<alpaka::AtomicAdd>(
+                                    acc,
+                                    &bins[bin],
+                                    static_cast<TCount>(1u),
+                                    alpaka::hierarchy::Threads{});
+                            }
+                        }
+                        alpaka::syncBlockThreads(acc);
+
+                        // merge the private bins into the global histogram
+                        for(TIdx i = threadIndex; i < numBins; i += static_cast<TIdx>(TBlockSize))
+                        {
+                            if(bins[i] != 0)
+                            {
+                                alpaka::atomicOp<alpaka::AtomicAdd>(
+                                    acc,
+                                    &histogram[i],
+                                    bins[i],
+                                    alpaka::hierarchy::Grids{});
+                            }
+                        }
+                    }
+                    else
+                    {
+                        for(MemIndex iter(acc, n, TBlockSize), end = iter.end(); iter < end; ++iter)
+                        {
+                            TIdx const bin = binFunc(acc, samples[*iter]);
+                            if(bin < numBins)
+                            {
+                                alpaka::atomicOp<alpaka::AtomicAdd>(
+                                    acc,
+                                    &histogram[bin],
+                                    static_cast<TCount>(1u),
+                                    alpaka::hierarchy::Grids{});
+                            }
+                        }
+                    }
+                }
+            };
+        } // namespace detail
+    } // namespace histogram
+} // namespace vikunja
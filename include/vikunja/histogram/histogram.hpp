@@ -0,0 +1,235 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/access/BlockStrategy.hpp>
+#include <vikunja/affinity/Affinity.hpp>
+#include <vikunja/histogram/detail/BlockThreadHistogramKernel.hpp>
+#include <vikunja/reduce/reduce.hpp>
+#include <vikunja/transform/transform.hpp>
+#include <vikunja/workdiv/BlockBasedWorkDiv.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+#include <cstdint>
+
+namespace vikunja
+{
+    namespace histogram
+    {
+        namespace detail
+        {
+            /**
+             * Zeros the histogram and counts the samples. If the bins fit in the shared memory, they are privatized
+             * per block, otherwise the samples are counted with global atomic operations.
+             */
+            template<
+                typename TAcc,
+                typename WorkDivPolicy,
+                typename MemAccessPolicy,
+                typename TDevAcc,
+                typename TQueue,
+                typename TIdx,
+                typename TSampleIterator,
+                typename TCount,
+                typename TBinFunc>
+            void histogramImpl(
+                TDevAcc& devAcc,
+                TQueue& queue,
+                TIdx const& n,
+                TSampleIterator const& samples,
+                TCount* const histogram,
+                TIdx const& numBins,
+                TBinFunc const& binFunc)
+            {
+                if(numBins == 0)
+                {
+                    return;
+                }
+                vikunja::transform::deviceTransform<TAcc, WorkDivPolicy, MemAccessPolicy>(
+                    devAcc,
+                    queue,
+                    numBins,
+                    histogram,
+                    histogram,
+                    vikunja::reduce::detail::Fill<TCount>{0});
+                if(n == 0)
+                {
+                    return;
+                }
+
+                vikunja::affinity::applyAffinity<TAcc>();
+                constexpr uint64_t blockSize = WorkDivPolicy::template getBlockSize<TAcc>();
+                using Dim = alpaka::Dim<TAcc>;
+                using WorkDiv = alpaka::WorkDivMembers<Dim, TIdx>;
+                using Vec = alpaka::Vec<Dim, TIdx>;
+                constexpr TIdx xIndex = Dim::value - 1u;
+
+                Vec const elementsPerThread(Vec::all(static_cast<TIdx>(1u)));
+                Vec threadsPerBlock(Vec::all(static_cast<TIdx>(1u)));
+                Vec blocksPerGrid(Vec::all(static_cast<TIdx>(1u)));
+
+                bool const privatized = numBins <= static_cast<TIdx>(sharedHistogramBins);
+                if(n < static_cast<TIdx>(blockSize))
+                {
+                    WorkDiv const singleThreadWorkDiv{blocksPerGrid, threadsPerBlock, elementsPerThread};
+                    if(privatized)
+                    {
+                        HistogramKernel<1u, MemAccessPolicy, true, TCount> kernel;
+                        alpaka::exec<TAcc>(
+                            queue,
+                            singleThreadWorkDiv,
+                            kernel,
+                            samples,
+                            histogram,
+                            n,
+                            numBins,
+                            binFunc);
+                    }
+                    else
+                    {
+                        HistogramKernel<1u, MemAccessPolicy, false, TCount> kernel;
+                        alpaka::exec<TAcc>(
+                            queue,
+                            singleThreadWorkDiv,
+                            kernel,
+                            samples,
+                            histogram,
+                            n,
+                            numBins,
+                            binFunc);
+                    }
+                    return;
+                }
+
+                TIdx gridSize = WorkDivPolicy::template getGridSize<TAcc>(devAcc);
+                // each block merges its private bins into the global histogram, therefore it should count at least
+                // as many samples as there are bins
+                TIdx const samplesPerBlock
+                    = (privatized && numBins > static_cast<TIdx>(blockSize)) ? numBins : static_cast<TIdx>(blockSize);
+                TIdx const maxGridSize = n / samplesPerBlock;
+                if(gridSize > maxGridSize)
+                {
+                    gridSize = (maxGridSize > 0) ? maxGridSize : static_cast<TIdx>(1u);
+                }
+                blocksPerGrid[xIndex] = gridSize;
+                threadsPerBlock[xIndex] = static_cast<TIdx>(blockSize);
+
+                WorkDiv const multiBlockWorkDiv{blocksPerGrid, threadsPerBlock, elementsPerThread};
+                if(privatized)
+                {
+                    HistogramKernel<blockSize, MemAccessPolicy, true, TCount> kernel;
+                    alpaka::exec<TAcc>(queue, multiBlockWorkDiv, kernel, samples, histogram, n, numBins, binFunc);
+                }
+                else
+                {
+                    HistogramKernel<blockSize, MemAccessPolicy, false, TCount> kernel;
+                    alpaka::exec<TAcc>(queue, multiBlockWorkDiv, kernel, samples, histogram, n, numBins, binFunc);
+                }
+            }
+        } // namespace detail
+
+        /**
+         * Counts the samples in numBins bins of equal width, which divide the range [lower, upper), i.e. if one has
+         * the samples [0,1,5,9,10,-1], 2 bins, lower 0 and upper 10, the histogram will contain [2,2]. Samples outside
+         * of the range are not counted. For integral samples, the bin is computed with integer arithmetic, so no
+         * sample is counted in a wrong bin because of rounding.
+         * If the bins fit in the shared memory (see detail::sharedHistogramBins), each block counts its samples in
+         * private bins in the shared memory and adds them to the histogram at the end, so the atomic operations of
+         * frequent bins do not collide in the global memory. On the CPU accelerators, the private bins of a block
+         * with a single thread are private per thread. More bins are counted with atomic operations in the global
+         * memory.
+         * @tparam TAcc The alpaka accelerator type to use.
+         * @tparam WorkDivPolicy The working division policy. Defaults to a templated value depending on the
+         * accelerator. For the API of this, see workdiv/BlockBasedWorkDiv.hpp
+         * @tparam MemAccessPolicy The memory access policy of the samples. Defaults to a templated value depending
+         * on the accelerator. For the API of this, see vikunja::MemAccess::PolicyBasedBlockStrategy
+         * @tparam TSampleIterator Type of the sample iterator. Should be a pointer-like type.
+         * @tparam TCount Type of the bin counters. Must be supported by the alpaka atomic add.
+         * @tparam TLevel Type of the range boundaries.
+         * @tparam TDevAcc The type of the alpaka accelerator.
+         * @tparam TQueue The type of the alpaka queue.
+         * @tparam TIdx The index type to use.
+         * @param devAcc The alpaka accelerator.
+         * @param queue The alpaka queue.
+         * @param n The number of samples.
+         * @param samples The samples.
+         * @param histogram The output histogram with numBins counters. It is overwritten.
+         * @param numBins The number of bins.
+         * @param lower The inclusive lower boundary of the first bin.
+         * @param upper The exclusive upper boundary of the last bin.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename MemAccessPolicy = vikunja::MemAccess::MemAccessPolicy<TAcc>,
+            typename TSampleIterator,
+            typename TCount,
+            typename TLevel,
+            typename TDevAcc,
+            typename TQueue,
+            typename TIdx>
+        auto deviceHistogramEven(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            TIdx const& n,
+            TSampleIterator const& samples,
+            TCount* const histogram,
+            TIdx const& numBins,
+            TLevel const& lower,
+            TLevel const& upper) -> void
+        {
+            detail::histogramImpl<TAcc, WorkDivPolicy, MemAccessPolicy>(
+                devAcc,
+                queue,
+                n,
+                samples,
+                histogram,
+                numBins,
+                detail::EvenBin<TLevel, TIdx>{lower, upper, numBins});
+        }
+
+        /**
+         * Counts the samples in numBins bins with arbitrary boundaries: bin i counts the samples with
+         * levels[i] <= sample < levels[i + 1]. The bin of each sample is found with a binary search in the levels.
+         * Samples outside of [levels[0], levels[numBins]) are not counted.
+         * @see deviceHistogramEven
+         * @param levels The ascending bin boundaries with numBins + 1 elements.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename MemAccessPolicy = vikunja::MemAccess::MemAccessPolicy<TAcc>,
+            typename TSampleIterator,
+            typename TCount,
+            typename TLevelIterator,
+            typename TDevAcc,
+            typename TQueue,
+            typename TIdx>
+        auto deviceHistogramRange(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            TIdx const& n,
+            TSampleIterator const& samples,
+            TCount* const histogram,
+            TIdx const& numBins,
+            TLevelIterator const& levels) -> void
+        {
+            detail::histogramImpl<TAcc, WorkDivPolicy, MemAccessPolicy>(
+                devAcc,
+                queue,
+                n,
+                samples,
+                histogram,
+                numBins,
+                detail::RangeBin<TLevelIterator, TIdx>{levels, numBins});
+        }
+    } // namespace histogram
+} // namespace vikunja
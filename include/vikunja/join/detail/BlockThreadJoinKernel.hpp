@@ -0,0 +1,132 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/mem/iterator.hpp>
+#include <vikunja/operators/functors.hpp>
+#include <vikunja/operators/operators.hpp>
+#include <vikunja/sort/detail/MergePath.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+#include <cstdint>
+
+namespace vikunja
+{
+    namespace join
+    {
+        namespace detail
+        {
+            /**
+             * Transform functor, which returns the flag of the semi or anti join of an element of the left sequence
+             * from the lower bound of the element in the right sequence.
+             * @tparam TAnti If true, the flag is set for elements without a match, otherwise for elements with a
+             * match.
+             * @tparam TCompareOperator The vikunja::operators type of the comparator.
+             */
+            template<bool TAnti, typename TCompareOperator, typename TIterator, typename TIdx, typename TCompare>
+            struct MatchFlagFunc
+            {
+                TIterator right;
+                TIdx nRight;
+                TCompare compare;
+
+                template<typename TAcc, typename TKey>
+                ALPAKA_FN_HOST_ACC bool operator()(TAcc const& acc, TKey const& key, TIdx const& lowerBound) const
+                {
+                    // the element at the lower bound is not less than the key, it matches if it is not greater
+                    bool const match
+                        = lowerBound < nRight && !TCompareOperator::run(acc, compare, key, right[lowerBound]);
+                    return match != TAnti;
+                }
+            };
+
+            /**
+             * Writes the index pairs of the inner join. Each element i of the left sequence matches the elements
+             * [lowerBounds[i], upperBounds[i]) of the right sequence, its pairs are written in front of
+             * matchEnds[i]. The pairs are distributed with a load balancing search: each thread processes an equal
+             * share of the merge path of the pair indices and the match ends, so that neither elements with many
+             * matches nor many elements without a match unbalance the work.
+             */
+            struct LoadBalancedJoinKernel
+            {
+                /**
+                 * @param acc The alpaka accelerator.
+                 * @param lowerBounds The lower bound of each left element in the right sequence.
+                 * @param upperBounds The upper bound of each left element in the right sequence.
+                 * @param matchEnds The inclusive scan of the number of matches of the left elements.
+                 * @param nLeft The size of the left sequence.
+                 * @param numPairs The number of pairs.
+                 * @param leftIndices The output iterator of the indices of the left elements.
+                 * @param rightIndices The output iterator of the indices of the right elements.
+                 */
+                template<
+                    typename TAcc,
+                    typename TIdx,
+                    typename TBoundIterator,
+                    typename TLeftOutputIterator,
+                    typename TRightOutputIterator>
+                ALPAKA_FN_ACC void operator()(
+                    TAcc const& acc,
+                    TBoundIterator const& lowerBounds,
+                    TBoundIterator const& upperBounds,
+                    TBoundIterator const& matchEnds,
+                    TIdx const& nLeft,
+                    TIdx const& numPairs,
+                    TLeftOutputIterator const& leftIndices,
+                    TRightOutputIterator const& rightIndices) const
+                {
+                    constexpr TIdx xIndex = alpaka::Dim<TAcc>::value - 1u;
+                    TIdx const globalThreadIndex = alpaka::getIdx<alpaka::Grid, alpaka::Threads>(acc)[xIndex];
+                    TIdx const globalThreadCount = alpaka::getWorkDiv<alpaka::Grid, alpaka::Threads>(acc)[xIndex];
+
+                    TIdx const pathLength = nLeft + numPairs;
+                    TIdx const itemsPerThread = (pathLength + globalThreadCount - 1) / globalThreadCount;
+                    TIdx begin = globalThreadIndex * itemsPerThread;
+                    begin = (begin < pathLength) ? begin : pathLength;
+                    TIdx const end = (pathLength - begin < itemsPerThread) ? pathLength : begin + itemsPerThread;
+                    if(begin == end)
+                    {
+                        return;
+                    }
+
+                    // a left element is passed, if the pair index reaches its match end
+                    using LessOperator
+                        = vikunja::operators::BinaryOp<TAcc, vikunja::operators::Less<TIdx>, TIdx, TIdx>;
+                    vikunja::mem::iterator::CountingIterator<TIdx> const pairIndex;
+                    TIdx left = vikunja::sort::detail::mergePathSearch<LessOperator>(
+                        acc,
+                        matchEnds,
+                        nLeft,
+                        pairIndex,
+                        numPairs,
+                        begin,
+                        vikunja::operators::Less<TIdx>());
+                    TIdx pair = begin - left;
+
+                    for(TIdx k = begin; k < end; ++k)
+                    {
+                        if(left < nLeft && (pair >= numPairs || matchEnds[left] <= pair))
+                        {
+                            ++left;
+                        }
+                        else
+                        {
+                            TIdx const matchBegin = matchEnds[left] - (upperBounds[left] - lowerBounds[left]);
+                            leftIndices[pair] = left;
+                            rightIndices[pair] = lowerBounds[left] + (pair - matchBegin);
+                            ++pair;
+                        }
+                    }
+                }
+            };
+        } // namespace detail
+    } // namespace join
+} // namespace vikunja
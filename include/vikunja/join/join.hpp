@@ -0,0 +1,420 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/affinity/Affinity.hpp>
+#include <vikunja/join/detail/BlockThreadJoinKernel.hpp>
+#include <vikunja/operators/functors.hpp>
+#include <vikunja/operators/operators.hpp>
+#include <vikunja/scan/detail/BlockThreadScanKernel.hpp>
+#include <vikunja/scan/scan.hpp>
+#include <vikunja/search/search.hpp>
+#include <vikunja/transform/transform.hpp>
+#include <vikunja/workdiv/BlockBasedWorkDiv.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+#include <cstdint>
+#include <iterator>
+
+namespace vikunja
+{
+    namespace join
+    {
+        namespace detail
+        {
+            /**
+             * Implementation of the inner join. The lower and upper bound of each left element in the right sequence
+             * are found by merging both sequences, the number of matches of each left element is scanned and the
+             * total number of pairs is copied to the host. If TWritePairs is true, the pairs are written with a load
+             * balancing search afterwards.
+             * @tparam TWritePairs If false, only the number of pairs is computed and the output is not accessed.
+             * @return The number of pairs.
+             */
+            template<
+                typename TAcc,
+                typename WorkDivPolicy,
+                bool TWritePairs,
+                typename TDevAcc,
+                typename TDevHost,
+                typename TQueue,
+                typename TIdx,
+                typename TLeftIterator,
+                typename TRightIterator,
+                typename TLeftOutputIterator,
+                typename TRightOutputIterator,
+                typename TCompare>
+            auto innerJoinImpl(
+                TDevAcc& devAcc,
+                TDevHost& devHost,
+                TQueue& queue,
+                TLeftIterator const& left,
+                TIdx const& nLeft,
+                TRightIterator const& right,
+                TIdx const& nRight,
+                TLeftOutputIterator const& leftIndices,
+                TRightOutputIterator const& rightIndices,
+                TCompare const& compare) -> TIdx
+            {
+                if(nLeft == 0 || nRight == 0)
+                {
+                    return 0;
+                }
+                using Dim = alpaka::Dim<TAcc>;
+                using Vec = alpaka::Vec<Dim, TIdx>;
+                constexpr TIdx xIndex = Dim::value - 1u;
+
+                Vec boundsExtent(Vec::all(static_cast<TIdx>(1u)));
+                boundsExtent[xIndex] = nLeft;
+                auto lowerBounds = alpaka::allocBuf<TIdx, TIdx>(devAcc, boundsExtent);
+                auto upperBounds = alpaka::allocBuf<TIdx, TIdx>(devAcc, boundsExtent);
+                auto matchEnds = alpaka::allocBuf<TIdx, TIdx>(devAcc, boundsExtent);
+                TIdx* const lowerBoundsPtr = alpaka::getPtrNative(lowerBounds);
+                TIdx* const upperBoundsPtr = alpaka::getPtrNative(upperBounds);
+                TIdx* const matchEndsPtr = alpaka::getPtrNative(matchEnds);
+
+                vikunja::search::deviceSortedLowerBound<TAcc, WorkDivPolicy>(
+                    devAcc,
+                    queue,
+                    right,
+                    right + nRight,
+                    left,
+                    nLeft,
+                    lowerBoundsPtr,
+                    compare);
+                vikunja::search::deviceSortedUpperBound<TAcc, WorkDivPolicy>(
+                    devAcc,
+                    queue,
+                    right,
+                    right + nRight,
+                    left,
+                    nLeft,
+                    upperBoundsPtr,
+                    compare);
+                vikunja::transform::deviceTransform<TAcc, WorkDivPolicy>(
+                    devAcc,
+                    queue,
+                    nLeft,
+                    upperBoundsPtr,
+                    lowerBoundsPtr,
+                    matchEndsPtr,
+                    vikunja::operators::Minus<TIdx>());
+                vikunja::scan::deviceInclusiveScan<TAcc, WorkDivPolicy>(
+                    devAcc,
+                    queue,
+                    nLeft,
+                    matchEndsPtr,
+                    matchEndsPtr,
+                    vikunja::operators::Plus<TIdx>());
+
+                // the last match end is the number of pairs
+                Vec const countExtent(Vec::all(static_cast<TIdx>(1u)));
+                alpaka::ViewPlainPtr<TDevAcc, TIdx, Dim, TIdx> lastMatchEnd(
+                    matchEndsPtr + (nLeft - 1),
+                    devAcc,
+                    countExtent);
+                auto countView = alpaka::allocBuf<TIdx, TIdx>(devHost, countExtent);
+                alpaka::memcpy(queue, countView, lastMatchEnd, countExtent);
+                alpaka::wait(queue);
+                TIdx const numPairs = alpaka::getPtrNative(countView)[0];
+
+                if constexpr(TWritePairs)
+                {
+                    if(numPairs == 0)
+                    {
+                        return 0;
+                    }
+                    vikunja::affinity::applyAffinity<TAcc>();
+                    constexpr uint64_t blockSize = WorkDivPolicy::template getBlockSize<TAcc>();
+                    using WorkDiv = alpaka::WorkDivMembers<Dim, TIdx>;
+
+                    Vec const elementsPerThread(Vec::all(static_cast<TIdx>(1u)));
+                    Vec threadsPerBlock(Vec::all(static_cast<TIdx>(1u)));
+                    Vec blocksPerGrid(Vec::all(static_cast<TIdx>(1u)));
+
+                    TIdx const pathLength = nLeft + numPairs;
+                    if(pathLength >= static_cast<TIdx>(blockSize))
+                    {
+                        TIdx gridSize = WorkDivPolicy::template getGridSize<TAcc>(devAcc);
+                        TIdx const maxGridSize = pathLength / static_cast<TIdx>(blockSize);
+                        blocksPerGrid[xIndex] = (gridSize < maxGridSize) ? gridSize : maxGridSize;
+                        threadsPerBlock[xIndex] = static_cast<TIdx>(blockSize);
+                    }
+                    WorkDiv const workDiv{blocksPerGrid, threadsPerBlock, elementsPerThread};
+                    LoadBalancedJoinKernel kernel;
+                    alpaka::exec<TAcc>(
+                        queue,
+                        workDiv,
+                        kernel,
+                        lowerBoundsPtr,
+                        upperBoundsPtr,
+                        matchEndsPtr,
+                        nLeft,
+                        numPairs,
+                        leftIndices,
+                        rightIndices);
+                    // the helper memory must not be freed before the kernel is finished
+                    alpaka::wait(queue);
+                }
+                return numPairs;
+            }
+
+            /**
+             * Implementation of the semi and anti join. The lower bound of each left element in the right sequence is
+             * found by merging both sequences and the flag is computed from the element at the lower bound.
+             * @tparam TAnti If true, the flag is set for elements without a match, otherwise for elements with a
+             * match.
+             */
+            template<
+                typename TAcc,
+                typename WorkDivPolicy,
+                bool TAnti,
+                typename TCompareOperator,
+                typename TDevAcc,
+                typename TQueue,
+                typename TIdx,
+                typename TLeftIterator,
+                typename TRightIterator,
+                typename TFlagIterator,
+                typename TCompare>
+            void matchFlagImpl(
+                TDevAcc& devAcc,
+                TQueue& queue,
+                TLeftIterator const& left,
+                TIdx const& nLeft,
+                TRightIterator const& right,
+                TIdx const& nRight,
+                TFlagIterator const& flags,
+                TCompare const& compare)
+            {
+                if(nLeft == 0)
+                {
+                    return;
+                }
+                using Vec = alpaka::Vec<alpaka::Dim<TAcc>, TIdx>;
+                Vec boundsExtent(Vec::all(static_cast<TIdx>(1u)));
+                boundsExtent[alpaka::Dim<TAcc>::value - 1u] = nLeft;
+                auto lowerBounds = alpaka::allocBuf<TIdx, TIdx>(devAcc, boundsExtent);
+                TIdx* const lowerBoundsPtr = alpaka::getPtrNative(lowerBounds);
+
+                vikunja::search::deviceSortedLowerBound<TAcc, WorkDivPolicy>(
+                    devAcc,
+                    queue,
+                    right,
+                    right + nRight,
+                    left,
+                    nLeft,
+                    lowerBoundsPtr,
+                    compare);
+                vikunja::transform::deviceTransform<TAcc, WorkDivPolicy>(
+                    devAcc,
+                    queue,
+                    nLeft,
+                    left,
+                    lowerBoundsPtr,
+                    flags,
+                    MatchFlagFunc<TAnti, TCompareOperator, TRightIterator, TIdx, TCompare>{right, nRight, compare});
+                // the helper memory must not be freed before the kernels are finished
+                alpaka::wait(queue);
+            }
+        } // namespace detail
+
+        /**
+         * Returns the number of index pairs of the inner join of two sorted sequences, i.e. the number of pairs of
+         * equal elements. Two elements are equal, if none of them is ordered before the other one.
+         * @see deviceInnerJoin
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TLeftIterator,
+            typename TRightIterator,
+            typename TCompare
+            = vikunja::operators::Less<typename std::iterator_traits<TLeftIterator>::value_type>,
+            typename TDevAcc,
+            typename TDevHost,
+            typename TQueue,
+            typename TIdx>
+        auto deviceInnerJoinSize(
+            TDevAcc& devAcc,
+            TDevHost& devHost,
+            TQueue& queue,
+            TLeftIterator const& left,
+            TIdx const& nLeft,
+            TRightIterator const& right,
+            TIdx const& nRight,
+            TCompare const& compare = TCompare{}) -> TIdx
+        {
+            return detail::innerJoinImpl<TAcc, WorkDivPolicy, false>(
+                devAcc,
+                devHost,
+                queue,
+                left,
+                nLeft,
+                right,
+                nRight,
+                static_cast<TIdx*>(nullptr),
+                static_cast<TIdx*>(nullptr),
+                compare);
+        }
+
+        /**
+         * Sort-merge join of two sorted sequences. For each pair of equal elements, the index of the left element
+         * and the index of the right element are written to the output, ordered by the left index and then by the
+         * right index. Two elements are equal, if none of them is ordered before the other one. For example, the
+         * left sequence [1,2,2,4] and the right sequence [2,2,3,4] produce the left indices [1,1,2,2,3] and the
+         * right indices [0,1,0,1,3].
+         * The join counts the matches of each left element with a merge of both sequences, scans the counts and
+         * writes the pairs with a load balancing search, in which each thread writes an equal share of the pairs.
+         * The outputs must be big enough for all pairs, see deviceInnerJoinSize.
+         * @tparam TAcc The alpaka accelerator type to use.
+         * @tparam WorkDivPolicy The working division policy. Defaults to a templated value depending on the
+         * accelerator.
+         * @tparam TLeftIterator Type of the left sequence. Should be a pointer-like type.
+         * @tparam TRightIterator Type of the right sequence. Should be a pointer-like type.
+         * @tparam TLeftOutputIterator Type of the output iterator of the left indices. Should be a pointer-like type.
+         * @tparam TRightOutputIterator Type of the output iterator of the right indices. Should be a pointer-like
+         * type.
+         * @tparam TCompare Type of the comparator. Defaults to operator<.
+         * @tparam TDevAcc The type of the alpaka accelerator.
+         * @tparam TDevHost The type of the alpaka host.
+         * @tparam TQueue The type of the alpaka queue.
+         * @tparam TIdx The index type to use.
+         * @param devAcc The alpaka accelerator.
+         * @param devHost The alpaka host.
+         * @param queue The alpaka queue. The function waits for the queue, before it returns.
+         * @param left The left sorted sequence.
+         * @param nLeft The size of the left sequence.
+         * @param right The right sorted sequence.
+         * @param nRight The size of the right sequence.
+         * @param leftIndices The output iterator of the indices of the left elements.
+         * @param rightIndices The output iterator of the indices of the right elements.
+         * @param compare The comparator, which was used to sort both sequences.
+         * @return The number of pairs.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TLeftIterator,
+            typename TRightIterator,
+            typename TLeftOutputIterator,
+            typename TRightOutputIterator,
+            typename TCompare
+            = vikunja::operators::Less<typename std::iterator_traits<TLeftIterator>::value_type>,
+            typename TDevAcc,
+            typename TDevHost,
+            typename TQueue,
+            typename TIdx>
+        auto deviceInnerJoin(
+            TDevAcc& devAcc,
+            TDevHost& devHost,
+            TQueue& queue,
+            TLeftIterator const& left,
+            TIdx const& nLeft,
+            TRightIterator const& right,
+            TIdx const& nRight,
+            TLeftOutputIterator const& leftIndices,
+            TRightOutputIterator const& rightIndices,
+            TCompare const& compare = TCompare{}) -> TIdx
+        {
+            return detail::innerJoinImpl<TAcc, WorkDivPolicy, true>(
+                devAcc,
+                devHost,
+                queue,
+                left,
+                nLeft,
+                right,
+                nRight,
+                leftIndices,
+                rightIndices,
+                compare);
+        }
+
+        /**
+         * Semi join of two sorted sequences: writes a flag for each element of the left sequence, which is true if
+         * the right sequence contains an equal element. No index pairs are written. The flags can be used with
+         * the stream compaction to select the elements.
+         * @see deviceInnerJoin
+         * @param flags The output iterator of the flags with nLeft elements.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TLeftIterator,
+            typename TRightIterator,
+            typename TFlagIterator,
+            typename TCompare
+            = vikunja::operators::Less<typename std::iterator_traits<TLeftIterator>::value_type>,
+            typename TDevAcc,
+            typename TQueue,
+            typename TIdx,
+            typename TValue = typename std::iterator_traits<TLeftIterator>::value_type,
+            typename TCompareOperator = vikunja::operators::BinaryOp<TAcc, TCompare, TValue, TValue>>
+        auto deviceSemiJoin(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            TLeftIterator const& left,
+            TIdx const& nLeft,
+            TRightIterator const& right,
+            TIdx const& nRight,
+            TFlagIterator const& flags,
+            TCompare const& compare = TCompare{}) -> void
+        {
+            detail::matchFlagImpl<TAcc, WorkDivPolicy, false, TCompareOperator>(
+                devAcc,
+                queue,
+                left,
+                nLeft,
+                right,
+                nRight,
+                flags,
+                compare);
+        }
+
+        /**
+         * Anti join of two sorted sequences: writes a flag for each element of the left sequence, which is true if
+         * the right sequence contains no equal element.
+         * @see deviceSemiJoin
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TLeftIterator,
+            typename TRightIterator,
+            typename TFlagIterator,
+            typename TCompare
+            = vikunja::operators::Less<typename std::iterator_traits<TLeftIterator>::value_type>,
+            typename TDevAcc,
+            typename TQueue,
+            typename TIdx,
+            typename TValue = typename std::iterator_traits<TLeftIterator>::value_type,
+            typename TCompareOperator = vikunja::operators::BinaryOp<TAcc, TCompare, TValue, TValue>>
+        auto deviceAntiJoin(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            TLeftIterator const& left,
+            TIdx const& nLeft,
+            TRightIterator const& right,
+            TIdx const& nRight,
+            TFlagIterator const& flags,
+            TCompare const& compare = TCompare{}) -> void
+        {
+            detail::matchFlagImpl<TAcc, WorkDivPolicy, true, TCompareOperator>(
+                devAcc,
+                queue,
+                left,
+                nLeft,
+                right,
+                nRight,
+                flags,
+                compare);
+        }
+    } // namespace join
+} // namespace vikunja
@@ -0,0 +1,100 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <alpaka/alpaka.hpp>
+
+#include <cstddef>
+#include <iterator>
+
+namespace vikunja
+{
+    namespace mem
+    {
+        /**
+         * Iterators, which are not backed by memory. They can be passed to the algorithms instead of a pointer to
+         * avoid the allocation of a helper buffer.
+         */
+        namespace iterator
+        {
+            /**
+             * Read only iterator, which returns the index itself, shifted by an optional begin. It provides the
+             * member types of std::iterator_traits and the pointer arithmetic of the reduce, so that it can be used
+             * as input of the transform and of the transform reduce.
+             * @tparam T The index type.
+             */
+            template<typename T>
+            struct CountingIterator
+            {
+                using value_type = T;
+                using difference_type = std::ptrdiff_t;
+                using pointer = T const*;
+                using reference = T;
+                using iterator_category = std::input_iterator_tag;
+
+                T begin = 0;
+
+                ALPAKA_FN_HOST_ACC ALPAKA_FN_INLINE T operator[](T const index) const
+                {
+                    return begin + index;
+                }
+
+                ALPAKA_FN_HOST_ACC ALPAKA_FN_INLINE T operator*() const
+                {
+                    return begin;
+                }
+
+                ALPAKA_FN_HOST_ACC ALPAKA_FN_INLINE CountingIterator operator+(T const offset) const
+                {
+                    return CountingIterator{begin + offset};
+                }
+            };
+
+            /**
+             * Iterator, which returns the same value for each index, e.g. the value input of the reduce by key to
+             * count the elements of each run.
+             * @tparam T Type of the value.
+             */
+            template<typename T>
+            struct ConstantIterator
+            {
+                T value;
+
+                template<typename TIdx>
+                constexpr ALPAKA_FN_HOST_ACC T operator[](TIdx const&) const
+                {
+                    return value;
+                }
+            };
+
+            /**
+             * Output iterator, which ignores all writes, e.g. the value output of the reduce by key, if only the
+             * keys are needed.
+             */
+            struct DiscardIterator
+            {
+                struct Sink
+                {
+                    template<typename T>
+                    constexpr ALPAKA_FN_HOST_ACC Sink const& operator=(T const&) const
+                    {
+                        return *this;
+                    }
+                };
+
+                template<typename TIdx>
+                constexpr ALPAKA_FN_HOST_ACC Sink operator[](TIdx const&) const
+                {
+                    return Sink{};
+                }
+            };
+        } // namespace iterator
+    } // namespace mem
+} // namespace vikunja
@@ -0,0 +1,106 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/sort/detail/MergePath.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+namespace vikunja
+{
+    namespace merge
+    {
+        namespace detail
+        {
+            /**
+             * Merges two sorted sequences. Each thread writes an equal share of the output. The begin of the share
+             * in both inputs is found with a merge path search, therefore the work is balanced independent of the
+             * sizes and the distribution of the inputs.
+             * @tparam THasValues If true, the values are moved with their keys.
+             * @tparam TCompareOperator The vikunja::operators type of the comparator.
+             */
+            template<bool THasValues, typename TCompareOperator>
+            struct MergeKernel
+            {
+                /**
+                 * @param acc The alpaka accelerator.
+                 * @param aKeys The first sorted sequence.
+                 * @param aValues The values of the first sequence.
+                 * @param na The size of the first sequence.
+                 * @param bKeys The second sorted sequence.
+                 * @param bValues The values of the second sequence.
+                 * @param nb The size of the second sequence.
+                 * @param keysOut The merged sequence.
+                 * @param valuesOut The values of the merged sequence.
+                 * @param compare The comparator.
+                 */
+                template<
+                    typename TAcc,
+                    typename TIdx,
+                    typename TKeyIteratorA,
+                    typename TValueIteratorA,
+                    typename TKeyIteratorB,
+                    typename TValueIteratorB,
+                    typename TKeyOutputIterator,
+                    typename TValueOutputIterator,
+                    typename TCompare>
+                ALPAKA_FN_ACC void operator()(
+                    TAcc const& acc,
+                    TKeyIteratorA const& aKeys,
+                    TValueIteratorA const& aValues,
+                    TIdx const& na,
+                    TKeyIteratorB const& bKeys,
+                    TValueIteratorB const& bValues,
+                    TIdx const& nb,
+                    TKeyOutputIterator const& keysOut,
+                    TValueOutputIterator const& valuesOut,
+                    TCompare const& compare) const
+                {
+                    constexpr TIdx xIndex = alpaka::Dim<TAcc>::value - 1u;
+                    TIdx const globalThreadIndex = alpaka::getIdx<alpaka::Grid, alpaka::Threads>(acc)[xIndex];
+                    TIdx const globalThreadCount = alpaka::getWorkDiv<alpaka::Grid, alpaka::Threads>(acc)[xIndex];
+
+                    TIdx const n = na + nb;
+                    TIdx const itemsPerThread = (n + globalThreadCount - 1) / globalThreadCount;
+                    TIdx begin = globalThreadIndex * itemsPerThread;
+                    begin = (begin < n) ? begin : n;
+                    TIdx const end = (n - begin < itemsPerThread) ? n : begin + itemsPerThread;
+                    if(begin == end)
+                    {
+                        return;
+                    }
+
+                    TIdx const ai = vikunja::sort::detail::mergePathSearch<TCompareOperator>(
+                        acc,
+                        aKeys,
+                        na,
+                        bKeys,
+                        nb,
+                        begin,
+                        compare);
+                    vikunja::sort::detail::serialMerge<TCompareOperator, THasValues>(
+                        acc,
+                        aKeys,
+                        aValues,
+                        ai,
+                        na,
+                        bKeys,
+                        bValues,
+                        begin - ai,
+                        nb,
+                        keysOut + begin,
+                        valuesOut + begin,
+                        end - begin,
+                        compare);
+                }
+            };
+        } // namespace detail
+    } // namespace merge
+} // namespace vikunja
@@ -0,0 +1,221 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/affinity/Affinity.hpp>
+#include <vikunja/merge/detail/BlockThreadMergeKernel.hpp>
+#include <vikunja/operators/operators.hpp>
+#include <vikunja/workdiv/BlockBasedWorkDiv.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+#include <cstdint>
+#include <iterator>
+
+namespace vikunja
+{
+    namespace merge
+    {
+        namespace detail
+        {
+            /**
+             * Selects the work division of the merge and executes the merge kernel. Each thread should write at
+             * least one element.
+             */
+            template<
+                typename TAcc,
+                typename WorkDivPolicy,
+                bool THasValues,
+                typename TCompareOperator,
+                typename TDevAcc,
+                typename TQueue,
+                typename TIdx,
+                typename TKeyIteratorA,
+                typename TValueIteratorA,
+                typename TKeyIteratorB,
+                typename TValueIteratorB,
+                typename TKeyOutputIterator,
+                typename TValueOutputIterator,
+                typename TCompare>
+            void mergeImpl(
+                TDevAcc& devAcc,
+                TQueue& queue,
+                TKeyIteratorA const& aKeys,
+                TValueIteratorA const& aValues,
+                TIdx const& na,
+                TKeyIteratorB const& bKeys,
+                TValueIteratorB const& bValues,
+                TIdx const& nb,
+                TKeyOutputIterator const& keysOut,
+                TValueOutputIterator const& valuesOut,
+                TCompare const& compare)
+            {
+                TIdx const n = na + nb;
+                if(n == 0)
+                {
+                    return;
+                }
+                vikunja::affinity::applyAffinity<TAcc>();
+                constexpr uint64_t blockSize = WorkDivPolicy::template getBlockSize<TAcc>();
+                using Dim = alpaka::Dim<TAcc>;
+                using WorkDiv = alpaka::WorkDivMembers<Dim, TIdx>;
+                using Vec = alpaka::Vec<Dim, TIdx>;
+                constexpr TIdx xIndex = Dim::value - 1u;
+
+                Vec const elementsPerThread(Vec::all(static_cast<TIdx>(1u)));
+                Vec threadsPerBlock(Vec::all(static_cast<TIdx>(1u)));
+                Vec blocksPerGrid(Vec::all(static_cast<TIdx>(1u)));
+
+                MergeKernel<THasValues, TCompareOperator> kernel;
+                if(n >= static_cast<TIdx>(blockSize))
+                {
+                    TIdx gridSize = WorkDivPolicy::template getGridSize<TAcc>(devAcc);
+                    TIdx const maxGridSize = n / static_cast<TIdx>(blockSize);
+                    blocksPerGrid[xIndex] = (gridSize < maxGridSize) ? gridSize : maxGridSize;
+                    threadsPerBlock[xIndex] = static_cast<TIdx>(blockSize);
+                }
+                WorkDiv const workDiv{blocksPerGrid, threadsPerBlock, elementsPerThread};
+                alpaka::exec<TAcc>(
+                    queue,
+                    workDiv,
+                    kernel,
+                    aKeys,
+                    aValues,
+                    na,
+                    bKeys,
+                    bValues,
+                    nb,
+                    keysOut,
+                    valuesOut,
+                    compare);
+            }
+        } // namespace detail
+
+        /**
+         * Merges two sorted sequences into one sorted sequence, i.e. if one has the sequences [1,3,5] and [2,3,4]
+         * and the comparator (a, b) -> a < b, the output will contain [1,2,3,3,4,5].
+         * The merge is stable: equal elements keep their order and the elements of a are written in front of the
+         * equal elements of b. Each thread writes an equal share of the output, whose begin is found with a merge
+         * path search, therefore the work is balanced independent of the distribution of the inputs.
+         * The output must have a size of at least na + nb and must not overlap with the inputs.
+         * @tparam TAcc The alpaka accelerator type to use.
+         * @tparam WorkDivPolicy The working division policy. Defaults to a templated value depending on the
+         * accelerator.
+         * @tparam TCompare Type of the comparator.
+         * @tparam TInputIteratorA Type of the first input iterator. Should be a pointer-like type.
+         * @tparam TInputIteratorB Type of the second input iterator. Should be a pointer-like type.
+         * @tparam TOutputIterator Type of the output iterator. Should be a pointer-like type.
+         * @tparam TDevAcc The type of the alpaka accelerator.
+         * @tparam TQueue The type of the alpaka queue.
+         * @tparam TIdx The index type to use.
+         * @tparam TCompareOperator The vikunja::operators type of the comparator.
+         * @param devAcc The alpaka accelerator.
+         * @param queue The alpaka queue.
+         * @param a The first sorted sequence.
+         * @param na The size of the first sequence.
+         * @param b The second sorted sequence.
+         * @param nb The size of the second sequence.
+         * @param destination The output iterator.
+         * @param compare The comparator, which returns true if the first argument is ordered before the second. It
+         * can optionally take the alpaka accelerator as first argument.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TCompare,
+            typename TInputIteratorA,
+            typename TInputIteratorB,
+            typename TOutputIterator,
+            typename TDevAcc,
+            typename TQueue,
+            typename TIdx,
+            typename TData = typename std::iterator_traits<TInputIteratorA>::value_type,
+            typename TCompareOperator = vikunja::operators::BinaryOp<TAcc, TCompare, TData, TData>>
+        auto deviceMerge(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            TInputIteratorA const& a,
+            TIdx const& na,
+            TInputIteratorB const& b,
+            TIdx const& nb,
+            TOutputIterator const& destination,
+            TCompare const& compare) -> void
+        {
+            // the values are not used, therefore the keys are passed as dummy
+            detail::mergeImpl<TAcc, WorkDivPolicy, false, TCompareOperator>(
+                devAcc,
+                queue,
+                a,
+                a,
+                na,
+                b,
+                b,
+                nb,
+                destination,
+                destination,
+                compare);
+        }
+
+        /**
+         * Merges two sorted key sequences and moves the values with their keys.
+         * @see deviceMerge
+         * @param aKeys The first sorted key sequence.
+         * @param aValues The values of the first sequence.
+         * @param na The size of the first sequence.
+         * @param bKeys The second sorted key sequence.
+         * @param bValues The values of the second sequence.
+         * @param nb The size of the second sequence.
+         * @param keysOut The output iterator of the keys.
+         * @param valuesOut The output iterator of the values.
+         * @param compare The comparator of the keys.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TCompare,
+            typename TKeyIteratorA,
+            typename TValueIteratorA,
+            typename TKeyIteratorB,
+            typename TValueIteratorB,
+            typename TKeyOutputIterator,
+            typename TValueOutputIterator,
+            typename TDevAcc,
+            typename TQueue,
+            typename TIdx,
+            typename TKey = typename std::iterator_traits<TKeyIteratorA>::value_type,
+            typename TCompareOperator = vikunja::operators::BinaryOp<TAcc, TCompare, TKey, TKey>>
+        auto deviceMergeByKey(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            TKeyIteratorA const& aKeys,
+            TValueIteratorA const& aValues,
+            TIdx const& na,
+            TKeyIteratorB const& bKeys,
+            TValueIteratorB const& bValues,
+            TIdx const& nb,
+            TKeyOutputIterator const& keysOut,
+            TValueOutputIterator const& valuesOut,
+            TCompare const& compare) -> void
+        {
+            detail::mergeImpl<TAcc, WorkDivPolicy, true, TCompareOperator>(
+                devAcc,
+                queue,
+                aKeys,
+                aValues,
+                na,
+                bKeys,
+                bValues,
+                nb,
+                keysOut,
+                valuesOut,
+                compare);
+        }
+    } // namespace merge
+} // namespace vikunja
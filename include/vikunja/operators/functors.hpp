@@ -0,0 +1,60 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <alpaka/alpaka.hpp>
+
+namespace vikunja
+{
+    namespace operators
+    {
+        /**
+         * Sum of two values, which can be used in kernels.
+         * @tparam T Type of the values.
+         */
+        template<typename T>
+        struct Plus
+        {
+            static constexpr bool isCommutative = true;
+
+            constexpr ALPAKA_FN_HOST_ACC T operator()(T const& a, T const& b) const
+            {
+                return a + b;
+            }
+        };
+
+        /**
+         * Difference of two values, which can be used in kernels.
+         * @tparam T Type of the values.
+         */
+        template<typename T>
+        struct Minus
+        {
+            constexpr ALPAKA_FN_HOST_ACC T operator()(T const& a, T const& b) const
+            {
+                return a - b;
+            }
+        };
+
+        /**
+         * Less than comparison of two values, which can be used in kernels. It is the default comparator of the
+         * search and join functions.
+         * @tparam T Type of the values.
+         */
+        template<typename T>
+        struct Less
+        {
+            constexpr ALPAKA_FN_HOST_ACC bool operator()(T const& a, T const& b) const
+            {
+                return a < b;
+            }
+        };
+    } // namespace operators
+} // namespace vikunja
@@ -177,5 +177,190 @@ namespace vikunja
             }
         };
 
+        namespace traits
+        {
+            /**
+             * Marks a functor as associative, which allows the algorithms to change the order in which partial
+             * results are combined, for example to use a native reduction of the backend.
+             * A functor is associative, if it provides the member `static constexpr bool isAssociative = true`, is
+             * wrapped with vikunja::operators::associative() or if this trait is specialized for it.
+             * tparam TFunc Type of the functor.
+             */
+            template<typename TFunc, typename TSfinae = void>
+            struct IsAssociative : std::false_type
+            {
+            };
+
+            template<typename TFunc>
+            struct IsAssociative<TFunc, std::enable_if_t<TFunc::isAssociative>> : std::true_type
+            {
+            };
+
+            template<typename TData>
+            struct IsAssociative<std::plus<TData>> : std::true_type
+            {
+            };
+
+            template<typename TData>
+            struct IsAssociative<std::multiplies<TData>> : std::true_type
+            {
+            };
+
+            template<typename TData>
+            struct IsAssociative<std::bit_and<TData>> : std::true_type
+            {
+            };
+
+            template<typename TData>
+            struct IsAssociative<std::bit_or<TData>> : std::true_type
+            {
+            };
+
+            template<typename TData>
+            struct IsAssociative<std::bit_xor<TData>> : std::true_type
+            {
+            };
+
+            template<typename TData>
+            struct IsAssociative<std::logical_and<TData>> : std::true_type
+            {
+            };
+
+            template<typename TData>
+            struct IsAssociative<std::logical_or<TData>> : std::true_type
+            {
+            };
+
+            /**
+             * Marks a functor as commutative, which allows the algorithms to combine the operands in any order, for
+             * example with atomic operations.
+             * A functor is commutative, if it provides the member `static constexpr bool isCommutative = true`, is
+             * wrapped with vikunja::operators::commutative() or if this trait is specialized for it.
+             * tparam TFunc Type of the functor.
+             */
+            template<typename TFunc, typename TSfinae = void>
+            struct IsCommutative : std::false_type
+            {
+            };
+
+            template<typename TFunc>
+            struct IsCommutative<TFunc, std::enable_if_t<TFunc::isCommutative>> : std::true_type
+            {
+            };
+
+            template<typename TData>
+            struct IsCommutative<std::plus<TData>> : std::true_type
+            {
+            };
+
+            template<typename TData>
+            struct IsCommutative<std::multiplies<TData>> : std::true_type
+            {
+            };
+
+            template<typename TData>
+            struct IsCommutative<std::bit_and<TData>> : std::true_type
+            {
+            };
+
+            template<typename TData>
+            struct IsCommutative<std::bit_or<TData>> : std::true_type
+            {
+            };
+
+            template<typename TData>
+            struct IsCommutative<std::bit_xor<TData>> : std::true_type
+            {
+            };
+
+            template<typename TData>
+            struct IsCommutative<std::logical_and<TData>> : std::true_type
+            {
+            };
+
+            template<typename TData>
+            struct IsCommutative<std::logical_or<TData>> : std::true_type
+            {
+            };
+        } // namespace traits
+
+        /**
+         * True, if the functor is marked as associative. See vikunja::operators::traits::IsAssociative.
+         * tparam TFunc Type of the functor.
+         */
+        template<typename TFunc>
+        inline constexpr bool isAssociative = traits::IsAssociative<TFunc>::value;
+
+        /**
+         * True, if the functor is marked as commutative. See vikunja::operators::traits::IsCommutative.
+         * tparam TFunc Type of the functor.
+         */
+        template<typename TFunc>
+        inline constexpr bool isCommutative = traits::IsCommutative<TFunc>::value;
+
+        /**
+         * Wraps a functor and marks it as associative. The wrapper supports the same interfaces as the functor,
+         * with and without the TAcc argument.
+         * tparam TFunc Type of the functor.
+         */
+        template<typename TFunc>
+        struct AssociativeOp
+        {
+            static constexpr bool isAssociative = true;
+            static constexpr bool isCommutative = traits::IsCommutative<TFunc>::value;
+
+            TFunc m_func;
+
+            template<typename... TArgs>
+            ALPAKA_FN_HOST_ACC auto operator()(TArgs&&... args) const
+                -> decltype(std::declval<TFunc const&>()(std::forward<TArgs>(args)...))
+            {
+                return m_func(std::forward<TArgs>(args)...);
+            }
+        };
+
+        /**
+         * Marks a functor or lambda as associative.
+         * param func functor
+         * return the wrapped functor
+         */
+        template<typename TFunc>
+        ALPAKA_FN_HOST_ACC auto associative(TFunc const& func) -> AssociativeOp<TFunc>
+        {
+            return AssociativeOp<TFunc>{func};
+        }
+
+        /**
+         * Wraps a functor and marks it as commutative. The wrapper supports the same interfaces as the functor,
+         * with and without the TAcc argument. An associative functor stays associative.
+         * tparam TFunc Type of the functor.
+         */
+        template<typename TFunc>
+        struct CommutativeOp
+        {
+            static constexpr bool isAssociative = traits::IsAssociative<TFunc>::value;
+            static constexpr bool isCommutative = true;
+
+            TFunc m_func;
+
+            template<typename... TArgs>
+            ALPAKA_FN_HOST_ACC auto operator()(TArgs&&... args) const
+                -> decltype(std::declval<TFunc const&>()(std::forward<TArgs>(args)...))
+            {
+                return m_func(std::forward<TArgs>(args)...);
+            }
+        };
+
+        /**
+         * Marks a functor or lambda as commutative.
+         * param func functor
+         * return the wrapped functor
+         */
+        template<typename TFunc>
+        ALPAKA_FN_HOST_ACC auto commutative(TFunc const& func) -> CommutativeOp<TFunc>
+        {
+            return CommutativeOp<TFunc>{func};
+        }
+
     } // namespace operators
 } // namespace vikunja
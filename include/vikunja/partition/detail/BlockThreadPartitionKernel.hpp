@@ -0,0 +1,174 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/access/BlockStrategy.hpp>
+#include <vikunja/scan/detail/BlockThreadScanKernel.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+namespace vikunja
+{
+    namespace partition
+    {
+        namespace detail
+        {
+            /**
+             * Last phase of the stable partition: each thread writes the selected elements of its chunk behind the
+             * selected elements of the previous chunks and the rejected elements of its chunk behind all selected
+             * elements and the rejected elements of the previous chunks. Both output streams are written in a single
+             * pass over the chunk. The last thread of the grid writes the partition point.
+             * @tparam TBlockSize The block size of this kernel.
+             * @tparam TPredicateOperator The vikunja::operators type of the predicate.
+             */
+            template<uint64_t TBlockSize, typename TPredicateOperator>
+            struct ChunkStablePartitionKernel
+            {
+                /**
+                 * @param acc The alpaka accelerator.
+                 * @param source The input iterator.
+                 * @param destination The output iterator.
+                 * @param chunkOffsets The exclusive prefix of the chunk counts of the selected elements. The value of
+                 * the first chunk is not used, the element behind the last chunk contains the total number of
+                 * selected elements.
+                 * @param numChunks The number of chunks.
+                 * @param partitionPoint Output iterator for the number of selected elements.
+                 * @param n The size of the input iterator.
+                 * @param predicate The predicate.
+                 */
+                template<
+                    typename TAcc,
+                    typename TIdx,
+                    typename TInputIterator,
+                    typename TOutputIterator,
+                    typename TOffsetIterator,
+                    typename TCountIterator,
+                    typename TPredicate>
+                ALPAKA_FN_ACC void operator()(
+                    TAcc const& acc,
+                    TInputIterator const& source,
+                    TOutputIterator const& destination,
+                    TOffsetIterator const& chunkOffsets,
+                    TIdx const& numChunks,
+                    TCountIterator const& partitionPoint,
+                    TIdx const& n,
+                    TPredicate const& predicate) const
+                {
+                    constexpr TIdx xIndex = alpaka::Dim<TAcc>::value - 1u;
+                    auto const globalThreadIndex = alpaka::getIdx<alpaka::Grid, alpaka::Threads>(acc)[xIndex];
+                    auto const globalThreadCount = alpaka::getWorkDiv<alpaka::Grid, alpaka::Threads>(acc)[xIndex];
+                    if(globalThreadIndex == globalThreadCount - 1)
+                    {
+                        *partitionPoint = chunkOffsets[numChunks];
+                    }
+
+                    using MemIndex = vikunja::MemAccess::BlockStrategy<vikunja::scan::detail::ChunkPolicy, TAcc, TIdx>;
+                    MemIndex iter(acc, n, TBlockSize);
+                    MemIndex const end = iter.end();
+
+                    TIdx selected = (globalThreadIndex == 0) ? 0 : chunkOffsets[globalThreadIndex];
+                    // the number of rejected elements in front of the chunk
+                    TIdx rejected = chunkOffsets[numChunks] + *iter - selected;
+                    for(; iter < end; ++iter)
+                    {
+                        auto const& value = source[*iter];
+                        if(TPredicateOperator::run(acc, predicate, value))
+                        {
+                            destination[selected++] = value;
+                        }
+                        else
+                        {
+                            destination[rejected++] = value;
+                        }
+                    }
+                }
+            };
+
+            /**
+             * Unstable partition in a single kernel: each thread counts the selected elements of its chunk, reserves
+             * space for its selected elements at the front and for its rejected elements at the back of the output
+             * with two atomic operations and writes both output streams in a single pass. The chunks are placed in
+             * the order of the atomic operations, therefore the order of the elements is not kept.
+             * @tparam TBlockSize The block size of this kernel.
+             * @tparam TPredicateOperator The vikunja::operators type of the predicate.
+             */
+            template<uint64_t TBlockSize, typename TPredicateOperator>
+            struct ChunkPartitionKernel
+            {
+                /**
+                 * @param acc The alpaka accelerator.
+                 * @param source The input iterator.
+                 * @param destination The output iterator.
+                 * @param counters Two zero initialized counters for the selected and the rejected elements. After
+                 * the kernel, the first counter contains the partition point.
+                 * @param n The size of the input iterator.
+                 * @param predicate The predicate.
+                 */
+                template<
+                    typename TAcc,
+                    typename TIdx,
+                    typename TInputIterator,
+                    typename TOutputIterator,
+                    typename TPredicate>
+                ALPAKA_FN_ACC void operator()(
+                    TAcc const& acc,
+                    TInputIterator const& source,
+                    TOutputIterator const& destination,
+                    TIdx* const counters,
+                    TIdx const& n,
+                    TPredicate const& predicate) const
+                {
+                    using MemIndex = vikunja::MemAccess::BlockStrategy<vikunja::scan::detail::ChunkPolicy, TAcc, TIdx>;
+                    TIdx count = 0;
+                    TIdx selectedCount = 0;
+                    for(MemIndex iter(acc, n, TBlockSize), end = iter.end(); iter < end; ++iter)
+                    {
+                        ++count;
+                        if(TPredicateOperator::run(acc, predicate, source[*iter]))
+                        {
+                            ++selectedCount;
+                        }
+                    }
+                    if(count == 0)
+                    {
+                        return;
+                    }
+
+                    TIdx selected = alpaka::atomicOp<alpaka::AtomicAdd>(
+                        acc,
+                        &counters[0],
+                        selectedCount,
+                        alpaka::hierarchy::Grids{});
+                    TIdx const rejectedCount = count - selectedCount;
+                    TIdx const rejectedBehind = alpaka::atomicOp<alpaka::AtomicAdd>(
+                        acc,
+                        &counters[1],
+                        rejectedCount,
+                        alpaka::hierarchy::Grids{});
+                    // the rejected elements are written from the back to the front of the output
+                    TIdx rejected = n - rejectedBehind - rejectedCount;
+
+                    for(MemIndex iter(acc, n, TBlockSize), end = iter.end(); iter < end; ++iter)
+                    {
+                        auto const& value = source[*iter];
+                        if(TPredicateOperator::run(acc, predicate, value))
+                        {
+                            destination[selected++] = value;
+                        }
+                        else
+                        {
+                            destination[rejected++] = value;
+                        }
+                    }
+                }
+            };
+        } // namespace detail
+    } // namespace partition
+} // namespace vikunja
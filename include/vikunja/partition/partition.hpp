@@ -0,0 +1,492 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/affinity/Affinity.hpp>
+#include <vikunja/compact/detail/BlockThreadCompactKernel.hpp>
+#include <vikunja/operators/functors.hpp>
+#include <vikunja/operators/operators.hpp>
+#include <vikunja/partition/detail/BlockThreadPartitionKernel.hpp>
+#include <vikunja/reduce/reduce.hpp>
+#include <vikunja/scan/detail/BlockThreadScanKernel.hpp>
+#include <vikunja/transform/transform.hpp>
+#include <vikunja/workdiv/BlockBasedWorkDiv.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+#include <cassert>
+#include <iterator>
+#include <type_traits>
+
+namespace vikunja
+{
+    namespace partition
+    {
+        namespace detail
+        {
+            /**
+             * Executes the partition with a fixed work division. The stable partition counts the selected elements
+             * of each chunk with the kernel of the compaction, scans the counts in a single block and writes both
+             * output streams in a single pass. The unstable partition needs only a single kernel, see
+             * ChunkPartitionKernel.
+             * @tparam TBlockSize The block size of the kernels.
+             * @tparam TStable If true, the order of the selected and of the rejected elements is kept.
+             * @param gridSize The number of blocks. Each thread of the grid must own at least one element.
+             * @return The partition point.
+             */
+            template<
+                typename TAcc,
+                uint64_t TBlockSize,
+                bool TStable,
+                typename TPredicateOperator,
+                typename TDevAcc,
+                typename TDevHost,
+                typename TQueue,
+                typename TIdx,
+                typename TInputIterator,
+                typename TOutputIterator,
+                typename TPredicate>
+            auto partitionChunks(
+                TDevAcc& devAcc,
+                TDevHost& devHost,
+                TQueue& queue,
+                TIdx const& n,
+                TIdx const& gridSize,
+                TInputIterator const& source,
+                TOutputIterator const& destination,
+                TPredicate const& predicate) -> TIdx
+            {
+                using Dim = alpaka::Dim<TAcc>;
+                using WorkDiv = alpaka::WorkDivMembers<Dim, TIdx>;
+                using Vec = alpaka::Vec<Dim, TIdx>;
+                constexpr TIdx xIndex = Dim::value - 1u;
+
+                Vec const elementsPerThread(Vec::all(static_cast<TIdx>(1u)));
+                Vec threadsPerBlock(Vec::all(static_cast<TIdx>(1u)));
+                Vec blocksPerGrid(Vec::all(static_cast<TIdx>(1u)));
+                Vec const singleBlocksPerGrid(Vec::all(static_cast<TIdx>(1u)));
+                blocksPerGrid[xIndex] = gridSize;
+                threadsPerBlock[xIndex] = static_cast<TIdx>(TBlockSize);
+                WorkDiv const multiBlockWorkDiv{blocksPerGrid, threadsPerBlock, elementsPerThread};
+                WorkDiv const singleBlockWorkDiv{singleBlocksPerGrid, threadsPerBlock, elementsPerThread};
+
+                Vec countExtent(Vec::all(static_cast<TIdx>(1u)));
+                countExtent[xIndex] = static_cast<TIdx>(2u);
+                auto countBuffer = alpaka::allocBuf<TIdx, TIdx>(devAcc, countExtent);
+                auto countView = alpaka::allocBuf<TIdx, TIdx>(devHost, countExtent);
+
+                if constexpr(TStable)
+                {
+                    TIdx const numChunks = gridSize * static_cast<TIdx>(TBlockSize);
+                    // the additional element behind the last chunk gets the total number of selected elements
+                    Vec chunkCountsExtent(Vec::all(static_cast<TIdx>(1u)));
+                    chunkCountsExtent[xIndex] = numChunks + 1;
+                    auto chunkCounts = alpaka::allocBuf<TIdx, TIdx>(devAcc, chunkCountsExtent);
+                    alpaka::memset(queue, chunkCounts, 0u, chunkCountsExtent);
+
+                    using PlusOperator
+                        = vikunja::operators::BinaryOp<TAcc, vikunja::operators::Plus<TIdx>, TIdx, TIdx>;
+                    vikunja::compact::detail::ChunkCountKernel<TBlockSize, TPredicateOperator> chunkCountKernel;
+                    vikunja::scan::detail::ChunkSumScanKernel<TBlockSize, TIdx, PlusOperator> chunkCountScanKernel;
+                    ChunkStablePartitionKernel<TBlockSize, TPredicateOperator> partitionKernel;
+
+                    alpaka::exec<TAcc>(
+                        queue,
+                        multiBlockWorkDiv,
+                        chunkCountKernel,
+                        source,
+                        alpaka::getPtrNative(chunkCounts),
+                        n,
+                        predicate);
+                    alpaka::exec<TAcc>(
+                        queue,
+                        singleBlockWorkDiv,
+                        chunkCountScanKernel,
+                        alpaka::getPtrNative(chunkCounts),
+                        numChunks + 1,
+                        vikunja::operators::Plus<TIdx>());
+                    alpaka::exec<TAcc>(
+                        queue,
+                        multiBlockWorkDiv,
+                        partitionKernel,
+                        source,
+                        destination,
+                        alpaka::getPtrNative(chunkCounts),
+                        numChunks,
+                        alpaka::getPtrNative(countBuffer),
+                        n,
+                        predicate);
+                    alpaka::memcpy(queue, countView, countBuffer, countExtent);
+                    // the helper memory must not be freed before the kernels are finished
+                    alpaka::wait(queue);
+                }
+                else
+                {
+                    alpaka::memset(queue, countBuffer, 0u, countExtent);
+                    ChunkPartitionKernel<TBlockSize, TPredicateOperator> partitionKernel;
+                    alpaka::exec<TAcc>(
+                        queue,
+                        multiBlockWorkDiv,
+                        partitionKernel,
+                        source,
+                        destination,
+                        alpaka::getPtrNative(countBuffer),
+                        n,
+                        predicate);
+                    alpaka::memcpy(queue, countView, countBuffer, countExtent);
+                    alpaka::wait(queue);
+                }
+                return alpaka::getPtrNative(countView)[0];
+            }
+
+            /**
+             * Selects the work division of the partition. Each thread of the grid needs at least one element.
+             */
+            template<
+                typename TAcc,
+                typename WorkDivPolicy,
+                bool TStable,
+                typename TPredicateOperator,
+                typename TDevAcc,
+                typename TDevHost,
+                typename TQueue,
+                typename TIdx,
+                typename TInputIterator,
+                typename TOutputIterator,
+                typename TPredicate>
+            auto partitionImpl(
+                TDevAcc& devAcc,
+                TDevHost& devHost,
+                TQueue& queue,
+                TIdx const& n,
+                TInputIterator const& source,
+                TOutputIterator const& destination,
+                TPredicate const& predicate) -> TIdx
+            {
+                if(n == 0)
+                {
+                    return 0;
+                }
+                vikunja::affinity::applyAffinity<TAcc>();
+                constexpr uint64_t blockSize = WorkDivPolicy::template getBlockSize<TAcc>();
+                if(n < static_cast<TIdx>(blockSize))
+                {
+                    // the small problem is partitioned by a single thread
+                    return partitionChunks<TAcc, 1u, TStable, TPredicateOperator>(
+                        devAcc,
+                        devHost,
+                        queue,
+                        n,
+                        static_cast<TIdx>(1u),
+                        source,
+                        destination,
+                        predicate);
+                }
+                TIdx gridSize = WorkDivPolicy::template getGridSize<TAcc>(devAcc);
+                TIdx const maxGridSize = n / static_cast<TIdx>(blockSize);
+                if(gridSize > maxGridSize)
+                {
+                    gridSize = maxGridSize;
+                }
+                return partitionChunks<TAcc, blockSize, TStable, TPredicateOperator>(
+                    devAcc,
+                    devHost,
+                    queue,
+                    n,
+                    gridSize,
+                    source,
+                    destination,
+                    predicate);
+            }
+
+            /**
+             * In place partition: the data is copied to helper memory and partitioned back.
+             */
+            template<
+                typename TAcc,
+                typename WorkDivPolicy,
+                bool TStable,
+                typename TPredicateOperator,
+                typename TDevAcc,
+                typename TDevHost,
+                typename TQueue,
+                typename TIdx,
+                typename TIterator,
+                typename TPredicate>
+            auto partitionInPlaceImpl(
+                TDevAcc& devAcc,
+                TDevHost& devHost,
+                TQueue& queue,
+                TIdx const& n,
+                TIterator const& data,
+                TPredicate const& predicate) -> TIdx
+            {
+                using TData = typename std::iterator_traits<TIterator>::value_type;
+                if(n == 0)
+                {
+                    return 0;
+                }
+                using Vec = alpaka::Vec<alpaka::Dim<TAcc>, TIdx>;
+                Vec dataExtent(Vec::all(static_cast<TIdx>(1u)));
+                dataExtent[alpaka::Dim<TAcc>::value - 1u] = n;
+                auto helper = alpaka::allocBuf<TData, TIdx>(devAcc, dataExtent);
+                TData* const helperPtr = alpaka::getPtrNative(helper);
+                vikunja::transform::deviceTransform<TAcc>(
+                    devAcc,
+                    queue,
+                    n,
+                    data,
+                    helperPtr,
+                    vikunja::reduce::detail::Identity<TData>());
+                // partitionImpl waits for the queue, before the helper memory is freed
+                return partitionImpl<TAcc, WorkDivPolicy, TStable, TPredicateOperator>(
+                    devAcc,
+                    devHost,
+                    queue,
+                    n,
+                    helperPtr,
+                    data,
+                    predicate);
+            }
+        } // namespace detail
+
+        /**
+         * Writes the elements of the input, which fulfill the predicate, to the front of the output and all other
+         * elements behind them, i.e. if one has the array [1,2,3,4,5] and the predicate (x) -> x % 2 == 1, the output
+         * could contain [5,1,3,2,4] and 3 is returned. The order within both parts is not kept, see
+         * deviceStablePartition.
+         * The partition needs a single kernel: each thread counts the selected elements of its chunk, reserves space
+         * at the front and at the back of the output with atomic operations and writes both parts in a single pass.
+         * The output must be as big as the input and must not overlap with it.
+         * @tparam TAcc The alpaka accelerator type to use.
+         * @tparam WorkDivPolicy The working division policy. Defaults to a templated value depending on the
+         * accelerator. Each thread needs a contiguous chunk of the input, therefore the linear memory access policy
+         * is always used.
+         * @tparam TPredicate Type of the predicate.
+         * @tparam TInputIterator Type of the input iterator. Should be a pointer-like type.
+         * @tparam TOutputIterator Type of the output iterator. Should be a pointer-like type.
+         * @tparam TDevAcc The type of the alpaka accelerator.
+         * @tparam TDevHost The type of the alpaka host.
+         * @tparam TQueue The type of the alpaka queue.
+         * @tparam TIdx The index type to use.
+         * @tparam TPredicateOperator The vikunja::operators type of the predicate.
+         * @param devAcc The alpaka accelerator.
+         * @param devHost The alpaka host.
+         * @param queue The alpaka queue.
+         * @param n The number of elements in the input.
+         * @param source The input iterator.
+         * @param destination The output iterator.
+         * @param predicate The predicate, which returns true for the elements of the first part.
+         * @return The partition point, i.e. the number of elements, which fulfill the predicate.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TPredicate,
+            typename TInputIterator,
+            typename TOutputIterator,
+            typename TDevAcc,
+            typename TDevHost,
+            typename TQueue,
+            typename TIdx,
+            typename TPredicateOperator = vikunja::operators::
+                UnaryOp<TAcc, TPredicate, typename std::iterator_traits<TInputIterator>::value_type>>
+        auto devicePartition(
+            TDevAcc& devAcc,
+            TDevHost& devHost,
+            TQueue& queue,
+            TIdx const& n,
+            TInputIterator const& source,
+            TOutputIterator const& destination,
+            TPredicate const& predicate) -> TIdx
+        {
+            return detail::partitionImpl<TAcc, WorkDivPolicy, false, TPredicateOperator>(
+                devAcc,
+                devHost,
+                queue,
+                n,
+                source,
+                destination,
+                predicate);
+        }
+
+        /**
+         * Partition with begin and end iterator of the input.
+         * @see devicePartition
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TPredicate,
+            typename TInputIterator,
+            typename TOutputIterator,
+            typename TDevAcc,
+            typename TDevHost,
+            typename TQueue>
+        auto devicePartition(
+            TDevAcc& devAcc,
+            TDevHost& devHost,
+            TQueue& queue,
+            TInputIterator const& sourceBegin,
+            TInputIterator const& sourceEnd,
+            TOutputIterator const& destination,
+            TPredicate const& predicate)
+        {
+            assert(sourceEnd >= sourceBegin);
+            auto size = static_cast<typename alpaka::trait::IdxType<TAcc>::type>(sourceEnd - sourceBegin);
+            return devicePartition<TAcc, WorkDivPolicy>(
+                devAcc,
+                devHost,
+                queue,
+                size,
+                sourceBegin,
+                destination,
+                predicate);
+        }
+
+        /**
+         * Partitions the data in place. The data is copied to temporary memory of the size of the data first.
+         * @see devicePartition
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TPredicate,
+            typename TIterator,
+            typename TDevAcc,
+            typename TDevHost,
+            typename TQueue,
+            typename TIdx,
+            typename TPredicateOperator = vikunja::operators::
+                UnaryOp<TAcc, TPredicate, typename std::iterator_traits<TIterator>::value_type>>
+        auto devicePartition(
+            TDevAcc& devAcc,
+            TDevHost& devHost,
+            TQueue& queue,
+            TIdx const& n,
+            TIterator const& data,
+            TPredicate const& predicate) -> TIdx
+        {
+            return detail::partitionInPlaceImpl<TAcc, WorkDivPolicy, false, TPredicateOperator>(
+                devAcc,
+                devHost,
+                queue,
+                n,
+                data,
+                predicate);
+        }
+
+        /**
+         * Writes the elements of the input, which fulfill the predicate, to the front of the output and all other
+         * elements behind them. In contrast to devicePartition, the order within both parts is kept, i.e. if one has
+         * the array [1,2,3,4,5] and the predicate (x) -> x % 2 == 1, the output will contain [1,3,5,2,4].
+         * The selected elements of each chunk are counted and scanned like in the compaction, afterwards each thread
+         * writes both parts of its chunk in a single pass.
+         * @see devicePartition
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TPredicate,
+            typename TInputIterator,
+            typename TOutputIterator,
+            typename TDevAcc,
+            typename TDevHost,
+            typename TQueue,
+            typename TIdx,
+            typename TPredicateOperator = vikunja::operators::
+                UnaryOp<TAcc, TPredicate, typename std::iterator_traits<TInputIterator>::value_type>>
+        auto deviceStablePartition(
+            TDevAcc& devAcc,
+            TDevHost& devHost,
+            TQueue& queue,
+            TIdx const& n,
+            TInputIterator const& source,
+            TOutputIterator const& destination,
+            TPredicate const& predicate) -> TIdx
+        {
+            return detail::partitionImpl<TAcc, WorkDivPolicy, true, TPredicateOperator>(
+                devAcc,
+                devHost,
+                queue,
+                n,
+                source,
+                destination,
+                predicate);
+        }
+
+        /**
+         * Stable partition with begin and end iterator of the input.
+         * @see deviceStablePartition
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TPredicate,
+            typename TInputIterator,
+            typename TOutputIterator,
+            typename TDevAcc,
+            typename TDevHost,
+            typename TQueue>
+        auto deviceStablePartition(
+            TDevAcc& devAcc,
+            TDevHost& devHost,
+            TQueue& queue,
+            TInputIterator const& sourceBegin,
+            TInputIterator const& sourceEnd,
+            TOutputIterator const& destination,
+            TPredicate const& predicate)
+        {
+            assert(sourceEnd >= sourceBegin);
+            auto size = static_cast<typename alpaka::trait::IdxType<TAcc>::type>(sourceEnd - sourceBegin);
+            return deviceStablePartition<TAcc, WorkDivPolicy>(
+                devAcc,
+                devHost,
+                queue,
+                size,
+                sourceBegin,
+                destination,
+                predicate);
+        }
+
+        /**
+         * Partitions the data in place and keeps the order within both parts. The data is copied to temporary
+         * memory of the size of the data first.
+         * @see deviceStablePartition
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TPredicate,
+            typename TIterator,
+            typename TDevAcc,
+            typename TDevHost,
+            typename TQueue,
+            typename TIdx,
+            typename TPredicateOperator = vikunja::operators::
+                UnaryOp<TAcc, TPredicate, typename std::iterator_traits<TIterator>::value_type>>
+        auto deviceStablePartition(
+            TDevAcc& devAcc,
+            TDevHost& devHost,
+            TQueue& queue,
+            TIdx const& n,
+            TIterator const& data,
+            TPredicate const& predicate) -> TIdx
+        {
+            return detail::partitionInPlaceImpl<TAcc, WorkDivPolicy, true, TPredicateOperator>(
+                devAcc,
+                devHost,
+                queue,
+                n,
+                data,
+                predicate);
+        }
+    } // namespace partition
+} // namespace vikunja
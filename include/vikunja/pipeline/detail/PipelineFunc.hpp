@@ -0,0 +1,179 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/blas1/detail/Blas1Func.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+#include <limits>
+#include <type_traits>
+
+namespace vikunja
+{
+    namespace pipeline
+    {
+        namespace detail
+        {
+            /**
+             * Transform functor of the normalize: divides the element by the euclidean norm of the sequence. A zero
+             * sequence stays zero.
+             */
+            template<typename T>
+            struct NormalizeFunc
+            {
+                template<typename TAcc>
+                ALPAKA_FN_HOST_ACC T operator()(
+                    TAcc const& acc,
+                    T const& x,
+                    vikunja::blas1::detail::ScaledSquareSum<T> const& norm) const
+                {
+                    if(norm.scale == T{0})
+                    {
+                        return x;
+                    }
+                    // dividing by the scale first avoids the overflow of the norm itself
+                    return (x / norm.scale) / alpaka::math::sqrt(acc, norm.sumOfSquares);
+                }
+            };
+
+            /**
+             * Partial result of the softmax, which represents the sum of exp(x - max) of the elements.
+             */
+            template<typename T>
+            struct MaxExpSum
+            {
+                T max;
+                T sum;
+            };
+
+            /**
+             * Transform functor of the softmax reduce: returns the partial result of a single element.
+             */
+            template<typename T>
+            struct MaxExpSumFunc
+            {
+                constexpr ALPAKA_FN_HOST_ACC MaxExpSum<T> operator()(T const& x) const
+                {
+                    return MaxExpSum<T>{x, T{1}};
+                }
+            };
+
+            /**
+             * Reduce functor of the softmax: rescales both sums to the larger maximum and adds them. Therefore, the
+             * maximum and the sum of the exponentials are computed in a single read of the data and no exponential
+             * overflows.
+             */
+            template<typename T>
+            struct MaxExpSumMerge
+            {
+                template<typename TAcc>
+                ALPAKA_FN_HOST_ACC MaxExpSum<T> operator()(
+                    TAcc const& acc,
+                    MaxExpSum<T> const& a,
+                    MaxExpSum<T> const& b) const
+                {
+                    T const max = (a.max < b.max) ? b.max : a.max;
+                    // comparing the maxima first avoids NaN for infinite maxima
+                    T const factorA = (a.max == max) ? T{1} : alpaka::math::exp(acc, a.max - max);
+                    T const factorB = (b.max == max) ? T{1} : alpaka::math::exp(acc, b.max - max);
+                    return MaxExpSum<T>{max, a.sum * factorA + b.sum * factorB};
+                }
+            };
+
+            /**
+             * Transform functor of the softmax: returns exp(x - max) / sum.
+             */
+            template<typename T>
+            struct SoftmaxFunc
+            {
+                template<typename TAcc>
+                ALPAKA_FN_HOST_ACC T operator()(TAcc const& acc, T const& x, MaxExpSum<T> const& expSum) const
+                {
+                    return alpaka::math::exp(acc, x - expSum.max) / expSum.sum;
+                }
+            };
+
+            /**
+             * Transform functor of the log softmax: returns x - log-sum-exp, where the log-sum-exp is
+             * max + log(sum).
+             */
+            template<typename T>
+            struct LogSoftmaxFunc
+            {
+                template<typename TAcc>
+                ALPAKA_FN_HOST_ACC T operator()(TAcc const& acc, T const& x, MaxExpSum<T> const& expSum) const
+                {
+                    return (x - expSum.max) - alpaka::math::log(acc, expSum.sum);
+                }
+            };
+
+            /**
+             * Reduce functor of the quantize: returns the larger value.
+             */
+            template<typename T>
+            struct MaxFunc
+            {
+                constexpr ALPAKA_FN_HOST_ACC T operator()(T const& a, T const& b) const
+                {
+                    return (a < b) ? b : a;
+                }
+            };
+
+            /**
+             * Returns the largest value of the signed output type, which is exactly representable in the floating
+             * point type T, e.g. 127 for int8_t and 2^63 - 2^39 for int64_t and float. The maximum of the output type
+             * itself would be rounded up to 2^63 by the conversion to float, which overflows the conversion back.
+             */
+            template<typename T, typename TOutput>
+            constexpr TOutput quantizeLevels()
+            {
+                constexpr int droppedBits = std::numeric_limits<TOutput>::digits - std::numeric_limits<T>::digits;
+                if constexpr(droppedBits > 0)
+                {
+                    // clear the bits below the precision of T
+                    return std::numeric_limits<TOutput>::max() & ~((TOutput{1} << droppedBits) - TOutput{1});
+                }
+                else
+                {
+                    return std::numeric_limits<TOutput>::max();
+                }
+            }
+
+            /**
+             * Transform functor of the symmetric quantize: maps [-maxAbs, maxAbs] linear to the integers
+             * [-levels, levels] of the output type and rounds to the nearest integer. See quantizeLevels for the
+             * levels.
+             * @tparam T The floating point type of the input.
+             * @tparam TOutput The signed integral type of the output.
+             */
+            template<typename T, typename TOutput>
+            struct QuantizeFunc
+            {
+                static_assert(
+                    std::is_integral_v<TOutput> && std::is_signed_v<TOutput>,
+                    "The output of the quantize must be a signed integral type.");
+
+                static constexpr T levels = static_cast<T>(quantizeLevels<T, TOutput>());
+
+                template<typename TAcc>
+                ALPAKA_FN_HOST_ACC TOutput operator()(TAcc const& acc, T const& x, T const& maxAbs) const
+                {
+                    if(maxAbs == T{0})
+                    {
+                        return TOutput{0};
+                    }
+                    T const value = alpaka::math::round(acc, x * (levels / maxAbs));
+                    return static_cast<TOutput>((value < -levels) ? -levels : ((value > levels) ? levels : value));
+                }
+            };
+        } // namespace detail
+    } // namespace pipeline
+} // namespace vikunja
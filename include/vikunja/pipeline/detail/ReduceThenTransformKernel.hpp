@@ -0,0 +1,167 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/access/BlockStrategy.hpp>
+#include <vikunja/reduce/detail/BlockThreadReduceKernel.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+#include <cstdint>
+
+namespace vikunja
+{
+    namespace pipeline
+    {
+        namespace detail
+        {
+            /**
+             * Inputs up to this size in bytes are reduced and transformed by a single block in a single kernel
+             * launch. They fit into the caches, so that the second read of the input by the transform is cheap and
+             * the launches and the helper memory of the multi block reduce dominate the runtime.
+             */
+            constexpr std::uint64_t singleLaunchBytes = 64 * 1024;
+
+            /**
+             * Transform functor of the multi launch pipeline, which reads the result of the reduce from the device
+             * memory and passes it with each element to the transform function.
+             * @tparam TTransformOperator The vikunja::operators type of the transform function.
+             */
+            template<typename TTransformOperator, typename TRed, typename TTransformFunc>
+            struct ScalarTransformFunc
+            {
+                TRed const* scalar;
+                TTransformFunc transformFunc;
+
+                template<typename TAcc, typename TData>
+                ALPAKA_FN_HOST_ACC auto operator()(TAcc const& acc, TData const& value) const
+                {
+                    return TTransformOperator::run(acc, transformFunc, value, *scalar);
+                }
+            };
+
+            /**
+             * Reduces the input and transforms each element with the result in a single kernel, which is executed
+             * by a single block. The threads reduce their elements, combine the partial results with the block tree
+             * in the shared memory and transform their elements again with the result of the tree, so that the
+             * result never leaves the block. The tree does not keep the order of the elements, therefore the reduce
+             * function must be associative and commutative.
+             * @tparam TBlockSize The block size of the kernel.
+             * @tparam TMemAccessPolicy The memory access policy of the kernel.
+             * @tparam TRed The type of the reduction.
+             * @tparam TReduceTransformOperator The vikunja::operators type of the transform applied before the
+             * reduce.
+             * @tparam TReduceOperator The vikunja::operators type of the reduce function.
+             * @tparam TTransformOperator The vikunja::operators type of the transform applied with the result.
+             */
+            template<
+                std::uint64_t TBlockSize,
+                typename TMemAccessPolicy,
+                typename TRed,
+                typename TReduceTransformOperator,
+                typename TReduceOperator,
+                typename TTransformOperator>
+            struct SingleBlockReduceThenTransformKernel
+            {
+                /**
+                 * @param acc The alpaka accelerator.
+                 * @param source The input iterator.
+                 * @param destination The output iterator.
+                 * @param n The number of elements. Must be greater than 0.
+                 * @param reduceTransformFunc The transform applied before the reduce.
+                 * @param reduceFunc The reduce operator.
+                 * @param transformFunc The transform applied to each element and the result of the reduce.
+                 * @param scalar If not nullptr, the result of the reduce is written to it.
+                 */
+                template<
+                    typename TAcc,
+                    typename TIdx,
+                    typename TInputIterator,
+                    typename TOutputIterator,
+                    typename TReduceTransformFunc,
+                    typename TReduceFunc,
+                    typename TTransformFunc>
+                ALPAKA_FN_ACC void operator()(
+                    TAcc const& acc,
+                    TInputIterator const& source,
+                    TOutputIterator const& destination,
+                    TIdx const& n,
+                    TReduceTransformFunc const& reduceTransformFunc,
+                    TReduceFunc const& reduceFunc,
+                    TTransformFunc const& transformFunc,
+                    TRed* const scalar) const
+                {
+                    using SharedArray = vikunja::reduce::detail::sharedStaticArray<TRed, TBlockSize>;
+                    using SharedFlags = vikunja::reduce::detail::sharedStaticArray<std::uint8_t, TBlockSize>;
+                    auto& sdata(alpaka::declareSharedVar<SharedArray, __COUNTER__>(acc));
+                    // without a neutral element, the tree has to know which threads hold a partial result
+                    auto& valid(alpaka::declareSharedVar<SharedFlags, __COUNTER__>(acc));
+
+                    constexpr TIdx xIndex = alpaka::Dim<TAcc>::value - 1u;
+                    TIdx const threadIndex = alpaka::getIdx<alpaka::Block, alpaka::Threads>(acc)[xIndex];
+
+                    using MemIndex = vikunja::MemAccess::BlockStrategy<TMemAccessPolicy, TAcc, TIdx>;
+                    MemIndex iter(acc, n, TBlockSize);
+                    MemIndex const end = iter.end();
+                    valid[threadIndex] = (iter < end) ? 1u : 0u;
+                    if(iter < end)
+                    {
+                        auto tSum = TReduceTransformOperator::run(acc, reduceTransformFunc, source[*iter]);
+                        for(++iter; iter < end; ++iter)
+                        {
+                            tSum = TReduceOperator::run(
+                                acc,
+                                reduceFunc,
+                                tSum,
+                                TReduceTransformOperator::run(acc, reduceTransformFunc, source[*iter]));
+                        }
+                        sdata[threadIndex] = tSum;
+                    }
+                    alpaka::syncBlockThreads(acc);
+
+                    // the partial result of thread i is combined with the one of thread i + half, which holds
+                    // elements of the strided chunks in between, so the order of the elements is not kept
+                    for(TIdx activeThreads = TBlockSize; activeThreads > 1;)
+                    {
+                        TIdx const half = (activeThreads + 1) / 2;
+                        if(threadIndex + half < activeThreads && valid[threadIndex + half])
+                        {
+                            if(valid[threadIndex])
+                            {
+                                sdata[threadIndex] = TReduceOperator::run(
+                                    acc,
+                                    reduceFunc,
+                                    sdata[threadIndex],
+                                    sdata[threadIndex + half]);
+                            }
+                            else
+                            {
+                                sdata[threadIndex] = sdata[threadIndex + half];
+                                valid[threadIndex] = 1u;
+                            }
+                        }
+                        alpaka::syncBlockThreads(acc);
+                        activeThreads = half;
+                    }
+
+                    TRed const result = sdata[0];
+                    if(threadIndex == 0 && scalar != nullptr)
+                    {
+                        *scalar = result;
+                    }
+                    for(MemIndex mapIter(acc, n, TBlockSize); mapIter < end; ++mapIter)
+                    {
+                        destination[*mapIter] = TTransformOperator::run(acc, transformFunc, source[*mapIter], result);
+                    }
+                }
+            };
+        } // namespace detail
+    } // namespace pipeline
+} // namespace vikunja
@@ -0,0 +1,371 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/access/BlockStrategy.hpp>
+#include <vikunja/affinity/Affinity.hpp>
+#include <vikunja/blas1/detail/Blas1Func.hpp>
+#include <vikunja/operators/operators.hpp>
+#include <vikunja/pipeline/detail/PipelineFunc.hpp>
+#include <vikunja/pipeline/detail/ReduceThenTransformKernel.hpp>
+#include <vikunja/reduce/reduce.hpp>
+#include <vikunja/transform/transform.hpp>
+#include <vikunja/workdiv/BlockBasedWorkDiv.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+
+namespace vikunja
+{
+    /**
+     * Fused pipelines, which reduce a sequence to a value and transform each element with this value, e.g. the
+     * normalize, the softmax or the quantize. The value stays on the device: the transform reads it from the device
+     * memory instead of waiting for the result of the reduce on the host.
+     */
+    namespace pipeline
+    {
+        /**
+         * Reduces the transformed input to a value and transforms each element of the input with this value:
+         * output[i] = transformFunc(input[i], reduce(reduceTransformFunc(input[0]), ...)). For example, given the
+         * array [1, 2, 3, 4], the reduce transform (x) -> x, the reduce function (x, y) -> x + y and the transform
+         * function (x, sum) -> x / sum would return [0.1, 0.2, 0.3, 0.4].
+         *
+         * Inputs up to 64 KiB are reduced and transformed by a single block in a single kernel launch. Larger inputs
+         * are reduced by the kernels of vikunja::reduce::deviceTransformReduce into the device memory and
+         * transformed by a second kernel, which reads the value from there. Both paths combine the partial results
+         * in a tree, which does not keep the order of the elements. Therefore, the reduce function must be
+         * associative and commutative.
+         * @tparam TAcc The alpaka accelerator type to use.
+         * @tparam WorkDivPolicy The working division policy. Defaults to a templated value depending on the
+         * accelerator. For the API of this, see workdiv/BlockBasedWorkDiv.hpp
+         * @tparam MemAccessPolicy The memory access policy. Defaults to a templated value depending on the
+         * accelerator. For the API of this, see vikunja::MemAccess::PolicyBasedBlockStrategy
+         * @tparam TReduceTransformFunc Type of the transform applied before the reduce.
+         * @tparam TReduceFunc Type of the reduce operator.
+         * @tparam TTransformFunc Type of the transform applied with the result of the reduce.
+         * @tparam TInputIterator Type of the input iterator. Should be a pointer-like type.
+         * @tparam TOutputIterator Type of the output iterator. Should be a pointer-like type.
+         * @tparam TDevAcc The type of the alpaka accelerator.
+         * @tparam TQueue The type of the alpaka queue.
+         * @tparam TIdx The index type to use.
+         * @tparam TReduceTransformOperator The vikunja::operators type of the transform applied before the reduce.
+         * @tparam TReduceOperator The vikunja::operators type of the reduce function.
+         * @tparam TRed The type of the result of the reduce.
+         * @tparam TTransformOperator The vikunja::operators type of the transform applied with the result of the
+         * reduce.
+         * @param devAcc The alpaka accelerator.
+         * @param queue The alpaka queue.
+         * @param n The number of elements. Nothing is done, if n is 0.
+         * @param input The input iterator.
+         * @param output The output iterator. Can be equal to the input.
+         * @param reduceTransformFunc The transform applied before the reduce.
+         * @param reduceFunc The reduce operator.
+         * @param transformFunc The transform operator, which gets an element and the result of the reduce.
+         * @param scalar Optional pointer to the device memory, where the result of the reduce is written to.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename MemAccessPolicy = vikunja::MemAccess::MemAccessPolicy<TAcc>,
+            typename TReduceTransformFunc,
+            typename TReduceFunc,
+            typename TTransformFunc,
+            typename TInputIterator,
+            typename TOutputIterator,
+            typename TDevAcc,
+            typename TQueue,
+            typename TIdx,
+            typename TData = typename std::iterator_traits<TInputIterator>::value_type,
+            typename TReduceTransformOperator = vikunja::operators::UnaryOp<TAcc, TReduceTransformFunc, TData>,
+            typename TReduceOperator = vikunja::operators::BinaryOp<
+                TAcc,
+                TReduceFunc,
+                typename TReduceTransformOperator::TRed,
+                typename TReduceTransformOperator::TRed>,
+            typename TRed = typename TReduceOperator::TRed,
+            typename TTransformOperator = vikunja::operators::BinaryOp<TAcc, TTransformFunc, TData, TRed>>
+        void deviceReduceThenTransform(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            TIdx const& n,
+            TInputIterator const& input,
+            TOutputIterator const& output,
+            TReduceTransformFunc const& reduceTransformFunc,
+            TReduceFunc const& reduceFunc,
+            TTransformFunc const& transformFunc,
+            TRed* const scalar = nullptr)
+        {
+            if(n == 0)
+            {
+                return;
+            }
+
+            if(static_cast<std::uint64_t>(n) * sizeof(TData) <= detail::singleLaunchBytes)
+            {
+                vikunja::affinity::applyAffinity<TAcc>();
+                constexpr std::uint64_t blockSize = WorkDivPolicy::template getBlockSize<TAcc>();
+                using Dim = alpaka::Dim<TAcc>;
+                using WorkDiv = alpaka::WorkDivMembers<Dim, TIdx>;
+                using Vec = alpaka::Vec<Dim, TIdx>;
+                constexpr TIdx xIndex = Dim::value - 1u;
+
+                Vec const elementsPerThread(Vec::all(static_cast<TIdx>(1u)));
+                Vec threadsPerBlock(Vec::all(static_cast<TIdx>(1u)));
+                Vec const blocksPerGrid(Vec::all(static_cast<TIdx>(1u)));
+                threadsPerBlock[xIndex] = static_cast<TIdx>(blockSize);
+                WorkDiv const workDiv{blocksPerGrid, threadsPerBlock, elementsPerThread};
+
+                detail::SingleBlockReduceThenTransformKernel<
+                    blockSize,
+                    MemAccessPolicy,
+                    TRed,
+                    TReduceTransformOperator,
+                    TReduceOperator,
+                    TTransformOperator>
+                    kernel;
+                alpaka::exec<TAcc>(
+                    queue,
+                    workDiv,
+                    kernel,
+                    input,
+                    output,
+                    n,
+                    reduceTransformFunc,
+                    reduceFunc,
+                    transformFunc,
+                    scalar);
+                return;
+            }
+
+            auto const scalarBuffer = vikunja::reduce::detail::transformReduceToDevice<
+                TAcc,
+                WorkDivPolicy,
+                MemAccessPolicy,
+                TReduceTransformOperator,
+                TReduceOperator,
+                TRed>(devAcc, queue, n, input, reduceTransformFunc, reduceFunc);
+            TRed const* const scalarPtr = alpaka::getPtrNative(scalarBuffer);
+
+            vikunja::transform::deviceTransform<TAcc, WorkDivPolicy, MemAccessPolicy>(
+                devAcc,
+                queue,
+                n,
+                input,
+                output,
+                detail::ScalarTransformFunc<TTransformOperator, TRed, TTransformFunc>{scalarPtr, transformFunc});
+            if(scalar != nullptr)
+            {
+                using Dim = alpaka::Dim<TAcc>;
+                using Vec = alpaka::Vec<Dim, TIdx>;
+                Vec const scalarExtent(Vec::all(static_cast<TIdx>(1u)));
+                alpaka::ViewPlainPtr<TDevAcc, TRed, Dim, TIdx> scalarView(scalar, devAcc, scalarExtent);
+                alpaka::memcpy(queue, scalarView, scalarBuffer, scalarExtent);
+            }
+            // the kernels read the value from the buffer
+            alpaka::wait(queue);
+        }
+
+        /**
+         * Divides each element by the euclidean norm of the sequence. The norm is computed like
+         * vikunja::blas1::deviceNrm2, without overflow or underflow of the squares. A zero sequence is copied.
+         * @see deviceReduceThenTransform
+         * @param input The floating point input.
+         * @param output The output. Can be equal to the input.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename MemAccessPolicy = vikunja::MemAccess::MemAccessPolicy<TAcc>,
+            typename TInputIterator,
+            typename TOutputIterator,
+            typename TDevAcc,
+            typename TQueue,
+            typename TIdx,
+            typename TValue = typename std::iterator_traits<TInputIterator>::value_type>
+        void deviceNormalize(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            TIdx const& n,
+            TInputIterator const& input,
+            TOutputIterator const& output)
+        {
+            deviceReduceThenTransform<TAcc, WorkDivPolicy, MemAccessPolicy>(
+                devAcc,
+                queue,
+                n,
+                input,
+                output,
+                vikunja::blas1::detail::ScaledSquareFunc<TValue>(),
+                vikunja::blas1::detail::ScaledSquareSumCombine<TValue>(),
+                detail::NormalizeFunc<TValue>());
+        }
+
+        /**
+         * Computes the softmax exp(x[i] - max) / sum(exp(x[j] - max)) of the sequence. The maximum and the sum of
+         * the exponentials are computed together in a single reduce, which rescales the partial sums to the
+         * larger maximum, so that no exponential overflows.
+         * @see deviceReduceThenTransform
+         * @param input The floating point input.
+         * @param output The output. Can be equal to the input.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename MemAccessPolicy = vikunja::MemAccess::MemAccessPolicy<TAcc>,
+            typename TInputIterator,
+            typename TOutputIterator,
+            typename TDevAcc,
+            typename TQueue,
+            typename TIdx,
+            typename TValue = typename std::iterator_traits<TInputIterator>::value_type>
+        void deviceSoftmax(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            TIdx const& n,
+            TInputIterator const& input,
+            TOutputIterator const& output)
+        {
+            deviceReduceThenTransform<TAcc, WorkDivPolicy, MemAccessPolicy>(
+                devAcc,
+                queue,
+                n,
+                input,
+                output,
+                detail::MaxExpSumFunc<TValue>(),
+                detail::MaxExpSumMerge<TValue>(),
+                detail::SoftmaxFunc<TValue>());
+        }
+
+        /**
+         * Computes the logarithm of the softmax x[i] - log(sum(exp(x[j]))) of the sequence. The log-sum-exp is
+         * computed like in deviceSoftmax.
+         * @see deviceSoftmax
+         * @param input The floating point input.
+         * @param output The output. Can be equal to the input.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename MemAccessPolicy = vikunja::MemAccess::MemAccessPolicy<TAcc>,
+            typename TInputIterator,
+            typename TOutputIterator,
+            typename TDevAcc,
+            typename TQueue,
+            typename TIdx,
+            typename TValue = typename std::iterator_traits<TInputIterator>::value_type>
+        void deviceLogSoftmax(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            TIdx const& n,
+            TInputIterator const& input,
+            TOutputIterator const& output)
+        {
+            deviceReduceThenTransform<TAcc, WorkDivPolicy, MemAccessPolicy>(
+                devAcc,
+                queue,
+                n,
+                input,
+                output,
+                detail::MaxExpSumFunc<TValue>(),
+                detail::MaxExpSumMerge<TValue>(),
+                detail::LogSoftmaxFunc<TValue>());
+        }
+
+        /**
+         * Computes log(sum(exp(x[i]))) of the sequence without overflow of the exponentials.
+         * @see deviceSoftmax
+         * @param devHost The alpaka host.
+         * @param input The floating point input.
+         * @return The log-sum-exp. Negative infinity, if n is 0.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename MemAccessPolicy = vikunja::MemAccess::MemAccessPolicy<TAcc>,
+            typename TInputIterator,
+            typename TDevAcc,
+            typename TDevHost,
+            typename TQueue,
+            typename TIdx,
+            typename TValue = typename std::iterator_traits<TInputIterator>::value_type>
+        auto deviceLogSumExp(
+            TDevAcc& devAcc,
+            TDevHost& devHost,
+            TQueue& queue,
+            TIdx const& n,
+            TInputIterator const& input) -> TValue
+        {
+            if(n == 0)
+            {
+                return -std::numeric_limits<TValue>::infinity();
+            }
+            detail::MaxExpSum<TValue> const result
+                = vikunja::reduce::deviceTransformReduce<TAcc, WorkDivPolicy, MemAccessPolicy>(
+                    devAcc,
+                    devHost,
+                    queue,
+                    n,
+                    input,
+                    detail::MaxExpSumFunc<TValue>(),
+                    detail::MaxExpSumMerge<TValue>());
+            return result.max + std::log(result.sum);
+        }
+
+        /**
+         * Quantizes the sequence symmetrically to the signed integral output type: the range [-maxAbs, maxAbs] of
+         * the input is mapped linear to [-levels, levels] of the output type, where maxAbs is the largest absolute
+         * value of the input and levels is the largest value of the output type, which is exactly representable in
+         * the input type, e.g. 127 for int8_t. The element is restored by output[i] * maxAbs / levels. A zero
+         * sequence is quantized to 0.
+         * @see deviceReduceThenTransform
+         * @param input The floating point input.
+         * @param output The signed integral output, e.g. int8_t.
+         * @param maxAbs Optional pointer to the device memory, where the largest absolute value is written to.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename MemAccessPolicy = vikunja::MemAccess::MemAccessPolicy<TAcc>,
+            typename TInputIterator,
+            typename TOutputIterator,
+            typename TDevAcc,
+            typename TQueue,
+            typename TIdx,
+            typename TValue = typename std::iterator_traits<TInputIterator>::value_type,
+            typename TOutput = typename std::iterator_traits<TOutputIterator>::value_type>
+        void deviceQuantize(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            TIdx const& n,
+            TInputIterator const& input,
+            TOutputIterator const& output,
+            TValue* const maxAbs = nullptr)
+        {
+            static_assert(
+                std::is_integral_v<TOutput> && std::is_signed_v<TOutput>,
+                "The output of the quantize must be a signed integral type.");
+            deviceReduceThenTransform<TAcc, WorkDivPolicy, MemAccessPolicy>(
+                devAcc,
+                queue,
+                n,
+                input,
+                output,
+                vikunja::blas1::detail::AbsFunc<TValue>(),
+                detail::MaxFunc<TValue>(),
+                detail::QuantizeFunc<TValue, TOutput>(),
+                maxAbs);
+        }
+    } // namespace pipeline
+} // namespace vikunja
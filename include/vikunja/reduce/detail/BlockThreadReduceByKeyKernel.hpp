@@ -0,0 +1,244 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/access/BlockStrategy.hpp>
+#include <vikunja/scan/detail/BlockThreadScanKernel.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+namespace vikunja
+{
+    namespace reduce
+    {
+        namespace detail
+        {
+            /**
+             * Summary of a chunk of the reduce by key. The summaries of consecutive chunks are combined with
+             * SegmentedCombine.
+             * @tparam TIdx The index type.
+             * @tparam TRed The type of the reduction.
+             */
+            template<typename TIdx, typename TRed>
+            struct KeySegmentSummary
+            {
+                //! Number of segment heads, i.e. elements whose key differs from the key of the previous element.
+                TIdx heads;
+                //! True, if the chunk contains a segment head.
+                bool hasHead;
+                //! Reduction of the elements behind the last segment head or of all elements, if there is none.
+                TRed value;
+            };
+
+            /**
+             * Combines the summaries of two consecutive chunks. The reduction of the second chunk continues the
+             * reduction of the first chunk, if the second chunk has no segment head. The operation is associative,
+             * if the reduce function is associative, therefore it can be scanned.
+             * @tparam TReduceOperator The vikunja::operators type of the reduce function.
+             * @tparam TReduceFunc Type of the reduce function.
+             */
+            template<typename TReduceOperator, typename TReduceFunc>
+            struct SegmentedCombine
+            {
+                TReduceFunc reduceFunc;
+
+                template<typename TAcc, typename TSummary>
+                ALPAKA_FN_HOST_ACC TSummary operator()(TAcc const& acc, TSummary const& a, TSummary const& b) const
+                {
+                    TSummary result;
+                    result.heads = a.heads + b.heads;
+                    result.hasHead = a.hasHead || b.hasHead;
+                    result.value = b.hasHead ? b.value : TReduceOperator::run(acc, reduceFunc, a.value, b.value);
+                    return result;
+                }
+            };
+
+            /**
+             * Equality of two values, which can be used in kernels.
+             * @tparam T Type of the values.
+             */
+            template<typename T>
+            struct EqualTo
+            {
+                constexpr ALPAKA_FN_HOST_ACC bool operator()(T const& a, T const& b) const
+                {
+                    return a == b;
+                }
+            };
+
+            /**
+             * Returns true, if the element i is the first element of a segment of equal keys.
+             * @tparam TEqualOperator The vikunja::operators type of the equality predicate.
+             */
+            template<typename TEqualOperator, typename TAcc, typename TIdx, typename TKeyIterator, typename TEqual>
+            ALPAKA_FN_HOST_ACC ALPAKA_FN_INLINE bool isSegmentHead(
+                TAcc const& acc,
+                TKeyIterator const& keys,
+                TIdx const i,
+                TEqual const& equal)
+            {
+                return i == 0 || !TEqualOperator::run(acc, equal, keys[i - 1], keys[i]);
+            }
+
+            /**
+             * First phase of the reduce by key: each thread summarizes its chunk of the input. The chunk of each
+             * thread must contain at least one element.
+             * @tparam TBlockSize The block size of this kernel.
+             * @tparam TRed The type of the reduction.
+             * @tparam TReduceOperator The vikunja::operators type of the reduce function.
+             * @tparam TEqualOperator The vikunja::operators type of the key equality predicate.
+             */
+            template<uint64_t TBlockSize, typename TRed, typename TReduceOperator, typename TEqualOperator>
+            struct ChunkKeySummaryKernel
+            {
+                /**
+                 * @param acc The alpaka accelerator.
+                 * @param keys The input keys.
+                 * @param values The input values.
+                 * @param summaries The output iterator with one summary per thread of the grid.
+                 * @param n The number of elements.
+                 * @param reduceFunc The reduce function.
+                 * @param equal The key equality predicate.
+                 */
+                template<
+                    typename TAcc,
+                    typename TIdx,
+                    typename TKeyIterator,
+                    typename TValueIterator,
+                    typename TSummaryIterator,
+                    typename TReduceFunc,
+                    typename TEqual>
+                ALPAKA_FN_ACC void operator()(
+                    TAcc const& acc,
+                    TKeyIterator const& keys,
+                    TValueIterator const& values,
+                    TSummaryIterator const& summaries,
+                    TIdx const& n,
+                    TReduceFunc const& reduceFunc,
+                    TEqual const& equal) const
+                {
+                    constexpr TIdx xIndex = alpaka::Dim<TAcc>::value - 1u;
+                    auto const globalThreadIndex = alpaka::getIdx<alpaka::Grid, alpaka::Threads>(acc)[xIndex];
+
+                    KeySegmentSummary<TIdx, TRed> summary{0, false, TRed{}};
+                    bool first = true;
+                    using MemIndex = vikunja::MemAccess::BlockStrategy<vikunja::scan::detail::ChunkPolicy, TAcc, TIdx>;
+                    for(MemIndex iter(acc, n, TBlockSize), end = iter.end(); iter < end; ++iter)
+                    {
+                        if(isSegmentHead<TEqualOperator>(acc, keys, *iter, equal))
+                        {
+                            ++summary.heads;
+                            summary.hasHead = true;
+                            summary.value = values[*iter];
+                        }
+                        else if(first)
+                        {
+                            summary.value = values[*iter];
+                        }
+                        else
+                        {
+                            summary.value = TReduceOperator::run(acc, reduceFunc, summary.value, values[*iter]);
+                        }
+                        first = false;
+                    }
+                    summaries[globalThreadIndex] = summary;
+                }
+            };
+
+            /**
+             * Last phase of the reduce by key: each thread reduces the segments of its chunk. The reduction of a
+             * segment is written by the thread, which finds the head of the next segment, and the reduction of the
+             * last segment by the last thread of the grid. The last thread also writes the number of segments.
+             * @tparam TBlockSize The block size of this kernel.
+             * @tparam TRed The type of the reduction.
+             * @tparam TReduceOperator The vikunja::operators type of the reduce function.
+             * @tparam TEqualOperator The vikunja::operators type of the key equality predicate.
+             */
+            template<uint64_t TBlockSize, typename TRed, typename TReduceOperator, typename TEqualOperator>
+            struct ChunkReduceByKeyKernel
+            {
+                /**
+                 * @param acc The alpaka accelerator.
+                 * @param keys The input keys.
+                 * @param values The input values.
+                 * @param keysOut The key of each segment.
+                 * @param valuesOut The reduction of each segment.
+                 * @param chunkPrefixes The exclusive scan of the chunk summaries. The value of the first chunk is not
+                 * used.
+                 * @param count Output iterator for the number of segments.
+                 * @param n The number of elements.
+                 * @param reduceFunc The reduce function.
+                 * @param equal The key equality predicate.
+                 */
+                template<
+                    typename TAcc,
+                    typename TIdx,
+                    typename TKeyIterator,
+                    typename TValueIterator,
+                    typename TKeyOutputIterator,
+                    typename TValueOutputIterator,
+                    typename TPrefixIterator,
+                    typename TCountIterator,
+                    typename TReduceFunc,
+                    typename TEqual>
+                ALPAKA_FN_ACC void operator()(
+                    TAcc const& acc,
+                    TKeyIterator const& keys,
+                    TValueIterator const& values,
+                    TKeyOutputIterator const& keysOut,
+                    TValueOutputIterator const& valuesOut,
+                    TPrefixIterator const& chunkPrefixes,
+                    TCountIterator const& count,
+                    TIdx const& n,
+                    TReduceFunc const& reduceFunc,
+                    TEqual const& equal) const
+                {
+                    constexpr TIdx xIndex = alpaka::Dim<TAcc>::value - 1u;
+                    auto const globalThreadIndex = alpaka::getIdx<alpaka::Grid, alpaka::Threads>(acc)[xIndex];
+                    auto const globalThreadCount = alpaka::getWorkDiv<alpaka::Grid, alpaka::Threads>(acc)[xIndex];
+
+                    // the segment, which is open at the begin of the chunk
+                    TIdx heads = 0;
+                    TRed value{};
+                    if(globalThreadIndex != 0)
+                    {
+                        heads = chunkPrefixes[globalThreadIndex].heads;
+                        value = chunkPrefixes[globalThreadIndex].value;
+                    }
+
+                    using MemIndex = vikunja::MemAccess::BlockStrategy<vikunja::scan::detail::ChunkPolicy, TAcc, TIdx>;
+                    for(MemIndex iter(acc, n, TBlockSize), end = iter.end(); iter < end; ++iter)
+                    {
+                        if(isSegmentHead<TEqualOperator>(acc, keys, *iter, equal))
+                        {
+                            if(heads > 0)
+                            {
+                                valuesOut[heads - 1] = value;
+                            }
+                            keysOut[heads] = keys[*iter];
+                            ++heads;
+                            value = values[*iter];
+                        }
+                        else
+                        {
+                            value = TReduceOperator::run(acc, reduceFunc, value, values[*iter]);
+                        }
+                    }
+
+                    if(globalThreadIndex == globalThreadCount - 1)
+                    {
+                        valuesOut[heads - 1] = value;
+                        *count = heads;
+                    }
+                }
+            };
+        } // namespace detail
+    } // namespace reduce
+} // namespace vikunja
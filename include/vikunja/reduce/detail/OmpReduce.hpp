@@ -0,0 +1,123 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/access/BlockStrategy.hpp>
+#include <vikunja/affinity/Affinity.hpp>
+#include <vikunja/operators/operators.hpp>
+#include <vikunja/workdiv/BlockBasedWorkDiv.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+#ifdef _OPENMP
+#    include <omp.h>
+#endif
+
+namespace vikunja
+{
+    namespace reduce
+    {
+        namespace detail
+        {
+            /**
+             * True, if the transform reduce can be executed by ompTransformReduce(). This requires an OpenMP
+             * accelerator, the default work division and memory access policies, an associative reduce functor and
+             * functors without the TAcc argument, because there is no accelerator object outside of a kernel. Policies
+             * passed by the caller, e.g. by the autotuner, are always executed by the kernels.
+             * @tparam TAcc The alpaka accelerator type.
+             * @tparam WorkDivPolicy The working division policy of the call.
+             * @tparam MemAccessPolicy The memory access policy of the call.
+             * @tparam TTransformFunc Type of the transform functor.
+             * @tparam TReduceFunc Type of the reduce functor.
+             * @tparam TData Type of the input elements.
+             * @tparam TRed Type of the result of the transform functor.
+             */
+            template<
+                typename TAcc,
+                typename WorkDivPolicy,
+                typename MemAccessPolicy,
+                typename TTransformFunc,
+                typename TReduceFunc,
+                typename TData,
+                typename TRed>
+            inline constexpr bool useOmpReduce = vikunja::affinity::traits::IsOmpAcc<TAcc>::value
+                && std::is_same_v<WorkDivPolicy, vikunja::workdiv::BlockBasedPolicy<TAcc>>
+                && std::is_same_v<MemAccessPolicy, vikunja::MemAccess::MemAccessPolicy<TAcc>>
+                && vikunja::operators::isAssociative<TReduceFunc> && std::is_invocable_v<TTransformFunc, TData>
+                && std::is_invocable_v<TReduceFunc, TRed, TRed>;
+
+#ifdef _OPENMP
+            /**
+             * Transform reduce via an OpenMP parallel region instead of the two kernel block tree reduction. Each
+             * OpenMP thread reduces a contiguous chunk of the input. The partial results are combined in the order of
+             * the chunks.
+             * The algorithms do not know the neutral element of the reduce functor, therefore the reduction clause of
+             * OpenMP cannot be used.
+             * @tparam TRed The type of the reduction.
+             * @param n The size of the input iterator. Must be greater than 0.
+             * @param source The input iterator.
+             * @param transformFunc The transform operator.
+             * @param reduceFunc The reduce operator.
+             * @return Value of the combined transform/reduce operation.
+             */
+            template<
+                typename TRed,
+                typename TIdx,
+                typename TInputIterator,
+                typename TTransformFunc,
+                typename TReduceFunc>
+            auto ompTransformReduce(
+                TIdx const& n,
+                TInputIterator const& source,
+                TTransformFunc const& transformFunc,
+                TReduceFunc const& reduceFunc) -> TRed
+            {
+                std::vector<std::optional<TRed>> partialResults(static_cast<std::size_t>(omp_get_max_threads()));
+
+#    pragma omp parallel
+                {
+                    auto const numThreads = static_cast<TIdx>(omp_get_num_threads());
+                    auto const threadIndex = static_cast<TIdx>(omp_get_thread_num());
+                    vikunja::affinity::pinOmpThread();
+                    // distribute the remainder to the first threads, without overflow of n * threadIndex
+                    TIdx const chunkSize = n / numThreads;
+                    TIdx const remainder = n % numThreads;
+                    TIdx const begin = chunkSize * threadIndex + (threadIndex < remainder ? threadIndex : remainder);
+                    TIdx const end = begin + chunkSize + (threadIndex < remainder ? 1 : 0);
+
+                    if(begin < end)
+                    {
+                        TRed tSum = transformFunc(source[begin]);
+                        for(TIdx i = begin + 1; i < end; ++i)
+                        {
+                            tSum = reduceFunc(tSum, transformFunc(source[i]));
+                        }
+                        partialResults[static_cast<std::size_t>(threadIndex)] = tSum;
+                    }
+                }
+
+                std::optional<TRed> result;
+                for(auto const& partialResult : partialResults)
+                {
+                    if(partialResult)
+                    {
+                        result = result ? reduceFunc(*result, *partialResult) : *partialResult;
+                    }
+                }
+                return *result;
+            }
+#endif
+        } // namespace detail
+    } // namespace reduce
+} // namespace vikunja
@@ -0,0 +1,89 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/threadpool/ThreadPool.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+#include <iterator>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace vikunja
+{
+    namespace reduce
+    {
+        namespace detail
+        {
+            /**
+             * Transform reduce on the host thread pool. Each thread of the pool reduces one linear chunk of the input.
+             * The partial results are combined in the order of the chunks.
+             * @tparam TAcc The alpaka accelerator type. The accelerator needs to use host memory.
+             * @tparam TRed The type of the reduction.
+             * @param n The size of the input iterator. Must be greater than 0.
+             * @param source The input iterator.
+             * @param transformFunc The transform operator. Must not take the acc argument.
+             * @param reduceFunc The reduce operator. Must not take the acc argument.
+             * @return Value of the combined transform/reduce operation.
+             */
+            template<
+                typename TAcc,
+                typename TRed,
+                typename TIdx,
+                typename TInputIterator,
+                typename TTransformFunc,
+                typename TReduceFunc>
+            auto threadPoolTransformReduce(
+                TIdx const& n,
+                TInputIterator const& source,
+                TTransformFunc const& transformFunc,
+                TReduceFunc const& reduceFunc) -> TRed
+            {
+                static_assert(
+                    std::is_same_v<alpaka::Pltf<alpaka::Dev<TAcc>>, alpaka::PltfCpu>,
+                    "The host thread pool requires an accelerator with host memory.");
+                static_assert(
+                    std::is_invocable_v<TTransformFunc, typename std::iterator_traits<TInputIterator>::value_type>
+                        && std::is_invocable_v<TReduceFunc, TRed, TRed>,
+                    "The host thread pool requires functors without the acc argument.");
+
+                auto& pool = vikunja::threadpool::ThreadPool::instance();
+                std::vector<std::optional<TRed>> partialResults(pool.size());
+
+                pool.run(
+                    [&](std::size_t const taskIndex, std::size_t const numTasks)
+                    {
+                        auto const chunk = vikunja::threadpool::ThreadPool::getChunk(n, taskIndex, numTasks);
+                        if(chunk.first < chunk.second)
+                        {
+                            TRed tSum = transformFunc(source[chunk.first]);
+                            for(TIdx i = chunk.first + 1; i < chunk.second; ++i)
+                            {
+                                tSum = reduceFunc(tSum, transformFunc(source[i]));
+                            }
+                            partialResults[taskIndex] = tSum;
+                        }
+                    });
+
+                std::optional<TRed> result;
+                for(auto const& partialResult : partialResults)
+                {
+                    if(partialResult)
+                    {
+                        result = result ? reduceFunc(*result, *partialResult) : *partialResult;
+                    }
+                }
+                return *result;
+            }
+        } // namespace detail
+    } // namespace reduce
+} // namespace vikunja
@@ -10,9 +10,12 @@
 #pragma once
 
 #include <vikunja/access/BlockStrategy.hpp>
+#include <vikunja/affinity/Affinity.hpp>
 #include <vikunja/operators/operators.hpp>
 #include <vikunja/reduce/detail/BlockThreadReduceKernel.hpp>
+#include <vikunja/reduce/detail/OmpReduce.hpp>
 #include <vikunja/reduce/detail/SmallProblemReduceKernel.hpp>
+#include <vikunja/reduce/detail/ThreadPoolReduce.hpp>
 #include <vikunja/workdiv/BlockBasedWorkDiv.hpp>
 
 #include <alpaka/alpaka.hpp>
@@ -55,6 +58,145 @@ namespace vikunja
                     return arg;
                 }
             };
+
+            /**
+             * Functor, which returns a constant value for any argument. It can be used to fill an output with the
+             * transform.
+             * @tparam T Type of the value.
+             */
+            template<typename T>
+            struct Fill
+            {
+                T value;
+
+                template<typename TInput>
+                constexpr ALPAKA_FN_HOST_ACC T operator()(TInput const&) const
+                {
+                    return value;
+                }
+            };
+
+            /**
+             * Executes the kernels of the transform reduce and keeps the result on the device. The result is the
+             * first element of the returned buffer, when the queue has finished the enqueued kernels. The buffer is
+             * returned to keep it alive until then.
+             * @see vikunja::reduce::deviceTransformReduce
+             * @param devAcc The alpaka accelerator.
+             * @param queue The alpaka queue.
+             * @param n The number of input elements. Must be greater than 0.
+             * @param buffer The input iterator.
+             * @param transformFunc The transform operator.
+             * @param reduceFunc The reduce operator.
+             * @return Device buffer, which holds the result in its first element.
+             */
+            template<
+                typename TAcc,
+                typename WorkDivPolicy,
+                typename MemAccessPolicy,
+                typename TTransformOperator,
+                typename TReduceOperator,
+                typename TRed,
+                typename TDevAcc,
+                typename TQueue,
+                typename TIdx,
+                typename TInputIterator,
+                typename TTransformFunc,
+                typename TReduceFunc>
+            auto transformReduceToDevice(
+                TDevAcc& devAcc,
+                TQueue& queue,
+                TIdx const& n,
+                TInputIterator const& buffer,
+                TTransformFunc const& transformFunc,
+                TReduceFunc const& reduceFunc)
+            {
+                vikunja::affinity::applyAffinity<TAcc>();
+                constexpr uint64_t blockSize = WorkDivPolicy::template getBlockSize<TAcc>();
+                using Dim = alpaka::Dim<TAcc>;
+                using WorkDiv = alpaka::WorkDivMembers<Dim, TIdx>;
+                using Vec = alpaka::Vec<Dim, TIdx>;
+                constexpr TIdx xIndex = Dim::value - 1u;
+
+                Vec elementsPerThread(Vec::all(static_cast<TIdx>(1u)));
+                Vec threadsPerBlock(Vec::all(static_cast<TIdx>(1u)));
+                Vec blocksPerGrid(Vec::all(static_cast<TIdx>(1u)));
+
+                // in case n < blockSize, the block reductions only work
+                // if the MemAccessPolicy maps the correct values.
+                if(n < blockSize)
+                {
+                    Vec const resultBufferExtent(Vec::all(static_cast<TIdx>(1u)));
+                    auto resultBuffer = alpaka::allocBuf<TRed, TIdx>(devAcc, resultBufferExtent);
+                    WorkDiv dummyWorkDiv{blocksPerGrid, threadsPerBlock, elementsPerThread};
+                    SmallProblemReduceKernel<TTransformOperator, TReduceOperator> kernel;
+                    alpaka::exec<TAcc>(
+                        queue,
+                        dummyWorkDiv,
+                        kernel,
+                        buffer,
+                        alpaka::getPtrNative(resultBuffer),
+                        n,
+                        transformFunc,
+                        reduceFunc);
+                    return resultBuffer;
+                }
+
+
+                TIdx gridSize = WorkDivPolicy::template getGridSize<TAcc>(devAcc);
+
+                TIdx maxGridSize = static_cast<TIdx>((((n + 1) / 2) - 1) / static_cast<TIdx>(blockSize) + 1);
+                if(gridSize > maxGridSize)
+                {
+                    gridSize = maxGridSize;
+                }
+
+                TIdx workDivGridSize = gridSize;
+                TIdx workDivBlockSize = blockSize;
+
+                blocksPerGrid[xIndex] = workDivGridSize;
+                threadsPerBlock[xIndex] = workDivBlockSize;
+
+                Vec const singleElementsPerThread(Vec::all(static_cast<TIdx>(1u)));
+                Vec singleThreadsPerBlock(Vec::all(static_cast<TIdx>(1u)));
+                Vec const singleBlocksPerGrid(Vec::all(static_cast<TIdx>(1u)));
+                singleThreadsPerBlock[xIndex] = workDivBlockSize;
+
+                Vec sharedMemExtent(Vec::all(static_cast<TIdx>(1u)));
+                sharedMemExtent[xIndex] = gridSize;
+
+                WorkDiv multiBlockWorkDiv{blocksPerGrid, threadsPerBlock, elementsPerThread};
+                WorkDiv singleBlockWorkDiv{singleBlocksPerGrid, singleThreadsPerBlock, singleElementsPerThread};
+
+                auto secondPhaseBuffer = alpaka::allocBuf<TRed, TIdx>(devAcc, sharedMemExtent);
+
+                BlockThreadReduceKernel<blockSize, MemAccessPolicy, TRed, TTransformOperator, TReduceOperator>
+                    multiBlockKernel;
+
+                using TIdentityTransformOperator
+                    = vikunja::operators::UnaryOp<TAcc, Identity<TRed>, typename TTransformOperator::TRed>;
+                BlockThreadReduceKernel<blockSize, MemAccessPolicy, TRed, TIdentityTransformOperator, TReduceOperator>
+                    singleBlockKernel;
+                // execute kernels
+                alpaka::exec<TAcc>(
+                    queue,
+                    multiBlockWorkDiv,
+                    multiBlockKernel,
+                    buffer,
+                    alpaka::getPtrNative(secondPhaseBuffer),
+                    n,
+                    transformFunc,
+                    reduceFunc);
+                alpaka::exec<TAcc>(
+                    queue,
+                    singleBlockWorkDiv,
+                    singleBlockKernel,
+                    alpaka::getPtrNative(secondPhaseBuffer),
+                    alpaka::getPtrNative(secondPhaseBuffer),
+                    gridSize,
+                    Identity<TRed>(),
+                    reduceFunc);
+                return secondPhaseBuffer;
+            }
         } // namespace detail
 
         /**
@@ -117,103 +259,48 @@ namespace vikunja
             {
                 //            return static_cast<TRed>(0);
             }
-            constexpr uint64_t blockSize = WorkDivPolicy::template getBlockSize<TAcc>();
-            using Dim = alpaka::Dim<TAcc>;
-            using WorkDiv = alpaka::WorkDivMembers<Dim, TIdx>;
-            using Vec = alpaka::Vec<Dim, TIdx>;
-            constexpr TIdx xIndex = Dim::value - 1u;
-
-            Vec elementsPerThread(Vec::all(static_cast<TIdx>(1u)));
-            Vec threadsPerBlock(Vec::all(static_cast<TIdx>(1u)));
-            Vec blocksPerGrid(Vec::all(static_cast<TIdx>(1u)));
-
-            Vec const resultBufferExtent(Vec::all(static_cast<TIdx>(1u)));
-            auto resultBuffer = alpaka::allocBuf<TRed, TIdx>(devAcc, resultBufferExtent);
-
-            // in case n < blockSize, the block reductions only work
-            // if the MemAccessPolicy maps the correct values.
-            if(n < blockSize)
+            if constexpr(vikunja::workdiv::isHostThreadPoolPolicy<WorkDivPolicy>)
             {
-                auto resultBuffer = alpaka::allocBuf<TRed, TIdx>(devAcc, resultBufferExtent);
-                WorkDiv dummyWorkDiv{blocksPerGrid, threadsPerBlock, elementsPerThread};
-                detail::SmallProblemReduceKernel<TTransformOperator, TReduceOperator> kernel;
-                alpaka::exec<TAcc>(
-                    queue,
-                    dummyWorkDiv,
-                    kernel,
-                    buffer,
-                    alpaka::getPtrNative(resultBuffer),
-                    n,
-                    transformFunc,
-                    reduceFunc);
-                auto resultView = alpaka::allocBuf<TRed, TIdx>(devHost, resultBufferExtent);
-                // TRed result;
-                // alpaka::ViewPlainPtr<TDevHost, TRed, Dim, TIdx> resultView{&result, devHost,
-                // static_cast<TIdx>(1u)};
-                alpaka::memcpy(queue, resultView, resultBuffer, resultBufferExtent);
-                alpaka::wait(queue);
-                auto result = alpaka::getPtrNative(resultView);
-                return result[0];
+                if(n > 0)
+                {
+                    // previous tasks in the queue can write to the input
+                    alpaka::wait(queue);
+                    return detail::threadPoolTransformReduce<TAcc, TRed>(n, buffer, transformFunc, reduceFunc);
+                }
             }
-
-
-            TIdx gridSize = WorkDivPolicy::template getGridSize<TAcc>(devAcc);
-
-            TIdx maxGridSize = static_cast<TIdx>((((n + 1) / 2) - 1) / static_cast<TIdx>(blockSize) + 1);
-            if(gridSize > maxGridSize)
+#ifdef _OPENMP
+            // On the OpenMP backends, an associative reduction with the default policies is executed directly in an
+            // OpenMP parallel region, which avoids the second kernel, the helper memory and the block barriers.
+            if constexpr(detail::useOmpReduce<
+                             TAcc,
+                             WorkDivPolicy,
+                             MemAccessPolicy,
+                             TTransformFunc,
+                             TReduceFunc,
+                             typename std::iterator_traits<TInputIterator>::value_type,
+                             typename TTransformOperator::TRed>)
             {
-                gridSize = maxGridSize;
+                if(n > 0)
+                {
+                    // previous tasks in the queue can write to the input
+                    alpaka::wait(queue);
+                    return detail::ompTransformReduce<TRed>(n, buffer, transformFunc, reduceFunc);
+                }
             }
+#endif
+            auto const resultBuffer = detail::transformReduceToDevice<
+                TAcc,
+                WorkDivPolicy,
+                MemAccessPolicy,
+                TTransformOperator,
+                TReduceOperator,
+                TRed>(devAcc, queue, n, buffer, transformFunc, reduceFunc);
 
-            TIdx workDivGridSize = gridSize;
-            TIdx workDivBlockSize = blockSize;
-
-            blocksPerGrid[xIndex] = workDivGridSize;
-            threadsPerBlock[xIndex] = workDivBlockSize;
-
-            Vec const singleElementsPerThread(Vec::all(static_cast<TIdx>(1u)));
-            Vec singleThreadsPerBlock(Vec::all(static_cast<TIdx>(1u)));
-            Vec const singleBlocksPerGrid(Vec::all(static_cast<TIdx>(1u)));
-            singleThreadsPerBlock[xIndex] = workDivBlockSize;
-
-            Vec sharedMemExtent(Vec::all(static_cast<TIdx>(1u)));
-            sharedMemExtent[xIndex] = gridSize;
-
-            WorkDiv multiBlockWorkDiv{blocksPerGrid, threadsPerBlock, elementsPerThread};
-            WorkDiv singleBlockWorkDiv{singleBlocksPerGrid, singleThreadsPerBlock, singleElementsPerThread};
-
-            auto secondPhaseBuffer = alpaka::allocBuf<TRed, TIdx>(devAcc, sharedMemExtent);
-
-            detail::BlockThreadReduceKernel<blockSize, MemAccessPolicy, TRed, TTransformOperator, TReduceOperator>
-                multiBlockKernel;
-
-            using TIdentityTransformOperator
-                = vikunja::operators::UnaryOp<TAcc, detail::Identity<TRed>, typename TTransformOperator::TRed>;
-            detail::
-                BlockThreadReduceKernel<blockSize, MemAccessPolicy, TRed, TIdentityTransformOperator, TReduceOperator>
-                    singleBlockKernel;
-            // execute kernels
-            alpaka::exec<TAcc>(
-                queue,
-                multiBlockWorkDiv,
-                multiBlockKernel,
-                buffer,
-                alpaka::getPtrNative(secondPhaseBuffer),
-                n,
-                transformFunc,
-                reduceFunc);
-            alpaka::exec<TAcc>(
-                queue,
-                singleBlockWorkDiv,
-                singleBlockKernel,
-                alpaka::getPtrNative(secondPhaseBuffer),
-                alpaka::getPtrNative(secondPhaseBuffer),
-                gridSize,
-                detail::Identity<TRed>(),
-                reduceFunc);
-
+            using Dim = alpaka::Dim<TAcc>;
+            using Vec = alpaka::Vec<Dim, TIdx>;
+            Vec const resultBufferExtent(Vec::all(static_cast<TIdx>(1u)));
             auto resultView = alpaka::allocBuf<TRed, TIdx>(devHost, resultBufferExtent);
-            alpaka::memcpy(queue, resultView, secondPhaseBuffer, resultBufferExtent);
+            alpaka::memcpy(queue, resultView, resultBuffer, resultBufferExtent);
 
             // wait for result, otherwise the async CPU queue causes a segfault
             alpaka::wait(queue);
@@ -275,7 +362,14 @@ namespace vikunja
         {
             assert(bufferEnd >= bufferBegin);
             auto size = static_cast<typename alpaka::trait::IdxType<TAcc>::type>(bufferEnd - bufferBegin);
-            return deviceTransformReduce<TAcc>(devAcc, devHost, queue, size, bufferBegin, transformFunc, reduceFunc);
+            return deviceTransformReduce<TAcc, WorkDivPolicy, MemAccessPolicy>(
+                devAcc,
+                devHost,
+                queue,
+                size,
+                bufferBegin,
+                transformFunc,
+                reduceFunc);
         }
 
         /**
@@ -385,7 +479,7 @@ namespace vikunja
         {
             assert(bufferEnd >= bufferBegin);
             auto size = static_cast<typename alpaka::trait::IdxType<TAcc>::type>(bufferEnd - bufferBegin);
-            return deviceReduce<TAcc>(devAcc, devHost, queue, size, bufferBegin, func);
+            return deviceReduce<TAcc, WorkDivPolicy, MemAccessPolicy>(devAcc, devHost, queue, size, bufferBegin, func);
         }
     } // namespace reduce
 } // namespace vikunja
@@ -0,0 +1,289 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/affinity/Affinity.hpp>
+#include <vikunja/operators/operators.hpp>
+#include <vikunja/reduce/detail/BlockThreadReduceByKeyKernel.hpp>
+#include <vikunja/scan/detail/BlockThreadScanKernel.hpp>
+#include <vikunja/workdiv/BlockBasedWorkDiv.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+#include <cassert>
+#include <iterator>
+#include <type_traits>
+
+namespace vikunja
+{
+    namespace reduce
+    {
+        namespace detail
+        {
+            /**
+             * Implementation of the reduce by key. Each thread of the grid owns a contiguous chunk of the input.
+             * The first kernel summarizes each chunk by its number of segment heads and the reduction of its last
+             * segment, the second kernel scans the summaries in a single block with a segmented combine and the
+             * third kernel reduces the segments of each chunk and writes the results. Only the number of segments
+             * is copied to the host.
+             * @tparam TEqualOperator The vikunja::operators type of the key equality predicate.
+             * @return The number of segments.
+             */
+            template<
+                typename TAcc,
+                typename WorkDivPolicy,
+                typename TRed,
+                typename TReduceOperator,
+                typename TEqualOperator,
+                typename TDevAcc,
+                typename TDevHost,
+                typename TQueue,
+                typename TIdx,
+                typename TKeyIterator,
+                typename TValueIterator,
+                typename TKeyOutputIterator,
+                typename TValueOutputIterator,
+                typename TFunc,
+                typename TEqual>
+            auto reduceByKeyImpl(
+                TDevAcc& devAcc,
+                TDevHost& devHost,
+                TQueue& queue,
+                TIdx const& n,
+                TKeyIterator const& keys,
+                TValueIterator const& values,
+                TKeyOutputIterator const& keysOut,
+                TValueOutputIterator const& valuesOut,
+                TFunc const& func,
+                TEqual const& equal) -> TIdx
+            {
+                if(n == 0)
+                {
+                    return 0;
+                }
+                vikunja::affinity::applyAffinity<TAcc>();
+                constexpr uint64_t blockSize = WorkDivPolicy::template getBlockSize<TAcc>();
+                using Dim = alpaka::Dim<TAcc>;
+                using WorkDiv = alpaka::WorkDivMembers<Dim, TIdx>;
+                using Vec = alpaka::Vec<Dim, TIdx>;
+                using Summary = KeySegmentSummary<TIdx, TRed>;
+                constexpr TIdx xIndex = Dim::value - 1u;
+
+                Vec const elementsPerThread(Vec::all(static_cast<TIdx>(1u)));
+                Vec threadsPerBlock(Vec::all(static_cast<TIdx>(1u)));
+                Vec blocksPerGrid(Vec::all(static_cast<TIdx>(1u)));
+
+                Vec const countExtent(Vec::all(static_cast<TIdx>(1u)));
+                auto countBuffer = alpaka::allocBuf<TIdx, TIdx>(devAcc, countExtent);
+                auto countView = alpaka::allocBuf<TIdx, TIdx>(devHost, countExtent);
+
+                if(n < static_cast<TIdx>(blockSize))
+                {
+                    // the small problem is reduced by a single thread
+                    WorkDiv const singleThreadWorkDiv{blocksPerGrid, threadsPerBlock, elementsPerThread};
+                    ChunkReduceByKeyKernel<1u, TRed, TReduceOperator, TEqualOperator> kernel;
+                    alpaka::exec<TAcc>(
+                        queue,
+                        singleThreadWorkDiv,
+                        kernel,
+                        keys,
+                        values,
+                        keysOut,
+                        valuesOut,
+                        static_cast<Summary*>(nullptr),
+                        alpaka::getPtrNative(countBuffer),
+                        n,
+                        func,
+                        equal);
+                    alpaka::memcpy(queue, countView, countBuffer, countExtent);
+                    alpaka::wait(queue);
+                    return alpaka::getPtrNative(countView)[0];
+                }
+
+                // each chunk needs at least one element
+                TIdx gridSize = WorkDivPolicy::template getGridSize<TAcc>(devAcc);
+                TIdx const maxGridSize = n / static_cast<TIdx>(blockSize);
+                if(gridSize > maxGridSize)
+                {
+                    gridSize = maxGridSize;
+                }
+                TIdx const numChunks = gridSize * static_cast<TIdx>(blockSize);
+
+                blocksPerGrid[xIndex] = gridSize;
+                threadsPerBlock[xIndex] = static_cast<TIdx>(blockSize);
+                Vec const singleBlocksPerGrid(Vec::all(static_cast<TIdx>(1u)));
+
+                WorkDiv const multiBlockWorkDiv{blocksPerGrid, threadsPerBlock, elementsPerThread};
+                WorkDiv const singleBlockWorkDiv{singleBlocksPerGrid, threadsPerBlock, elementsPerThread};
+
+                Vec summariesExtent(Vec::all(static_cast<TIdx>(1u)));
+                summariesExtent[xIndex] = numChunks;
+                auto summaries = alpaka::allocBuf<Summary, TIdx>(devAcc, summariesExtent);
+
+                using Combine = SegmentedCombine<TReduceOperator, TFunc>;
+                using CombineOperator = vikunja::operators::BinaryOp<TAcc, Combine, Summary, Summary>;
+                ChunkKeySummaryKernel<blockSize, TRed, TReduceOperator, TEqualOperator> summaryKernel;
+                vikunja::scan::detail::ChunkSumScanKernel<blockSize, Summary, CombineOperator> summaryScanKernel;
+                ChunkReduceByKeyKernel<blockSize, TRed, TReduceOperator, TEqualOperator> reduceByKeyKernel;
+
+                alpaka::exec<TAcc>(
+                    queue,
+                    multiBlockWorkDiv,
+                    summaryKernel,
+                    keys,
+                    values,
+                    alpaka::getPtrNative(summaries),
+                    n,
+                    func,
+                    equal);
+                alpaka::exec<TAcc>(
+                    queue,
+                    singleBlockWorkDiv,
+                    summaryScanKernel,
+                    alpaka::getPtrNative(summaries),
+                    numChunks,
+                    Combine{func});
+                alpaka::exec<TAcc>(
+                    queue,
+                    multiBlockWorkDiv,
+                    reduceByKeyKernel,
+                    keys,
+                    values,
+                    keysOut,
+                    valuesOut,
+                    alpaka::getPtrNative(summaries),
+                    alpaka::getPtrNative(countBuffer),
+                    n,
+                    func,
+                    equal);
+                alpaka::memcpy(queue, countView, countBuffer, countExtent);
+                // the helper memory must not be freed before the kernels are finished
+                alpaka::wait(queue);
+                return alpaka::getPtrNative(countView)[0];
+            }
+        } // namespace detail
+
+        /**
+         * Reduces each segment of consecutive equal keys, i.e. if one has the keys [1,1,2,2,2,1], the values
+         * [1,2,3,4,5,6] and the reduce function (x,y) -> x + y, the output keys will contain [1,2,1], the output
+         * values [3,12,6] and 3 is returned. The keys are compared with operator==. The values of a segment are
+         * reduced from left to right, therefore the reduce function must be associative, but not commutative.
+         * All stages run on the device, only the number of segments is copied to the host.
+         * The outputs must be big enough for all segments and must not overlap with the inputs.
+         * @tparam TAcc The alpaka accelerator type to use.
+         * @tparam WorkDivPolicy The working division policy. Defaults to a templated value depending on the
+         * accelerator. Each thread needs a contiguous chunk of the input, therefore the linear memory access policy
+         * is always used.
+         * @tparam TFunc Type of the reduce function.
+         * @tparam TKeyIterator Type of the key iterator. Should be a pointer-like type.
+         * @tparam TValueIterator Type of the value iterator. Should be a pointer-like type.
+         * @tparam TKeyOutputIterator Type of the key output iterator. Should be a pointer-like type.
+         * @tparam TValueOutputIterator Type of the value output iterator. Should be a pointer-like type.
+         * @tparam TDevAcc The type of the alpaka accelerator.
+         * @tparam TDevHost The type of the alpaka host.
+         * @tparam TQueue The type of the alpaka queue.
+         * @tparam TIdx The index type to use.
+         * @tparam TValue The value type of the values.
+         * @tparam TOperator The vikunja::operators type of the reduce function.
+         * @tparam TRed The return type of the reduce function.
+         * @param devAcc The alpaka accelerator.
+         * @param devHost The alpaka host.
+         * @param queue The alpaka queue.
+         * @param n The number of input elements.
+         * @param keys The input keys.
+         * @param values The input values.
+         * @param keysOut The key of each segment.
+         * @param valuesOut The reduction of each segment.
+         * @param func The reduce function.
+         * @return The number of segments.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TFunc,
+            typename TKeyIterator,
+            typename TValueIterator,
+            typename TKeyOutputIterator,
+            typename TValueOutputIterator,
+            typename TDevAcc,
+            typename TDevHost,
+            typename TQueue,
+            typename TIdx,
+            typename TValue = typename std::iterator_traits<TValueIterator>::value_type,
+            typename TOperator = vikunja::operators::BinaryOp<TAcc, TFunc, TValue, TValue>,
+            typename TRed = typename TOperator::TRed>
+        auto deviceReduceByKey(
+            TDevAcc& devAcc,
+            TDevHost& devHost,
+            TQueue& queue,
+            TIdx const& n,
+            TKeyIterator const& keys,
+            TValueIterator const& values,
+            TKeyOutputIterator const& keysOut,
+            TValueOutputIterator const& valuesOut,
+            TFunc const& func) -> TIdx
+        {
+            using TKey = typename std::iterator_traits<TKeyIterator>::value_type;
+            using TReduceOperator = vikunja::operators::BinaryOp<TAcc, TFunc, TRed, TRed>;
+            using TEqualOperator = vikunja::operators::BinaryOp<TAcc, detail::EqualTo<TKey>, TKey, TKey>;
+            return detail::reduceByKeyImpl<TAcc, WorkDivPolicy, TRed, TReduceOperator, TEqualOperator>(
+                devAcc,
+                devHost,
+                queue,
+                n,
+                keys,
+                values,
+                keysOut,
+                valuesOut,
+                func,
+                detail::EqualTo<TKey>());
+        }
+
+        /**
+         * Reduce by key with begin and end iterator of the keys.
+         * @see deviceReduceByKey
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TFunc,
+            typename TKeyIterator,
+            typename TValueIterator,
+            typename TKeyOutputIterator,
+            typename TValueOutputIterator,
+            typename TDevAcc,
+            typename TDevHost,
+            typename TQueue>
+        auto deviceReduceByKey(
+            TDevAcc& devAcc,
+            TDevHost& devHost,
+            TQueue& queue,
+            TKeyIterator const& keysBegin,
+            TKeyIterator const& keysEnd,
+            TValueIterator const& values,
+            TKeyOutputIterator const& keysOut,
+            TValueOutputIterator const& valuesOut,
+            TFunc const& func)
+        {
+            assert(keysEnd >= keysBegin);
+            auto size = static_cast<typename alpaka::trait::IdxType<TAcc>::type>(keysEnd - keysBegin);
+            return deviceReduceByKey<TAcc, WorkDivPolicy>(
+                devAcc,
+                devHost,
+                queue,
+                size,
+                keysBegin,
+                values,
+                keysOut,
+                valuesOut,
+                func);
+        }
+    } // namespace reduce
+} // namespace vikunja
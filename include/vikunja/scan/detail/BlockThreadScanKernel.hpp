@@ -0,0 +1,240 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/access/BlockStrategy.hpp>
+#include <vikunja/reduce/detail/BlockThreadReduceKernel.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+namespace vikunja
+{
+    namespace scan
+    {
+        namespace detail
+        {
+            /**
+             * The scan kernels require, that each thread processes a contiguous chunk of the input and that the
+             * chunks are ordered by the global thread index. Therefore, the linear memory access policy is used on
+             * all platforms.
+             */
+            using ChunkPolicy = vikunja::MemAccess::policies::LinearMemAccessPolicy;
+
+            /**
+             * First phase of the scan: each thread reduces its chunk of the input. The chunk of each thread must
+             * contain at least one element.
+             * @tparam TBlockSize The block size of this kernel.
+             * @tparam TTransformOperator The vikunja::operators type of the transform function.
+             * @tparam TScanOperator The vikunja::operators type of the scan function.
+             */
+            template<uint64_t TBlockSize, typename TTransformOperator, typename TScanOperator>
+            struct ChunkReduceKernel
+            {
+                /**
+                 * @param acc The alpaka accelerator.
+                 * @param source The input iterator.
+                 * @param chunkSums The output iterator with one element per thread of the grid.
+                 * @param n The size of the input iterator.
+                 * @param transformFunc The transform operator.
+                 * @param scanFunc The scan operator.
+                 */
+                template<
+                    typename TAcc,
+                    typename TIdx,
+                    typename TInputIterator,
+                    typename TOutputIterator,
+                    typename TTransformFunc,
+                    typename TScanFunc>
+                ALPAKA_FN_ACC void operator()(
+                    TAcc const& acc,
+                    TInputIterator const& source,
+                    TOutputIterator const& chunkSums,
+                    TIdx const& n,
+                    TTransformFunc const& transformFunc,
+                    TScanFunc const& scanFunc) const
+                {
+                    constexpr TIdx xIndex = alpaka::Dim<TAcc>::value - 1u;
+                    auto const globalThreadIndex = alpaka::getIdx<alpaka::Grid, alpaka::Threads>(acc)[xIndex];
+
+                    using MemIndex = vikunja::MemAccess::BlockStrategy<ChunkPolicy, TAcc, TIdx>;
+                    MemIndex iter(acc, n, TBlockSize);
+                    MemIndex end = iter.end();
+
+                    auto tSum = TTransformOperator::run(acc, transformFunc, source[*iter]);
+                    for(++iter; iter < end; ++iter)
+                    {
+                        tSum = TScanOperator::run(
+                            acc,
+                            scanFunc,
+                            tSum,
+                            TTransformOperator::run(acc, transformFunc, source[*iter]));
+                    }
+                    chunkSums[globalThreadIndex] = tSum;
+                }
+            };
+
+            /**
+             * Second phase of the scan: replaces the chunk sums by their exclusive prefix in place. The kernel is
+             * executed with a single block. The first element has no prefix and stays unchanged.
+             * @tparam TBlockSize The block size of this kernel.
+             * @tparam TRed The type of the chunk sums.
+             * @tparam TScanOperator The vikunja::operators type of the scan function.
+             */
+            template<uint64_t TBlockSize, typename TRed, typename TScanOperator>
+            struct ChunkSumScanKernel
+            {
+                /**
+                 * @param acc The alpaka accelerator.
+                 * @param chunkSums The chunk sums. Must contain at least TBlockSize elements.
+                 * @param numChunks The number of chunk sums.
+                 * @param scanFunc The scan operator.
+                 */
+                template<typename TAcc, typename TIdx, typename TIterator, typename TScanFunc>
+                ALPAKA_FN_ACC void operator()(
+                    TAcc const& acc,
+                    TIterator const& chunkSums,
+                    TIdx const& numChunks,
+                    TScanFunc const& scanFunc) const
+                {
+                    using SharedArray = vikunja::reduce::detail::sharedStaticArray<TRed, TBlockSize>;
+                    auto& sdata(alpaka::declareSharedVar<SharedArray, __COUNTER__>(acc));
+
+                    constexpr TIdx xIndex = alpaka::Dim<TAcc>::value - 1u;
+                    auto const threadIndex = alpaka::getIdx<alpaka::Block, alpaka::Threads>(acc)[xIndex];
+
+                    using MemIndex = vikunja::MemAccess::BlockStrategy<ChunkPolicy, TAcc, TIdx>;
+                    MemIndex iter(acc, numChunks, TBlockSize);
+                    MemIndex const end = iter.end();
+
+                    TRed tSum = chunkSums[*iter];
+                    for(++iter; iter < end; ++iter)
+                    {
+                        tSum = TScanOperator::run(acc, scanFunc, tSum, chunkSums[*iter]);
+                    }
+                    sdata[threadIndex] = tSum;
+
+                    alpaka::syncBlockThreads(acc);
+
+                    // exclusive scan of the thread sums, the number of threads is small
+                    if(threadIndex == 0)
+                    {
+                        TRed running = sdata[0];
+                        for(TIdx i = 1; i < static_cast<TIdx>(TBlockSize); ++i)
+                        {
+                            TRed const value = sdata[i];
+                            sdata[i] = running;
+                            running = TScanOperator::run(acc, scanFunc, running, value);
+                        }
+                    }
+
+                    alpaka::syncBlockThreads(acc);
+
+                    bool hasCarry = threadIndex != 0;
+                    TRed carry = sdata[threadIndex];
+                    for(MemIndex scanIter(acc, numChunks, TBlockSize); scanIter < end; ++scanIter)
+                    {
+                        TRed const value = chunkSums[*scanIter];
+                        if(hasCarry)
+                        {
+                            chunkSums[*scanIter] = carry;
+                            carry = TScanOperator::run(acc, scanFunc, carry, value);
+                        }
+                        else
+                        {
+                            carry = value;
+                            hasCarry = true;
+                        }
+                    }
+                }
+            };
+
+            /**
+             * Last phase of the scan: each thread scans its chunk of the input, starting with the prefix of its
+             * chunk.
+             * @tparam TBlockSize The block size of this kernel.
+             * @tparam TExclusive If true, the i-th output element does not contain the i-th input element.
+             * @tparam TRed The type of the scan.
+             * @tparam TTransformOperator The vikunja::operators type of the transform function.
+             * @tparam TScanOperator The vikunja::operators type of the scan function.
+             */
+            template<
+                uint64_t TBlockSize,
+                bool TExclusive,
+                typename TRed,
+                typename TTransformOperator,
+                typename TScanOperator>
+            struct ChunkScanKernel
+            {
+                /**
+                 * @param acc The alpaka accelerator.
+                 * @param source The input iterator.
+                 * @param destination The output iterator.
+                 * @param chunkPrefixes The exclusive prefix of each chunk. The value of the first chunk is not used.
+                 * @param n The size of the input iterator.
+                 * @param init The initial value of the scan. Only used, if hasInit is true.
+                 * @param hasInit True, if the scan starts with init.
+                 * @param transformFunc The transform operator.
+                 * @param scanFunc The scan operator.
+                 */
+                template<
+                    typename TAcc,
+                    typename TIdx,
+                    typename TInputIterator,
+                    typename TOutputIterator,
+                    typename TPrefixIterator,
+                    typename TTransformFunc,
+                    typename TScanFunc>
+                ALPAKA_FN_ACC void operator()(
+                    TAcc const& acc,
+                    TInputIterator const& source,
+                    TOutputIterator const& destination,
+                    TPrefixIterator const& chunkPrefixes,
+                    TIdx const& n,
+                    TRed const& init,
+                    bool const hasInit,
+                    TTransformFunc const& transformFunc,
+                    TScanFunc const& scanFunc) const
+                {
+                    constexpr TIdx xIndex = alpaka::Dim<TAcc>::value - 1u;
+                    auto const globalThreadIndex = alpaka::getIdx<alpaka::Grid, alpaka::Threads>(acc)[xIndex];
+
+                    bool hasCarry = hasInit;
+                    TRed carry = init;
+                    if(globalThreadIndex != 0)
+                    {
+                        carry = hasInit ? TScanOperator::run(acc, scanFunc, init, chunkPrefixes[globalThreadIndex])
+                                        : chunkPrefixes[globalThreadIndex];
+                        hasCarry = true;
+                    }
+
+                    using MemIndex = vikunja::MemAccess::BlockStrategy<ChunkPolicy, TAcc, TIdx>;
+                    MemIndex iter(acc, n, TBlockSize);
+                    MemIndex const end = iter.end();
+                    for(; iter < end; ++iter)
+                    {
+                        // read the input before the output is written, so that the scan can work in place
+                        TRed const value = TTransformOperator::run(acc, transformFunc, source[*iter]);
+                        if constexpr(TExclusive)
+                        {
+                            destination[*iter] = carry;
+                            carry = TScanOperator::run(acc, scanFunc, carry, value);
+                        }
+                        else
+                        {
+                            carry = hasCarry ? TScanOperator::run(acc, scanFunc, carry, value) : value;
+                            hasCarry = true;
+                            destination[*iter] = carry;
+                        }
+                    }
+                }
+            };
+        } // namespace detail
+    } // namespace scan
+} // namespace vikunja
@@ -0,0 +1,482 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/affinity/Affinity.hpp>
+#include <vikunja/operators/operators.hpp>
+#include <vikunja/reduce/reduce.hpp>
+#include <vikunja/scan/detail/BlockThreadScanKernel.hpp>
+#include <vikunja/workdiv/BlockBasedWorkDiv.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+#include <cassert>
+#include <iterator>
+#include <type_traits>
+
+namespace vikunja
+{
+    namespace scan
+    {
+        namespace detail
+        {
+            /**
+             * Prevents the deduction of a template parameter from a function argument, so that the initial value is
+             * converted to the type of the scan.
+             */
+            template<typename T>
+            struct NonDeduced
+            {
+                using type = T;
+            };
+
+            /**
+             * Reduce-then-scan implementation of all scan variants. The input is split into one contiguous chunk per
+             * thread of the grid. The first kernel reduces each chunk, the second kernel scans the chunk sums in a
+             * single block and the third kernel scans each chunk, starting with the prefix of the chunk. The input
+             * is read twice, but no inter-block synchronization is required, which is not available on all alpaka
+             * accelerators.
+             * @tparam TExclusive If true, an exclusive scan is executed, otherwise an inclusive scan.
+             * @param init The initial value of the scan. Only used, if hasInit is true.
+             * @param hasInit True, if the scan starts with init.
+             */
+            template<
+                typename TAcc,
+                typename WorkDivPolicy,
+                bool TExclusive,
+                typename TTransformOperator,
+                typename TScanOperator,
+                typename TRed,
+                typename TDevAcc,
+                typename TQueue,
+                typename TIdx,
+                typename TInputIterator,
+                typename TOutputIterator,
+                typename TTransformFunc,
+                typename TScanFunc>
+            auto scanImpl(
+                TDevAcc& devAcc,
+                TQueue& queue,
+                TIdx const& n,
+                TInputIterator const& source,
+                TOutputIterator const& destination,
+                TRed const& init,
+                bool const hasInit,
+                TTransformFunc const& transformFunc,
+                TScanFunc const& scanFunc) -> void
+            {
+                if(n == 0)
+                {
+                    return;
+                }
+                vikunja::affinity::applyAffinity<TAcc>();
+                constexpr uint64_t blockSize = WorkDivPolicy::template getBlockSize<TAcc>();
+                using Dim = alpaka::Dim<TAcc>;
+                using WorkDiv = alpaka::WorkDivMembers<Dim, TIdx>;
+                using Vec = alpaka::Vec<Dim, TIdx>;
+                constexpr TIdx xIndex = Dim::value - 1u;
+
+                Vec const elementsPerThread(Vec::all(static_cast<TIdx>(1u)));
+                Vec threadsPerBlock(Vec::all(static_cast<TIdx>(1u)));
+                Vec blocksPerGrid(Vec::all(static_cast<TIdx>(1u)));
+
+                // the small problem is scanned by a single thread
+                if(n < static_cast<TIdx>(blockSize))
+                {
+                    WorkDiv const singleThreadWorkDiv{blocksPerGrid, threadsPerBlock, elementsPerThread};
+                    ChunkScanKernel<1u, TExclusive, TRed, TTransformOperator, TScanOperator> kernel;
+                    alpaka::exec<TAcc>(
+                        queue,
+                        singleThreadWorkDiv,
+                        kernel,
+                        source,
+                        destination,
+                        static_cast<TRed*>(nullptr),
+                        n,
+                        init,
+                        hasInit,
+                        transformFunc,
+                        scanFunc);
+                    alpaka::wait(queue);
+                    return;
+                }
+
+                // each chunk needs at least one element
+                TIdx gridSize = WorkDivPolicy::template getGridSize<TAcc>(devAcc);
+                TIdx const maxGridSize = n / static_cast<TIdx>(blockSize);
+                if(gridSize > maxGridSize)
+                {
+                    gridSize = maxGridSize;
+                }
+                TIdx const numChunks = gridSize * static_cast<TIdx>(blockSize);
+
+                blocksPerGrid[xIndex] = gridSize;
+                threadsPerBlock[xIndex] = static_cast<TIdx>(blockSize);
+                Vec const singleBlocksPerGrid(Vec::all(static_cast<TIdx>(1u)));
+
+                WorkDiv const multiBlockWorkDiv{blocksPerGrid, threadsPerBlock, elementsPerThread};
+                WorkDiv const singleBlockWorkDiv{singleBlocksPerGrid, threadsPerBlock, elementsPerThread};
+
+                Vec chunkSumsExtent(Vec::all(static_cast<TIdx>(1u)));
+                chunkSumsExtent[xIndex] = numChunks;
+                auto chunkSums = alpaka::allocBuf<TRed, TIdx>(devAcc, chunkSumsExtent);
+
+                ChunkReduceKernel<blockSize, TTransformOperator, TScanOperator> chunkReduceKernel;
+                ChunkSumScanKernel<blockSize, TRed, TScanOperator> chunkSumScanKernel;
+                ChunkScanKernel<blockSize, TExclusive, TRed, TTransformOperator, TScanOperator> chunkScanKernel;
+
+                alpaka::exec<TAcc>(
+                    queue,
+                    multiBlockWorkDiv,
+                    chunkReduceKernel,
+                    source,
+                    alpaka::getPtrNative(chunkSums),
+                    n,
+                    transformFunc,
+                    scanFunc);
+                alpaka::exec<TAcc>(
+                    queue,
+                    singleBlockWorkDiv,
+                    chunkSumScanKernel,
+                    alpaka::getPtrNative(chunkSums),
+                    numChunks,
+                    scanFunc);
+                alpaka::exec<TAcc>(
+                    queue,
+                    multiBlockWorkDiv,
+                    chunkScanKernel,
+                    source,
+                    destination,
+                    alpaka::getPtrNative(chunkSums),
+                    n,
+                    init,
+                    hasInit,
+                    transformFunc,
+                    scanFunc);
+
+                // the helper memory must not be freed before the kernels are finished
+                alpaka::wait(queue);
+            }
+        } // namespace detail
+
+        /**
+         * Transforms each element of the input and writes the inclusive scan of the transformed values to the
+         * output, i.e. if one has the array [1,2,3,4], the transform function (x) -> 2 * x and the scan function
+         * (x,y) -> x + y, the output will contain [2,6,12,20].
+         * The scan function must be associative, but it does not need to be commutative. Input and output iterator
+         * can be the same.
+         * @tparam TAcc The alpaka accelerator type to use.
+         * @tparam WorkDivPolicy The working division policy. Defaults to a templated value depending on the
+         * accelerator. The scan always uses the linear memory access policy, because each thread needs a contiguous
+         * chunk of the input.
+         * @tparam TTransformFunc Type of the transform operator.
+         * @tparam TScanFunc Type of the scan operator.
+         * @tparam TInputIterator Type of the input iterator. Should be a pointer-like type.
+         * @tparam TOutputIterator Type of the output iterator. Should be a pointer-like type.
+         * @tparam TDevAcc The type of the alpaka accelerator.
+         * @tparam TQueue The type of the alpaka queue.
+         * @tparam TIdx The index type to use.
+         * @tparam TTransformOperator The vikunja::operators type of the transform function.
+         * @tparam TScanOperator The vikunja::operators type of the scan function.
+         * @tparam TRed The type of the scan.
+         * @param devAcc The alpaka accelerator.
+         * @param queue The alpaka queue. The function waits for the queue, before it returns.
+         * @param n The number of elements in the input.
+         * @param source The input iterator.
+         * @param destination The output iterator.
+         * @param transformFunc The transform operator.
+         * @param scanFunc The scan operator.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TTransformFunc,
+            typename TScanFunc,
+            typename TInputIterator,
+            typename TOutputIterator,
+            typename TDevAcc,
+            typename TQueue,
+            typename TIdx,
+            typename TTransformOperator = vikunja::operators::
+                UnaryOp<TAcc, TTransformFunc, typename std::iterator_traits<TInputIterator>::value_type>,
+            typename TScanOperator = vikunja::operators::
+                BinaryOp<TAcc, TScanFunc, typename TTransformOperator::TRed, typename TTransformOperator::TRed>,
+            typename TRed = typename TScanOperator::TRed>
+        auto deviceTransformInclusiveScan(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            TIdx const& n,
+            TInputIterator const& source,
+            TOutputIterator const& destination,
+            TTransformFunc const& transformFunc,
+            TScanFunc const& scanFunc) -> void
+        {
+            detail::scanImpl<TAcc, WorkDivPolicy, false, TTransformOperator, TScanOperator>(
+                devAcc,
+                queue,
+                n,
+                source,
+                destination,
+                TRed{},
+                false,
+                transformFunc,
+                scanFunc);
+        }
+
+        /**
+         * Transform inclusive scan with begin and end iterator of the input.
+         * @see deviceTransformInclusiveScan
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TTransformFunc,
+            typename TScanFunc,
+            typename TInputIterator,
+            typename TOutputIterator,
+            typename TDevAcc,
+            typename TQueue>
+        auto deviceTransformInclusiveScan(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            TInputIterator const& sourceBegin,
+            TInputIterator const& sourceEnd,
+            TOutputIterator const& destination,
+            TTransformFunc const& transformFunc,
+            TScanFunc const& scanFunc) -> void
+        {
+            assert(sourceEnd >= sourceBegin);
+            auto size = static_cast<typename alpaka::trait::IdxType<TAcc>::type>(sourceEnd - sourceBegin);
+            deviceTransformInclusiveScan<TAcc, WorkDivPolicy>(
+                devAcc,
+                queue,
+                size,
+                sourceBegin,
+                destination,
+                transformFunc,
+                scanFunc);
+        }
+
+        /**
+         * Transforms each element of the input and writes the exclusive scan of the transformed values to the
+         * output, i.e. if one has the array [1,2,3,4], the initial value 10, the transform function (x) -> 2 * x and
+         * the scan function (x,y) -> x + y, the output will contain [10,12,16,22].
+         * The scan function must be associative, but it does not need to be commutative. Input and output iterator
+         * can be the same.
+         * @see deviceTransformInclusiveScan
+         * @param init The initial value of the scan, which is the first output element.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TTransformFunc,
+            typename TScanFunc,
+            typename TInputIterator,
+            typename TOutputIterator,
+            typename TDevAcc,
+            typename TQueue,
+            typename TIdx,
+            typename TTransformOperator = vikunja::operators::
+                UnaryOp<TAcc, TTransformFunc, typename std::iterator_traits<TInputIterator>::value_type>,
+            typename TScanOperator = vikunja::operators::
+                BinaryOp<TAcc, TScanFunc, typename TTransformOperator::TRed, typename TTransformOperator::TRed>,
+            typename TRed = typename TScanOperator::TRed>
+        auto deviceTransformExclusiveScan(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            TIdx const& n,
+            TInputIterator const& source,
+            TOutputIterator const& destination,
+            typename detail::NonDeduced<TRed>::type const& init,
+            TTransformFunc const& transformFunc,
+            TScanFunc const& scanFunc) -> void
+        {
+            detail::scanImpl<TAcc, WorkDivPolicy, true, TTransformOperator, TScanOperator>(
+                devAcc,
+                queue,
+                n,
+                source,
+                destination,
+                init,
+                true,
+                transformFunc,
+                scanFunc);
+        }
+
+        /**
+         * Transform exclusive scan with begin and end iterator of the input.
+         * @see deviceTransformExclusiveScan
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TTransformFunc,
+            typename TScanFunc,
+            typename TInputIterator,
+            typename TOutputIterator,
+            typename TDevAcc,
+            typename TQueue,
+            typename TInit>
+        auto deviceTransformExclusiveScan(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            TInputIterator const& sourceBegin,
+            TInputIterator const& sourceEnd,
+            TOutputIterator const& destination,
+            TInit const& init,
+            TTransformFunc const& transformFunc,
+            TScanFunc const& scanFunc) -> void
+        {
+            assert(sourceEnd >= sourceBegin);
+            auto size = static_cast<typename alpaka::trait::IdxType<TAcc>::type>(sourceEnd - sourceBegin);
+            deviceTransformExclusiveScan<TAcc, WorkDivPolicy>(
+                devAcc,
+                queue,
+                size,
+                sourceBegin,
+                destination,
+                init,
+                transformFunc,
+                scanFunc);
+        }
+
+        /**
+         * Inclusive scan, which works exactly like deviceTransformInclusiveScan with an identity function for the
+         * transform operator, i.e. if one has the array [1,2,3,4] and the scan function (x,y) -> x + y, the output
+         * will contain [1,3,6,10].
+         * @see deviceTransformInclusiveScan
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TFunc,
+            typename TInputIterator,
+            typename TOutputIterator,
+            typename TDevAcc,
+            typename TQueue,
+            typename TIdx,
+            typename TOperator = vikunja::operators::BinaryOp<
+                TAcc,
+                TFunc,
+                typename std::iterator_traits<TInputIterator>::value_type,
+                typename std::iterator_traits<TInputIterator>::value_type>,
+            typename TRed = typename TOperator::TRed>
+        auto deviceInclusiveScan(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            TIdx const& n,
+            TInputIterator const& source,
+            TOutputIterator const& destination,
+            TFunc const& func) -> void
+        {
+            deviceTransformInclusiveScan<TAcc, WorkDivPolicy>(
+                devAcc,
+                queue,
+                n,
+                source,
+                destination,
+                vikunja::reduce::detail::Identity<TRed>(),
+                func);
+        }
+
+        /**
+         * Inclusive scan with begin and end iterator of the input.
+         * @see deviceInclusiveScan
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TFunc,
+            typename TInputIterator,
+            typename TOutputIterator,
+            typename TDevAcc,
+            typename TQueue>
+        auto deviceInclusiveScan(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            TInputIterator const& sourceBegin,
+            TInputIterator const& sourceEnd,
+            TOutputIterator const& destination,
+            TFunc const& func) -> void
+        {
+            assert(sourceEnd >= sourceBegin);
+            auto size = static_cast<typename alpaka::trait::IdxType<TAcc>::type>(sourceEnd - sourceBegin);
+            deviceInclusiveScan<TAcc, WorkDivPolicy>(devAcc, queue, size, sourceBegin, destination, func);
+        }
+
+        /**
+         * Exclusive scan, which works exactly like deviceTransformExclusiveScan with an identity function for the
+         * transform operator, i.e. if one has the array [1,2,3,4], the initial value 0 and the scan function
+         * (x,y) -> x + y, the output will contain [0,1,3,6].
+         * @see deviceTransformExclusiveScan
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TFunc,
+            typename TInputIterator,
+            typename TOutputIterator,
+            typename TDevAcc,
+            typename TQueue,
+            typename TIdx,
+            typename TOperator = vikunja::operators::BinaryOp<
+                TAcc,
+                TFunc,
+                typename std::iterator_traits<TInputIterator>::value_type,
+                typename std::iterator_traits<TInputIterator>::value_type>,
+            typename TRed = typename TOperator::TRed>
+        auto deviceExclusiveScan(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            TIdx const& n,
+            TInputIterator const& source,
+            TOutputIterator const& destination,
+            typename detail::NonDeduced<TRed>::type const& init,
+            TFunc const& func) -> void
+        {
+            deviceTransformExclusiveScan<TAcc, WorkDivPolicy>(
+                devAcc,
+                queue,
+                n,
+                source,
+                destination,
+                init,
+                vikunja::reduce::detail::Identity<TRed>(),
+                func);
+        }
+
+        /**
+         * Exclusive scan with begin and end iterator of the input.
+         * @see deviceExclusiveScan
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TFunc,
+            typename TInputIterator,
+            typename TOutputIterator,
+            typename TDevAcc,
+            typename TQueue,
+            typename TInit>
+        auto deviceExclusiveScan(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            TInputIterator const& sourceBegin,
+            TInputIterator const& sourceEnd,
+            TOutputIterator const& destination,
+            TInit const& init,
+            TFunc const& func) -> void
+        {
+            assert(sourceEnd >= sourceBegin);
+            auto size = static_cast<typename alpaka::trait::IdxType<TAcc>::type>(sourceEnd - sourceBegin);
+            deviceExclusiveScan<TAcc, WorkDivPolicy>(devAcc, queue, size, sourceBegin, destination, init, func);
+        }
+    } // namespace scan
+} // namespace vikunja
@@ -0,0 +1,134 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <alpaka/alpaka.hpp>
+
+#include <cstdint>
+#include <type_traits>
+
+namespace vikunja
+{
+    namespace scatter
+    {
+        namespace detail
+        {
+            //! Number of elements, which the gather and scatter prefetch ahead on the CPU.
+            constexpr uint32_t prefetchDistance = 16u;
+
+            //! True, if the accelerator runs on the CPU.
+            template<typename TAcc>
+            constexpr bool isCpuAcc = std::is_same_v<alpaka::Pltf<alpaka::Dev<TAcc>>, alpaka::PltfCpu>;
+
+            /**
+             * Hints the CPU to load the cache line of an address, which is accessed soon. Does nothing, if the
+             * compiler does not support it or in device code.
+             * @tparam TWrite If true, the address is written, otherwise read.
+             */
+            template<bool TWrite, typename T>
+            ALPAKA_FN_HOST_ACC ALPAKA_FN_INLINE void prefetch([[maybe_unused]] T const* const address)
+            {
+#if(defined(__GNUC__) || defined(__clang__)) && !defined(__CUDA_ARCH__) && !defined(__HIP_DEVICE_COMPILE__)
+                __builtin_prefetch(address, TWrite ? 1 : 0);
+#endif
+            }
+
+            /**
+             * Transform functor, which copies the element of source at indices[i] to destination[i]. If TMasked is
+             * true, only elements, whose stencil fulfills the predicate, are copied. On the CPU, the source element
+             * of index i + prefetchDistance is prefetched, because the thread of a contiguous chunk reaches it soon.
+             */
+            template<
+                bool TMasked,
+                typename TPredOperator,
+                typename TIndexIterator,
+                typename TInputIterator,
+                typename TOutputIterator,
+                typename TStencilIterator,
+                typename TPred,
+                typename TIdx>
+            struct GatherFunc
+            {
+                TIndexIterator indices;
+                TInputIterator source;
+                TOutputIterator destination;
+                TStencilIterator stencil;
+                TPred pred;
+                TIdx n;
+
+                template<typename TAcc>
+                ALPAKA_FN_HOST_ACC bool operator()(TAcc const& acc, TIdx const& i) const
+                {
+                    if constexpr(isCpuAcc<TAcc> && std::is_pointer_v<TInputIterator>)
+                    {
+                        if(i + prefetchDistance < n)
+                        {
+                            prefetch<false>(&source[indices[i + prefetchDistance]]);
+                        }
+                    }
+                    if constexpr(TMasked)
+                    {
+                        if(!TPredOperator::run(acc, pred, stencil[i]))
+                        {
+                            return false;
+                        }
+                    }
+                    destination[i] = source[indices[i]];
+                    return true;
+                }
+            };
+
+            /**
+             * Transform functor, which copies source[i] to the element of destination at indices[i]. If TMasked is
+             * true, only elements, whose stencil fulfills the predicate, are copied. On the CPU, the destination
+             * element of index i + prefetchDistance is prefetched for writing.
+             */
+            template<
+                bool TMasked,
+                typename TPredOperator,
+                typename TInputIterator,
+                typename TIndexIterator,
+                typename TOutputIterator,
+                typename TStencilIterator,
+                typename TPred,
+                typename TIdx>
+            struct ScatterFunc
+            {
+                TInputIterator source;
+                TIndexIterator indices;
+                TOutputIterator destination;
+                TStencilIterator stencil;
+                TPred pred;
+                TIdx n;
+
+                template<typename TAcc>
+                ALPAKA_FN_HOST_ACC bool operator()(TAcc const& acc, TIdx const& i) const
+                {
+                    if constexpr(isCpuAcc<TAcc> && std::is_pointer_v<TOutputIterator>)
+                    {
+                        if(i + prefetchDistance < n)
+                        {
+                            prefetch<true>(&destination[indices[i + prefetchDistance]]);
+                        }
+                    }
+                    if constexpr(TMasked)
+                    {
+                        if(!TPredOperator::run(acc, pred, stencil[i]))
+                        {
+                            return false;
+                        }
+                    }
+                    destination[indices[i]] = source[i];
+                    return true;
+                }
+            };
+        } // namespace detail
+    } // namespace scatter
+} // namespace vikunja
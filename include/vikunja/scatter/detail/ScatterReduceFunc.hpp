@@ -0,0 +1,114 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/operators/functors.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+#include <type_traits>
+
+namespace vikunja
+{
+    namespace scatter
+    {
+        namespace detail
+        {
+            /**
+             * Reduces a value into a target in the global memory with an atomic operation. Sums, i.e.
+             * vikunja::operators::Plus, are reduced with an atomic add, all other functions with an atomic compare
+             * and swap loop, which requires a value type supported by the alpaka compare and swap operation.
+             * @tparam TReduceOperator The vikunja::operators type of the reduce function.
+             */
+            template<typename TReduceOperator, typename TAcc, typename TValue, typename TReduce>
+            ALPAKA_FN_HOST_ACC void atomicReduce(
+                TAcc const& acc,
+                TValue* const target,
+                TValue const& value,
+                TReduce const& reduce)
+            {
+                if constexpr(std::is_same_v<TReduce, vikunja::operators::Plus<TValue>>)
+                {
+                    alpaka::atomicOp<alpaka::AtomicAdd>(acc, target, value, alpaka::hierarchy::Grids{});
+                }
+                else
+                {
+                    TValue assumed = *target;
+                    while(true)
+                    {
+                        TValue const desired = TReduceOperator::run(acc, reduce, assumed, value);
+                        TValue const old = alpaka::atomicOp<alpaka::AtomicCas>(
+                            acc,
+                            target,
+                            assumed,
+                            desired,
+                            alpaka::hierarchy::Grids{});
+                        if(old == assumed)
+                        {
+                            break;
+                        }
+                        assumed = old;
+                    }
+                }
+            }
+
+            /**
+             * Transform functor, which reduces a value into the target element of its index with an atomic
+             * operation.
+             */
+            template<typename TReduceOperator, typename TValue, typename TReduce>
+            struct AtomicScatterReduceFunc
+            {
+                TValue* target;
+                TReduce reduce;
+
+                template<typename TAcc, typename TIndex>
+                ALPAKA_FN_HOST_ACC bool operator()(TAcc const& acc, TValue const& value, TIndex const& index) const
+                {
+                    atomicReduce<TReduceOperator>(acc, &target[index], value, reduce);
+                    return true;
+                }
+            };
+
+            /**
+             * Transform functor, which reduces the already reduced value of a unique index into its target
+             * element. Each index occurs only once, therefore no atomic operation is required.
+             */
+            template<typename TReduceOperator, typename TTargetIterator, typename TReduce>
+            struct UniqueScatterReduceFunc
+            {
+                TTargetIterator target;
+                TReduce reduce;
+
+                template<typename TAcc, typename TIndex, typename TValue>
+                ALPAKA_FN_HOST_ACC bool operator()(TAcc const& acc, TIndex const& index, TValue const& value) const
+                {
+                    target[index] = TReduceOperator::run(acc, reduce, target[index], value);
+                    return true;
+                }
+            };
+
+            /**
+             * Transform functor, which returns every stride-th element of a sequence.
+             */
+            template<typename TIterator, typename TIdx>
+            struct StridedSampleFunc
+            {
+                TIterator data;
+                TIdx stride;
+
+                ALPAKA_FN_HOST_ACC auto operator()(TIdx const& i) const
+                {
+                    return data[i * stride];
+                }
+            };
+        } // namespace detail
+    } // namespace scatter
+} // namespace vikunja
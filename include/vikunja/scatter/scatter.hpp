@@ -0,0 +1,267 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/access/BlockStrategy.hpp>
+#include <vikunja/mem/iterator.hpp>
+#include <vikunja/operators/operators.hpp>
+#include <vikunja/reduce/reduce.hpp>
+#include <vikunja/scatter/detail/GatherScatterFunc.hpp>
+#include <vikunja/transform/transform.hpp>
+#include <vikunja/workdiv/BlockBasedWorkDiv.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+#include <iterator>
+
+namespace vikunja
+{
+    namespace scatter
+    {
+        namespace detail
+        {
+            /**
+             * Executes a gather or scatter functor for the indices [0, n) with the transform kernel.
+             */
+            template<
+                typename TAcc,
+                typename WorkDivPolicy,
+                typename MemAccessPolicy,
+                typename TDevAcc,
+                typename TQueue,
+                typename TIdx,
+                typename TFunc>
+            void indexTransformImpl(TDevAcc& devAcc, TQueue& queue, TIdx const& n, TFunc const& func)
+            {
+                vikunja::transform::deviceTransform<TAcc, WorkDivPolicy, MemAccessPolicy>(
+                    devAcc,
+                    queue,
+                    n,
+                    vikunja::mem::iterator::CountingIterator<TIdx>{},
+                    vikunja::mem::iterator::DiscardIterator{},
+                    func);
+            }
+        } // namespace detail
+
+        /**
+         * Copies the elements of source at the given indices to the destination, i.e. destination[i] =
+         * source[indices[i]], e.g. to reorder data by the permutation of a sort. If one has the indices [2,0,1] and
+         * the source [a,b,c], the destination will contain [c,a,b]. The gather runs through the transform kernel.
+         * On the CPU accelerators, each thread prefetches the source element, which it reads a few iterations
+         * later, so that the random reads overlap.
+         * @tparam TAcc The alpaka accelerator type to use.
+         * @tparam WorkDivPolicy The working division policy. Defaults to a templated value depending on the
+         * accelerator. For the API of this, see workdiv/BlockBasedWorkDiv.hpp
+         * @tparam MemAccessPolicy The memory access policy. Defaults to a templated value depending on the
+         * accelerator. For the API of this, see vikunja::MemAccess::PolicyBasedBlockStrategy
+         * @tparam TIndexIterator Type of the index iterator. Should be a pointer-like type.
+         * @tparam TInputIterator Type of the source iterator. Should be a pointer-like type.
+         * @tparam TOutputIterator Type of the destination iterator. Should be a pointer-like type.
+         * @tparam TDevAcc The type of the alpaka accelerator.
+         * @tparam TQueue The type of the alpaka queue.
+         * @tparam TIdx The index type to use.
+         * @param devAcc The alpaka accelerator.
+         * @param queue The alpaka queue.
+         * @param indices The source index of each destination element.
+         * @param source The source.
+         * @param destination The destination with n elements. Must not overlap with the source.
+         * @param n The number of elements to gather.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename MemAccessPolicy = vikunja::MemAccess::MemAccessPolicy<TAcc>,
+            typename TIndexIterator,
+            typename TInputIterator,
+            typename TOutputIterator,
+            typename TDevAcc,
+            typename TQueue,
+            typename TIdx,
+            typename TIndex = typename std::iterator_traits<TIndexIterator>::value_type,
+            typename TPredOperator
+            = vikunja::operators::UnaryOp<TAcc, vikunja::reduce::detail::Identity<TIndex>, TIndex>>
+        auto deviceGather(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            TIndexIterator const& indices,
+            TInputIterator const& source,
+            TOutputIterator const& destination,
+            TIdx const& n) -> void
+        {
+            // not masked, the indices and the identity are passed as dummy stencil and predicate
+            detail::indexTransformImpl<TAcc, WorkDivPolicy, MemAccessPolicy>(
+                devAcc,
+                queue,
+                n,
+                detail::GatherFunc<
+                    false,
+                    TPredOperator,
+                    TIndexIterator,
+                    TInputIterator,
+                    TOutputIterator,
+                    TIndexIterator,
+                    vikunja::reduce::detail::Identity<TIndex>,
+                    TIdx>{indices, source, destination, indices, vikunja::reduce::detail::Identity<TIndex>(), n});
+        }
+
+        /**
+         * Gathers only the elements, whose stencil fulfills the predicate, i.e. destination[i] =
+         * source[indices[i]] if pred(stencil[i]). All other elements of the destination are not changed.
+         * @see deviceGather
+         * @param stencil The stencil of each destination element.
+         * @param pred The predicate. It can optionally take the alpaka accelerator as first argument.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename MemAccessPolicy = vikunja::MemAccess::MemAccessPolicy<TAcc>,
+            typename TIndexIterator,
+            typename TInputIterator,
+            typename TOutputIterator,
+            typename TStencilIterator,
+            typename TPred,
+            typename TDevAcc,
+            typename TQueue,
+            typename TIdx,
+            typename TStencil = typename std::iterator_traits<TStencilIterator>::value_type,
+            typename TPredOperator = vikunja::operators::UnaryOp<TAcc, TPred, TStencil>>
+        auto deviceGatherIf(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            TIndexIterator const& indices,
+            TInputIterator const& source,
+            TOutputIterator const& destination,
+            TIdx const& n,
+            TStencilIterator const& stencil,
+            TPred const& pred) -> void
+        {
+            detail::indexTransformImpl<TAcc, WorkDivPolicy, MemAccessPolicy>(
+                devAcc,
+                queue,
+                n,
+                detail::GatherFunc<
+                    true,
+                    TPredOperator,
+                    TIndexIterator,
+                    TInputIterator,
+                    TOutputIterator,
+                    TStencilIterator,
+                    TPred,
+                    TIdx>{indices, source, destination, stencil, pred, n});
+        }
+
+        /**
+         * Copies the elements of source to the given indices of the destination, i.e. destination[indices[i]] =
+         * source[i], e.g. to apply the inverse of a permutation. If one has the source [a,b,c] and the indices
+         * [2,0,1], the destination will contain [b,c,a]. If an index occurs several times, it is not defined, which
+         * element is written. The scatter runs through the transform kernel. On the CPU accelerators, each thread
+         * prefetches the destination element, which it writes a few iterations later.
+         * @tparam TAcc The alpaka accelerator type to use.
+         * @tparam WorkDivPolicy The working division policy. Defaults to a templated value depending on the
+         * accelerator. For the API of this, see workdiv/BlockBasedWorkDiv.hpp
+         * @tparam MemAccessPolicy The memory access policy. Defaults to a templated value depending on the
+         * accelerator. For the API of this, see vikunja::MemAccess::PolicyBasedBlockStrategy
+         * @tparam TInputIterator Type of the source iterator. Should be a pointer-like type.
+         * @tparam TIndexIterator Type of the index iterator. Should be a pointer-like type.
+         * @tparam TOutputIterator Type of the destination iterator. Should be a pointer-like type.
+         * @tparam TDevAcc The type of the alpaka accelerator.
+         * @tparam TQueue The type of the alpaka queue.
+         * @tparam TIdx The index type to use.
+         * @param devAcc The alpaka accelerator.
+         * @param queue The alpaka queue.
+         * @param source The source with n elements.
+         * @param indices The destination index of each source element.
+         * @param destination The destination. Must not overlap with the source.
+         * @param n The number of elements to scatter.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename MemAccessPolicy = vikunja::MemAccess::MemAccessPolicy<TAcc>,
+            typename TInputIterator,
+            typename TIndexIterator,
+            typename TOutputIterator,
+            typename TDevAcc,
+            typename TQueue,
+            typename TIdx,
+            typename TIndex = typename std::iterator_traits<TIndexIterator>::value_type,
+            typename TPredOperator
+            = vikunja::operators::UnaryOp<TAcc, vikunja::reduce::detail::Identity<TIndex>, TIndex>>
+        auto deviceScatter(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            TInputIterator const& source,
+            TIndexIterator const& indices,
+            TOutputIterator const& destination,
+            TIdx const& n) -> void
+        {
+            // not masked, the indices and the identity are passed as dummy stencil and predicate
+            detail::indexTransformImpl<TAcc, WorkDivPolicy, MemAccessPolicy>(
+                devAcc,
+                queue,
+                n,
+                detail::ScatterFunc<
+                    false,
+                    TPredOperator,
+                    TInputIterator,
+                    TIndexIterator,
+                    TOutputIterator,
+                    TIndexIterator,
+                    vikunja::reduce::detail::Identity<TIndex>,
+                    TIdx>{source, indices, destination, indices, vikunja::reduce::detail::Identity<TIndex>(), n});
+        }
+
+        /**
+         * Scatters only the elements, whose stencil fulfills the predicate, i.e. destination[indices[i]] =
+         * source[i] if pred(stencil[i]). All other elements of the destination are not changed.
+         * @see deviceScatter
+         * @param stencil The stencil of each source element.
+         * @param pred The predicate. It can optionally take the alpaka accelerator as first argument.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename MemAccessPolicy = vikunja::MemAccess::MemAccessPolicy<TAcc>,
+            typename TInputIterator,
+            typename TIndexIterator,
+            typename TOutputIterator,
+            typename TStencilIterator,
+            typename TPred,
+            typename TDevAcc,
+            typename TQueue,
+            typename TIdx,
+            typename TStencil = typename std::iterator_traits<TStencilIterator>::value_type,
+            typename TPredOperator = vikunja::operators::UnaryOp<TAcc, TPred, TStencil>>
+        auto deviceScatterIf(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            TInputIterator const& source,
+            TIndexIterator const& indices,
+            TOutputIterator const& destination,
+            TIdx const& n,
+            TStencilIterator const& stencil,
+            TPred const& pred) -> void
+        {
+            detail::indexTransformImpl<TAcc, WorkDivPolicy, MemAccessPolicy>(
+                devAcc,
+                queue,
+                n,
+                detail::ScatterFunc<
+                    true,
+                    TPredOperator,
+                    TInputIterator,
+                    TIndexIterator,
+                    TOutputIterator,
+                    TStencilIterator,
+                    TPred,
+                    TIdx>{source, indices, destination, stencil, pred, n});
+        }
+    } // namespace scatter
+} // namespace vikunja
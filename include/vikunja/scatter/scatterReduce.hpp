@@ -0,0 +1,301 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/access/BlockStrategy.hpp>
+#include <vikunja/mem/iterator.hpp>
+#include <vikunja/operators/functors.hpp>
+#include <vikunja/operators/operators.hpp>
+#include <vikunja/reduce/reduce.hpp>
+#include <vikunja/reduce/reduceByKey.hpp>
+#include <vikunja/scatter/detail/ScatterReduceFunc.hpp>
+#include <vikunja/sort/radixSort.hpp>
+#include <vikunja/transform/transform.hpp>
+#include <vikunja/workdiv/BlockBasedWorkDiv.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+
+namespace vikunja
+{
+    namespace scatter
+    {
+        /**
+         * Selects, how deviceScatterReduce reduces values with equal indices.
+         */
+        enum class ScatterReduceStrategy
+        {
+            //! Selects atomic or sort with the conflict rate of a sample of the indices, if the function is marked
+            //! as commutative, and sort otherwise.
+            automatic,
+            //! Each value is reduced into its target with an atomic operation. Requires a commutative function.
+            atomic,
+            //! The values are sorted by index and reduced by key, each target is updated once.
+            sort
+        };
+
+        namespace detail
+        {
+            //! Maximum number of indices, which are sampled to estimate the conflict rate.
+            constexpr uint64_t conflictSampleSize = 1024u;
+
+            //! The sort strategy is selected, if more than this share of the sampled indices are duplicates.
+            constexpr double sortConflictRate = 0.25;
+
+            /**
+             * Estimates the share of the indices, which are reduced into an already used target, from evenly
+             * spaced samples. Only the samples are copied to the host.
+             */
+            template<
+                typename TAcc,
+                typename WorkDivPolicy,
+                typename MemAccessPolicy,
+                typename TDevAcc,
+                typename TDevHost,
+                typename TQueue,
+                typename TIdx,
+                typename TIndexIterator>
+            double estimateConflictRate(
+                TDevAcc& devAcc,
+                TDevHost& devHost,
+                TQueue& queue,
+                TIdx const& n,
+                TIndexIterator const& indices)
+            {
+                using TIndex = typename std::iterator_traits<TIndexIterator>::value_type;
+                using Dim = alpaka::Dim<TAcc>;
+                using Vec = alpaka::Vec<Dim, TIdx>;
+                constexpr TIdx xIndex = Dim::value - 1u;
+
+                TIdx const sampleSize = std::min(n, static_cast<TIdx>(conflictSampleSize));
+                Vec sampleExtent(Vec::all(static_cast<TIdx>(1u)));
+                sampleExtent[xIndex] = sampleSize;
+                auto samples = alpaka::allocBuf<TIndex, TIdx>(devAcc, sampleExtent);
+                auto hostSamples = alpaka::allocBuf<TIndex, TIdx>(devHost, sampleExtent);
+                vikunja::transform::deviceTransform<TAcc, WorkDivPolicy, MemAccessPolicy>(
+                    devAcc,
+                    queue,
+                    sampleSize,
+                    vikunja::mem::iterator::CountingIterator<TIdx>{},
+                    alpaka::getPtrNative(samples),
+                    StridedSampleFunc<TIndexIterator, TIdx>{indices, n / sampleSize});
+                alpaka::memcpy(queue, hostSamples, samples, sampleExtent);
+                alpaka::wait(queue);
+
+                TIndex* const begin = alpaka::getPtrNative(hostSamples);
+                TIndex* const end = begin + sampleSize;
+                std::sort(begin, end);
+                TIdx const distinct = static_cast<TIdx>(std::unique(begin, end) - begin);
+                return static_cast<double>(sampleSize - distinct) / static_cast<double>(sampleSize);
+            }
+
+            /**
+             * Sorts copies of the values by their index, reduces the values of each index and reduces the result
+             * into the target. The sort is stable and the reduce by key reduces from left to right, therefore the
+             * values of each index are reduced in the input order.
+             */
+            template<
+                typename TAcc,
+                typename WorkDivPolicy,
+                typename MemAccessPolicy,
+                typename TReduceOperator,
+                typename TDevAcc,
+                typename TDevHost,
+                typename TQueue,
+                typename TIdx,
+                typename TValueIterator,
+                typename TIndexIterator,
+                typename TValue,
+                typename TReduce>
+            void sortScatterReduceImpl(
+                TDevAcc& devAcc,
+                TDevHost& devHost,
+                TQueue& queue,
+                TValueIterator const& values,
+                TIndexIterator const& indices,
+                TIdx const& n,
+                TValue* const target,
+                TReduce const& reduce)
+            {
+                using TIndex = typename std::iterator_traits<TIndexIterator>::value_type;
+                using Dim = alpaka::Dim<TAcc>;
+                using Vec = alpaka::Vec<Dim, TIdx>;
+                constexpr TIdx xIndex = Dim::value - 1u;
+
+                Vec extent(Vec::all(static_cast<TIdx>(1u)));
+                extent[xIndex] = n;
+                auto sortedIndices = alpaka::allocBuf<TIndex, TIdx>(devAcc, extent);
+                auto sortedValues = alpaka::allocBuf<TValue, TIdx>(devAcc, extent);
+                auto uniqueIndices = alpaka::allocBuf<TIndex, TIdx>(devAcc, extent);
+                auto reducedValues = alpaka::allocBuf<TValue, TIdx>(devAcc, extent);
+                TIndex* const sortedIndicesPtr = alpaka::getPtrNative(sortedIndices);
+                TValue* const sortedValuesPtr = alpaka::getPtrNative(sortedValues);
+
+                vikunja::transform::deviceTransform<TAcc, WorkDivPolicy, MemAccessPolicy>(
+                    devAcc,
+                    queue,
+                    n,
+                    indices,
+                    sortedIndicesPtr,
+                    vikunja::reduce::detail::Identity<TIndex>());
+                vikunja::transform::deviceTransform<TAcc, WorkDivPolicy, MemAccessPolicy>(
+                    devAcc,
+                    queue,
+                    n,
+                    values,
+                    sortedValuesPtr,
+                    vikunja::reduce::detail::Identity<TValue>());
+                vikunja::sort::deviceRadixSortPairs<TAcc, WorkDivPolicy>(
+                    devAcc,
+                    queue,
+                    n,
+                    sortedIndicesPtr,
+                    sortedValuesPtr);
+                TIdx const numTargets = vikunja::reduce::deviceReduceByKey<TAcc, WorkDivPolicy>(
+                    devAcc,
+                    devHost,
+                    queue,
+                    n,
+                    sortedIndicesPtr,
+                    sortedValuesPtr,
+                    alpaka::getPtrNative(uniqueIndices),
+                    alpaka::getPtrNative(reducedValues),
+                    reduce);
+                vikunja::transform::deviceTransform<TAcc, WorkDivPolicy, MemAccessPolicy>(
+                    devAcc,
+                    queue,
+                    numTargets,
+                    alpaka::getPtrNative(uniqueIndices),
+                    alpaka::getPtrNative(reducedValues),
+                    vikunja::mem::iterator::DiscardIterator{},
+                    UniqueScatterReduceFunc<TReduceOperator, TValue*, TReduce>{target, reduce});
+                alpaka::wait(queue);
+            }
+        } // namespace detail
+
+        /**
+         * Reduces each value into the target element of its index, i.e. target[indices[i]] =
+         * reduce(target[indices[i]], values[i]) for all i, like index_add or a particle to grid deposition. If one
+         * has the values [1,2,3,4], the indices [0,2,0,1], the target [10,10,10] and a sum, the target will contain
+         * [14,14,12].
+         * Two strategies are implemented. The atomic strategy reduces each value with an alpaka atomic operation
+         * in a single pass: an atomic add for sums, i.e. vikunja::operators::Plus, and a compare and swap loop
+         * otherwise. It is fast, if only a few values share an index. If many values share an index, the atomic
+         * operations on the same target serialize. The sort strategy sorts copies of the indices and values with
+         * the radix sort, reduces the values of each index with the reduce by key and updates each target once
+         * without atomic operations. It needs temporary memory of four times the input size, but its runtime does
+         * not depend on the conflicts. Only the sort strategy supports functions, which are not commutative: the
+         * values of each index are reduced in the input order.
+         * The automatic strategy selects the sort strategy, if the function is not marked as commutative, see
+         * vikunja::operators::traits::IsCommutative. Otherwise, it copies up to detail::conflictSampleSize evenly
+         * spaced indices to the host and selects the sort strategy, if more than detail::sortConflictRate of them
+         * are duplicates.
+         * The function waits for the queue before it returns.
+         * @tparam TAcc The alpaka accelerator type to use.
+         * @tparam WorkDivPolicy The working division policy. Defaults to a templated value depending on the
+         * accelerator. For the API of this, see workdiv/BlockBasedWorkDiv.hpp
+         * @tparam MemAccessPolicy The memory access policy. Defaults to a templated value depending on the
+         * accelerator. For the API of this, see vikunja::MemAccess::PolicyBasedBlockStrategy
+         * @tparam TValueIterator Type of the value iterator. Should be a pointer-like type.
+         * @tparam TIndexIterator Type of the index iterator. Should be a pointer-like type to an integral type.
+         * @tparam TValue Type of the target elements. Must be supported by the alpaka atomic operations for the
+         * atomic strategy.
+         * @tparam TReduce Type of the reduce function.
+         * @tparam TDevAcc The type of the alpaka accelerator.
+         * @tparam TDevHost The type of the alpaka host device.
+         * @tparam TQueue The type of the alpaka queue.
+         * @tparam TIdx The index type to use.
+         * @tparam TReduceOperator The vikunja::operators type of the reduce function.
+         * @param devAcc The alpaka accelerator.
+         * @param devHost The alpaka host device.
+         * @param queue The alpaka queue.
+         * @param values The values.
+         * @param indices The target index of each value. Must be smaller than the size of the target.
+         * @param n The number of values.
+         * @param target The target, into which the values are reduced.
+         * @param reduce The associative reduce function. It can optionally take the alpaka accelerator as first
+         * argument.
+         * @param strategy The strategy. Defaults to automatic.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename MemAccessPolicy = vikunja::MemAccess::MemAccessPolicy<TAcc>,
+            typename TValueIterator,
+            typename TIndexIterator,
+            typename TValue,
+            typename TReduce,
+            typename TDevAcc,
+            typename TDevHost,
+            typename TQueue,
+            typename TIdx,
+            typename TReduceOperator = vikunja::operators::BinaryOp<TAcc, TReduce, TValue, TValue>>
+        auto deviceScatterReduce(
+            TDevAcc& devAcc,
+            TDevHost& devHost,
+            TQueue& queue,
+            TValueIterator const& values,
+            TIndexIterator const& indices,
+            TIdx const& n,
+            TValue* const target,
+            TReduce const& reduce,
+            ScatterReduceStrategy strategy = ScatterReduceStrategy::automatic) -> void
+        {
+            if(n == 0)
+            {
+                return;
+            }
+            if(strategy == ScatterReduceStrategy::automatic && !vikunja::operators::isCommutative<TReduce>)
+            {
+                // the order of the atomic operations is undefined
+                strategy = ScatterReduceStrategy::sort;
+            }
+            if(strategy == ScatterReduceStrategy::automatic)
+            {
+                double const conflictRate = detail::estimateConflictRate<TAcc, WorkDivPolicy, MemAccessPolicy>(
+                    devAcc,
+                    devHost,
+                    queue,
+                    n,
+                    indices);
+                strategy = (conflictRate > detail::sortConflictRate) ? ScatterReduceStrategy::sort
+                                                                     : ScatterReduceStrategy::atomic;
+            }
+
+            if(strategy == ScatterReduceStrategy::sort)
+            {
+                detail::sortScatterReduceImpl<TAcc, WorkDivPolicy, MemAccessPolicy, TReduceOperator>(
+                    devAcc,
+                    devHost,
+                    queue,
+                    values,
+                    indices,
+                    n,
+                    target,
+                    reduce);
+            }
+            else
+            {
+                vikunja::transform::deviceTransform<TAcc, WorkDivPolicy, MemAccessPolicy>(
+                    devAcc,
+                    queue,
+                    n,
+                    values,
+                    indices,
+                    vikunja::mem::iterator::DiscardIterator{},
+                    detail::AtomicScatterReduceFunc<TReduceOperator, TValue, TReduce>{target, reduce});
+                alpaka::wait(queue);
+            }
+        }
+    } // namespace scatter
+} // namespace vikunja
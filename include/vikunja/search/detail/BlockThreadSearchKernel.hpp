@@ -0,0 +1,305 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/access/BlockStrategy.hpp>
+#include <vikunja/reduce/detail/BlockThreadReduceKernel.hpp>
+#include <vikunja/sort/detail/MergePath.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+#include <cstdint>
+
+namespace vikunja
+{
+    namespace search
+    {
+        namespace detail
+        {
+            /**
+             * Returns true, if the element of the sorted sequence is in front of the bound of the query. For the
+             * lower bound, these are all elements less than the query, for the upper bound all elements not greater
+             * than the query.
+             * @tparam TUpper If true, the upper bound is searched, otherwise the lower bound.
+             * @tparam TCompareOperator The vikunja::operators type of the comparator.
+             */
+            template<
+                bool TUpper,
+                typename TCompareOperator,
+                typename TAcc,
+                typename TElement,
+                typename TQuery,
+                typename TCompare>
+            ALPAKA_FN_HOST_ACC ALPAKA_FN_INLINE bool isInFront(
+                TAcc const& acc,
+                TElement const& element,
+                TQuery const& query,
+                TCompare const& compare)
+            {
+                if constexpr(TUpper)
+                {
+                    return !TCompareOperator::run(acc, compare, query, element);
+                }
+                else
+                {
+                    return TCompareOperator::run(acc, compare, element, query);
+                }
+            }
+
+            /**
+             * Binary search of the bound of a query in the range [low, high) of a sorted sequence.
+             * @tparam TUpper If true, the upper bound is searched, otherwise the lower bound.
+             * @tparam TCompareOperator The vikunja::operators type of the comparator.
+             * @return The index of the first element of the range, which is not in front of the bound.
+             */
+            template<
+                bool TUpper,
+                typename TCompareOperator,
+                typename TAcc,
+                typename TIdx,
+                typename TIterator,
+                typename TValue,
+                typename TCompare>
+            ALPAKA_FN_HOST_ACC TIdx boundSearch(
+                TAcc const& acc,
+                TIterator const& sorted,
+                TIdx low,
+                TIdx high,
+                TValue const& query,
+                TCompare const& compare)
+            {
+                while(low < high)
+                {
+                    TIdx const mid = low + (high - low) / 2;
+                    if(isInFront<TUpper, TCompareOperator>(acc, sorted[mid], query, compare))
+                    {
+                        low = mid + 1;
+                    }
+                    else
+                    {
+                        high = mid;
+                    }
+                }
+                return low;
+            }
+
+            /**
+             * Transform functor, which searches the bound of a query in the whole sorted sequence. It is executed
+             * by the transform kernel.
+             * @tparam TUpper If true, the upper bound is searched, otherwise the lower bound.
+             * @tparam TCompareOperator The vikunja::operators type of the comparator.
+             */
+            template<bool TUpper, typename TCompareOperator, typename TIterator, typename TIdx, typename TCompare>
+            struct BoundFunc
+            {
+                TIterator sorted;
+                TIdx n;
+                TCompare compare;
+
+                template<typename TAcc, typename TValue>
+                ALPAKA_FN_HOST_ACC TIdx operator()(TAcc const& acc, TValue const& query) const
+                {
+                    return boundSearch<TUpper, TCompareOperator>(acc, sorted, static_cast<TIdx>(0), n, query, compare);
+                }
+            };
+
+            /**
+             * Returns the position of the cached element i, if numCached elements of a sorted sequence of size n are
+             * cached. The cached element i is the last element of the i-th of numCached + 1 equal parts.
+             */
+            template<typename TIdx>
+            ALPAKA_FN_HOST_ACC ALPAKA_FN_INLINE TIdx cachedPosition(TIdx const i, TIdx const n, TIdx const numCached)
+            {
+                return ((i + 1) * n) / (numCached + 1);
+            }
+
+            /**
+             * Searches the bound of each query. Each block loads the top TCacheLevels levels of the implicit binary
+             * search tree of the sorted sequence, i.e. 2^TCacheLevels - 1 evenly spaced elements, to the shared
+             * memory first. The first search steps of all queries of the block use the shared memory, the remaining
+             * steps search the small range between two cached elements in the global memory.
+             * @tparam TBlockSize The block size of this kernel.
+             * @tparam TMemAccessPolicy The memory access policy of the queries.
+             * @tparam TCacheLevels The number of cached tree levels.
+             * @tparam TUpper If true, the upper bound is searched, otherwise the lower bound.
+             * @tparam TValue The type of the sorted elements.
+             * @tparam TCompareOperator The vikunja::operators type of the comparator.
+             */
+            template<
+                uint64_t TBlockSize,
+                typename TMemAccessPolicy,
+                uint32_t TCacheLevels,
+                bool TUpper,
+                typename TValue,
+                typename TCompareOperator>
+            struct CachedBoundKernel
+            {
+                //! Number of cached elements.
+                static constexpr uint64_t cacheSize = (uint64_t{1} << TCacheLevels) - 1u;
+
+                /**
+                 * @param acc The alpaka accelerator.
+                 * @param sorted The sorted sequence.
+                 * @param n The size of the sorted sequence. Must be greater than cacheSize.
+                 * @param queries The queries.
+                 * @param destination The output iterator of the bounds.
+                 * @param nQueries The number of queries.
+                 * @param compare The comparator.
+                 */
+                template<
+                    typename TAcc,
+                    typename TIdx,
+                    typename TIterator,
+                    typename TQueryIterator,
+                    typename TOutputIterator,
+                    typename TCompare>
+                ALPAKA_FN_ACC void operator()(
+                    TAcc const& acc,
+                    TIterator const& sorted,
+                    TIdx const& n,
+                    TQueryIterator const& queries,
+                    TOutputIterator const& destination,
+                    TIdx const& nQueries,
+                    TCompare const& compare) const
+                {
+                    using SharedArray = vikunja::reduce::detail::sharedStaticArray<TValue, cacheSize>;
+                    auto& cache(alpaka::declareSharedVar<SharedArray, __COUNTER__>(acc));
+
+                    constexpr TIdx xIndex = alpaka::Dim<TAcc>::value - 1u;
+                    auto const threadIndex = alpaka::getIdx<alpaka::Block, alpaka::Threads>(acc)[xIndex];
+                    constexpr TIdx numCached = static_cast<TIdx>(cacheSize);
+
+                    for(TIdx i = threadIndex; i < numCached; i += static_cast<TIdx>(TBlockSize))
+                    {
+                        cache[i] = sorted[cachedPosition(i, n, numCached)];
+                    }
+                    alpaka::syncBlockThreads(acc);
+
+                    using MemIndex = vikunja::MemAccess::BlockStrategy<TMemAccessPolicy, TAcc, TIdx>;
+                    for(MemIndex iter(acc, nQueries, TBlockSize), end = iter.end(); iter < end; ++iter)
+                    {
+                        TValue const query = queries[*iter];
+                        TIdx const part = boundSearch<TUpper, TCompareOperator>(
+                            acc,
+                            cache,
+                            static_cast<TIdx>(0),
+                            numCached,
+                            query,
+                            compare);
+                        // the bound is behind the cached element in front of the part and not behind its last one
+                        TIdx const low = (part == 0) ? 0 : cachedPosition(part - 1, n, numCached) + 1;
+                        TIdx const high = (part == numCached) ? n : cachedPosition(part, n, numCached);
+                        destination[*iter]
+                            = boundSearch<TUpper, TCompareOperator>(acc, sorted, low, high, query, compare);
+                    }
+                }
+            };
+
+            /**
+             * Searches the bounds of sorted queries by merging the queries with the sorted sequence. Each thread
+             * processes an equal share of the merge path, whose begin is found with a merge path search. Therefore,
+             * the sorted sequence and the queries are read only once.
+             * @tparam TUpper If true, the upper bound is searched, otherwise the lower bound.
+             * @tparam TCompareOperator The vikunja::operators type of the comparator.
+             */
+            template<bool TUpper, typename TCompareOperator>
+            struct SortedBoundKernel
+            {
+                /**
+                 * @param acc The alpaka accelerator.
+                 * @param sorted The sorted sequence.
+                 * @param n The size of the sorted sequence.
+                 * @param queries The sorted queries.
+                 * @param destination The output iterator of the bounds.
+                 * @param nQueries The number of queries.
+                 * @param compare The comparator.
+                 */
+                template<
+                    typename TAcc,
+                    typename TIdx,
+                    typename TIterator,
+                    typename TQueryIterator,
+                    typename TOutputIterator,
+                    typename TCompare>
+                ALPAKA_FN_ACC void operator()(
+                    TAcc const& acc,
+                    TIterator const& sorted,
+                    TIdx const& n,
+                    TQueryIterator const& queries,
+                    TOutputIterator const& destination,
+                    TIdx const& nQueries,
+                    TCompare const& compare) const
+                {
+                    constexpr TIdx xIndex = alpaka::Dim<TAcc>::value - 1u;
+                    TIdx const globalThreadIndex = alpaka::getIdx<alpaka::Grid, alpaka::Threads>(acc)[xIndex];
+                    TIdx const globalThreadCount = alpaka::getWorkDiv<alpaka::Grid, alpaka::Threads>(acc)[xIndex];
+
+                    TIdx const pathLength = n + nQueries;
+                    TIdx const itemsPerThread = (pathLength + globalThreadCount - 1) / globalThreadCount;
+                    TIdx begin = globalThreadIndex * itemsPerThread;
+                    begin = (begin < pathLength) ? begin : pathLength;
+                    TIdx const end = (pathLength - begin < itemsPerThread) ? pathLength : begin + itemsPerThread;
+                    if(begin == end)
+                    {
+                        return;
+                    }
+
+                    // on equal elements, the merge path takes the element of the first sequence first: for the lower
+                    // bound the query is in front of equal elements, for the upper bound behind them
+                    TIdx queryIndex = 0;
+                    if constexpr(TUpper)
+                    {
+                        TIdx const sortedBegin = vikunja::sort::detail::mergePathSearch<TCompareOperator>(
+                            acc,
+                            sorted,
+                            n,
+                            queries,
+                            nQueries,
+                            begin,
+                            compare);
+                        queryIndex = begin - sortedBegin;
+                    }
+                    else
+                    {
+                        queryIndex = vikunja::sort::detail::mergePathSearch<TCompareOperator>(
+                            acc,
+                            queries,
+                            nQueries,
+                            sorted,
+                            n,
+                            begin,
+                            compare);
+                    }
+                    TIdx sortedIndex = begin - queryIndex;
+
+                    for(TIdx k = begin; k < end; ++k)
+                    {
+                        bool const takeQuery = queryIndex < nQueries
+                            && (sortedIndex >= n
+                                || !isInFront<TUpper, TCompareOperator>(
+                                    acc,
+                                    sorted[sortedIndex],
+                                    queries[queryIndex],
+                                    compare));
+                        if(takeQuery)
+                        {
+                            destination[queryIndex] = sortedIndex;
+                            ++queryIndex;
+                        }
+                        else
+                        {
+                            ++sortedIndex;
+                        }
+                    }
+                }
+            };
+        } // namespace detail
+    } // namespace search
+} // namespace vikunja
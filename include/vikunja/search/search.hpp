@@ -0,0 +1,368 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/access/BlockStrategy.hpp>
+#include <vikunja/affinity/Affinity.hpp>
+#include <vikunja/operators/functors.hpp>
+#include <vikunja/operators/operators.hpp>
+#include <vikunja/search/detail/BlockThreadSearchKernel.hpp>
+#include <vikunja/transform/transform.hpp>
+#include <vikunja/workdiv/BlockBasedWorkDiv.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+
+namespace vikunja
+{
+    namespace search
+    {
+        namespace detail
+        {
+            /**
+             * Searches the bound of each query with a binary search. Without cache, the search is executed by the
+             * transform kernel. With cache, each block caches the top levels of the search tree in shared memory.
+             * @tparam TCacheLevels The number of cached tree levels. 0 disables the cache.
+             * @tparam TUpper If true, the upper bound is searched, otherwise the lower bound.
+             */
+            template<
+                typename TAcc,
+                typename WorkDivPolicy,
+                typename MemAccessPolicy,
+                uint32_t TCacheLevels,
+                bool TUpper,
+                typename TCompareOperator,
+                typename TDevAcc,
+                typename TQueue,
+                typename TIdx,
+                typename TIterator,
+                typename TQueryIterator,
+                typename TOutputIterator,
+                typename TCompare>
+            void boundImpl(
+                TDevAcc& devAcc,
+                TQueue& queue,
+                TIterator const& sorted,
+                TIdx const& n,
+                TQueryIterator const& queries,
+                TIdx const& nQueries,
+                TOutputIterator const& destination,
+                TCompare const& compare)
+            {
+                using TValue = typename std::iterator_traits<TIterator>::value_type;
+                if(nQueries == 0)
+                {
+                    return;
+                }
+                using Kernel = CachedBoundKernel<
+                    WorkDivPolicy::template getBlockSize<TAcc>(),
+                    MemAccessPolicy,
+                    TCacheLevels,
+                    TUpper,
+                    TValue,
+                    TCompareOperator>;
+                constexpr TIdx cacheSize = static_cast<TIdx>(Kernel::cacheSize);
+                // the cache is only useful, if the sorted sequence is bigger than the cache and the cache is
+                // reused by enough queries
+                if(TCacheLevels == 0 || n <= cacheSize || nQueries < cacheSize)
+                {
+                    vikunja::transform::deviceTransform<TAcc, WorkDivPolicy, MemAccessPolicy>(
+                        devAcc,
+                        queue,
+                        nQueries,
+                        queries,
+                        destination,
+                        BoundFunc<TUpper, TCompareOperator, TIterator, TIdx, TCompare>{sorted, n, compare});
+                    return;
+                }
+
+                vikunja::affinity::applyAffinity<TAcc>();
+                constexpr uint64_t blockSize = WorkDivPolicy::template getBlockSize<TAcc>();
+                using Dim = alpaka::Dim<TAcc>;
+                using WorkDiv = alpaka::WorkDivMembers<Dim, TIdx>;
+                using Vec = alpaka::Vec<Dim, TIdx>;
+                constexpr TIdx xIndex = Dim::value - 1u;
+
+                // each block loads the cache, therefore it should search at least as many queries
+                TIdx gridSize = WorkDivPolicy::template getGridSize<TAcc>(devAcc);
+                TIdx const maxGridSize = nQueries / cacheSize;
+                if(gridSize > maxGridSize)
+                {
+                    gridSize = maxGridSize;
+                }
+
+                Vec const elementsPerThread(Vec::all(static_cast<TIdx>(1u)));
+                Vec threadsPerBlock(Vec::all(static_cast<TIdx>(1u)));
+                Vec blocksPerGrid(Vec::all(static_cast<TIdx>(1u)));
+                blocksPerGrid[xIndex] = gridSize;
+                threadsPerBlock[xIndex] = static_cast<TIdx>(blockSize);
+
+                WorkDiv const multiBlockWorkDiv{blocksPerGrid, threadsPerBlock, elementsPerThread};
+                Kernel kernel;
+                alpaka::exec<TAcc>(
+                    queue,
+                    multiBlockWorkDiv,
+                    kernel,
+                    sorted,
+                    n,
+                    queries,
+                    destination,
+                    nQueries,
+                    compare);
+            }
+
+            /**
+             * Searches the bounds of sorted queries with the merge path of the queries and the sorted sequence.
+             * @tparam TUpper If true, the upper bound is searched, otherwise the lower bound.
+             */
+            template<
+                typename TAcc,
+                typename WorkDivPolicy,
+                bool TUpper,
+                typename TCompareOperator,
+                typename TDevAcc,
+                typename TQueue,
+                typename TIdx,
+                typename TIterator,
+                typename TQueryIterator,
+                typename TOutputIterator,
+                typename TCompare>
+            void sortedBoundImpl(
+                TDevAcc& devAcc,
+                TQueue& queue,
+                TIterator const& sorted,
+                TIdx const& n,
+                TQueryIterator const& queries,
+                TIdx const& nQueries,
+                TOutputIterator const& destination,
+                TCompare const& compare)
+            {
+                if(nQueries == 0)
+                {
+                    return;
+                }
+                vikunja::affinity::applyAffinity<TAcc>();
+                constexpr uint64_t blockSize = WorkDivPolicy::template getBlockSize<TAcc>();
+                using Dim = alpaka::Dim<TAcc>;
+                using WorkDiv = alpaka::WorkDivMembers<Dim, TIdx>;
+                using Vec = alpaka::Vec<Dim, TIdx>;
+                constexpr TIdx xIndex = Dim::value - 1u;
+
+                Vec const elementsPerThread(Vec::all(static_cast<TIdx>(1u)));
+                Vec threadsPerBlock(Vec::all(static_cast<TIdx>(1u)));
+                Vec blocksPerGrid(Vec::all(static_cast<TIdx>(1u)));
+
+                TIdx const pathLength = n + nQueries;
+                if(pathLength >= static_cast<TIdx>(blockSize))
+                {
+                    TIdx gridSize = WorkDivPolicy::template getGridSize<TAcc>(devAcc);
+                    TIdx const maxGridSize = pathLength / static_cast<TIdx>(blockSize);
+                    blocksPerGrid[xIndex] = (gridSize < maxGridSize) ? gridSize : maxGridSize;
+                    threadsPerBlock[xIndex] = static_cast<TIdx>(blockSize);
+                }
+                WorkDiv const workDiv{blocksPerGrid, threadsPerBlock, elementsPerThread};
+                SortedBoundKernel<TUpper, TCompareOperator> kernel;
+                alpaka::exec<TAcc>(queue, workDiv, kernel, sorted, n, queries, destination, nQueries, compare);
+            }
+        } // namespace detail
+
+        /**
+         * Searches the lower bound of each query in a sorted sequence, i.e. the index of the first element of the
+         * sequence, which is not less than the query, like std::lower_bound. The queries can be in any order. Each
+         * query is searched with a binary search, which is executed by the transform kernel.
+         * If TCacheLevels is greater than zero and the sequence and the number of queries are big enough, each
+         * block loads the top TCacheLevels levels of the implicit search tree of the sequence, i.e.
+         * 2^TCacheLevels - 1 evenly spaced elements, to the shared memory first. The first search steps of all
+         * queries of the block are done in the shared memory.
+         * @tparam TAcc The alpaka accelerator type to use.
+         * @tparam WorkDivPolicy The working division policy. Defaults to a templated value depending on the
+         * accelerator. For the API of this, see workdiv/BlockBasedWorkDiv.hpp
+         * @tparam MemAccessPolicy The memory access policy of the queries. Defaults to a templated value depending
+         * on the accelerator. For the API of this, see vikunja::MemAccess::PolicyBasedBlockStrategy
+         * @tparam TCacheLevels The number of cached levels of the search tree. Defaults to no cache.
+         * @tparam TIterator Type of the sorted sequence. Should be a pointer-like type.
+         * @tparam TQueryIterator Type of the query iterator. Should be a pointer-like type.
+         * @tparam TOutputIterator Type of the output iterator. Should be a pointer-like type.
+         * @tparam TCompare Type of the comparator. Defaults to operator<.
+         * @tparam TDevAcc The type of the alpaka accelerator.
+         * @tparam TQueue The type of the alpaka queue.
+         * @tparam TIdx The index type to use.
+         * @tparam TCompareOperator The vikunja::operators type of the comparator.
+         * @param devAcc The alpaka accelerator.
+         * @param queue The alpaka queue.
+         * @param sortedBegin The begin of the sorted sequence.
+         * @param sortedEnd The end of the sorted sequence.
+         * @param queries The queries.
+         * @param nQueries The number of queries.
+         * @param destination The output iterator, which gets the index of the bound of each query.
+         * @param compare The comparator, which was used to sort the sequence. Returns true if its first argument
+         * is ordered before the second one.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename MemAccessPolicy = vikunja::MemAccess::MemAccessPolicy<TAcc>,
+            uint32_t TCacheLevels = 0u,
+            typename TIterator,
+            typename TQueryIterator,
+            typename TOutputIterator,
+            typename TCompare = vikunja::operators::Less<typename std::iterator_traits<TIterator>::value_type>,
+            typename TDevAcc,
+            typename TQueue,
+            typename TIdx,
+            typename TValue = typename std::iterator_traits<TIterator>::value_type,
+            typename TCompareOperator = vikunja::operators::BinaryOp<TAcc, TCompare, TValue, TValue>>
+        auto deviceLowerBound(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            TIterator const& sortedBegin,
+            TIterator const& sortedEnd,
+            TQueryIterator const& queries,
+            TIdx const& nQueries,
+            TOutputIterator const& destination,
+            TCompare const& compare = TCompare{}) -> void
+        {
+            assert(sortedEnd >= sortedBegin);
+            detail::boundImpl<TAcc, WorkDivPolicy, MemAccessPolicy, TCacheLevels, false, TCompareOperator>(
+                devAcc,
+                queue,
+                sortedBegin,
+                static_cast<TIdx>(sortedEnd - sortedBegin),
+                queries,
+                nQueries,
+                destination,
+                compare);
+        }
+
+        /**
+         * Searches the upper bound of each query in a sorted sequence, i.e. the index of the first element of the
+         * sequence, which is greater than the query, like std::upper_bound.
+         * @see deviceLowerBound
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename MemAccessPolicy = vikunja::MemAccess::MemAccessPolicy<TAcc>,
+            uint32_t TCacheLevels = 0u,
+            typename TIterator,
+            typename TQueryIterator,
+            typename TOutputIterator,
+            typename TCompare = vikunja::operators::Less<typename std::iterator_traits<TIterator>::value_type>,
+            typename TDevAcc,
+            typename TQueue,
+            typename TIdx,
+            typename TValue = typename std::iterator_traits<TIterator>::value_type,
+            typename TCompareOperator = vikunja::operators::BinaryOp<TAcc, TCompare, TValue, TValue>>
+        auto deviceUpperBound(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            TIterator const& sortedBegin,
+            TIterator const& sortedEnd,
+            TQueryIterator const& queries,
+            TIdx const& nQueries,
+            TOutputIterator const& destination,
+            TCompare const& compare = TCompare{}) -> void
+        {
+            assert(sortedEnd >= sortedBegin);
+            detail::boundImpl<TAcc, WorkDivPolicy, MemAccessPolicy, TCacheLevels, true, TCompareOperator>(
+                devAcc,
+                queue,
+                sortedBegin,
+                static_cast<TIdx>(sortedEnd - sortedBegin),
+                queries,
+                nQueries,
+                destination,
+                compare);
+        }
+
+        /**
+         * Lower bound of sorted queries. Instead of a binary search for each query, the queries are merged with
+         * the sorted sequence. Each thread processes an equal share of the merge path, therefore the sequence and
+         * the queries are read only once and the work is balanced independent of the distribution of the queries.
+         * The queries must be sorted with the same comparator as the sequence.
+         * @see deviceLowerBound
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TIterator,
+            typename TQueryIterator,
+            typename TOutputIterator,
+            typename TCompare = vikunja::operators::Less<typename std::iterator_traits<TIterator>::value_type>,
+            typename TDevAcc,
+            typename TQueue,
+            typename TIdx,
+            typename TValue = typename std::iterator_traits<TIterator>::value_type,
+            typename TCompareOperator = vikunja::operators::BinaryOp<TAcc, TCompare, TValue, TValue>>
+        auto deviceSortedLowerBound(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            TIterator const& sortedBegin,
+            TIterator const& sortedEnd,
+            TQueryIterator const& queries,
+            TIdx const& nQueries,
+            TOutputIterator const& destination,
+            TCompare const& compare = TCompare{}) -> void
+        {
+            assert(sortedEnd >= sortedBegin);
+            detail::sortedBoundImpl<TAcc, WorkDivPolicy, false, TCompareOperator>(
+                devAcc,
+                queue,
+                sortedBegin,
+                static_cast<TIdx>(sortedEnd - sortedBegin),
+                queries,
+                nQueries,
+                destination,
+                compare);
+        }
+
+        /**
+         * Upper bound of sorted queries.
+         * @see deviceSortedLowerBound
+         * @see deviceUpperBound
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TIterator,
+            typename TQueryIterator,
+            typename TOutputIterator,
+            typename TCompare = vikunja::operators::Less<typename std::iterator_traits<TIterator>::value_type>,
+            typename TDevAcc,
+            typename TQueue,
+            typename TIdx,
+            typename TValue = typename std::iterator_traits<TIterator>::value_type,
+            typename TCompareOperator = vikunja::operators::BinaryOp<TAcc, TCompare, TValue, TValue>>
+        auto deviceSortedUpperBound(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            TIterator const& sortedBegin,
+            TIterator const& sortedEnd,
+            TQueryIterator const& queries,
+            TIdx const& nQueries,
+            TOutputIterator const& destination,
+            TCompare const& compare = TCompare{}) -> void
+        {
+            assert(sortedEnd >= sortedBegin);
+            detail::sortedBoundImpl<TAcc, WorkDivPolicy, true, TCompareOperator>(
+                devAcc,
+                queue,
+                sortedBegin,
+                static_cast<TIdx>(sortedEnd - sortedBegin),
+                queries,
+                nQueries,
+                destination,
+                compare);
+        }
+    } // namespace search
+} // namespace vikunja
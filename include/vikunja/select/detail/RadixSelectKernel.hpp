@@ -0,0 +1,197 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/access/BlockStrategy.hpp>
+#include <vikunja/reduce/detail/BlockThreadReduceKernel.hpp>
+#include <vikunja/scan/detail/BlockThreadScanKernel.hpp>
+#include <vikunja/sort/detail/RadixSortKernel.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+#include <cstdint>
+#include <type_traits>
+
+namespace vikunja
+{
+    namespace select
+    {
+        namespace detail
+        {
+            /**
+             * One pass of the radix select: each block counts the digits of the keys of its threads, whose more
+             * significant bits are equal to the bits of the searched key, which are already known, in a histogram in
+             * the shared memory. Each block adds its histogram to the global histogram with one atomic operation per
+             * bin.
+             * @tparam TBlockSize The block size of this kernel.
+             */
+            template<uint64_t TBlockSize>
+            struct RadixSelectHistogramKernel
+            {
+                /**
+                 * @param acc The alpaka accelerator.
+                 * @param keys The input keys.
+                 * @param histogram The zero initialized output histogram with radixSize elements.
+                 * @param n The number of keys.
+                 * @param prefix The known bits of the searched key.
+                 * @param prefixMask The mask of the known bits.
+                 * @param shift The first bit of the digit.
+                 */
+                template<typename TAcc, typename TIdx, typename TKeyIterator, typename TBits>
+                ALPAKA_FN_ACC void operator()(
+                    TAcc const& acc,
+                    TKeyIterator const& keys,
+                    TIdx* const histogram,
+                    TIdx const& n,
+                    TBits const prefix,
+                    TBits const prefixMask,
+                    uint32_t const shift) const
+                {
+                    using vikunja::sort::detail::radixSize;
+                    using TKey = std::decay_t<decltype(keys[0])>;
+                    using KeyTraits = vikunja::sort::detail::RadixKeyTraits<TKey>;
+
+                    using SharedArray = vikunja::reduce::detail::sharedStaticArray<TIdx, radixSize>;
+                    auto& counts(alpaka::declareSharedVar<SharedArray, __COUNTER__>(acc));
+
+                    constexpr TIdx xIndex = alpaka::Dim<TAcc>::value - 1u;
+                    auto const threadIndex = alpaka::getIdx<alpaka::Block, alpaka::Threads>(acc)[xIndex];
+                    for(TIdx d = threadIndex; d < radixSize; d += static_cast<TIdx>(TBlockSize))
+                    {
+                        counts[d] = 0;
+                    }
+                    alpaka::syncBlockThreads(acc);
+
+                    using MemIndex = vikunja::MemAccess::BlockStrategy<vikunja::scan::detail::ChunkPolicy, TAcc, TIdx>;
+                    for(MemIndex iter(acc, n, TBlockSize), end = iter.end(); iter < end; ++iter)
+                    {
+                        TBits const bits = KeyTraits::toBits(keys[*iter]);
+                        if((bits & prefixMask) == prefix)
+                        {
+                            alpaka::atomicOp<alpaka::AtomicAdd>(
+                                acc,
+                                &counts[static_cast<uint32_t>(bits >> shift) & (radixSize - 1u)],
+                                static_cast<TIdx>(1u),
+                                alpaka::hierarchy::Threads{});
+                        }
+                    }
+                    alpaka::syncBlockThreads(acc);
+
+                    for(TIdx d = threadIndex; d < radixSize; d += static_cast<TIdx>(TBlockSize))
+                    {
+                        if(counts[d] != 0)
+                        {
+                            alpaka::atomicOp<alpaka::AtomicAdd>(
+                                acc,
+                                &histogram[d],
+                                counts[d],
+                                alpaka::hierarchy::Grids{});
+                        }
+                    }
+                }
+            };
+
+            /**
+             * Writes the k largest keys and their indices. All keys greater than the threshold are selected and as
+             * many keys equal to the threshold as needed to get k keys. Each thread reserves the output positions of
+             * its chunk with atomic operations, therefore the order of the output is not defined.
+             * @tparam TBlockSize The block size of this kernel.
+             */
+            template<uint64_t TBlockSize>
+            struct TopKKernel
+            {
+                /**
+                 * @param acc The alpaka accelerator.
+                 * @param keys The input keys.
+                 * @param outValues The output keys.
+                 * @param outIndices The output indices.
+                 * @param counters Two zero initialized counters for the greater and the equal keys.
+                 * @param n The number of keys.
+                 * @param k The number of keys to select.
+                 * @param numGreater The number of keys greater than the threshold.
+                 * @param threshold The bits of the k-th largest key.
+                 */
+                template<
+                    typename TAcc,
+                    typename TIdx,
+                    typename TKeyIterator,
+                    typename TValueOutputIterator,
+                    typename TIndexOutputIterator,
+                    typename TBits>
+                ALPAKA_FN_ACC void operator()(
+                    TAcc const& acc,
+                    TKeyIterator const& keys,
+                    TValueOutputIterator const& outValues,
+                    TIndexOutputIterator const& outIndices,
+                    TIdx* const counters,
+                    TIdx const& n,
+                    TIdx const& k,
+                    TIdx const& numGreater,
+                    TBits const threshold) const
+                {
+                    using TKey = std::decay_t<decltype(keys[0])>;
+                    using KeyTraits = vikunja::sort::detail::RadixKeyTraits<TKey>;
+                    using MemIndex = vikunja::MemAccess::BlockStrategy<vikunja::scan::detail::ChunkPolicy, TAcc, TIdx>;
+
+                    TIdx greaterCount = 0;
+                    TIdx equalCount = 0;
+                    for(MemIndex iter(acc, n, TBlockSize), end = iter.end(); iter < end; ++iter)
+                    {
+                        TBits const bits = KeyTraits::toBits(keys[*iter]);
+                        greaterCount += (bits > threshold) ? 1 : 0;
+                        equalCount += (bits == threshold) ? 1 : 0;
+                    }
+                    if(greaterCount == 0 && equalCount == 0)
+                    {
+                        return;
+                    }
+
+                    TIdx greater = 0;
+                    if(greaterCount != 0)
+                    {
+                        greater = alpaka::atomicOp<alpaka::AtomicAdd>(
+                            acc,
+                            &counters[0],
+                            greaterCount,
+                            alpaka::hierarchy::Grids{});
+                    }
+                    // the keys equal to the threshold are written behind all greater keys
+                    TIdx equal = numGreater;
+                    if(equalCount != 0)
+                    {
+                        equal += alpaka::atomicOp<alpaka::AtomicAdd>(
+                            acc,
+                            &counters[1],
+                            equalCount,
+                            alpaka::hierarchy::Grids{});
+                    }
+
+                    for(MemIndex iter(acc, n, TBlockSize), end = iter.end(); iter < end; ++iter)
+                    {
+                        auto const key = keys[*iter];
+                        TBits const bits = KeyTraits::toBits(key);
+                        if(bits > threshold)
+                        {
+                            outValues[greater] = key;
+                            outIndices[greater] = *iter;
+                            ++greater;
+                        }
+                        else if(bits == threshold && equal < k)
+                        {
+                            outValues[equal] = key;
+                            outIndices[equal] = *iter;
+                            ++equal;
+                        }
+                    }
+                }
+            };
+        } // namespace detail
+    } // namespace select
+} // namespace vikunja
@@ -0,0 +1,400 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/affinity/Affinity.hpp>
+#include <vikunja/select/detail/RadixSelectKernel.hpp>
+#include <vikunja/sort/detail/RadixSortKernel.hpp>
+#include <vikunja/workdiv/BlockBasedWorkDiv.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <cstdint>
+#include <iterator>
+
+namespace vikunja
+{
+    namespace select
+    {
+        namespace detail
+        {
+            /**
+             * Result of the radix select.
+             * @tparam TBits The unsigned integer representation of the key type.
+             * @tparam TIdx The index type.
+             */
+            template<typename TBits, typename TIdx>
+            struct RadixSelectResult
+            {
+                //! The bits of the selected key.
+                TBits bits;
+                //! The number of keys less than the selected key.
+                TIdx numLess;
+                //! The number of keys equal to the selected key.
+                TIdx numEqual;
+            };
+
+            /**
+             * Finds the key with the given rank in ascending order with a most significant digit radix select. Each
+             * pass counts the digits of all keys, which match the already known bits of the searched key, and
+             * selects the digit containing the rank on the host. Only the histogram of radixSize elements is copied to
+             * the host, the keys are never moved. If TWriteTopK is true, the keys greater than or equal to the
+             * selected key are written to the output afterwards, so that the output contains the n - rank largest
+             * keys.
+             * @tparam TBlockSize The block size of the kernels.
+             * @tparam TWriteTopK If false, the output iterators are not accessed.
+             * @param gridSize The number of blocks. The number of keys must be at least gridSize * TBlockSize.
+             * @param rank The rank of the searched key in ascending order. Must be less than n.
+             */
+            template<
+                typename TAcc,
+                uint64_t TBlockSize,
+                bool TWriteTopK,
+                typename TDevAcc,
+                typename TDevHost,
+                typename TQueue,
+                typename TIdx,
+                typename TKeyIterator,
+                typename TValueOutputIterator,
+                typename TIndexOutputIterator>
+            auto radixSelectPasses(
+                TDevAcc& devAcc,
+                TDevHost& devHost,
+                TQueue& queue,
+                TIdx const& n,
+                TIdx const& gridSize,
+                TKeyIterator const& keys,
+                TIdx const& rank,
+                TValueOutputIterator const& outValues,
+                TIndexOutputIterator const& outIndices)
+            {
+                using vikunja::sort::detail::radixBits;
+                using vikunja::sort::detail::radixSize;
+                using TKey = typename std::iterator_traits<TKeyIterator>::value_type;
+                using TBits = typename vikunja::sort::detail::RadixKeyTraits<TKey>::TBits;
+                using Dim = alpaka::Dim<TAcc>;
+                using WorkDiv = alpaka::WorkDivMembers<Dim, TIdx>;
+                using Vec = alpaka::Vec<Dim, TIdx>;
+                constexpr TIdx xIndex = Dim::value - 1u;
+
+                Vec const elementsPerThread(Vec::all(static_cast<TIdx>(1u)));
+                Vec threadsPerBlock(Vec::all(static_cast<TIdx>(1u)));
+                Vec blocksPerGrid(Vec::all(static_cast<TIdx>(1u)));
+                blocksPerGrid[xIndex] = gridSize;
+                threadsPerBlock[xIndex] = static_cast<TIdx>(TBlockSize);
+                WorkDiv const multiBlockWorkDiv{blocksPerGrid, threadsPerBlock, elementsPerThread};
+
+                Vec histogramExtent(Vec::all(static_cast<TIdx>(1u)));
+                histogramExtent[xIndex] = static_cast<TIdx>(radixSize);
+                auto histogram = alpaka::allocBuf<TIdx, TIdx>(devAcc, histogramExtent);
+                auto hostHistogram = alpaka::allocBuf<TIdx, TIdx>(devHost, histogramExtent);
+                TIdx const* const hostHistogramPtr = alpaka::getPtrNative(hostHistogram);
+
+                RadixSelectHistogramKernel<TBlockSize> histogramKernel;
+                RadixSelectResult<TBits, TIdx> result{0, 0, n};
+                TBits prefixMask = 0;
+                TIdx remainingRank = rank;
+                for(uint32_t shift = sizeof(TKey) * CHAR_BIT; shift > 0;)
+                {
+                    shift -= radixBits;
+                    alpaka::memset(queue, histogram, 0u, histogramExtent);
+                    alpaka::exec<TAcc>(
+                        queue,
+                        multiBlockWorkDiv,
+                        histogramKernel,
+                        keys,
+                        alpaka::getPtrNative(histogram),
+                        n,
+                        result.bits,
+                        prefixMask,
+                        shift);
+                    alpaka::memcpy(queue, hostHistogram, histogram, histogramExtent);
+                    alpaka::wait(queue);
+
+                    // select the digit, which contains the searched rank
+                    uint32_t digit = 0;
+                    while(remainingRank >= hostHistogramPtr[digit])
+                    {
+                        remainingRank -= hostHistogramPtr[digit];
+                        result.numLess += hostHistogramPtr[digit];
+                        ++digit;
+                    }
+                    result.numEqual = hostHistogramPtr[digit];
+                    result.bits |= static_cast<TBits>(digit) << shift;
+                    prefixMask |= static_cast<TBits>(radixSize - 1u) << shift;
+                }
+
+                if constexpr(TWriteTopK)
+                {
+                    Vec countersExtent(Vec::all(static_cast<TIdx>(1u)));
+                    countersExtent[xIndex] = static_cast<TIdx>(2u);
+                    auto counters = alpaka::allocBuf<TIdx, TIdx>(devAcc, countersExtent);
+                    alpaka::memset(queue, counters, 0u, countersExtent);
+                    TopKKernel<TBlockSize> topKKernel;
+                    alpaka::exec<TAcc>(
+                        queue,
+                        multiBlockWorkDiv,
+                        topKKernel,
+                        keys,
+                        outValues,
+                        outIndices,
+                        alpaka::getPtrNative(counters),
+                        n,
+                        n - rank,
+                        n - result.numLess - result.numEqual,
+                        result.bits);
+                    // the helper memory must not be freed before the kernel is finished
+                    alpaka::wait(queue);
+                }
+                return result;
+            }
+
+            /**
+             * Selects the work division of the radix select. Each thread needs at least one key and each block should
+             * have enough keys to amortize its histogram.
+             */
+            template<
+                typename TAcc,
+                typename WorkDivPolicy,
+                bool TWriteTopK,
+                typename TDevAcc,
+                typename TDevHost,
+                typename TQueue,
+                typename TIdx,
+                typename TKeyIterator,
+                typename TValueOutputIterator,
+                typename TIndexOutputIterator>
+            auto radixSelectImpl(
+                TDevAcc& devAcc,
+                TDevHost& devHost,
+                TQueue& queue,
+                TIdx const& n,
+                TKeyIterator const& keys,
+                TIdx const& rank,
+                TValueOutputIterator const& outValues,
+                TIndexOutputIterator const& outIndices)
+            {
+                using vikunja::sort::detail::radixSize;
+                vikunja::affinity::applyAffinity<TAcc>();
+                constexpr uint64_t blockSize = WorkDivPolicy::template getBlockSize<TAcc>();
+                if(n < static_cast<TIdx>(blockSize))
+                {
+                    return radixSelectPasses<TAcc, 1u, TWriteTopK>(
+                        devAcc,
+                        devHost,
+                        queue,
+                        n,
+                        static_cast<TIdx>(1u),
+                        keys,
+                        rank,
+                        outValues,
+                        outIndices);
+                }
+                TIdx gridSize = WorkDivPolicy::template getGridSize<TAcc>(devAcc);
+                TIdx const maxGridSize = n / std::max(static_cast<TIdx>(blockSize), static_cast<TIdx>(radixSize));
+                if(gridSize > maxGridSize)
+                {
+                    gridSize = maxGridSize;
+                }
+                if(gridSize < 1)
+                {
+                    gridSize = 1;
+                }
+                return radixSelectPasses<TAcc, blockSize, TWriteTopK>(
+                    devAcc,
+                    devHost,
+                    queue,
+                    n,
+                    gridSize,
+                    keys,
+                    rank,
+                    outValues,
+                    outIndices);
+            }
+        } // namespace detail
+
+        /**
+         * Returns the element, which would be at position nth, if the input was sorted in ascending order. For
+         * example, the median of an input with an odd number of elements is the element at position n / 2.
+         * The element is found with a most significant digit radix select without sorting or moving the input:
+         * each pass counts 8 bits of the keys, which match the already known bits of the result, and copies a
+         * histogram with 256 elements to the host. Integral and floating point types are supported, the order is
+         * the order of the radix sort.
+         * @tparam TAcc The alpaka accelerator type to use.
+         * @tparam WorkDivPolicy The working division policy. Defaults to a templated value depending on the
+         * accelerator. Each thread needs a contiguous chunk of the input, therefore the linear memory access policy
+         * is always used.
+         * @tparam TInputIterator Type of the input iterator. Should be a pointer-like type.
+         * @tparam TDevAcc The type of the alpaka accelerator.
+         * @tparam TDevHost The type of the alpaka host.
+         * @tparam TQueue The type of the alpaka queue.
+         * @tparam TIdx The index type to use.
+         * @param devAcc The alpaka accelerator.
+         * @param devHost The alpaka host.
+         * @param queue The alpaka queue. The function waits for the queue, before it returns.
+         * @param n The number of elements in the input.
+         * @param input The input iterator.
+         * @param nth The position of the searched element in the sorted input. Must be less than n.
+         * @return The nth element.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TInputIterator,
+            typename TDevAcc,
+            typename TDevHost,
+            typename TQueue,
+            typename TIdx>
+        auto deviceNthElement(
+            TDevAcc& devAcc,
+            TDevHost& devHost,
+            TQueue& queue,
+            TIdx const& n,
+            TInputIterator const& input,
+            TIdx const& nth) -> typename std::iterator_traits<TInputIterator>::value_type
+        {
+            using TKey = typename std::iterator_traits<TInputIterator>::value_type;
+            assert(nth < n);
+            auto const result = detail::radixSelectImpl<TAcc, WorkDivPolicy, false>(
+                devAcc,
+                devHost,
+                queue,
+                n,
+                input,
+                nth,
+                static_cast<TKey*>(nullptr),
+                static_cast<TIdx*>(nullptr));
+            return vikunja::sort::detail::RadixKeyTraits<TKey>::fromBits(result.bits);
+        }
+
+        /**
+         * Nth element with begin and end iterator of the input.
+         * @see deviceNthElement
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TInputIterator,
+            typename TDevAcc,
+            typename TDevHost,
+            typename TQueue,
+            typename TIdx>
+        auto deviceNthElement(
+            TDevAcc& devAcc,
+            TDevHost& devHost,
+            TQueue& queue,
+            TInputIterator const& inputBegin,
+            TInputIterator const& inputEnd,
+            TIdx const& nth)
+        {
+            assert(inputEnd >= inputBegin);
+            using Idx = typename alpaka::trait::IdxType<TAcc>::type;
+            auto size = static_cast<Idx>(inputEnd - inputBegin);
+            return deviceNthElement<TAcc, WorkDivPolicy>(
+                devAcc,
+                devHost,
+                queue,
+                size,
+                inputBegin,
+                static_cast<Idx>(nth));
+        }
+
+        /**
+         * Writes the k largest elements of the input and their indices to the output. The order of the output is not
+         * defined. If the k-th largest element occurs several times, it is not defined, which of its occurrences are
+         * written.
+         * The k-th largest element is found with the radix select of deviceNthElement, afterwards a single kernel
+         * writes all greater elements and the missing number of equal elements. The work does not depend on k and
+         * the input is never sorted.
+         * @see deviceNthElement
+         * @tparam TValueOutputIterator Type of the output iterator of the elements. Should be a pointer-like type.
+         * @tparam TIndexOutputIterator Type of the output iterator of the indices. Should be a pointer-like type.
+         * @param k The number of elements to select. Must not be greater than n.
+         * @param outValues The output iterator for the k largest elements.
+         * @param outIndices The output iterator for the indices of the k largest elements in the input.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TInputIterator,
+            typename TValueOutputIterator,
+            typename TIndexOutputIterator,
+            typename TDevAcc,
+            typename TDevHost,
+            typename TQueue,
+            typename TIdx>
+        auto deviceTopK(
+            TDevAcc& devAcc,
+            TDevHost& devHost,
+            TQueue& queue,
+            TIdx const& n,
+            TInputIterator const& input,
+            TIdx const& k,
+            TValueOutputIterator const& outValues,
+            TIndexOutputIterator const& outIndices) -> void
+        {
+            assert(k <= n);
+            if(k == 0)
+            {
+                return;
+            }
+            detail::radixSelectImpl<TAcc, WorkDivPolicy, true>(
+                devAcc,
+                devHost,
+                queue,
+                n,
+                input,
+                n - k,
+                outValues,
+                outIndices);
+        }
+
+        /**
+         * Top k with begin and end iterator of the input.
+         * @see deviceTopK
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TInputIterator,
+            typename TValueOutputIterator,
+            typename TIndexOutputIterator,
+            typename TDevAcc,
+            typename TDevHost,
+            typename TQueue,
+            typename TIdx>
+        auto deviceTopK(
+            TDevAcc& devAcc,
+            TDevHost& devHost,
+            TQueue& queue,
+            TInputIterator const& inputBegin,
+            TInputIterator const& inputEnd,
+            TIdx const& k,
+            TValueOutputIterator const& outValues,
+            TIndexOutputIterator const& outIndices) -> void
+        {
+            assert(inputEnd >= inputBegin);
+            using Idx = typename alpaka::trait::IdxType<TAcc>::type;
+            auto size = static_cast<Idx>(inputEnd - inputBegin);
+            deviceTopK<TAcc, WorkDivPolicy>(
+                devAcc,
+                devHost,
+                queue,
+                size,
+                inputBegin,
+                static_cast<Idx>(k),
+                outValues,
+                outIndices);
+        }
+    } // namespace select
+} // namespace vikunja
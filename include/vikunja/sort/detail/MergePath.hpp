@@ -0,0 +1,126 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <alpaka/alpaka.hpp>
+
+namespace vikunja
+{
+    namespace sort
+    {
+        namespace detail
+        {
+            /**
+             * Searches the intersection of a diagonal of the merge path with the path. The merge path of the sorted
+             * sequences a and b is the sequence of decisions of a serial merge. The first diagonal elements of the
+             * merged output contain the first i elements of a and the first diagonal - i elements of b. On equal
+             * elements, the element of a is taken first.
+             * @tparam TCompareOperator The vikunja::operators type of the comparator.
+             * @param acc The alpaka accelerator.
+             * @param a The first sorted sequence.
+             * @param na The size of the first sequence.
+             * @param b The second sorted sequence.
+             * @param nb The size of the second sequence.
+             * @param diagonal The number of merged elements. Must not be greater than na + nb.
+             * @param compare The comparator, which returns true if the first argument is ordered before the second.
+             * @return The number of elements of a in front of the diagonal.
+             */
+            template<
+                typename TCompareOperator,
+                typename TAcc,
+                typename TIdx,
+                typename TIteratorA,
+                typename TIteratorB,
+                typename TCompare>
+            ALPAKA_FN_HOST_ACC TIdx mergePathSearch(
+                TAcc const& acc,
+                TIteratorA const& a,
+                TIdx const na,
+                TIteratorB const& b,
+                TIdx const nb,
+                TIdx const diagonal,
+                TCompare const& compare)
+            {
+                TIdx low = (diagonal > nb) ? diagonal - nb : 0;
+                TIdx high = (diagonal < na) ? diagonal : na;
+                while(low < high)
+                {
+                    TIdx const mid = low + (high - low) / 2;
+                    if(TCompareOperator::run(acc, compare, b[diagonal - 1 - mid], a[mid]))
+                    {
+                        high = mid;
+                    }
+                    else
+                    {
+                        low = mid + 1;
+                    }
+                }
+                return low;
+            }
+
+            /**
+             * Merges count elements of the sorted sequences a and b, beginning at the position ai of a and bi of b,
+             * to the output. On equal elements, the element of a is written first, therefore the merge is stable.
+             * @tparam TCompareOperator The vikunja::operators type of the comparator.
+             * @tparam THasValues If true, the values are moved with their keys. Otherwise, the value iterators are
+             * not accessed.
+             */
+            template<
+                typename TCompareOperator,
+                bool THasValues,
+                typename TAcc,
+                typename TIdx,
+                typename TKeyIteratorA,
+                typename TValueIteratorA,
+                typename TKeyIteratorB,
+                typename TValueIteratorB,
+                typename TKeyOutputIterator,
+                typename TValueOutputIterator,
+                typename TCompare>
+            ALPAKA_FN_HOST_ACC void serialMerge(
+                TAcc const& acc,
+                TKeyIteratorA const& aKeys,
+                TValueIteratorA const& aValues,
+                TIdx ai,
+                TIdx const na,
+                TKeyIteratorB const& bKeys,
+                TValueIteratorB const& bValues,
+                TIdx bi,
+                TIdx const nb,
+                TKeyOutputIterator const& keysOut,
+                TValueOutputIterator const& valuesOut,
+                TIdx const count,
+                TCompare const& compare)
+            {
+                for(TIdx k = 0; k < count; ++k)
+                {
+                    if(bi < nb && (ai >= na || TCompareOperator::run(acc, compare, bKeys[bi], aKeys[ai])))
+                    {
+                        keysOut[k] = bKeys[bi];
+                        if constexpr(THasValues)
+                        {
+                            valuesOut[k] = bValues[bi];
+                        }
+                        ++bi;
+                    }
+                    else
+                    {
+                        keysOut[k] = aKeys[ai];
+                        if constexpr(THasValues)
+                        {
+                            valuesOut[k] = aValues[ai];
+                        }
+                        ++ai;
+                    }
+                }
+            }
+        } // namespace detail
+    } // namespace sort
+} // namespace vikunja
@@ -0,0 +1,263 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/access/BlockStrategy.hpp>
+#include <vikunja/scan/detail/BlockThreadScanKernel.hpp>
+#include <vikunja/sort/detail/MergePath.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+#include <cstdint>
+#include <iterator>
+
+namespace vikunja
+{
+    namespace sort
+    {
+        namespace detail
+        {
+            //! Number of elements, which are sorted by a single thread before the merge passes.
+            constexpr uint32_t sortTileSize = 16u;
+
+            /**
+             * Swaps the two elements, if the second one is ordered before the first one.
+             * @tparam TCompareOperator The vikunja::operators type of the comparator.
+             */
+            template<typename TCompareOperator, typename TAcc, typename TData, typename TCompare>
+            ALPAKA_FN_HOST_ACC ALPAKA_FN_INLINE void compareSwap(
+                TAcc const& acc,
+                TData& first,
+                TData& second,
+                TCompare const& compare)
+            {
+                if(TCompareOperator::run(acc, compare, second, first))
+                {
+                    TData const tmp = first;
+                    first = second;
+                    second = tmp;
+                }
+            }
+
+            /**
+             * Sorts a tile of at most sortTileSize elements in registers. The unstable variant uses Batcher's
+             * odd-even merge sorting network. The comparators, which touch an element behind the end of a partial
+             * tile, are skipped, which is equal to padding the tile with elements ordered behind all others. The
+             * stable variant uses an insertion sort.
+             * @tparam TStable If true, the order of equal elements is kept.
+             * @tparam TCompareOperator The vikunja::operators type of the comparator.
+             * @param data The begin of the tile.
+             * @param count The number of elements of the tile.
+             */
+            template<
+                bool TStable,
+                typename TCompareOperator,
+                typename TAcc,
+                typename TIdx,
+                typename TIterator,
+                typename TCompare>
+            ALPAKA_FN_HOST_ACC void sortTile(
+                TAcc const& acc,
+                TIterator const& data,
+                TIdx const count,
+                TCompare const& compare)
+            {
+                using TData = typename std::iterator_traits<TIterator>::value_type;
+                constexpr TIdx tileSize = static_cast<TIdx>(sortTileSize);
+
+                TData values[sortTileSize];
+                for(TIdx i = 0; i < count; ++i)
+                {
+                    values[i] = data[i];
+                }
+
+                if constexpr(TStable)
+                {
+                    for(TIdx i = 1; i < count; ++i)
+                    {
+                        TData const value = values[i];
+                        TIdx j = i;
+                        for(; j > 0 && TCompareOperator::run(acc, compare, value, values[j - 1]); --j)
+                        {
+                            values[j] = values[j - 1];
+                        }
+                        values[j] = value;
+                    }
+                }
+                else
+                {
+                    for(TIdx p = 1; p < tileSize; p *= 2)
+                    {
+                        for(TIdx k = p; k >= 1; k /= 2)
+                        {
+                            for(TIdx j = k % p; j + k < tileSize; j += 2 * k)
+                            {
+                                for(TIdx i = 0; i < k && i + j + k < count; ++i)
+                                {
+                                    if((i + j) / (2 * p) == (i + j + k) / (2 * p))
+                                    {
+                                        compareSwap<TCompareOperator>(acc, values[i + j], values[i + j + k], compare);
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+
+                for(TIdx i = 0; i < count; ++i)
+                {
+                    data[i] = values[i];
+                }
+            }
+
+            /**
+             * Writes the output range [begin, end) of a merge pass, which merges neighboring sorted runs of the
+             * given width. The begin of the range in the two input runs is found with the merge path, therefore
+             * ranges of equal size need equal work independent of the distribution of the data.
+             * @tparam TCompareOperator The vikunja::operators type of the comparator.
+             * @param source The input with sorted runs of the given width.
+             * @param destination The output with sorted runs of twice the width.
+             * @param n The number of elements of the input.
+             */
+            template<
+                typename TCompareOperator,
+                typename TAcc,
+                typename TIdx,
+                typename TInputIterator,
+                typename TOutputIterator,
+                typename TCompare>
+            ALPAKA_FN_HOST_ACC void mergeRuns(
+                TAcc const& acc,
+                TInputIterator const& source,
+                TOutputIterator const& destination,
+                TIdx const n,
+                TIdx const width,
+                TIdx begin,
+                TIdx const end,
+                TCompare const& compare)
+            {
+                // the range can span several pairs of runs
+                while(begin < end)
+                {
+                    TIdx const pairBegin = begin / (2 * width) * (2 * width);
+                    TIdx const middle = (n - pairBegin < width) ? n : pairBegin + width;
+                    TIdx const pairEnd = (n - middle < width) ? n : middle + width;
+                    TIdx const segmentEnd = (end < pairEnd) ? end : pairEnd;
+
+                    TIdx const na = middle - pairBegin;
+                    TIdx const nb = pairEnd - middle;
+                    TIdx const diagonal = begin - pairBegin;
+                    TIdx const ai = mergePathSearch<TCompareOperator>(
+                        acc,
+                        source + pairBegin,
+                        na,
+                        source + middle,
+                        nb,
+                        diagonal,
+                        compare);
+                    // the values are not used, therefore the keys are passed as dummy
+                    serialMerge<TCompareOperator, false>(
+                        acc,
+                        source + pairBegin,
+                        source + pairBegin,
+                        ai,
+                        na,
+                        source + middle,
+                        source + middle,
+                        diagonal - ai,
+                        nb,
+                        destination + begin,
+                        destination + begin,
+                        segmentEnd - begin,
+                        compare);
+                    begin = segmentEnd;
+                }
+            }
+
+            /**
+             * First phase of the merge sort: each thread sorts tiles of sortTileSize elements in registers.
+             * @tparam TBlockSize The block size of this kernel.
+             * @tparam TStable If true, the order of equal elements is kept.
+             * @tparam TCompareOperator The vikunja::operators type of the comparator.
+             */
+            template<uint64_t TBlockSize, bool TStable, typename TCompareOperator>
+            struct TileSortKernel
+            {
+                /**
+                 * @param acc The alpaka accelerator.
+                 * @param data The elements, which are sorted in place.
+                 * @param n The number of elements.
+                 * @param compare The comparator.
+                 */
+                template<typename TAcc, typename TIdx, typename TIterator, typename TCompare>
+                ALPAKA_FN_ACC void operator()(
+                    TAcc const& acc,
+                    TIterator const& data,
+                    TIdx const& n,
+                    TCompare const& compare) const
+                {
+                    constexpr TIdx tileSize = static_cast<TIdx>(sortTileSize);
+                    TIdx const numTiles = (n + tileSize - 1) / tileSize;
+
+                    using MemIndex = vikunja::MemAccess::BlockStrategy<vikunja::scan::detail::ChunkPolicy, TAcc, TIdx>;
+                    for(MemIndex iter(acc, numTiles, TBlockSize), end = iter.end(); iter < end; ++iter)
+                    {
+                        TIdx const tileBegin = *iter * tileSize;
+                        TIdx const count = (n - tileBegin < tileSize) ? n - tileBegin : tileSize;
+                        sortTile<TStable, TCompareOperator>(acc, data + tileBegin, count, compare);
+                    }
+                }
+            };
+
+            /**
+             * Merge pass of the merge sort: merges neighboring sorted runs of the given width. Each thread writes
+             * an equal share of the output.
+             * @tparam TBlockSize The block size of this kernel.
+             * @tparam TCompareOperator The vikunja::operators type of the comparator.
+             */
+            template<uint64_t TBlockSize, typename TCompareOperator>
+            struct MergePassKernel
+            {
+                /**
+                 * @param acc The alpaka accelerator.
+                 * @param source The input with sorted runs of the given width.
+                 * @param destination The output with sorted runs of twice the width.
+                 * @param n The number of elements.
+                 * @param width The width of the sorted runs of the input.
+                 * @param compare The comparator.
+                 */
+                template<
+                    typename TAcc,
+                    typename TIdx,
+                    typename TInputIterator,
+                    typename TOutputIterator,
+                    typename TCompare>
+                ALPAKA_FN_ACC void operator()(
+                    TAcc const& acc,
+                    TInputIterator const& source,
+                    TOutputIterator const& destination,
+                    TIdx const& n,
+                    TIdx const& width,
+                    TCompare const& compare) const
+                {
+                    constexpr TIdx xIndex = alpaka::Dim<TAcc>::value - 1u;
+                    TIdx const globalThreadIndex = alpaka::getIdx<alpaka::Grid, alpaka::Threads>(acc)[xIndex];
+                    TIdx const globalThreadCount = alpaka::getWorkDiv<alpaka::Grid, alpaka::Threads>(acc)[xIndex];
+
+                    TIdx const itemsPerThread = (n + globalThreadCount - 1) / globalThreadCount;
+                    TIdx begin = globalThreadIndex * itemsPerThread;
+                    begin = (begin < n) ? begin : n;
+                    TIdx const end = (n - begin < itemsPerThread) ? n : begin + itemsPerThread;
+                    mergeRuns<TCompareOperator>(acc, source, destination, n, width, begin, end, compare);
+                }
+            };
+        } // namespace detail
+    } // namespace sort
+} // namespace vikunja
@@ -0,0 +1,296 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/reduce/detail/BlockThreadReduceKernel.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace vikunja
+{
+    namespace sort
+    {
+        namespace detail
+        {
+            //! Number of key bits, which are sorted in one pass of the radix sort.
+            constexpr uint32_t radixBits = 8u;
+            //! Number of buckets of one pass of the radix sort.
+            constexpr uint32_t radixSize = 1u << radixBits;
+
+            /**
+             * Maps a key to an unsigned integer, whose ascending order is the ascending order of the keys, and back.
+             * @tparam TKey The key type. Integral and floating point types are supported.
+             */
+            template<typename TKey, typename TSfinae = void>
+            struct RadixKeyTraits;
+
+            template<typename TKey>
+            struct RadixKeyTraits<TKey, std::enable_if_t<std::is_integral_v<TKey> && std::is_unsigned_v<TKey>>>
+            {
+                using TBits = TKey;
+
+                static ALPAKA_FN_HOST_ACC ALPAKA_FN_INLINE TBits toBits(TKey const key)
+                {
+                    return key;
+                }
+
+                static ALPAKA_FN_HOST_ACC ALPAKA_FN_INLINE TKey fromBits(TBits const bits)
+                {
+                    return bits;
+                }
+            };
+
+            template<typename TKey>
+            struct RadixKeyTraits<TKey, std::enable_if_t<std::is_integral_v<TKey> && std::is_signed_v<TKey>>>
+            {
+                using TBits = std::make_unsigned_t<TKey>;
+
+                static ALPAKA_FN_HOST_ACC ALPAKA_FN_INLINE TBits toBits(TKey const key)
+                {
+                    // negative values are sorted in front of the positive values
+                    return static_cast<TBits>(key) ^ (TBits{1} << (sizeof(TKey) * CHAR_BIT - 1u));
+                }
+
+                static ALPAKA_FN_HOST_ACC ALPAKA_FN_INLINE TKey fromBits(TBits const bits)
+                {
+                    return static_cast<TKey>(bits ^ (TBits{1} << (sizeof(TKey) * CHAR_BIT - 1u)));
+                }
+            };
+
+            template<typename TKey>
+            struct RadixKeyTraits<TKey, std::enable_if_t<std::is_floating_point_v<TKey>>>
+            {
+                static_assert(
+                    sizeof(TKey) == 4u || sizeof(TKey) == 8u,
+                    "Only IEEE 754 float and double are supported.");
+                using TBits = std::conditional_t<sizeof(TKey) == 4u, std::uint32_t, std::uint64_t>;
+
+                static ALPAKA_FN_HOST_ACC ALPAKA_FN_INLINE TBits toBits(TKey const key)
+                {
+                    TBits bits;
+                    std::memcpy(&bits, &key, sizeof(TKey));
+                    constexpr TBits signBit = TBits{1} << (sizeof(TKey) * CHAR_BIT - 1u);
+                    // negative values: reverse the order of the magnitude, positive values: sort behind negative
+                    return bits ^ ((bits & signBit) ? ~TBits{0} : signBit);
+                }
+
+                static ALPAKA_FN_HOST_ACC ALPAKA_FN_INLINE TKey fromBits(TBits const bits)
+                {
+                    constexpr TBits signBit = TBits{1} << (sizeof(TKey) * CHAR_BIT - 1u);
+                    TBits const keyBits = bits ^ ((bits & signBit) ? signBit : ~TBits{0});
+                    TKey key;
+                    std::memcpy(&key, &keyBits, sizeof(TKey));
+                    return key;
+                }
+            };
+
+            /**
+             * Returns the digit of a key for the pass, which starts at bit shift.
+             */
+            template<typename TKey>
+            ALPAKA_FN_HOST_ACC ALPAKA_FN_INLINE uint32_t
+            getDigit(TKey const& key, uint32_t const shift, uint32_t const mask)
+            {
+                return static_cast<uint32_t>(RadixKeyTraits<TKey>::toBits(key) >> shift) & mask;
+            }
+
+            /**
+             * Returns the range [first, second) of the contiguous chunk of the keys, which is sorted by the block
+             * blockIndex. The chunk sizes differ by at most one key.
+             */
+            template<typename TIdx>
+            ALPAKA_FN_HOST_ACC ALPAKA_FN_INLINE void getBlockChunk(
+                TIdx const n,
+                TIdx const blockIndex,
+                TIdx const numBlocks,
+                TIdx& begin,
+                TIdx& end)
+            {
+                TIdx const chunkSize = n / numBlocks;
+                TIdx const remainder = n % numBlocks;
+                begin = chunkSize * blockIndex + (blockIndex < remainder ? blockIndex : remainder);
+                end = begin + chunkSize + (blockIndex < remainder ? 1 : 0);
+            }
+
+            /**
+             * First phase of a radix sort pass: each block counts the digits of the keys of its chunk in a histogram
+             * in the shared memory. The counts are stored digit major, i.e. the count of digit d of block b is at
+             * position d * numBlocks + b. Therefore, an exclusive scan of the counts returns the output position of
+             * the first key of each digit and block.
+             * @tparam TBlockSize The block size of this kernel.
+             */
+            template<uint64_t TBlockSize>
+            struct RadixHistogramKernel
+            {
+                /**
+                 * @param acc The alpaka accelerator.
+                 * @param keys The input keys.
+                 * @param histograms The output counts with radixSize elements per block of the grid.
+                 * @param n The number of keys.
+                 * @param shift The first bit of the digit.
+                 * @param mask The bit mask of the digit.
+                 */
+                template<typename TAcc, typename TIdx, typename TKeyIterator, typename THistogramIterator>
+                ALPAKA_FN_ACC void operator()(
+                    TAcc const& acc,
+                    TKeyIterator const& keys,
+                    THistogramIterator const& histograms,
+                    TIdx const& n,
+                    uint32_t const shift,
+                    uint32_t const mask) const
+                {
+                    using SharedArray = vikunja::reduce::detail::sharedStaticArray<TIdx, radixSize>;
+                    auto& counts(alpaka::declareSharedVar<SharedArray, __COUNTER__>(acc));
+
+                    constexpr TIdx xIndex = alpaka::Dim<TAcc>::value - 1u;
+                    auto const threadIndex = alpaka::getIdx<alpaka::Block, alpaka::Threads>(acc)[xIndex];
+                    auto const blockIndex = alpaka::getIdx<alpaka::Grid, alpaka::Blocks>(acc)[xIndex];
+                    auto const numBlocks = alpaka::getWorkDiv<alpaka::Grid, alpaka::Blocks>(acc)[xIndex];
+
+                    for(TIdx d = threadIndex; d < radixSize; d += static_cast<TIdx>(TBlockSize))
+                    {
+                        counts[d] = 0;
+                    }
+                    alpaka::syncBlockThreads(acc);
+
+                    TIdx begin;
+                    TIdx end;
+                    getBlockChunk(n, static_cast<TIdx>(blockIndex), static_cast<TIdx>(numBlocks), begin, end);
+                    for(TIdx i = begin + threadIndex; i < end; i += static_cast<TIdx>(TBlockSize))
+                    {
+                        alpaka::atomicOp<alpaka::AtomicAdd>(
+                            acc,
+                            &counts[getDigit(keys[i], shift, mask)],
+                            static_cast<TIdx>(1u),
+                            alpaka::hierarchy::Threads{});
+                    }
+                    alpaka::syncBlockThreads(acc);
+
+                    for(TIdx d = threadIndex; d < radixSize; d += static_cast<TIdx>(TBlockSize))
+                    {
+                        histograms[d * numBlocks + blockIndex] = counts[d];
+                    }
+                }
+            };
+
+            /**
+             * Last phase of a radix sort pass: each block moves the keys and values of its chunk to their output
+             * position. The chunk is processed in tiles of TBlockSize consecutive keys. The rank of a key within its
+             * digit in the tile is the number of keys with the same digit of the lower threads, therefore each pass
+             * is stable. The next output position of each digit is kept in the shared memory.
+             * @tparam TBlockSize The block size of this kernel.
+             * @tparam THasValues If false, the value iterators are not accessed.
+             */
+            template<uint64_t TBlockSize, bool THasValues>
+            struct RadixScatterKernel
+            {
+                /**
+                 * @param acc The alpaka accelerator.
+                 * @param keysIn The input keys.
+                 * @param keysOut The output keys.
+                 * @param valuesIn The input values.
+                 * @param valuesOut The output values.
+                 * @param offsets The exclusive scan of the histograms. The first element is not used.
+                 * @param n The number of keys.
+                 * @param shift The first bit of the digit.
+                 * @param mask The bit mask of the digit.
+                 */
+                template<
+                    typename TAcc,
+                    typename TIdx,
+                    typename TKeyInputIterator,
+                    typename TKeyOutputIterator,
+                    typename TValueInputIterator,
+                    typename TValueOutputIterator,
+                    typename TOffsetIterator>
+                ALPAKA_FN_ACC void operator()(
+                    TAcc const& acc,
+                    TKeyInputIterator const& keysIn,
+                    TKeyOutputIterator const& keysOut,
+                    TValueInputIterator const& valuesIn,
+                    TValueOutputIterator const& valuesOut,
+                    TOffsetIterator const& offsets,
+                    TIdx const& n,
+                    uint32_t const shift,
+                    uint32_t const mask) const
+                {
+                    using SharedCounts = vikunja::reduce::detail::sharedStaticArray<TIdx, radixSize>;
+                    using SharedDigits = vikunja::reduce::detail::sharedStaticArray<uint32_t, TBlockSize>;
+                    auto& positions(alpaka::declareSharedVar<SharedCounts, __COUNTER__>(acc));
+                    auto& tileCounts(alpaka::declareSharedVar<SharedCounts, __COUNTER__>(acc));
+                    auto& tileDigits(alpaka::declareSharedVar<SharedDigits, __COUNTER__>(acc));
+
+                    constexpr TIdx xIndex = alpaka::Dim<TAcc>::value - 1u;
+                    auto const threadIndex = alpaka::getIdx<alpaka::Block, alpaka::Threads>(acc)[xIndex];
+                    auto const blockIndex = alpaka::getIdx<alpaka::Grid, alpaka::Blocks>(acc)[xIndex];
+                    auto const numBlocks = alpaka::getWorkDiv<alpaka::Grid, alpaka::Blocks>(acc)[xIndex];
+
+                    for(TIdx d = threadIndex; d < radixSize; d += static_cast<TIdx>(TBlockSize))
+                    {
+                        TIdx const entry = d * numBlocks + blockIndex;
+                        positions[d] = (entry == 0) ? 0 : offsets[entry];
+                        tileCounts[d] = 0;
+                    }
+                    alpaka::syncBlockThreads(acc);
+
+                    TIdx begin;
+                    TIdx end;
+                    getBlockChunk(n, static_cast<TIdx>(blockIndex), static_cast<TIdx>(numBlocks), begin, end);
+                    // all threads of the block execute the same number of tiles
+                    for(TIdx tileBegin = begin; tileBegin < end; tileBegin += static_cast<TIdx>(TBlockSize))
+                    {
+                        TIdx const i = tileBegin + threadIndex;
+                        bool const isActive = i < end;
+                        auto const key = keysIn[isActive ? i : tileBegin];
+                        uint32_t const digit = isActive ? getDigit(key, shift, mask) : radixSize;
+                        tileDigits[threadIndex] = digit;
+                        if(isActive)
+                        {
+                            alpaka::atomicOp<alpaka::AtomicAdd>(
+                                acc,
+                                &tileCounts[digit],
+                                static_cast<TIdx>(1u),
+                                alpaka::hierarchy::Threads{});
+                        }
+                        alpaka::syncBlockThreads(acc);
+
+                        if(isActive)
+                        {
+                            TIdx rank = 0;
+                            for(TIdx t = 0; t < threadIndex; ++t)
+                            {
+                                rank += (tileDigits[t] == digit) ? 1 : 0;
+                            }
+                            TIdx const position = positions[digit] + rank;
+                            keysOut[position] = key;
+                            if constexpr(THasValues)
+                            {
+                                valuesOut[position] = valuesIn[i];
+                            }
+                        }
+                        alpaka::syncBlockThreads(acc);
+
+                        for(TIdx d = threadIndex; d < radixSize; d += static_cast<TIdx>(TBlockSize))
+                        {
+                            positions[d] += tileCounts[d];
+                            tileCounts[d] = 0;
+                        }
+                        alpaka::syncBlockThreads(acc);
+                    }
+                }
+            };
+        } // namespace detail
+    } // namespace sort
+} // namespace vikunja
@@ -0,0 +1,267 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/access/BlockStrategy.hpp>
+#include <vikunja/sort/detail/MergeSortKernel.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+#include <cstdint>
+
+namespace vikunja
+{
+    namespace sort
+    {
+        namespace detail
+        {
+            /**
+             * Maximum length of a segment, which is sorted by a single thread, if the block size is greater than
+             * one. Longer segments are sorted by a whole block.
+             */
+            constexpr uint32_t segmentThreadLimit = 128u;
+
+            /**
+             * Sorts the segment [begin, end) with a single thread. Segments up to sortTileSize elements are sorted in
+             * registers, longer segments are merged afterwards in the helper memory.
+             * @tparam TStable If true, the order of equal elements is kept.
+             * @tparam TCompareOperator The vikunja::operators type of the comparator.
+             * @param helper Helper memory with the size of the data.
+             */
+            template<
+                bool TStable,
+                typename TCompareOperator,
+                typename TAcc,
+                typename TIdx,
+                typename TIterator,
+                typename THelperIterator,
+                typename TCompare>
+            ALPAKA_FN_HOST_ACC void threadSortSegment(
+                TAcc const& acc,
+                TIterator const& data,
+                THelperIterator const& helper,
+                TIdx const begin,
+                TIdx const end,
+                TCompare const& compare)
+            {
+                constexpr TIdx tileSize = static_cast<TIdx>(sortTileSize);
+                TIdx const count = end - begin;
+                for(TIdx tileBegin = 0; tileBegin < count; tileBegin += tileSize)
+                {
+                    TIdx const tileCount = (count - tileBegin < tileSize) ? count - tileBegin : tileSize;
+                    sortTile<TStable, TCompareOperator>(acc, data + begin + tileBegin, tileCount, compare);
+                }
+
+                bool resultInHelper = false;
+                for(TIdx width = tileSize; width < count; width *= 2)
+                {
+                    if(resultInHelper)
+                    {
+                        mergeRuns<TCompareOperator>(
+                            acc,
+                            helper + begin,
+                            data + begin,
+                            count,
+                            width,
+                            TIdx{0},
+                            count,
+                            compare);
+                    }
+                    else
+                    {
+                        mergeRuns<TCompareOperator>(
+                            acc,
+                            data + begin,
+                            helper + begin,
+                            count,
+                            width,
+                            TIdx{0},
+                            count,
+                            compare);
+                    }
+                    resultInHelper = !resultInHelper;
+                }
+
+                if(resultInHelper)
+                {
+                    for(TIdx i = begin; i < end; ++i)
+                    {
+                        data[i] = helper[i];
+                    }
+                }
+            }
+
+            /**
+             * Sorts the short segments with one thread per segment. The segments are distributed grid striding over
+             * the threads, so that neighboring segments of different length are sorted by different threads.
+             * @tparam TBlockSize The block size of this kernel.
+             * @tparam TStable If true, the order of equal elements is kept.
+             * @tparam TCompareOperator The vikunja::operators type of the comparator.
+             */
+            template<uint64_t TBlockSize, bool TStable, typename TCompareOperator>
+            struct ThreadSegmentedSortKernel
+            {
+                /**
+                 * @param acc The alpaka accelerator.
+                 * @param data The elements, which are sorted in place.
+                 * @param helper Helper memory with the size of the data.
+                 * @param offsets The begin of each segment and the end of the last segment.
+                 * @param numSegments The number of segments.
+                 * @param maxLength Segments, which are longer, are skipped.
+                 * @param compare The comparator.
+                 */
+                template<
+                    typename TAcc,
+                    typename TIdx,
+                    typename TIterator,
+                    typename THelperIterator,
+                    typename TOffsetIterator,
+                    typename TCompare>
+                ALPAKA_FN_ACC void operator()(
+                    TAcc const& acc,
+                    TIterator const& data,
+                    THelperIterator const& helper,
+                    TOffsetIterator const& offsets,
+                    TIdx const& numSegments,
+                    TIdx const& maxLength,
+                    TCompare const& compare) const
+                {
+                    using MemIndex = vikunja::MemAccess::
+                        BlockStrategy<vikunja::MemAccess::policies::GridStridingMemAccessPolicy, TAcc, TIdx>;
+                    for(MemIndex iter(acc, numSegments, TBlockSize), end = iter.end(); iter < end; ++iter)
+                    {
+                        TIdx const begin = static_cast<TIdx>(offsets[*iter]);
+                        TIdx const segmentEnd = static_cast<TIdx>(offsets[*iter + 1]);
+                        if(segmentEnd - begin > 1 && segmentEnd - begin <= maxLength)
+                        {
+                            threadSortSegment<TStable, TCompareOperator>(
+                                acc,
+                                data,
+                                helper,
+                                begin,
+                                segmentEnd,
+                                compare);
+                        }
+                    }
+                }
+            };
+
+            /**
+             * Sorts the long segments with one block per segment. The threads of the block sort the tiles of the
+             * segment in registers and merge the sorted runs afterwards, where each thread writes an equal share of
+             * each merge pass.
+             * @tparam TBlockSize The block size of this kernel.
+             * @tparam TStable If true, the order of equal elements is kept.
+             * @tparam TCompareOperator The vikunja::operators type of the comparator.
+             */
+            template<uint64_t TBlockSize, bool TStable, typename TCompareOperator>
+            struct BlockSegmentedSortKernel
+            {
+                /**
+                 * @param acc The alpaka accelerator.
+                 * @param data The elements, which are sorted in place.
+                 * @param helper Helper memory with the size of the data.
+                 * @param offsets The begin of each segment and the end of the last segment.
+                 * @param numSegments The number of segments.
+                 * @param minLength Segments, which are not longer, are skipped.
+                 * @param compare The comparator.
+                 */
+                template<
+                    typename TAcc,
+                    typename TIdx,
+                    typename TIterator,
+                    typename THelperIterator,
+                    typename TOffsetIterator,
+                    typename TCompare>
+                ALPAKA_FN_ACC void operator()(
+                    TAcc const& acc,
+                    TIterator const& data,
+                    THelperIterator const& helper,
+                    TOffsetIterator const& offsets,
+                    TIdx const& numSegments,
+                    TIdx const& minLength,
+                    TCompare const& compare) const
+                {
+                    constexpr TIdx xIndex = alpaka::Dim<TAcc>::value - 1u;
+                    constexpr TIdx tileSize = static_cast<TIdx>(sortTileSize);
+                    constexpr TIdx blockSize = static_cast<TIdx>(TBlockSize);
+                    TIdx const threadIndex = alpaka::getIdx<alpaka::Block, alpaka::Threads>(acc)[xIndex];
+                    TIdx const blockIndex = alpaka::getIdx<alpaka::Grid, alpaka::Blocks>(acc)[xIndex];
+                    TIdx const gridSize = alpaka::getWorkDiv<alpaka::Grid, alpaka::Blocks>(acc)[xIndex];
+
+                    // the control flow depends only on the segment, therefore all threads of the block synchronize
+                    for(TIdx segment = blockIndex; segment < numSegments; segment += gridSize)
+                    {
+                        TIdx const begin = static_cast<TIdx>(offsets[segment]);
+                        TIdx const count = static_cast<TIdx>(offsets[segment + 1]) - begin;
+                        if(count <= minLength)
+                        {
+                            continue;
+                        }
+
+                        TIdx const numTiles = (count + tileSize - 1) / tileSize;
+                        for(TIdx tile = threadIndex; tile < numTiles; tile += blockSize)
+                        {
+                            TIdx const tileBegin = tile * tileSize;
+                            TIdx const tileCount = (count - tileBegin < tileSize) ? count - tileBegin : tileSize;
+                            sortTile<TStable, TCompareOperator>(acc, data + begin + tileBegin, tileCount, compare);
+                        }
+                        alpaka::syncBlockThreads(acc);
+
+                        TIdx const itemsPerThread = (count + blockSize - 1) / blockSize;
+                        TIdx shareBegin = threadIndex * itemsPerThread;
+                        shareBegin = (shareBegin < count) ? shareBegin : count;
+                        TIdx const shareEnd
+                            = (count - shareBegin < itemsPerThread) ? count : shareBegin + itemsPerThread;
+
+                        bool resultInHelper = false;
+                        for(TIdx width = tileSize; width < count; width *= 2)
+                        {
+                            if(resultInHelper)
+                            {
+                                mergeRuns<TCompareOperator>(
+                                    acc,
+                                    helper + begin,
+                                    data + begin,
+                                    count,
+                                    width,
+                                    shareBegin,
+                                    shareEnd,
+                                    compare);
+                            }
+                            else
+                            {
+                                mergeRuns<TCompareOperator>(
+                                    acc,
+                                    data + begin,
+                                    helper + begin,
+                                    count,
+                                    width,
+                                    shareBegin,
+                                    shareEnd,
+                                    compare);
+                            }
+                            resultInHelper = !resultInHelper;
+                            alpaka::syncBlockThreads(acc);
+                        }
+
+                        if(resultInHelper)
+                        {
+                            for(TIdx i = begin + shareBegin; i < begin + shareEnd; ++i)
+                            {
+                                data[i] = helper[i];
+                            }
+                        }
+                    }
+                }
+            };
+        } // namespace detail
+    } // namespace sort
+} // namespace vikunja
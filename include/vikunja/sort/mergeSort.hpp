@@ -0,0 +1,275 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/affinity/Affinity.hpp>
+#include <vikunja/operators/operators.hpp>
+#include <vikunja/reduce/reduce.hpp>
+#include <vikunja/sort/detail/MergeSortKernel.hpp>
+#include <vikunja/transform/transform.hpp>
+#include <vikunja/workdiv/BlockBasedWorkDiv.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+
+namespace vikunja
+{
+    namespace sort
+    {
+        namespace detail
+        {
+            /**
+             * Executes the tile sort and all merge passes of the merge sort with a fixed work division. Each merge
+             * pass doubles the width of the sorted runs and writes from the data to the helper memory or vice
+             * versa. If the result is in the helper memory after the last pass, it is copied back.
+             * @tparam TBlockSize The block size of the kernels.
+             * @tparam TStable If true, the order of equal elements is kept.
+             * @tparam TCompareOperator The vikunja::operators type of the comparator.
+             */
+            template<
+                typename TAcc,
+                uint64_t TBlockSize,
+                bool TStable,
+                typename TCompareOperator,
+                typename TDevAcc,
+                typename TQueue,
+                typename TIdx,
+                typename TIterator,
+                typename TCompare>
+            void mergeSortPasses(
+                TDevAcc& devAcc,
+                TQueue& queue,
+                TIdx const& n,
+                TIdx const& gridSize,
+                TIterator const& data,
+                TCompare const& compare)
+            {
+                using TData = typename std::iterator_traits<TIterator>::value_type;
+                using Dim = alpaka::Dim<TAcc>;
+                using WorkDiv = alpaka::WorkDivMembers<Dim, TIdx>;
+                using Vec = alpaka::Vec<Dim, TIdx>;
+                constexpr TIdx xIndex = Dim::value - 1u;
+
+                Vec const elementsPerThread(Vec::all(static_cast<TIdx>(1u)));
+                Vec threadsPerBlock(Vec::all(static_cast<TIdx>(1u)));
+                Vec blocksPerGrid(Vec::all(static_cast<TIdx>(1u)));
+                blocksPerGrid[xIndex] = gridSize;
+                threadsPerBlock[xIndex] = static_cast<TIdx>(TBlockSize);
+                WorkDiv const workDiv{blocksPerGrid, threadsPerBlock, elementsPerThread};
+
+                TileSortKernel<TBlockSize, TStable, TCompareOperator> tileSortKernel;
+                alpaka::exec<TAcc>(queue, workDiv, tileSortKernel, data, n, compare);
+
+                constexpr TIdx tileSize = static_cast<TIdx>(sortTileSize);
+                if(n <= tileSize)
+                {
+                    alpaka::wait(queue);
+                    return;
+                }
+
+                Vec dataExtent(Vec::all(static_cast<TIdx>(1u)));
+                dataExtent[xIndex] = n;
+                auto helper = alpaka::allocBuf<TData, TIdx>(devAcc, dataExtent);
+                TData* const helperPtr = alpaka::getPtrNative(helper);
+
+                MergePassKernel<TBlockSize, TCompareOperator> mergePassKernel;
+                bool resultInHelper = false;
+                for(TIdx width = tileSize; width < n; width *= 2)
+                {
+                    if(resultInHelper)
+                    {
+                        alpaka::exec<TAcc>(queue, workDiv, mergePassKernel, helperPtr, data, n, width, compare);
+                    }
+                    else
+                    {
+                        alpaka::exec<TAcc>(queue, workDiv, mergePassKernel, data, helperPtr, n, width, compare);
+                    }
+                    resultInHelper = !resultInHelper;
+                }
+
+                if(resultInHelper)
+                {
+                    vikunja::transform::deviceTransform<TAcc>(
+                        devAcc,
+                        queue,
+                        n,
+                        helperPtr,
+                        data,
+                        vikunja::reduce::detail::Identity<TData>());
+                }
+
+                // the helper memory must not be freed before the kernels are finished
+                alpaka::wait(queue);
+            }
+
+            /**
+             * Selects the work division of the merge sort. Each thread should sort at least one tile.
+             */
+            template<
+                typename TAcc,
+                typename WorkDivPolicy,
+                bool TStable,
+                typename TCompareOperator,
+                typename TDevAcc,
+                typename TQueue,
+                typename TIdx,
+                typename TIterator,
+                typename TCompare>
+            void mergeSortImpl(
+                TDevAcc& devAcc,
+                TQueue& queue,
+                TIdx const& n,
+                TIterator const& data,
+                TCompare const& compare)
+            {
+                if(n < 2)
+                {
+                    return;
+                }
+                vikunja::affinity::applyAffinity<TAcc>();
+                constexpr uint64_t blockSize = WorkDivPolicy::template getBlockSize<TAcc>();
+                if(n < static_cast<TIdx>(blockSize))
+                {
+                    mergeSortPasses<TAcc, 1u, TStable, TCompareOperator>(
+                        devAcc,
+                        queue,
+                        n,
+                        static_cast<TIdx>(1u),
+                        data,
+                        compare);
+                    return;
+                }
+                TIdx gridSize = WorkDivPolicy::template getGridSize<TAcc>(devAcc);
+                TIdx const maxGridSize = n / (static_cast<TIdx>(blockSize) * static_cast<TIdx>(sortTileSize));
+                if(gridSize > maxGridSize)
+                {
+                    gridSize = maxGridSize;
+                }
+                if(gridSize < 1)
+                {
+                    gridSize = 1;
+                }
+                mergeSortPasses<TAcc, blockSize, TStable, TCompareOperator>(devAcc, queue, n, gridSize, data, compare);
+            }
+        } // namespace detail
+
+        /**
+         * Sorts the elements with a comparator, i.e. after the sort compare(data[i + 1], data[i]) is false for all
+         * i. The order of equal elements is not kept, see deviceStableSort.
+         * Each thread sorts tiles of 16 elements in registers with a sorting network. Afterwards, merge passes
+         * double the length of the sorted runs, until the whole input is sorted. In each pass, each thread merges
+         * an equal share of the output, which is found with a merge path search.
+         * @tparam TAcc The alpaka accelerator type to use.
+         * @tparam WorkDivPolicy The working division policy. Defaults to a templated value depending on the
+         * accelerator.
+         * @tparam TCompare Type of the comparator.
+         * @tparam TIterator Type of the data iterator. Should be a pointer-like type.
+         * @tparam TDevAcc The type of the alpaka accelerator.
+         * @tparam TQueue The type of the alpaka queue.
+         * @tparam TIdx The index type to use.
+         * @tparam TCompareOperator The vikunja::operators type of the comparator.
+         * @param devAcc The alpaka accelerator.
+         * @param queue The alpaka queue. The function waits for the queue, before it returns.
+         * @param n The number of elements.
+         * @param data The elements, which are sorted in place.
+         * @param compare The comparator, which returns true if the first argument is ordered before the second. It
+         * can optionally take the alpaka accelerator as first argument.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TCompare,
+            typename TIterator,
+            typename TDevAcc,
+            typename TQueue,
+            typename TIdx,
+            typename TData = typename std::iterator_traits<TIterator>::value_type,
+            typename TCompareOperator = vikunja::operators::BinaryOp<TAcc, TCompare, TData, TData>>
+        auto deviceSort(TDevAcc& devAcc, TQueue& queue, TIdx const& n, TIterator const& data, TCompare const& compare)
+            -> void
+        {
+            detail::mergeSortImpl<TAcc, WorkDivPolicy, false, TCompareOperator>(devAcc, queue, n, data, compare);
+        }
+
+        /**
+         * Sort with begin and end iterator.
+         * @see deviceSort
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TCompare,
+            typename TIterator,
+            typename TDevAcc,
+            typename TQueue>
+        auto deviceSort(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            TIterator const& begin,
+            TIterator const& end,
+            TCompare const& compare) -> void
+        {
+            assert(end >= begin);
+            auto size = static_cast<typename alpaka::trait::IdxType<TAcc>::type>(end - begin);
+            deviceSort<TAcc, WorkDivPolicy>(devAcc, queue, size, begin, compare);
+        }
+
+        /**
+         * Sorts the elements with a comparator and keeps the order of equal elements. The tiles are sorted with an
+         * insertion sort instead of a sorting network, the merge passes are stable in both variants.
+         * @see deviceSort
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TCompare,
+            typename TIterator,
+            typename TDevAcc,
+            typename TQueue,
+            typename TIdx,
+            typename TData = typename std::iterator_traits<TIterator>::value_type,
+            typename TCompareOperator = vikunja::operators::BinaryOp<TAcc, TCompare, TData, TData>>
+        auto deviceStableSort(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            TIdx const& n,
+            TIterator const& data,
+            TCompare const& compare) -> void
+        {
+            detail::mergeSortImpl<TAcc, WorkDivPolicy, true, TCompareOperator>(devAcc, queue, n, data, compare);
+        }
+
+        /**
+         * Stable sort with begin and end iterator.
+         * @see deviceStableSort
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TCompare,
+            typename TIterator,
+            typename TDevAcc,
+            typename TQueue>
+        auto deviceStableSort(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            TIterator const& begin,
+            TIterator const& end,
+            TCompare const& compare) -> void
+        {
+            assert(end >= begin);
+            auto size = static_cast<typename alpaka::trait::IdxType<TAcc>::type>(end - begin);
+            deviceStableSort<TAcc, WorkDivPolicy>(devAcc, queue, size, begin, compare);
+        }
+    } // namespace sort
+} // namespace vikunja
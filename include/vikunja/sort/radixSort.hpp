@@ -0,0 +1,360 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/affinity/Affinity.hpp>
+#include <vikunja/operators/functors.hpp>
+#include <vikunja/operators/operators.hpp>
+#include <vikunja/reduce/reduce.hpp>
+#include <vikunja/scan/detail/BlockThreadScanKernel.hpp>
+#include <vikunja/sort/detail/RadixSortKernel.hpp>
+#include <vikunja/transform/transform.hpp>
+#include <vikunja/workdiv/BlockBasedWorkDiv.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <cstdint>
+#include <iterator>
+
+namespace vikunja
+{
+    namespace sort
+    {
+        namespace detail
+        {
+            /**
+             * Executes all passes of the radix sort with a fixed work division. Each pass sorts radixBits bits of
+             * the keys from the keys to the helper memory or vice versa. If the result is in the helper memory after
+             * the last pass, it is copied back.
+             * @tparam TBlockSize The block size of the kernels.
+             * @tparam THasValues If false, the value iterator is not accessed.
+             * @param gridSize The number of blocks.
+             */
+            template<
+                typename TAcc,
+                uint64_t TBlockSize,
+                bool THasValues,
+                typename TDevAcc,
+                typename TQueue,
+                typename TIdx,
+                typename TKeyIterator,
+                typename TValueIterator>
+            void radixSortPasses(
+                TDevAcc& devAcc,
+                TQueue& queue,
+                TIdx const& n,
+                TIdx const& gridSize,
+                TKeyIterator const& keys,
+                TValueIterator const& values,
+                uint32_t const beginBit,
+                uint32_t const endBit)
+            {
+                using TKey = typename std::iterator_traits<TKeyIterator>::value_type;
+                using TValue = typename std::iterator_traits<TValueIterator>::value_type;
+                using Dim = alpaka::Dim<TAcc>;
+                using WorkDiv = alpaka::WorkDivMembers<Dim, TIdx>;
+                using Vec = alpaka::Vec<Dim, TIdx>;
+                constexpr TIdx xIndex = Dim::value - 1u;
+
+                Vec const elementsPerThread(Vec::all(static_cast<TIdx>(1u)));
+                Vec threadsPerBlock(Vec::all(static_cast<TIdx>(1u)));
+                Vec blocksPerGrid(Vec::all(static_cast<TIdx>(1u)));
+                Vec const singleBlocksPerGrid(Vec::all(static_cast<TIdx>(1u)));
+                blocksPerGrid[xIndex] = gridSize;
+                threadsPerBlock[xIndex] = static_cast<TIdx>(TBlockSize);
+                WorkDiv const multiBlockWorkDiv{blocksPerGrid, threadsPerBlock, elementsPerThread};
+                WorkDiv const singleBlockWorkDiv{singleBlocksPerGrid, threadsPerBlock, elementsPerThread};
+
+                TIdx const numHistogramEntries = static_cast<TIdx>(radixSize) * gridSize;
+                Vec histogramExtent(Vec::all(static_cast<TIdx>(1u)));
+                histogramExtent[xIndex] = numHistogramEntries;
+                Vec dataExtent(Vec::all(static_cast<TIdx>(1u)));
+                dataExtent[xIndex] = n;
+                Vec valueExtent(Vec::all(static_cast<TIdx>(1u)));
+                valueExtent[xIndex] = THasValues ? n : static_cast<TIdx>(1u);
+
+                auto histograms = alpaka::allocBuf<TIdx, TIdx>(devAcc, histogramExtent);
+                auto helperKeys = alpaka::allocBuf<TKey, TIdx>(devAcc, dataExtent);
+                auto helperValues = alpaka::allocBuf<TValue, TIdx>(devAcc, valueExtent);
+                TKey* const helperKeysPtr = alpaka::getPtrNative(helperKeys);
+                TValue* const helperValuesPtr = alpaka::getPtrNative(helperValues);
+
+                using PlusOperator
+                    = vikunja::operators::BinaryOp<TAcc, vikunja::operators::Plus<TIdx>, TIdx, TIdx>;
+                RadixHistogramKernel<TBlockSize> histogramKernel;
+                vikunja::scan::detail::ChunkSumScanKernel<TBlockSize, TIdx, PlusOperator> histogramScanKernel;
+                RadixScatterKernel<TBlockSize, THasValues> scatterKernel;
+
+                auto runPass = [&](auto const& keysIn,
+                                   auto const& keysOut,
+                                   auto const& valuesIn,
+                                   auto const& valuesOut,
+                                   uint32_t const shift,
+                                   uint32_t const mask)
+                {
+                    alpaka::exec<TAcc>(
+                        queue,
+                        multiBlockWorkDiv,
+                        histogramKernel,
+                        keysIn,
+                        alpaka::getPtrNative(histograms),
+                        n,
+                        shift,
+                        mask);
+                    alpaka::exec<TAcc>(
+                        queue,
+                        singleBlockWorkDiv,
+                        histogramScanKernel,
+                        alpaka::getPtrNative(histograms),
+                        numHistogramEntries,
+                        vikunja::operators::Plus<TIdx>());
+                    alpaka::exec<TAcc>(
+                        queue,
+                        multiBlockWorkDiv,
+                        scatterKernel,
+                        keysIn,
+                        keysOut,
+                        valuesIn,
+                        valuesOut,
+                        alpaka::getPtrNative(histograms),
+                        n,
+                        shift,
+                        mask);
+                };
+
+                bool resultInHelper = false;
+                for(uint32_t shift = beginBit; shift < endBit; shift += radixBits)
+                {
+                    uint32_t const bits = (endBit - shift < radixBits) ? endBit - shift : radixBits;
+                    uint32_t const mask = (1u << bits) - 1u;
+                    if(resultInHelper)
+                    {
+                        runPass(helperKeysPtr, keys, helperValuesPtr, values, shift, mask);
+                    }
+                    else
+                    {
+                        runPass(keys, helperKeysPtr, values, helperValuesPtr, shift, mask);
+                    }
+                    resultInHelper = !resultInHelper;
+                }
+
+                if(resultInHelper)
+                {
+                    vikunja::transform::deviceTransform<TAcc>(
+                        devAcc,
+                        queue,
+                        n,
+                        helperKeysPtr,
+                        keys,
+                        vikunja::reduce::detail::Identity<TKey>());
+                    if constexpr(THasValues)
+                    {
+                        vikunja::transform::deviceTransform<TAcc>(
+                            devAcc,
+                            queue,
+                            n,
+                            helperValuesPtr,
+                            values,
+                            vikunja::reduce::detail::Identity<TValue>());
+                    }
+                }
+
+                // the helper memory must not be freed before the kernels are finished
+                alpaka::wait(queue);
+            }
+
+            /**
+             * Selects the work division of the radix sort. Each block should have enough keys to fill its tiles and
+             * to amortize its histogram.
+             */
+            template<
+                typename TAcc,
+                typename WorkDivPolicy,
+                bool THasValues,
+                typename TDevAcc,
+                typename TQueue,
+                typename TIdx,
+                typename TKeyIterator,
+                typename TValueIterator>
+            void radixSortImpl(
+                TDevAcc& devAcc,
+                TQueue& queue,
+                TIdx const& n,
+                TKeyIterator const& keys,
+                TValueIterator const& values,
+                uint32_t const beginBit,
+                uint32_t const endBit)
+            {
+                using TKey = typename std::iterator_traits<TKeyIterator>::value_type;
+                assert(beginBit <= endBit && endBit <= sizeof(TKey) * CHAR_BIT);
+                if(n < 2 || beginBit >= endBit)
+                {
+                    return;
+                }
+                vikunja::affinity::applyAffinity<TAcc>();
+                constexpr uint64_t blockSize = WorkDivPolicy::template getBlockSize<TAcc>();
+                if(n < static_cast<TIdx>(blockSize))
+                {
+                    radixSortPasses<TAcc, 1u, THasValues>(
+                        devAcc,
+                        queue,
+                        n,
+                        static_cast<TIdx>(1u),
+                        keys,
+                        values,
+                        beginBit,
+                        endBit);
+                    return;
+                }
+                TIdx gridSize = WorkDivPolicy::template getGridSize<TAcc>(devAcc);
+                TIdx const maxGridSize = n / std::max(static_cast<TIdx>(blockSize), static_cast<TIdx>(radixSize));
+                if(gridSize > maxGridSize)
+                {
+                    gridSize = maxGridSize;
+                }
+                if(gridSize < 1)
+                {
+                    gridSize = 1;
+                }
+                radixSortPasses<TAcc, blockSize, THasValues>(
+                    devAcc,
+                    queue,
+                    n,
+                    gridSize,
+                    keys,
+                    values,
+                    beginBit,
+                    endBit);
+            }
+        } // namespace detail
+
+        /**
+         * Sorts the keys in ascending order with a least significant digit radix sort. The sort is stable.
+         * Each pass sorts 8 bits of the keys and consists of three kernels: each block counts the digits of a
+         * contiguous chunk of the keys in the shared memory, the block histograms are scanned in a single block and
+         * each block moves the keys of its chunk tile by tile to their new position.
+         * Integral and floating point keys are supported. Negative floating point zero is sorted in front of the
+         * positive zero and NaN values with sign bit are sorted in front of all other values, without sign bit
+         * behind all other values.
+         * @tparam TAcc The alpaka accelerator type to use.
+         * @tparam WorkDivPolicy The working division policy. Defaults to a templated value depending on the
+         * accelerator. Each thread needs a contiguous chunk of the keys, therefore the linear memory access policy
+         * is always used.
+         * @tparam TKeyIterator Type of the key iterator. Should be a pointer-like type.
+         * @tparam TDevAcc The type of the alpaka accelerator.
+         * @tparam TQueue The type of the alpaka queue.
+         * @tparam TIdx The index type to use.
+         * @param devAcc The alpaka accelerator.
+         * @param queue The alpaka queue. The function waits for the queue, before it returns.
+         * @param n The number of keys.
+         * @param keys The keys, which are sorted in place.
+         * @param beginBit The first bit of the keys, which is used for the comparison.
+         * @param endBit One behind the last bit of the keys, which is used for the comparison. If only the lower
+         * bits of the keys are used, the number of passes can be reduced.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TKeyIterator,
+            typename TDevAcc,
+            typename TQueue,
+            typename TIdx>
+        auto deviceRadixSort(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            TIdx const& n,
+            TKeyIterator const& keys,
+            uint32_t const beginBit = 0u,
+            uint32_t const endBit = sizeof(typename std::iterator_traits<TKeyIterator>::value_type) * CHAR_BIT)
+            -> void
+        {
+            detail::radixSortImpl<TAcc, WorkDivPolicy, false>(devAcc, queue, n, keys, keys, beginBit, endBit);
+        }
+
+        /**
+         * Radix sort with begin and end iterator of the keys.
+         * @see deviceRadixSort
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TKeyIterator,
+            typename TDevAcc,
+            typename TQueue>
+        auto deviceRadixSort(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            TKeyIterator const& keysBegin,
+            TKeyIterator const& keysEnd,
+            uint32_t const beginBit = 0u,
+            uint32_t const endBit = sizeof(typename std::iterator_traits<TKeyIterator>::value_type) * CHAR_BIT)
+            -> void
+        {
+            assert(keysEnd >= keysBegin);
+            auto size = static_cast<typename alpaka::trait::IdxType<TAcc>::type>(keysEnd - keysBegin);
+            deviceRadixSort<TAcc, WorkDivPolicy>(devAcc, queue, size, keysBegin, beginBit, endBit);
+        }
+
+        /**
+         * Sorts the keys in ascending order and moves the values with their keys.
+         * @see deviceRadixSort
+         * @param values The values, which are reordered in place like the keys.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TKeyIterator,
+            typename TValueIterator,
+            typename TDevAcc,
+            typename TQueue,
+            typename TIdx>
+        auto deviceRadixSortPairs(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            TIdx const& n,
+            TKeyIterator const& keys,
+            TValueIterator const& values,
+            uint32_t const beginBit = 0u,
+            uint32_t const endBit = sizeof(typename std::iterator_traits<TKeyIterator>::value_type) * CHAR_BIT)
+            -> void
+        {
+            detail::radixSortImpl<TAcc, WorkDivPolicy, true>(devAcc, queue, n, keys, values, beginBit, endBit);
+        }
+
+        /**
+         * Radix sort of key value pairs with begin and end iterator of the keys.
+         * @see deviceRadixSortPairs
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TKeyIterator,
+            typename TValueIterator,
+            typename TDevAcc,
+            typename TQueue>
+        auto deviceRadixSortPairs(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            TKeyIterator const& keysBegin,
+            TKeyIterator const& keysEnd,
+            TValueIterator const& values,
+            uint32_t const beginBit = 0u,
+            uint32_t const endBit = sizeof(typename std::iterator_traits<TKeyIterator>::value_type) * CHAR_BIT)
+            -> void
+        {
+            assert(keysEnd >= keysBegin);
+            auto size = static_cast<typename alpaka::trait::IdxType<TAcc>::type>(keysEnd - keysBegin);
+            deviceRadixSortPairs<TAcc, WorkDivPolicy>(devAcc, queue, size, keysBegin, values, beginBit, endBit);
+        }
+    } // namespace sort
+} // namespace vikunja
@@ -0,0 +1,211 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/affinity/Affinity.hpp>
+#include <vikunja/operators/operators.hpp>
+#include <vikunja/sort/detail/SegmentedSortKernel.hpp>
+#include <vikunja/workdiv/BlockBasedWorkDiv.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+#include <cstdint>
+#include <iterator>
+#include <limits>
+
+namespace vikunja
+{
+    namespace sort
+    {
+        namespace detail
+        {
+            /**
+             * Implementation of the segmented sort. The first kernel sorts the short segments with one thread per
+             * segment, the second kernel the long segments with one block per segment. Both kernels read the
+             * offsets on the device, therefore the segments are not copied to the host to classify them. If the
+             * block size is one, the first kernel sorts all segments.
+             */
+            template<
+                typename TAcc,
+                typename WorkDivPolicy,
+                bool TStable,
+                typename TCompareOperator,
+                typename TDevAcc,
+                typename TQueue,
+                typename TIdx,
+                typename TIterator,
+                typename TOffsetIterator,
+                typename TCompare>
+            void segmentedSortImpl(
+                TDevAcc& devAcc,
+                TQueue& queue,
+                TIdx const& n,
+                TIterator const& data,
+                TIdx const& numSegments,
+                TOffsetIterator const& offsets,
+                TCompare const& compare)
+            {
+                using TData = typename std::iterator_traits<TIterator>::value_type;
+                if(n < 2 || numSegments == 0)
+                {
+                    return;
+                }
+                vikunja::affinity::applyAffinity<TAcc>();
+                constexpr uint64_t blockSize = WorkDivPolicy::template getBlockSize<TAcc>();
+                using Dim = alpaka::Dim<TAcc>;
+                using WorkDiv = alpaka::WorkDivMembers<Dim, TIdx>;
+                using Vec = alpaka::Vec<Dim, TIdx>;
+                constexpr TIdx xIndex = Dim::value - 1u;
+
+                Vec const elementsPerThread(Vec::all(static_cast<TIdx>(1u)));
+                Vec threadsPerBlock(Vec::all(static_cast<TIdx>(1u)));
+                Vec blocksPerGrid(Vec::all(static_cast<TIdx>(1u)));
+                threadsPerBlock[xIndex] = static_cast<TIdx>(blockSize);
+
+                Vec dataExtent(Vec::all(static_cast<TIdx>(1u)));
+                dataExtent[xIndex] = n;
+                auto helper = alpaka::allocBuf<TData, TIdx>(devAcc, dataExtent);
+                TData* const helperPtr = alpaka::getPtrNative(helper);
+
+                TIdx const policyGridSize = WorkDivPolicy::template getGridSize<TAcc>(devAcc);
+                TIdx const threadGridSize
+                    = (numSegments + static_cast<TIdx>(blockSize) - 1) / static_cast<TIdx>(blockSize);
+                blocksPerGrid[xIndex] = (threadGridSize < policyGridSize) ? threadGridSize : policyGridSize;
+                WorkDiv const threadWorkDiv{blocksPerGrid, threadsPerBlock, elementsPerThread};
+
+                TIdx const threadLimit = (blockSize == 1u) ? std::numeric_limits<TIdx>::max()
+                                                           : static_cast<TIdx>(segmentThreadLimit);
+                ThreadSegmentedSortKernel<blockSize, TStable, TCompareOperator> threadKernel;
+                alpaka::exec<TAcc>(
+                    queue,
+                    threadWorkDiv,
+                    threadKernel,
+                    data,
+                    helperPtr,
+                    offsets,
+                    numSegments,
+                    threadLimit,
+                    compare);
+
+                if constexpr(blockSize > 1u)
+                {
+                    blocksPerGrid[xIndex] = (numSegments < policyGridSize) ? numSegments : policyGridSize;
+                    WorkDiv const blockWorkDiv{blocksPerGrid, threadsPerBlock, elementsPerThread};
+                    BlockSegmentedSortKernel<blockSize, TStable, TCompareOperator> blockKernel;
+                    alpaka::exec<TAcc>(
+                        queue,
+                        blockWorkDiv,
+                        blockKernel,
+                        data,
+                        helperPtr,
+                        offsets,
+                        numSegments,
+                        threadLimit,
+                        compare);
+                }
+
+                // the helper memory must not be freed before the kernels are finished
+                alpaka::wait(queue);
+            }
+        } // namespace detail
+
+        /**
+         * Sorts many segments of the data independently with a comparator. Segment i contains the elements
+         * [offsets[i], offsets[i + 1]), therefore offsets contains numSegments + 1 ascending values. Elements, which
+         * are not part of a segment, are not changed.
+         * Segments up to 128 elements are sorted by a single thread: tiles of 16 elements are sorted in registers
+         * with a sorting network and merged afterwards. Longer segments are sorted by a whole block, whose threads
+         * share the tiles and each merge pass. On accelerators with a block size of one, all segments are sorted
+         * by a single thread. All segments are sorted with two kernel launches, independent of their number.
+         * The order of equal elements is not kept, see deviceStableSegmentedSort.
+         * @tparam TAcc The alpaka accelerator type to use.
+         * @tparam WorkDivPolicy The working division policy. Defaults to a templated value depending on the
+         * accelerator.
+         * @tparam TCompare Type of the comparator.
+         * @tparam TIterator Type of the data iterator. Should be a pointer-like type.
+         * @tparam TOffsetIterator Type of the offset iterator. Should be a pointer-like type.
+         * @tparam TDevAcc The type of the alpaka accelerator.
+         * @tparam TQueue The type of the alpaka queue.
+         * @tparam TIdx The index type to use.
+         * @tparam TCompareOperator The vikunja::operators type of the comparator.
+         * @param devAcc The alpaka accelerator.
+         * @param queue The alpaka queue. The function waits for the queue, before it returns.
+         * @param n The number of elements of the data.
+         * @param data The elements, which are sorted in place.
+         * @param numSegments The number of segments.
+         * @param offsets The begin of each segment and the end of the last segment.
+         * @param compare The comparator, which returns true if the first argument is ordered before the second. It
+         * can optionally take the alpaka accelerator as first argument.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TCompare,
+            typename TIterator,
+            typename TOffsetIterator,
+            typename TDevAcc,
+            typename TQueue,
+            typename TIdx,
+            typename TData = typename std::iterator_traits<TIterator>::value_type,
+            typename TCompareOperator = vikunja::operators::BinaryOp<TAcc, TCompare, TData, TData>>
+        auto deviceSegmentedSort(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            TIdx const& n,
+            TIterator const& data,
+            TIdx const& numSegments,
+            TOffsetIterator const& offsets,
+            TCompare const& compare) -> void
+        {
+            detail::segmentedSortImpl<TAcc, WorkDivPolicy, false, TCompareOperator>(
+                devAcc,
+                queue,
+                n,
+                data,
+                numSegments,
+                offsets,
+                compare);
+        }
+
+        /**
+         * Sorts many segments of the data independently and keeps the order of equal elements.
+         * @see deviceSegmentedSort
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TCompare,
+            typename TIterator,
+            typename TOffsetIterator,
+            typename TDevAcc,
+            typename TQueue,
+            typename TIdx,
+            typename TData = typename std::iterator_traits<TIterator>::value_type,
+            typename TCompareOperator = vikunja::operators::BinaryOp<TAcc, TCompare, TData, TData>>
+        auto deviceStableSegmentedSort(
+            TDevAcc& devAcc,
+            TQueue& queue,
+            TIdx const& n,
+            TIterator const& data,
+            TIdx const& numSegments,
+            TOffsetIterator const& offsets,
+            TCompare const& compare) -> void
+        {
+            detail::segmentedSortImpl<TAcc, WorkDivPolicy, true, TCompareOperator>(
+                devAcc,
+                queue,
+                n,
+                data,
+                numSegments,
+                offsets,
+                compare);
+        }
+    } // namespace sort
+} // namespace vikunja
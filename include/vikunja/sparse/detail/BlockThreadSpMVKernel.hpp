@@ -0,0 +1,139 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/mem/iterator.hpp>
+#include <vikunja/operators/functors.hpp>
+#include <vikunja/operators/operators.hpp>
+#include <vikunja/sort/detail/MergePath.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+namespace vikunja
+{
+    namespace sparse
+    {
+        namespace detail
+        {
+            /**
+             * Merge based CSR sparse matrix vector multiplication. The merge path of the row ends and the indices
+             * of the nonzeros is divided into equal shares, one per thread. Each thread finds the begin of its share
+             * with a merge path search and walks along it: a nonzero is multiplied and added to the sum of the
+             * current row, a row end writes y[row] = alpha * sum + beta * y[row] and starts the next row. Therefore,
+             * each thread processes the same number of rows and nonzeros together, independent of the row lengths.
+             * A row, which is not finished at the end of the share, is continued by the next threads. The partial
+             * sum of the last row of each thread is written as carry out and must be added to y afterwards.
+             */
+            struct MergeSpMVKernel
+            {
+                /**
+                 * @param acc The alpaka accelerator.
+                 * @param rowOffsets The begin of each row and the number of nonzeros, numRows + 1 elements.
+                 * @param columns The column of each nonzero.
+                 * @param values The value of each nonzero.
+                 * @param x The input vector.
+                 * @param y The output vector with numRows elements.
+                 * @param numRows The number of rows.
+                 * @param nnz The number of nonzeros.
+                 * @param alpha The factor of the product.
+                 * @param beta The factor of y. If it is zero, y is not read.
+                 * @param carryRows The output row of the carry out of each thread. numRows, if there is none.
+                 * @param carryValues The output partial sum of the carry out of each thread.
+                 */
+                template<
+                    typename TAcc,
+                    typename TIdx,
+                    typename TOffsetIterator,
+                    typename TColumnIterator,
+                    typename TValueIterator,
+                    typename TInputIterator,
+                    typename TOutputIterator,
+                    typename TScalar>
+                ALPAKA_FN_ACC void operator()(
+                    TAcc const& acc,
+                    TOffsetIterator const& rowOffsets,
+                    TColumnIterator const& columns,
+                    TValueIterator const& values,
+                    TInputIterator const& x,
+                    TOutputIterator const& y,
+                    TIdx const& numRows,
+                    TIdx const& nnz,
+                    TScalar const& alpha,
+                    TScalar const& beta,
+                    TIdx* const carryRows,
+                    TScalar* const carryValues) const
+                {
+                    constexpr TIdx xIndex = alpaka::Dim<TAcc>::value - 1u;
+                    TIdx const globalThreadIndex = alpaka::getIdx<alpaka::Grid, alpaka::Threads>(acc)[xIndex];
+                    TIdx const globalThreadCount = alpaka::getWorkDiv<alpaka::Grid, alpaka::Threads>(acc)[xIndex];
+
+                    TIdx const pathLength = numRows + nnz;
+                    TIdx const itemsPerThread = (pathLength + globalThreadCount - 1) / globalThreadCount;
+                    TIdx begin = globalThreadIndex * itemsPerThread;
+                    begin = (begin < pathLength) ? begin : pathLength;
+                    TIdx const end = (pathLength - begin < itemsPerThread) ? pathLength : begin + itemsPerThread;
+
+                    // a row is finished, if the nonzero index reaches its end
+                    using LessOperator
+                        = vikunja::operators::BinaryOp<TAcc, vikunja::operators::Less<TIdx>, TIdx, TIdx>;
+                    auto const rowEnds = rowOffsets + 1;
+                    vikunja::mem::iterator::CountingIterator<TIdx> const nonzeroIndex;
+                    TIdx row = vikunja::sort::detail::mergePathSearch<LessOperator>(
+                        acc,
+                        rowEnds,
+                        numRows,
+                        nonzeroIndex,
+                        nnz,
+                        begin,
+                        vikunja::operators::Less<TIdx>());
+                    TIdx nonzero = begin - row;
+
+                    TScalar sum = 0;
+                    for(TIdx k = begin; k < end; ++k)
+                    {
+                        if(row < numRows && (nonzero >= nnz || static_cast<TIdx>(rowEnds[row]) <= nonzero))
+                        {
+                            y[row] = (beta == TScalar{0}) ? alpha * sum : alpha * sum + beta * y[row];
+                            sum = 0;
+                            ++row;
+                        }
+                        else
+                        {
+                            sum += values[nonzero] * x[columns[nonzero]];
+                            ++nonzero;
+                        }
+                    }
+                    carryRows[globalThreadIndex] = row;
+                    carryValues[globalThreadIndex] = sum;
+                }
+            };
+
+            /**
+             * Transform functor, which adds the reduced carry outs of a row to y. Each row occurs only once.
+             */
+            template<typename TOutputIterator, typename TScalar, typename TIdx>
+            struct AddCarryFunc
+            {
+                TOutputIterator y;
+                TScalar alpha;
+                TIdx numRows;
+
+                ALPAKA_FN_HOST_ACC bool operator()(TIdx const& row, TScalar const& sum) const
+                {
+                    if(row < numRows)
+                    {
+                        y[row] += alpha * sum;
+                    }
+                    return true;
+                }
+            };
+        } // namespace detail
+    } // namespace sparse
+} // namespace vikunja
@@ -0,0 +1,193 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/affinity/Affinity.hpp>
+#include <vikunja/mem/iterator.hpp>
+#include <vikunja/operators/functors.hpp>
+#include <vikunja/reduce/reduce.hpp>
+#include <vikunja/reduce/reduceByKey.hpp>
+#include <vikunja/sparse/detail/BlockThreadSpMVKernel.hpp>
+#include <vikunja/transform/transform.hpp>
+#include <vikunja/workdiv/BlockBasedWorkDiv.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+
+namespace vikunja
+{
+    namespace sparse
+    {
+        /**
+         * Multiplies a sparse matrix in the compressed sparse row (CSR) format with a dense vector, i.e.
+         * y = alpha * A * x + beta * y. Row i of A contains the nonzeros [rowOffsets[i], rowOffsets[i + 1]), whose
+         * columns and values are stored in columns and values.
+         * The work is partitioned with a merge path of the row ends and the nonzeros: each thread processes an equal
+         * share of rows and nonzeros together, so a long row is processed by several threads and many short rows do
+         * not leave threads idle. The partial sums of the rows, which are split between threads, are reduced with
+         * the reduce by key and added to y afterwards. The number of nonzeros and of the split rows are copied to
+         * the host. The function waits for the queue before it returns.
+         * @tparam TAcc The alpaka accelerator type to use.
+         * @tparam WorkDivPolicy The working division policy. Defaults to a templated value depending on the
+         * accelerator. For the API of this, see workdiv/BlockBasedWorkDiv.hpp
+         * @tparam TOffsetIterator Type of the row offset iterator. Should be a pointer-like type.
+         * @tparam TColumnIterator Type of the column iterator. Should be a pointer-like type.
+         * @tparam TValueIterator Type of the value iterator. Should be a pointer-like type.
+         * @tparam TInputIterator Type of the input vector. Should be a pointer-like type.
+         * @tparam TOutputIterator Type of the output vector. Should be a pointer-like type.
+         * @tparam TScalar Type of the factors and of the row sums.
+         * @tparam TDevAcc The type of the alpaka accelerator.
+         * @tparam TDevHost The type of the alpaka host device.
+         * @tparam TQueue The type of the alpaka queue.
+         * @tparam TIdx The index type to use.
+         * @param devAcc The alpaka accelerator.
+         * @param devHost The alpaka host device.
+         * @param queue The alpaka queue.
+         * @param numRows The number of rows of the matrix.
+         * @param rowOffsets The begin of each row, numRows + 1 elements. The first element must be 0 and the last
+         * element is the number of nonzeros.
+         * @param columns The column of each nonzero.
+         * @param values The value of each nonzero.
+         * @param x The input vector.
+         * @param y The output vector with numRows elements. Must not overlap with x.
+         * @param alpha The factor of the product.
+         * @param beta The factor of y. If it is zero, y is only written, like in BLAS.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TOffsetIterator,
+            typename TColumnIterator,
+            typename TValueIterator,
+            typename TInputIterator,
+            typename TOutputIterator,
+            typename TScalar,
+            typename TDevAcc,
+            typename TDevHost,
+            typename TQueue,
+            typename TIdx>
+        auto deviceSpMV(
+            TDevAcc& devAcc,
+            TDevHost& devHost,
+            TQueue& queue,
+            TIdx const& numRows,
+            TOffsetIterator const& rowOffsets,
+            TColumnIterator const& columns,
+            TValueIterator const& values,
+            TInputIterator const& x,
+            TOutputIterator const& y,
+            TScalar const& alpha,
+            TScalar const& beta) -> void
+        {
+            if(numRows == 0)
+            {
+                return;
+            }
+            using TOffset = typename std::iterator_traits<TOffsetIterator>::value_type;
+            using Dim = alpaka::Dim<TAcc>;
+            using WorkDiv = alpaka::WorkDivMembers<Dim, TIdx>;
+            using Vec = alpaka::Vec<Dim, TIdx>;
+            constexpr TIdx xIndex = Dim::value - 1u;
+
+            // the last row offset is the number of nonzeros
+            Vec const countExtent(Vec::all(static_cast<TIdx>(1u)));
+            auto countView = alpaka::allocBuf<TOffset, TIdx>(devHost, countExtent);
+            if constexpr(std::is_pointer_v<TOffsetIterator>)
+            {
+                alpaka::ViewPlainPtr<TDevAcc, TOffset, Dim, TIdx> lastRowOffset(
+                    const_cast<TOffset*>(rowOffsets + numRows),
+                    devAcc,
+                    countExtent);
+                alpaka::memcpy(queue, countView, lastRowOffset, countExtent);
+            }
+            else
+            {
+                // an iterator without memory is evaluated on the device
+                auto countBuffer = alpaka::allocBuf<TOffset, TIdx>(devAcc, countExtent);
+                vikunja::transform::deviceTransform<TAcc, WorkDivPolicy>(
+                    devAcc,
+                    queue,
+                    static_cast<TIdx>(1u),
+                    rowOffsets + numRows,
+                    alpaka::getPtrNative(countBuffer),
+                    vikunja::reduce::detail::Identity<TOffset>());
+                alpaka::memcpy(queue, countView, countBuffer, countExtent);
+            }
+            alpaka::wait(queue);
+            TIdx const nnz = static_cast<TIdx>(alpaka::getPtrNative(countView)[0]);
+
+            vikunja::affinity::applyAffinity<TAcc>();
+            constexpr uint64_t blockSize = WorkDivPolicy::template getBlockSize<TAcc>();
+            Vec const elementsPerThread(Vec::all(static_cast<TIdx>(1u)));
+            Vec threadsPerBlock(Vec::all(static_cast<TIdx>(1u)));
+            Vec blocksPerGrid(Vec::all(static_cast<TIdx>(1u)));
+
+            TIdx const pathLength = numRows + nnz;
+            if(pathLength >= static_cast<TIdx>(blockSize))
+            {
+                TIdx gridSize = WorkDivPolicy::template getGridSize<TAcc>(devAcc);
+                TIdx const maxGridSize = pathLength / static_cast<TIdx>(blockSize);
+                blocksPerGrid[xIndex] = (gridSize < maxGridSize) ? gridSize : maxGridSize;
+                threadsPerBlock[xIndex] = static_cast<TIdx>(blockSize);
+            }
+            TIdx const numThreads = blocksPerGrid[xIndex] * threadsPerBlock[xIndex];
+
+            Vec carryExtent(Vec::all(static_cast<TIdx>(1u)));
+            carryExtent[xIndex] = numThreads;
+            auto carryRows = alpaka::allocBuf<TIdx, TIdx>(devAcc, carryExtent);
+            auto carryValues = alpaka::allocBuf<TScalar, TIdx>(devAcc, carryExtent);
+            auto reducedRows = alpaka::allocBuf<TIdx, TIdx>(devAcc, carryExtent);
+            auto reducedValues = alpaka::allocBuf<TScalar, TIdx>(devAcc, carryExtent);
+
+            WorkDiv const workDiv{blocksPerGrid, threadsPerBlock, elementsPerThread};
+            detail::MergeSpMVKernel kernel;
+            alpaka::exec<TAcc>(
+                queue,
+                workDiv,
+                kernel,
+                rowOffsets,
+                columns,
+                values,
+                x,
+                y,
+                numRows,
+                nnz,
+                alpha,
+                beta,
+                alpaka::getPtrNative(carryRows),
+                alpaka::getPtrNative(carryValues));
+
+            // the carry outs are ordered by row, therefore the partial sums of each row are consecutive
+            TIdx const numCarryRows = vikunja::reduce::deviceReduceByKey<TAcc, WorkDivPolicy>(
+                devAcc,
+                devHost,
+                queue,
+                numThreads,
+                alpaka::getPtrNative(carryRows),
+                alpaka::getPtrNative(carryValues),
+                alpaka::getPtrNative(reducedRows),
+                alpaka::getPtrNative(reducedValues),
+                vikunja::operators::Plus<TScalar>());
+            vikunja::transform::deviceTransform<TAcc, WorkDivPolicy>(
+                devAcc,
+                queue,
+                numCarryRows,
+                alpaka::getPtrNative(reducedRows),
+                alpaka::getPtrNative(reducedValues),
+                vikunja::mem::iterator::DiscardIterator{},
+                detail::AddCarryFunc<TOutputIterator, TScalar, TIdx>{y, alpha, numRows});
+            // the helper memory must not be freed before the kernels are finished
+            alpaka::wait(queue);
+        }
+    } // namespace sparse
+} // namespace vikunja
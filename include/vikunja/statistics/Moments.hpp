@@ -0,0 +1,117 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+namespace vikunja
+{
+    namespace statistics
+    {
+        /**
+         * Count, mean and sum of squared deviations from the mean (M2) of a sequence. The count is integral,
+         * because a floating point count stops growing, e.g. at 2^24 for float.
+         * @tparam T A floating point type.
+         */
+        template<typename T>
+        struct Moments
+        {
+            std::uint64_t count;
+            T mean;
+            T m2;
+
+            //! Population variance M2 / count.
+            T variance() const
+            {
+                return m2 / static_cast<T>(count);
+            }
+
+            //! Sample variance M2 / (count - 1).
+            T sampleVariance() const
+            {
+                return m2 / static_cast<T>(count - 1u);
+            }
+        };
+
+        /**
+         * Moments of a sequence up to the fourth order: additionally the sums of the cubed (M3) and the fourth
+         * powers (M4) of the deviations from the mean.
+         * @tparam T A floating point type.
+         */
+        template<typename T>
+        struct HigherMoments
+        {
+            std::uint64_t count;
+            T mean;
+            T m2;
+            T m3;
+            T m4;
+
+            //! Population variance M2 / count.
+            T variance() const
+            {
+                return m2 / static_cast<T>(count);
+            }
+
+            //! Sample variance M2 / (count - 1).
+            T sampleVariance() const
+            {
+                return m2 / static_cast<T>(count - 1u);
+            }
+
+            //! Population skewness sqrt(count) * M3 / M2^(3/2).
+            T skewness() const
+            {
+                return std::sqrt(static_cast<T>(count)) * m3 / std::pow(m2, T{1.5});
+            }
+
+            //! Population excess kurtosis count * M4 / M2^2 - 3.
+            T kurtosis() const
+            {
+                return static_cast<T>(count) * m4 / (m2 * m2) - T{3};
+            }
+        };
+
+        /**
+         * Count, means, sums of squared deviations and sum of the products of the deviations (C) of two
+         * sequences.
+         * @tparam T A floating point type.
+         */
+        template<typename T>
+        struct CoMoments
+        {
+            std::uint64_t count;
+            T meanX;
+            T meanY;
+            T m2X;
+            T m2Y;
+            T c;
+
+            //! Population covariance C / count.
+            T covariance() const
+            {
+                return c / static_cast<T>(count);
+            }
+
+            //! Sample covariance C / (count - 1).
+            T sampleCovariance() const
+            {
+                return c / static_cast<T>(count - 1u);
+            }
+
+            //! Pearson correlation coefficient C / sqrt(M2X * M2Y).
+            T correlation() const
+            {
+                return c / std::sqrt(m2X * m2Y);
+            }
+        };
+    } // namespace statistics
+} // namespace vikunja
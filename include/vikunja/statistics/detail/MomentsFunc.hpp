@@ -0,0 +1,159 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/statistics/Moments.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+#include <cstdint>
+
+namespace vikunja
+{
+    namespace statistics
+    {
+        namespace detail
+        {
+            /**
+             * Transform functor, which returns the moments of a single element.
+             */
+            template<typename T>
+            struct MomentsFunc
+            {
+                template<typename TInput>
+                constexpr ALPAKA_FN_HOST_ACC Moments<T> operator()(TInput const& x) const
+                {
+                    return Moments<T>{1u, static_cast<T>(x), T{0}};
+                }
+            };
+
+            /**
+             * Reduce functor, which merges the moments of two disjoint parts of a sequence with the parallel
+             * formulas of Chan et al. Unlike the sum of squares, the merge does not cancel catastrophically if the
+             * variance is small compared to the mean.
+             */
+            template<typename T>
+            struct MomentsMerge
+            {
+                static constexpr bool isAssociative = true;
+
+                constexpr ALPAKA_FN_HOST_ACC Moments<T> operator()(Moments<T> const& a, Moments<T> const& b) const
+                {
+                    std::uint64_t const count = a.count + b.count;
+                    if(count == 0u)
+                    {
+                        return a;
+                    }
+                    T const na = static_cast<T>(a.count);
+                    T const nb = static_cast<T>(b.count);
+                    T const n = static_cast<T>(count);
+                    T const delta = b.mean - a.mean;
+                    return Moments<T>{count, a.mean + delta * nb / n, a.m2 + b.m2 + delta * delta * na * nb / n};
+                }
+            };
+
+            /**
+             * Transform functor, which returns the moments up to the fourth order of a single element.
+             */
+            template<typename T>
+            struct HigherMomentsFunc
+            {
+                template<typename TInput>
+                constexpr ALPAKA_FN_HOST_ACC HigherMoments<T> operator()(TInput const& x) const
+                {
+                    return HigherMoments<T>{1u, static_cast<T>(x), T{0}, T{0}, T{0}};
+                }
+            };
+
+            /**
+             * Reduce functor, which merges the moments up to the fourth order of two disjoint parts of a sequence
+             * with the formulas of Pébay.
+             */
+            template<typename T>
+            struct HigherMomentsMerge
+            {
+                static constexpr bool isAssociative = true;
+
+                constexpr ALPAKA_FN_HOST_ACC HigherMoments<T> operator()(
+                    HigherMoments<T> const& a,
+                    HigherMoments<T> const& b) const
+                {
+                    std::uint64_t const count = a.count + b.count;
+                    if(count == 0u)
+                    {
+                        return a;
+                    }
+                    T const na = static_cast<T>(a.count);
+                    T const nb = static_cast<T>(b.count);
+                    T const delta = b.mean - a.mean;
+                    T const deltaN = delta / static_cast<T>(count);
+                    T const deltaN2 = deltaN * deltaN;
+                    T const term = delta * deltaN * na * nb;
+                    return HigherMoments<T>{
+                        count,
+                        a.mean + deltaN * nb,
+                        a.m2 + b.m2 + term,
+                        a.m3 + b.m3 + term * deltaN * (na - nb) + T{3} * deltaN * (na * b.m2 - nb * a.m2),
+                        a.m4 + b.m4 + term * deltaN2 * (na * na - na * nb + nb * nb)
+                            + T{6} * deltaN2 * (na * na * b.m2 + nb * nb * a.m2)
+                            + T{4} * deltaN * (na * b.m3 - nb * a.m3)};
+                }
+            };
+
+            /**
+             * Transform functor of the co-moments, which is applied to the index of the element, so that both
+             * sequences are read in the single pass of the transform reduce.
+             */
+            template<typename T, typename TIteratorX, typename TIteratorY>
+            struct CoMomentsFunc
+            {
+                TIteratorX x;
+                TIteratorY y;
+
+                template<typename TIdx>
+                constexpr ALPAKA_FN_HOST_ACC CoMoments<T> operator()(TIdx const& i) const
+                {
+                    return CoMoments<T>{1u, static_cast<T>(x[i]), static_cast<T>(y[i]), T{0}, T{0}, T{0}};
+                }
+            };
+
+            /**
+             * Reduce functor, which merges the co-moments of two disjoint parts of two sequences.
+             */
+            template<typename T>
+            struct CoMomentsMerge
+            {
+                static constexpr bool isAssociative = true;
+
+                constexpr ALPAKA_FN_HOST_ACC CoMoments<T> operator()(CoMoments<T> const& a, CoMoments<T> const& b)
+                    const
+                {
+                    std::uint64_t const count = a.count + b.count;
+                    if(count == 0u)
+                    {
+                        return a;
+                    }
+                    T const nb = static_cast<T>(b.count);
+                    T const n = static_cast<T>(count);
+                    T const deltaX = b.meanX - a.meanX;
+                    T const deltaY = b.meanY - a.meanY;
+                    T const weight = static_cast<T>(a.count) * nb / n;
+                    return CoMoments<T>{
+                        count,
+                        a.meanX + deltaX * nb / n,
+                        a.meanY + deltaY * nb / n,
+                        a.m2X + b.m2X + deltaX * deltaX * weight,
+                        a.m2Y + b.m2Y + deltaY * deltaY * weight,
+                        a.c + b.c + deltaX * deltaY * weight};
+                }
+            };
+        } // namespace detail
+    } // namespace statistics
+} // namespace vikunja
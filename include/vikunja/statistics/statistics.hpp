@@ -0,0 +1,166 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/access/BlockStrategy.hpp>
+#include <vikunja/mem/iterator.hpp>
+#include <vikunja/reduce/reduce.hpp>
+#include <vikunja/statistics/Moments.hpp>
+#include <vikunja/statistics/detail/MomentsFunc.hpp>
+#include <vikunja/workdiv/BlockBasedWorkDiv.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+#include <iterator>
+#include <type_traits>
+
+namespace vikunja
+{
+    namespace statistics
+    {
+        /**
+         * Computes the count, the mean and the sum of squared deviations from the mean of a sequence in a single
+         * read of the data, e.g. for the variance. Each element is transformed to the moments of a single element,
+         * which are merged with the parallel formulas of Chan et al. by the block tree and the second phase of the
+         * reduce. Unlike the difference of the sum of squares and the squared sum, the merge does not lose the
+         * precision of the variance if it is small compared to the mean.
+         * @tparam TAcc The alpaka accelerator type to use.
+         * @tparam WorkDivPolicy The working division policy. Defaults to a templated value depending on the
+         * accelerator. For the API of this, see workdiv/BlockBasedWorkDiv.hpp
+         * @tparam MemAccessPolicy The memory access policy. Defaults to a templated value depending on the
+         * accelerator. For the API of this, see vikunja::MemAccess::PolicyBasedBlockStrategy
+         * @tparam TInputIterator Type of the input iterator. Should be a pointer-like type.
+         * @tparam TDevAcc The type of the alpaka accelerator.
+         * @tparam TDevHost The type of the alpaka host.
+         * @tparam TQueue The type of the alpaka queue.
+         * @tparam TIdx The index type to use.
+         * @tparam T The floating point type of the moments. The input type for floating point inputs, otherwise
+         * double.
+         * @param devAcc The alpaka accelerator.
+         * @param devHost The alpaka host.
+         * @param queue The alpaka queue.
+         * @param n The number of elements.
+         * @param input The input iterator.
+         * @return The moments. All members are 0, if n is 0.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename MemAccessPolicy = vikunja::MemAccess::MemAccessPolicy<TAcc>,
+            typename TInputIterator,
+            typename TDevAcc,
+            typename TDevHost,
+            typename TQueue,
+            typename TIdx,
+            typename TData = typename std::iterator_traits<TInputIterator>::value_type,
+            typename T = std::conditional_t<std::is_floating_point_v<TData>, TData, double>>
+        auto deviceMoments(
+            TDevAcc& devAcc,
+            TDevHost& devHost,
+            TQueue& queue,
+            TIdx const& n,
+            TInputIterator const& input) -> Moments<T>
+        {
+            if(n == 0)
+            {
+                return Moments<T>{0u, T{0}, T{0}};
+            }
+            return vikunja::reduce::deviceTransformReduce<TAcc, WorkDivPolicy, MemAccessPolicy>(
+                devAcc,
+                devHost,
+                queue,
+                n,
+                input,
+                detail::MomentsFunc<T>(),
+                detail::MomentsMerge<T>());
+        }
+
+        /**
+         * Computes the moments up to the fourth order of a sequence in a single read of the data, e.g. for the
+         * skewness and the kurtosis. The moments are merged with the formulas of Pébay.
+         * @see deviceMoments
+         * @return The moments. All members are 0, if n is 0.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename MemAccessPolicy = vikunja::MemAccess::MemAccessPolicy<TAcc>,
+            typename TInputIterator,
+            typename TDevAcc,
+            typename TDevHost,
+            typename TQueue,
+            typename TIdx,
+            typename TData = typename std::iterator_traits<TInputIterator>::value_type,
+            typename T = std::conditional_t<std::is_floating_point_v<TData>, TData, double>>
+        auto deviceHigherMoments(
+            TDevAcc& devAcc,
+            TDevHost& devHost,
+            TQueue& queue,
+            TIdx const& n,
+            TInputIterator const& input) -> HigherMoments<T>
+        {
+            if(n == 0)
+            {
+                return HigherMoments<T>{0u, T{0}, T{0}, T{0}, T{0}};
+            }
+            return vikunja::reduce::deviceTransformReduce<TAcc, WorkDivPolicy, MemAccessPolicy>(
+                devAcc,
+                devHost,
+                queue,
+                n,
+                input,
+                detail::HigherMomentsFunc<T>(),
+                detail::HigherMomentsMerge<T>());
+        }
+
+        /**
+         * Computes the means, the sums of squared deviations and the sum of the products of the deviations of two
+         * sequences in a single read of both, e.g. for the covariance and the correlation. The transform reduce
+         * runs over the element indices, so that both sequences are read at the same index.
+         * @see deviceMoments
+         * @param x The first sequence.
+         * @param y The second sequence.
+         * @return The co-moments. All members are 0, if n is 0.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename MemAccessPolicy = vikunja::MemAccess::MemAccessPolicy<TAcc>,
+            typename TIteratorX,
+            typename TIteratorY,
+            typename TDevAcc,
+            typename TDevHost,
+            typename TQueue,
+            typename TIdx,
+            typename TData = typename std::iterator_traits<TIteratorX>::value_type,
+            typename T = std::conditional_t<std::is_floating_point_v<TData>, TData, double>>
+        auto deviceCoMoments(
+            TDevAcc& devAcc,
+            TDevHost& devHost,
+            TQueue& queue,
+            TIdx const& n,
+            TIteratorX const& x,
+            TIteratorY const& y) -> CoMoments<T>
+        {
+            if(n == 0)
+            {
+                return CoMoments<T>{0u, T{0}, T{0}, T{0}, T{0}, T{0}};
+            }
+            return vikunja::reduce::deviceTransformReduce<TAcc, WorkDivPolicy, MemAccessPolicy>(
+                devAcc,
+                devHost,
+                queue,
+                n,
+                vikunja::mem::iterator::CountingIterator<TIdx>{},
+                detail::CoMomentsFunc<T, TIteratorX, TIteratorY>{x, y},
+                detail::CoMomentsMerge<T>());
+        }
+    } // namespace statistics
+} // namespace vikunja
@@ -0,0 +1,188 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/affinity/Affinity.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace vikunja
+{
+    namespace threadpool
+    {
+        /**
+         * Persistent pool of host worker threads. The workers are started once and wait for jobs, instead of being
+         * spawned and joined for each kernel launch. After a job, the workers spin for a short time before they go to
+         * sleep, so that jobs which are submitted in a high frequency start within a few microseconds.
+         *
+         * A job is executed by all threads of the pool, including the calling thread, which executes the task with
+         * index 0. Task i is always executed by the same worker thread. The worker threads are pinned according to the
+         * process wide vikunja::affinity::AffinityPolicy, which defaults to compact for the pool, so that the data of
+         * a task stays in the caches of a core across repeated jobs. The calling thread belongs to the application and
+         * is never pinned.
+         */
+        class ThreadPool
+        {
+        private:
+            //! Number of polling iterations of an idle worker before it goes to sleep.
+            static constexpr std::uint32_t spinIterations = 1u << 16;
+
+            using TaskFunc = void (*)(void const* job, std::size_t taskIndex, std::size_t numTasks);
+
+            std::vector<std::thread> m_workers;
+            std::size_t m_numThreads;
+
+            // serializes the submission of jobs from different host threads
+            std::mutex m_submitMutex;
+
+            std::mutex m_sleepMutex;
+            std::condition_variable m_wakeUp;
+
+            std::atomic<std::uint64_t> m_generation{0};
+            std::atomic<std::size_t> m_pendingTasks{0};
+            std::atomic<bool> m_shutdown{false};
+
+            TaskFunc m_taskFunc = nullptr;
+            void const* m_job = nullptr;
+
+            explicit ThreadPool(std::size_t const numThreads) : m_numThreads(std::max(std::size_t{1}, numThreads))
+            {
+                for(std::size_t i = 1; i < m_numThreads; ++i)
+                {
+                    m_workers.emplace_back([this, i] { workerLoop(i); });
+                }
+            }
+
+            void workerLoop(std::size_t const taskIndex)
+            {
+                std::uint64_t seenGeneration = 0;
+                while(true)
+                {
+                    std::uint32_t spin = 0;
+                    while(m_generation.load(std::memory_order_acquire) == seenGeneration
+                          && !m_shutdown.load(std::memory_order_acquire))
+                    {
+                        if(++spin > spinIterations)
+                        {
+                            std::unique_lock<std::mutex> lock(m_sleepMutex);
+                            m_wakeUp.wait(
+                                lock,
+                                [&]
+                                {
+                                    return m_generation.load(std::memory_order_acquire) != seenGeneration
+                                        || m_shutdown.load(std::memory_order_acquire);
+                                });
+                        }
+                        else
+                        {
+                            std::this_thread::yield();
+                        }
+                    }
+                    if(m_shutdown.load(std::memory_order_acquire))
+                    {
+                        return;
+                    }
+                    seenGeneration = m_generation.load(std::memory_order_acquire);
+                    vikunja::affinity::pinCurrentThread(taskIndex, vikunja::affinity::ThreadKind::threadPool);
+                    m_taskFunc(m_job, taskIndex, m_numThreads);
+                    m_pendingTasks.fetch_sub(1, std::memory_order_acq_rel);
+                }
+            }
+
+        public:
+            ThreadPool(ThreadPool const&) = delete;
+            ThreadPool& operator=(ThreadPool const&) = delete;
+
+            ~ThreadPool()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(m_sleepMutex);
+                    m_shutdown.store(true, std::memory_order_release);
+                }
+                m_wakeUp.notify_all();
+                for(auto& worker : m_workers)
+                {
+                    worker.join();
+                }
+            }
+
+            /**
+             * Returns the process wide instance, which has one thread per hardware thread.
+             */
+            static ThreadPool& instance()
+            {
+                static ThreadPool pool(std::thread::hardware_concurrency());
+                return pool;
+            }
+
+            /**
+             * Number of threads of the pool, including the calling thread.
+             */
+            std::size_t size() const
+            {
+                return m_numThreads;
+            }
+
+            /**
+             * Executes func(taskIndex, numTasks) for each taskIndex in [0, size()) and returns, after all tasks are
+             * finished.
+             * @param func Functor, which is called by each thread of the pool.
+             */
+            template<typename TFunc>
+            void run(TFunc const& func)
+            {
+                std::lock_guard<std::mutex> submitLock(m_submitMutex);
+                if(m_numThreads > 1)
+                {
+                    m_job = static_cast<void const*>(&func);
+                    m_taskFunc = [](void const* job, std::size_t taskIndex, std::size_t numTasks)
+                    { (*static_cast<TFunc const*>(job))(taskIndex, numTasks); };
+                    m_pendingTasks.store(m_numThreads - 1, std::memory_order_relaxed);
+                    {
+                        // the lock avoids a lost wake up of a worker, which is going to sleep
+                        std::lock_guard<std::mutex> lock(m_sleepMutex);
+                        m_generation.fetch_add(1, std::memory_order_acq_rel);
+                    }
+                    m_wakeUp.notify_all();
+                }
+
+                func(std::size_t{0}, m_numThreads);
+
+                while(m_pendingTasks.load(std::memory_order_acquire) != 0)
+                {
+                    std::this_thread::yield();
+                }
+            }
+
+            /**
+             * Returns the range [first, second) of the linear chunk of task taskIndex, if a range of n elements is
+             * split in numTasks chunks. The chunk sizes differ by at most one element.
+             */
+            template<typename TIdx>
+            static std::pair<TIdx, TIdx> getChunk(TIdx const n, std::size_t const taskIndex, std::size_t numTasks)
+            {
+                auto const index = static_cast<TIdx>(taskIndex);
+                auto const count = static_cast<TIdx>(numTasks);
+                TIdx const chunkSize = n / count;
+                TIdx const remainder = n % count;
+                TIdx const begin = chunkSize * index + std::min(index, remainder);
+                TIdx const end = begin + chunkSize + (index < remainder ? 1 : 0);
+                return {begin, end};
+            }
+        };
+    } // namespace threadpool
+} // namespace vikunja
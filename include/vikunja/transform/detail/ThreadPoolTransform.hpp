@@ -0,0 +1,98 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/threadpool/ThreadPool.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+#include <iterator>
+#include <type_traits>
+
+namespace vikunja
+{
+    namespace transform
+    {
+        namespace detail
+        {
+            /**
+             * Transform on the host thread pool. Each thread of the pool transforms one linear chunk of the input.
+             * @tparam TAcc The alpaka accelerator type. The accelerator needs to use host memory.
+             * @param n The size of the input iterator.
+             * @param source The input iterator.
+             * @param destination The output iterator.
+             * @param func The transform operator. Must not take the acc argument.
+             */
+            template<typename TAcc, typename TIdx, typename TInputIterator, typename TOutputIterator, typename TFunc>
+            void threadPoolTransform(
+                TIdx const& n,
+                TInputIterator const& source,
+                TOutputIterator const& destination,
+                TFunc const& func)
+            {
+                static_assert(
+                    std::is_same_v<alpaka::Pltf<alpaka::Dev<TAcc>>, alpaka::PltfCpu>,
+                    "The host thread pool requires an accelerator with host memory.");
+                static_assert(
+                    std::is_invocable_v<TFunc, typename std::iterator_traits<TInputIterator>::value_type>,
+                    "The host thread pool requires functors without the acc argument.");
+
+                vikunja::threadpool::ThreadPool::instance().run(
+                    [&](std::size_t const taskIndex, std::size_t const numTasks)
+                    {
+                        auto const chunk = vikunja::threadpool::ThreadPool::getChunk(n, taskIndex, numTasks);
+                        for(TIdx i = chunk.first; i < chunk.second; ++i)
+                        {
+                            destination[i] = func(source[i]);
+                        }
+                    });
+            }
+
+            /**
+             * Transform of two inputs on the host thread pool.
+             * @see threadPoolTransform
+             */
+            template<
+                typename TAcc,
+                typename TIdx,
+                typename TInputIterator,
+                typename TInputIteratorSecond,
+                typename TOutputIterator,
+                typename TFunc>
+            void threadPoolTransform(
+                TIdx const& n,
+                TInputIterator const& source,
+                TInputIteratorSecond const& sourceSecond,
+                TOutputIterator const& destination,
+                TFunc const& func)
+            {
+                static_assert(
+                    std::is_same_v<alpaka::Pltf<alpaka::Dev<TAcc>>, alpaka::PltfCpu>,
+                    "The host thread pool requires an accelerator with host memory.");
+                static_assert(
+                    std::is_invocable_v<
+                        TFunc,
+                        typename std::iterator_traits<TInputIterator>::value_type,
+                        typename std::iterator_traits<TInputIteratorSecond>::value_type>,
+                    "The host thread pool requires functors without the acc argument.");
+
+                vikunja::threadpool::ThreadPool::instance().run(
+                    [&](std::size_t const taskIndex, std::size_t const numTasks)
+                    {
+                        auto const chunk = vikunja::threadpool::ThreadPool::getChunk(n, taskIndex, numTasks);
+                        for(TIdx i = chunk.first; i < chunk.second; ++i)
+                        {
+                            destination[i] = func(source[i], sourceSecond[i]);
+                        }
+                    });
+            }
+        } // namespace detail
+    } // namespace transform
+} // namespace vikunja
@@ -10,8 +10,10 @@
 #pragma once
 
 #include <vikunja/access/BlockStrategy.hpp>
+#include <vikunja/affinity/Affinity.hpp>
 #include <vikunja/operators/operators.hpp>
 #include <vikunja/transform/detail/BlockThreadTransformKernel.hpp>
+#include <vikunja/transform/detail/ThreadPoolTransform.hpp>
 #include <vikunja/workdiv/BlockBasedWorkDiv.hpp>
 
 #include <alpaka/alpaka.hpp>
@@ -82,6 +84,14 @@ namespace vikunja
             {
                 return;
             }
+            if constexpr(vikunja::workdiv::isHostThreadPoolPolicy<WorkDivPolicy>)
+            {
+                // previous tasks in the queue can access the input and output
+                alpaka::wait(queue);
+                detail::threadPoolTransform<TAcc>(n, source, destination, func);
+                return;
+            }
+            vikunja::affinity::applyAffinity<TAcc>();
             constexpr uint64_t blockSize = WorkDivPolicy::template getBlockSize<TAcc>();
             using Dim = alpaka::Dim<TAcc>;
             using WorkDiv = alpaka::WorkDivMembers<Dim, TIdx>;
@@ -158,7 +168,7 @@ namespace vikunja
         {
             assert(sourceEnd >= sourceBegin);
             auto size = static_cast<typename alpaka::trait::IdxType<TAcc>::type>(sourceEnd - sourceBegin);
-            deviceTransform<TAcc>(devAcc, queue, size, sourceBegin, destination, func);
+            deviceTransform<TAcc, WorkDivPolicy, MemAccessPolicy>(devAcc, queue, size, sourceBegin, destination, func);
         }
 
         /**
@@ -211,6 +221,14 @@ namespace vikunja
             {
                 return;
             }
+            if constexpr(vikunja::workdiv::isHostThreadPoolPolicy<WorkDivPolicy>)
+            {
+                // previous tasks in the queue can access the input and output
+                alpaka::wait(queue);
+                detail::threadPoolTransform<TAcc>(n, source, sourceSecond, destination, func);
+                return;
+            }
+            vikunja::affinity::applyAffinity<TAcc>();
             constexpr uint64_t blockSize = WorkDivPolicy::template getBlockSize<TAcc>();
             using Dim = alpaka::Dim<TAcc>;
             using WorkDiv = alpaka::WorkDivMembers<Dim, TIdx>;
@@ -288,7 +306,14 @@ namespace vikunja
         {
             assert(sourceEnd >= sourceBegin);
             auto size = static_cast<typename alpaka::trait::IdxType<TAcc>::type>(sourceEnd - sourceBegin);
-            deviceTransform<TAcc>(devAcc, queue, size, sourceBegin, sourceSecond, destination, func);
+            deviceTransform<TAcc, WorkDivPolicy, MemAccessPolicy>(
+                devAcc,
+                queue,
+                size,
+                sourceBegin,
+                sourceSecond,
+                destination,
+                func);
         }
     } // namespace transform
 } // namespace vikunja
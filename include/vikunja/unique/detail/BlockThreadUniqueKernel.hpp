@@ -0,0 +1,70 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/access/BlockStrategy.hpp>
+#include <vikunja/reduce/detail/BlockThreadReduceByKeyKernel.hpp>
+#include <vikunja/scan/detail/BlockThreadScanKernel.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+namespace vikunja
+{
+    namespace unique
+    {
+        namespace detail
+        {
+            /**
+             * Counts the run heads of the chunk of each thread, i.e. the elements which are not equal to their
+             * predecessor.
+             * @tparam TBlockSize The block size of this kernel.
+             * @tparam TEqualOperator The vikunja::operators type of the equality predicate.
+             */
+            template<uint64_t TBlockSize, typename TEqualOperator>
+            struct ChunkHeadCountKernel
+            {
+                /**
+                 * @param acc The alpaka accelerator.
+                 * @param source The input iterator.
+                 * @param chunkCounts The output iterator with one element per thread of the grid.
+                 * @param n The size of the input iterator.
+                 * @param equal The equality predicate.
+                 */
+                template<
+                    typename TAcc,
+                    typename TIdx,
+                    typename TInputIterator,
+                    typename TCountIterator,
+                    typename TEqual>
+                ALPAKA_FN_ACC void operator()(
+                    TAcc const& acc,
+                    TInputIterator const& source,
+                    TCountIterator const& chunkCounts,
+                    TIdx const& n,
+                    TEqual const& equal) const
+                {
+                    constexpr TIdx xIndex = alpaka::Dim<TAcc>::value - 1u;
+                    auto const globalThreadIndex = alpaka::getIdx<alpaka::Grid, alpaka::Threads>(acc)[xIndex];
+
+                    using MemIndex = vikunja::MemAccess::BlockStrategy<vikunja::scan::detail::ChunkPolicy, TAcc, TIdx>;
+                    TIdx count = 0;
+                    for(MemIndex iter(acc, n, TBlockSize), end = iter.end(); iter < end; ++iter)
+                    {
+                        if(vikunja::reduce::detail::isSegmentHead<TEqualOperator>(acc, source, *iter, equal))
+                        {
+                            ++count;
+                        }
+                    }
+                    chunkCounts[globalThreadIndex] = count;
+                }
+            };
+        } // namespace detail
+    } // namespace unique
+} // namespace vikunja
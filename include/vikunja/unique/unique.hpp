@@ -0,0 +1,319 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <vikunja/affinity/Affinity.hpp>
+#include <vikunja/mem/iterator.hpp>
+#include <vikunja/operators/functors.hpp>
+#include <vikunja/operators/operators.hpp>
+#include <vikunja/reduce/reduce.hpp>
+#include <vikunja/reduce/reduceByKey.hpp>
+#include <vikunja/unique/detail/BlockThreadUniqueKernel.hpp>
+#include <vikunja/workdiv/BlockBasedWorkDiv.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+#include <cassert>
+#include <iterator>
+
+namespace vikunja
+{
+    namespace unique
+    {
+        /**
+         * Copies the first element of each run of consecutive equal elements to the output, i.e. if one has the
+         * array [1,1,2,2,2,1,3,3], the output will contain [1,2,1,3] and 4 is returned.
+         * The runs are found, reduced and compacted in one fused pipeline of three kernels, which is shared with the
+         * reduce by key. Only the number of runs is copied to the host.
+         * The output must be big enough for all runs and must not overlap with the input.
+         * @tparam TAcc The alpaka accelerator type to use.
+         * @tparam WorkDivPolicy The working division policy. Defaults to a templated value depending on the
+         * accelerator. Each thread needs a contiguous chunk of the input, therefore the linear memory access policy
+         * is always used.
+         * @tparam TInputIterator Type of the input iterator. Should be a pointer-like type.
+         * @tparam TOutputIterator Type of the output iterator. Should be a pointer-like type.
+         * @tparam TDevAcc The type of the alpaka accelerator.
+         * @tparam TDevHost The type of the alpaka host.
+         * @tparam TQueue The type of the alpaka queue.
+         * @tparam TIdx The index type to use.
+         * @tparam TData The value type of the input.
+         * @tparam TEqual Type of the equality predicate.
+         * @tparam TEqualOperator The vikunja::operators type of the equality predicate.
+         * @param devAcc The alpaka accelerator.
+         * @param devHost The alpaka host.
+         * @param queue The alpaka queue.
+         * @param n The number of input elements.
+         * @param source The input iterator.
+         * @param destination The output iterator.
+         * @param equal The equality predicate, which returns true if two neighboring elements belong to the same
+         * run. Defaults to operator==. It can optionally take the alpaka accelerator as first argument.
+         * @return The number of runs.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TInputIterator,
+            typename TOutputIterator,
+            typename TDevAcc,
+            typename TDevHost,
+            typename TQueue,
+            typename TIdx,
+            typename TData = typename std::iterator_traits<TInputIterator>::value_type,
+            typename TEqual = vikunja::reduce::detail::EqualTo<TData>,
+            typename TEqualOperator = vikunja::operators::BinaryOp<TAcc, TEqual, TData, TData>>
+        auto deviceUnique(
+            TDevAcc& devAcc,
+            TDevHost& devHost,
+            TQueue& queue,
+            TIdx const& n,
+            TInputIterator const& source,
+            TOutputIterator const& destination,
+            TEqual const& equal = TEqual()) -> TIdx
+        {
+            using PlusOperator = vikunja::operators::BinaryOp<TAcc, vikunja::operators::Plus<TIdx>, TIdx, TIdx>;
+            // the reduction of the runs is not used
+            return vikunja::reduce::detail::reduceByKeyImpl<TAcc, WorkDivPolicy, TIdx, PlusOperator, TEqualOperator>(
+                devAcc,
+                devHost,
+                queue,
+                n,
+                source,
+                vikunja::mem::iterator::ConstantIterator<TIdx>{0},
+                destination,
+                vikunja::mem::iterator::DiscardIterator{},
+                vikunja::operators::Plus<TIdx>(),
+                equal);
+        }
+
+        /**
+         * Unique with begin and end iterator of the input.
+         * @see deviceUnique
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TInputIterator,
+            typename TOutputIterator,
+            typename TDevAcc,
+            typename TDevHost,
+            typename TQueue,
+            typename TEqual
+            = vikunja::reduce::detail::EqualTo<typename std::iterator_traits<TInputIterator>::value_type>>
+        auto deviceUnique(
+            TDevAcc& devAcc,
+            TDevHost& devHost,
+            TQueue& queue,
+            TInputIterator const& sourceBegin,
+            TInputIterator const& sourceEnd,
+            TOutputIterator const& destination,
+            TEqual const& equal = TEqual())
+        {
+            assert(sourceEnd >= sourceBegin);
+            auto size = static_cast<typename alpaka::trait::IdxType<TAcc>::type>(sourceEnd - sourceBegin);
+            return deviceUnique<TAcc, WorkDivPolicy>(devAcc, devHost, queue, size, sourceBegin, destination, equal);
+        }
+
+        /**
+         * Returns the number of runs of consecutive equal elements, i.e. the number of elements deviceUnique would
+         * write. Each thread counts the run heads of its chunk in a single pass, afterwards the counts of the
+         * chunks are reduced.
+         * @see deviceUnique
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TInputIterator,
+            typename TDevAcc,
+            typename TDevHost,
+            typename TQueue,
+            typename TIdx,
+            typename TData = typename std::iterator_traits<TInputIterator>::value_type,
+            typename TEqual = vikunja::reduce::detail::EqualTo<TData>,
+            typename TEqualOperator = vikunja::operators::BinaryOp<TAcc, TEqual, TData, TData>>
+        auto deviceUniqueCount(
+            TDevAcc& devAcc,
+            TDevHost& devHost,
+            TQueue& queue,
+            TIdx const& n,
+            TInputIterator const& source,
+            TEqual const& equal = TEqual()) -> TIdx
+        {
+            if(n == 0)
+            {
+                return 0;
+            }
+            vikunja::affinity::applyAffinity<TAcc>();
+            constexpr uint64_t blockSize = WorkDivPolicy::template getBlockSize<TAcc>();
+            using Dim = alpaka::Dim<TAcc>;
+            using WorkDiv = alpaka::WorkDivMembers<Dim, TIdx>;
+            using Vec = alpaka::Vec<Dim, TIdx>;
+            constexpr TIdx xIndex = Dim::value - 1u;
+
+            Vec const elementsPerThread(Vec::all(static_cast<TIdx>(1u)));
+            Vec threadsPerBlock(Vec::all(static_cast<TIdx>(1u)));
+            Vec blocksPerGrid(Vec::all(static_cast<TIdx>(1u)));
+            Vec chunkCountsExtent(Vec::all(static_cast<TIdx>(1u)));
+
+            if(n < static_cast<TIdx>(blockSize))
+            {
+                // the small problem is counted by a single thread
+                auto chunkCounts = alpaka::allocBuf<TIdx, TIdx>(devAcc, chunkCountsExtent);
+                WorkDiv const singleThreadWorkDiv{blocksPerGrid, threadsPerBlock, elementsPerThread};
+                detail::ChunkHeadCountKernel<1u, TEqualOperator> kernel;
+                alpaka::exec<TAcc>(
+                    queue,
+                    singleThreadWorkDiv,
+                    kernel,
+                    source,
+                    alpaka::getPtrNative(chunkCounts),
+                    n,
+                    equal);
+                auto countView = alpaka::allocBuf<TIdx, TIdx>(devHost, chunkCountsExtent);
+                alpaka::memcpy(queue, countView, chunkCounts, chunkCountsExtent);
+                alpaka::wait(queue);
+                return alpaka::getPtrNative(countView)[0];
+            }
+
+            TIdx gridSize = WorkDivPolicy::template getGridSize<TAcc>(devAcc);
+            TIdx const maxGridSize = n / static_cast<TIdx>(blockSize);
+            if(gridSize > maxGridSize)
+            {
+                gridSize = maxGridSize;
+            }
+            TIdx const numChunks = gridSize * static_cast<TIdx>(blockSize);
+            blocksPerGrid[xIndex] = gridSize;
+            threadsPerBlock[xIndex] = static_cast<TIdx>(blockSize);
+            chunkCountsExtent[xIndex] = numChunks;
+            auto chunkCounts = alpaka::allocBuf<TIdx, TIdx>(devAcc, chunkCountsExtent);
+
+            WorkDiv const multiBlockWorkDiv{blocksPerGrid, threadsPerBlock, elementsPerThread};
+            detail::ChunkHeadCountKernel<blockSize, TEqualOperator> kernel;
+            alpaka::exec<TAcc>(queue, multiBlockWorkDiv, kernel, source, alpaka::getPtrNative(chunkCounts), n, equal);
+            return vikunja::reduce::deviceReduce<TAcc, WorkDivPolicy>(
+                devAcc,
+                devHost,
+                queue,
+                numChunks,
+                alpaka::getPtrNative(chunkCounts),
+                vikunja::operators::Plus<TIdx>());
+        }
+
+        /**
+         * Unique count with begin and end iterator of the input.
+         * @see deviceUniqueCount
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TInputIterator,
+            typename TDevAcc,
+            typename TDevHost,
+            typename TQueue,
+            typename TEqual
+            = vikunja::reduce::detail::EqualTo<typename std::iterator_traits<TInputIterator>::value_type>>
+        auto deviceUniqueCount(
+            TDevAcc& devAcc,
+            TDevHost& devHost,
+            TQueue& queue,
+            TInputIterator const& sourceBegin,
+            TInputIterator const& sourceEnd,
+            TEqual const& equal = TEqual())
+        {
+            assert(sourceEnd >= sourceBegin);
+            auto size = static_cast<typename alpaka::trait::IdxType<TAcc>::type>(sourceEnd - sourceBegin);
+            return deviceUniqueCount<TAcc, WorkDivPolicy>(devAcc, devHost, queue, size, sourceBegin, equal);
+        }
+
+        /**
+         * Run length encoding: writes the first element and the length of each run of consecutive equal elements,
+         * i.e. if one has the array [1,1,2,2,2,1,3,3], the values will contain [1,2,1,3], the counts [2,3,1,2] and 4
+         * is returned. The lengths are computed by the reduce by key pipeline with an implicit value of one per
+         * element, therefore no transformed input is materialized.
+         * @see deviceUnique
+         * @param values The output iterator for the first element of each run.
+         * @param counts The output iterator for the length of each run. Its value type must be constructible from
+         * TIdx.
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TInputIterator,
+            typename TValueOutputIterator,
+            typename TCountOutputIterator,
+            typename TDevAcc,
+            typename TDevHost,
+            typename TQueue,
+            typename TIdx,
+            typename TData = typename std::iterator_traits<TInputIterator>::value_type,
+            typename TEqual = vikunja::reduce::detail::EqualTo<TData>,
+            typename TEqualOperator = vikunja::operators::BinaryOp<TAcc, TEqual, TData, TData>>
+        auto deviceRunLengthEncode(
+            TDevAcc& devAcc,
+            TDevHost& devHost,
+            TQueue& queue,
+            TIdx const& n,
+            TInputIterator const& source,
+            TValueOutputIterator const& values,
+            TCountOutputIterator const& counts,
+            TEqual const& equal = TEqual()) -> TIdx
+        {
+            using PlusOperator = vikunja::operators::BinaryOp<TAcc, vikunja::operators::Plus<TIdx>, TIdx, TIdx>;
+            return vikunja::reduce::detail::reduceByKeyImpl<TAcc, WorkDivPolicy, TIdx, PlusOperator, TEqualOperator>(
+                devAcc,
+                devHost,
+                queue,
+                n,
+                source,
+                vikunja::mem::iterator::ConstantIterator<TIdx>{1},
+                values,
+                counts,
+                vikunja::operators::Plus<TIdx>(),
+                equal);
+        }
+
+        /**
+         * Run length encoding with begin and end iterator of the input.
+         * @see deviceRunLengthEncode
+         */
+        template<
+            typename TAcc,
+            typename WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<TAcc>,
+            typename TInputIterator,
+            typename TValueOutputIterator,
+            typename TCountOutputIterator,
+            typename TDevAcc,
+            typename TDevHost,
+            typename TQueue,
+            typename TEqual
+            = vikunja::reduce::detail::EqualTo<typename std::iterator_traits<TInputIterator>::value_type>>
+        auto deviceRunLengthEncode(
+            TDevAcc& devAcc,
+            TDevHost& devHost,
+            TQueue& queue,
+            TInputIterator const& sourceBegin,
+            TInputIterator const& sourceEnd,
+            TValueOutputIterator const& values,
+            TCountOutputIterator const& counts,
+            TEqual const& equal = TEqual())
+        {
+            assert(sourceEnd >= sourceBegin);
+            auto size = static_cast<typename alpaka::trait::IdxType<TAcc>::type>(sourceEnd - sourceBegin);
+            return deviceRunLengthEncode<TAcc, WorkDivPolicy>(
+                devAcc,
+                devHost,
+                queue,
+                size,
+                sourceBegin,
+                values,
+                counts,
+                equal);
+        }
+    } // namespace unique
+} // namespace vikunja
@@ -9,10 +9,18 @@
 
 #pragma once
 
+#include <vikunja/threadpool/ThreadPool.hpp>
+
 #include <alpaka/alpaka.hpp>
 
 #include <algorithm>
 #include <thread>
+#include <type_traits>
+
+#ifdef ALPAKA_ACC_CPU_B_TBB_T_SEQ_ENABLED
+#    include <tbb/task_arena.h>
+#endif
+
 namespace vikunja
 {
     namespace workdiv
@@ -72,6 +80,51 @@ namespace vikunja
                     return 1;
                 }
             };
+            /**
+             * Execution tier for accelerators with host memory. The algorithms do not launch an alpaka kernel, but
+             * execute one linear chunk of the input per thread of the persistent vikunja::threadpool::ThreadPool.
+             * This avoids spawning and joining threads for each call. The functors must not take the acc argument.
+             * It is never selected by default and needs to be passed explicitly as WorkDivPolicy.
+             */
+            struct HostThreadPoolPolicy
+            {
+                template<typename TAcc, typename TIdx = alpaka::Idx<TAcc>>
+                static constexpr TIdx getBlockSize() noexcept
+                {
+                    return 1;
+                }
+
+                template<typename TAcc, typename TDevAcc, typename TIdx = alpaka::Idx<TAcc>>
+                static TIdx getGridSize(TDevAcc const& devAcc __attribute__((unused)))
+                {
+                    return static_cast<TIdx>(vikunja::threadpool::ThreadPool::instance().size());
+                }
+            };
+#ifdef ALPAKA_ACC_CPU_B_TBB_T_SEQ_ENABLED
+            /**
+             * For TBB. The TBB accelerator parallelizes on the grid-block-level and executes each block as a task.
+             */
+            struct BlockBasedTbbPolicy
+            {
+                //! Number of blocks per worker thread of the TBB arena. More blocks than workers allow the TBB
+                //! scheduler to balance the load via work stealing.
+                static constexpr int blocksPerWorker = 4;
+
+                template<typename TAcc, typename TIdx = alpaka::Idx<TAcc>>
+                static constexpr TIdx getBlockSize() noexcept
+                {
+                    return 1;
+                }
+
+                template<typename TAcc, typename TDevAcc, typename TIdx = alpaka::Idx<TAcc>>
+                static TIdx getGridSize(TDevAcc const& devAcc __attribute__((unused)))
+                {
+                    // the concurrency is queried every time, because the arena can be changed by the user
+                    int const concurrency = tbb::this_task_arena::max_concurrency();
+                    return std::max(static_cast<TIdx>(1), static_cast<TIdx>(concurrency * blocksPerWorker));
+                }
+            };
+#endif
             /**
              * For CUDA.
              */
@@ -128,6 +181,13 @@ namespace vikunja
                 using type = policies::BlockBasedBlockThreadPolicy;
             };
 #endif
+#ifdef ALPAKA_ACC_CPU_B_TBB_T_SEQ_ENABLED
+            template<typename... TArgs>
+            struct GetBlockBasedPolicy<alpaka::AccCpuTbbBlocks<TArgs...>>
+            {
+                using type = policies::BlockBasedTbbPolicy;
+            };
+#endif
 #ifdef ALPAKA_ACC_GPU_CUDA_ENABLED
             template<typename... TArgs>
             struct GetBlockBasedPolicy
@@ -158,5 +218,12 @@ namespace vikunja
 
         template<typename TAcc>
         using BlockBasedPolicy = typename traits::GetBlockBasedPolicy<TAcc>::type;
+
+        /**
+         * True, if the algorithms are executed by the host thread pool instead of an alpaka kernel.
+         */
+        template<typename TWorkDivPolicy>
+        inline constexpr bool isHostThreadPoolPolicy
+            = std::is_same_v<TWorkDivPolicy, policies::HostThreadPoolPolicy>;
     } // namespace workdiv
 } // namespace vikunja
@@ -19,19 +19,19 @@
 
 #include <catch2/catch.hpp>
 
-template<typename TData, typename TIdx>
+template<typename TData, typename TIdx, template<typename, typename> class TAcc = alpaka::ExampleDefaultAcc>
 inline void reduce_benchmark(TIdx size)
 {
     using Setup = vikunja::test::TestAlpakaSetup<
         alpaka::DimInt<1u>, // dim
         TIdx, // Idx
         alpaka::AccCpuSerial, // host type
-        alpaka::ExampleDefaultAcc, // device type
+        TAcc, // device type
         alpaka::Blocking // queue type
         >;
     using Vec = alpaka::Vec<typename Setup::Dim, typename Setup::Idx>;
 
-    INFO((vikunja::test::print_acc_info<typename Setup::Dim>(size)));
+    INFO((vikunja::test::print_acc_info<typename Setup::Dim, TAcc>(size)));
 
     Setup setup;
     Vec extent = Vec::all(static_cast<typename Setup::Idx>(size));
@@ -99,3 +99,22 @@ TEMPLATE_TEST_CASE("bechmark reduce", "[benchmark][reduce][vikunja]", int, float
         reduce_benchmark<Data, Idx>(GENERATE(100, 100'000, 1'270'000, 2'000'000));
     }
 }
+
+#ifdef ALPAKA_ACC_CPU_B_TBB_T_SEQ_ENABLED
+// float is not tested, because the precision errors of the float sum depend on the number of blocks, which depends on
+// the concurrency of the TBB arena
+TEMPLATE_TEST_CASE("bechmark reduce TBB", "[benchmark][reduce][vikunja][tbb]", int, double)
+{
+    using Data = TestType;
+    using Idx = std::uint64_t;
+
+    if constexpr(std::is_same_v<Data, int>)
+    {
+        reduce_benchmark<Data, Idx, alpaka::AccCpuTbbBlocks>(GENERATE(100, 100'000, 1'270'000, 1'600'000));
+    }
+    else if constexpr(std::is_same_v<Data, double>)
+    {
+        reduce_benchmark<Data, Idx, alpaka::AccCpuTbbBlocks>(GENERATE(100, 100'000, 1'270'000, 2'000'000));
+    }
+}
+#endif
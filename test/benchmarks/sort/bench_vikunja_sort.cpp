@@ -0,0 +1,133 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <vikunja/sort/mergeSort.hpp>
+#include <vikunja/sort/radixSort.hpp>
+#include <vikunja/test/AlpakaSetup.hpp>
+#include <vikunja/test/utility.hpp>
+
+#include <alpaka/alpaka.hpp>
+#include <alpaka/example/ExampleDefaultAcc.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+template<typename TData, typename TIdx, template<typename, typename> class TAcc = alpaka::ExampleDefaultAcc>
+inline void sort_benchmark(TIdx size)
+{
+    using Setup = vikunja::test::TestAlpakaSetup<
+        alpaka::DimInt<1u>, // dim
+        TIdx, // Idx
+        alpaka::AccCpuSerial, // host type
+        TAcc, // device type
+        alpaka::Blocking // queue type
+        >;
+    using Vec = alpaka::Vec<typename Setup::Dim, typename Setup::Idx>;
+
+    INFO((vikunja::test::print_acc_info<typename Setup::Dim, TAcc>(size)));
+
+    Setup setup;
+    Vec extent = Vec::all(static_cast<typename Setup::Idx>(size));
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> distribution(-1'000'000.0, 1'000'000.0);
+    std::vector<TData> input(static_cast<std::size_t>(size));
+    std::generate(input.begin(), input.end(), [&] { return static_cast<TData>(distribution(generator)); });
+
+    auto hostMemInput = alpaka::allocBuf<TData, typename Setup::Idx>(setup.devHost, extent);
+    std::copy(input.begin(), input.end(), alpaka::getPtrNative(hostMemInput));
+
+    // the unsorted keys are kept on the device, because each benchmark run sorts in place
+    auto devMemInput = alpaka::allocBuf<TData, typename Setup::Idx>(setup.devAcc, extent);
+    alpaka::memcpy(setup.queueAcc, devMemInput, hostMemInput, extent);
+
+    auto devMemKeys = alpaka::allocBuf<TData, typename Setup::Idx>(setup.devAcc, extent);
+    TData* devMemKeysPtrBegin = alpaka::getPtrNative(devMemKeys);
+    TData* devMemKeysPtrEnd = devMemKeysPtrBegin + size;
+
+    auto hostMemOutput = alpaka::allocBuf<TData, typename Setup::Idx>(setup.devHost, extent);
+    TData* hostMemOutputPtrBegin = alpaka::getPtrNative(hostMemOutput);
+
+    alpaka::memcpy(setup.queueAcc, devMemKeys, devMemInput, extent);
+    vikunja::sort::deviceRadixSort<typename Setup::Acc>(
+        setup.devAcc,
+        setup.queueAcc,
+        devMemKeysPtrBegin,
+        devMemKeysPtrEnd);
+    alpaka::memcpy(setup.queueAcc, hostMemOutput, devMemKeys, extent);
+    alpaka::wait(setup.queueAcc);
+
+    std::vector<TData> expected = input;
+    std::sort(expected.begin(), expected.end());
+    for(auto i = static_cast<typename Setup::Idx>(0); i < size; ++i)
+    {
+        REQUIRE(expected[i] == hostMemOutputPtrBegin[i]);
+    }
+
+    // both benchmarks include the copy of the unsorted input
+    BENCHMARK("radix sort vikunja")
+    {
+        alpaka::memcpy(setup.queueAcc, devMemKeys, devMemInput, extent);
+        vikunja::sort::deviceRadixSort<typename Setup::Acc>(
+            setup.devAcc,
+            setup.queueAcc,
+            devMemKeysPtrBegin,
+            devMemKeysPtrEnd);
+        return devMemKeysPtrBegin;
+    };
+
+    auto less = [] ALPAKA_FN_HOST_ACC(TData const a, TData const b) -> bool { return a < b; };
+
+    BENCHMARK("merge sort vikunja")
+    {
+        alpaka::memcpy(setup.queueAcc, devMemKeys, devMemInput, extent);
+        vikunja::sort::deviceSort<typename Setup::Acc>(
+            setup.devAcc,
+            setup.queueAcc,
+            devMemKeysPtrBegin,
+            devMemKeysPtrEnd,
+            less);
+        return devMemKeysPtrBegin;
+    };
+
+    std::vector<TData> keys(input.size());
+    BENCHMARK("std::sort")
+    {
+        std::copy(input.begin(), input.end(), keys.begin());
+        std::sort(keys.begin(), keys.end());
+        return keys.data();
+    };
+
+    alpaka::memcpy(setup.queueAcc, hostMemOutput, devMemKeys, extent);
+    alpaka::wait(setup.queueAcc);
+
+    REQUIRE(expected[0] == hostMemOutputPtrBegin[0]);
+    REQUIRE(keys == expected);
+}
+
+TEMPLATE_TEST_CASE("bechmark sort", "[benchmark][sort][vikunja]", int, float, double)
+{
+    using Data = TestType;
+    using Idx = std::uint64_t;
+
+    sort_benchmark<Data, Idx>(GENERATE(100, 100'000, 1'270'000, 2'000'000));
+}
+
+#ifdef ALPAKA_ACC_CPU_B_TBB_T_SEQ_ENABLED
+TEMPLATE_TEST_CASE("bechmark sort TBB", "[benchmark][sort][vikunja][tbb]", int, float, double)
+{
+    using Data = TestType;
+    using Idx = std::uint64_t;
+
+    sort_benchmark<Data, Idx, alpaka::AccCpuTbbBlocks>(GENERATE(100, 100'000, 1'270'000, 2'000'000));
+}
+#endif
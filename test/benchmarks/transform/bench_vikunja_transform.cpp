@@ -17,19 +17,19 @@
 
 #include <catch2/catch.hpp>
 
-template<typename TData, typename TIdx>
+template<typename TData, typename TIdx, template<typename, typename> class TAcc = alpaka::ExampleDefaultAcc>
 inline void transform_benchmark(TIdx size)
 {
     using Setup = vikunja::test::TestAlpakaSetup<
         alpaka::DimInt<1u>, // dim
         TIdx, // Idx
         alpaka::AccCpuSerial, // host type
-        alpaka::ExampleDefaultAcc, // device type
+        TAcc, // device type
         alpaka::Blocking // queue type
         >;
     using Vec = alpaka::Vec<typename Setup::Dim, typename Setup::Idx>;
 
-    INFO((vikunja::test::print_acc_info<typename Setup::Dim>(size)));
+    INFO((vikunja::test::print_acc_info<typename Setup::Dim, TAcc>(size)));
 
     Setup setup;
     Vec extent = Vec::all(static_cast<typename Setup::Idx>(size));
@@ -94,3 +94,13 @@ TEMPLATE_TEST_CASE("bechmark transform", "[benchmark][transform][vikunja]", int,
 
     transform_benchmark<Data, Idx>(GENERATE(100, 100'000, 1'270'000, 2'000'000));
 }
+
+#ifdef ALPAKA_ACC_CPU_B_TBB_T_SEQ_ENABLED
+TEMPLATE_TEST_CASE("bechmark transform TBB", "[benchmark][transform][vikunja][tbb]", int, float, double)
+{
+    using Data = TestType;
+    using Idx = std::uint64_t;
+
+    transform_benchmark<Data, Idx, alpaka::AccCpuTbbBlocks>(GENERATE(100, 100'000, 1'270'000, 2'000'000));
+}
+#endif
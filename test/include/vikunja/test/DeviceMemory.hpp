@@ -0,0 +1,67 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#pragma once
+
+#include <alpaka/alpaka.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace vikunja
+{
+    namespace test
+    {
+        /**
+         * @brief Copy a vector to new 1D memory on the device. At least one element is allocated, so that an empty
+         * vector results in a valid pointer.
+         *
+         * @tparam TSetup The vikunja::test::TestAlpakaSetup.
+         * @param setup The setup, whose accelerator queue is used.
+         * @param data The data to copy.
+         * @return auto Alpaka memory buffer on the device.
+         */
+        template<typename TSetup, typename TData>
+        auto toDevice(TSetup& setup, std::vector<TData> const& data)
+        {
+            using Idx = typename TSetup::Idx;
+            Idx const size = std::max(static_cast<Idx>(data.size()), static_cast<Idx>(1u));
+            auto hostMem = setup.template allocHost<TData>(size);
+            auto devMem = setup.template allocDev<TData>(size);
+            std::copy(data.begin(), data.end(), alpaka::getPtrNative(hostMem));
+            alpaka::memcpy(setup.queueAcc, devMem, hostMem, alpaka::Vec<alpaka::DimInt<1u>, Idx>::all(size));
+            alpaka::wait(setup.queueAcc);
+            return devMem;
+        }
+
+        /**
+         * @brief Copy the first elements of 1D device memory to a vector.
+         *
+         * @tparam TData Type of the elements.
+         * @tparam TSetup The vikunja::test::TestAlpakaSetup.
+         * @param setup The setup, whose accelerator queue is used.
+         * @param devMem Alpaka memory buffer on the device.
+         * @param size Number of elements to copy.
+         * @return std::vector<TData> The copied elements.
+         */
+        template<typename TData, typename TSetup, typename TBuf>
+        std::vector<TData> toHost(TSetup& setup, TBuf const& devMem, typename TSetup::Idx const size)
+        {
+            auto hostMem = setup.template allocHost<TData>(size);
+            alpaka::memcpy(
+                setup.queueAcc,
+                hostMem,
+                devMem,
+                alpaka::Vec<alpaka::DimInt<1u>, typename TSetup::Idx>::all(size));
+            alpaka::wait(setup.queueAcc);
+            TData const* const ptr = alpaka::getPtrNative(hostMem);
+            return std::vector<TData>(ptr, ptr + size);
+        }
+    } // namespace test
+} // namespace vikunja
@@ -27,12 +27,12 @@ namespace vikunja
 {
     namespace test
     {
-        template<typename TDim>
+        template<typename TDim, template<typename, typename> class TAcc = alpaka::ExampleDefaultAcc>
         inline std::string print_acc_info(std::size_t const size)
         {
             std::stringstream strs;
 
-            using Acc = alpaka::ExampleDefaultAcc<TDim, std::uint64_t>;
+            using Acc = TAcc<TDim, std::uint64_t>;
             strs << "Testing accelerator: " << alpaka::getAccName<Acc>() << " with size: " << size << "\n";
 
             using MemAccess = vikunja::MemAccess::MemAccessPolicy<Acc>;
@@ -0,0 +1,188 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <vikunja/autotune/autotune.hpp>
+#include <vikunja/test/AlpakaSetup.hpp>
+#include <vikunja/test/utility.hpp>
+
+#include <alpaka/alpaka.hpp>
+#include <alpaka/example/ExampleDefaultAcc.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <numeric>
+#include <string>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    std::size_t countLines(std::string const& path)
+    {
+        std::ifstream file(path);
+        std::size_t lines = 0;
+        std::string line;
+        while(std::getline(file, line))
+        {
+            ++lines;
+        }
+        return lines;
+    }
+} // namespace
+
+TEST_CASE("TuningCache", "[autotune]")
+{
+    std::string const path = "test_autotune_cache_file.cache";
+    std::remove(path.c_str());
+
+    auto& cache = vikunja::autotune::TuningCache::instance();
+    cache.setPath(path);
+
+    REQUIRE_FALSE(cache.get("key1").has_value());
+    cache.set("key1", "candidate1");
+    cache.set("key2", "candidate2");
+    REQUIRE(cache.get("key1").value() == "candidate1");
+
+    // entries needs to be restored from the file
+    cache.reload();
+    REQUIRE(cache.get("key1").value() == "candidate1");
+    REQUIRE(cache.get("key2").value() == "candidate2");
+
+    // the last entry of a key wins
+    cache.set("key1", "candidate3");
+    cache.reload();
+    REQUIRE(cache.get("key1").value() == "candidate3");
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Test autotuned reduce", "[autotune][reduce]")
+{
+    using Dim = alpaka::DimInt<1u>;
+    using Idx = std::uint64_t;
+    using Data = std::uint64_t;
+    using Setup = vikunja::test::
+        TestAlpakaSetup<Dim, Idx, alpaka::AccCpuSerial, alpaka::ExampleDefaultAcc, alpaka::Blocking>;
+
+    auto size = GENERATE(1, 777, 1 << 12);
+
+    INFO((vikunja::test::print_acc_info<Dim>(size)));
+
+    std::string const path = "test_autotune_reduce.cache";
+    std::remove(path.c_str());
+    vikunja::autotune::TuningCache::instance().setPath(path);
+
+    Setup setup;
+    auto hostMem = setup.allocHost<Data>(static_cast<Idx>(size));
+    auto devMem = setup.allocDev<Data>(static_cast<Idx>(size));
+    Data* const hostMemPtr = alpaka::getPtrNative(hostMem);
+    std::iota(hostMemPtr, hostMemPtr + size, 1);
+    alpaka::memcpy(setup.queueAcc, devMem, hostMem, alpaka::Vec<Dim, Idx>::all(static_cast<Idx>(size)));
+
+    auto sum = [] ALPAKA_FN_HOST_ACC(Data const i, Data const j) { return i + j; };
+    Data const n = static_cast<Data>(size);
+    Data const expectedResult = (n * (n + 1) / 2);
+
+    // first call tunes and stores the result
+    REQUIRE(
+        vikunja::autotune::deviceReduce<typename Setup::Acc>(
+            setup.devAcc,
+            setup.devHost,
+            setup.queueAcc,
+            static_cast<Idx>(size),
+            alpaka::getPtrNative(devMem),
+            sum)
+        == expectedResult);
+    REQUIRE(countLines(path) == 1);
+
+    // second call, also after reloading the cache file, reuses the result
+    vikunja::autotune::TuningCache::instance().reload();
+    Data* const begin = alpaka::getPtrNative(devMem);
+    REQUIRE(
+        vikunja::autotune::deviceReduce<typename Setup::Acc>(
+            setup.devAcc,
+            setup.devHost,
+            setup.queueAcc,
+            begin,
+            begin + size,
+            sum)
+        == expectedResult);
+    REQUIRE(countLines(path) == 1);
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Test autotuned transform", "[autotune][transform]")
+{
+    using Dim = alpaka::DimInt<1u>;
+    using Idx = std::uint64_t;
+    using Data = std::uint64_t;
+    using Setup = vikunja::test::
+        TestAlpakaSetup<Dim, Idx, alpaka::AccCpuSerial, alpaka::ExampleDefaultAcc, alpaka::Blocking>;
+
+    auto size = GENERATE(1, 777, 1 << 12);
+
+    INFO((vikunja::test::print_acc_info<Dim>(size)));
+
+    std::string const path = "test_autotune_transform.cache";
+    std::remove(path.c_str());
+    vikunja::autotune::TuningCache::instance().setPath(path);
+
+    Setup setup;
+    auto extent = alpaka::Vec<Dim, Idx>::all(static_cast<Idx>(size));
+    auto hostMem = setup.allocHost<Data>(static_cast<Idx>(size));
+    auto devInputMem = setup.allocDev<Data>(static_cast<Idx>(size));
+    auto devOutputMem = setup.allocDev<Data>(static_cast<Idx>(size));
+    Data* const hostMemPtr = alpaka::getPtrNative(hostMem);
+    std::iota(hostMemPtr, hostMemPtr + size, 0);
+    alpaka::memcpy(setup.queueAcc, devInputMem, hostMem, extent);
+
+    auto incOne = [] ALPAKA_FN_HOST_ACC(Data const i) { return i + 1; };
+
+    SECTION("out of place")
+    {
+        vikunja::autotune::deviceTransform<typename Setup::Acc>(
+            setup.devAcc,
+            setup.queueAcc,
+            static_cast<Idx>(size),
+            alpaka::getPtrNative(devInputMem),
+            alpaka::getPtrNative(devOutputMem),
+            incOne);
+        REQUIRE(countLines(path) == 1);
+
+        alpaka::memcpy(setup.queueAcc, hostMem, devOutputMem, extent);
+        alpaka::wait(setup.queueAcc);
+        for(Idx i = 0; i < static_cast<Idx>(size); ++i)
+        {
+            REQUIRE(hostMemPtr[i] == i + 1);
+        }
+    }
+
+    SECTION("in place")
+    {
+        // the transform must be executed exactly one time, therefore no tuning is possible
+        vikunja::autotune::deviceTransform<typename Setup::Acc>(
+            setup.devAcc,
+            setup.queueAcc,
+            static_cast<Idx>(size),
+            alpaka::getPtrNative(devInputMem),
+            alpaka::getPtrNative(devInputMem),
+            incOne);
+        REQUIRE(countLines(path) == 0);
+
+        alpaka::memcpy(setup.queueAcc, hostMem, devInputMem, extent);
+        alpaka::wait(setup.queueAcc);
+        for(Idx i = 0; i < static_cast<Idx>(size); ++i)
+        {
+            REQUIRE(hostMemPtr[i] == i + 1);
+        }
+    }
+
+    std::remove(path.c_str());
+}
@@ -0,0 +1,233 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <vikunja/blas1/blas1.hpp>
+#include <vikunja/test/AlpakaSetup.hpp>
+#include <vikunja/test/DeviceMemory.hpp>
+#include <vikunja/test/utility.hpp>
+
+#include <alpaka/alpaka.hpp>
+#include <alpaka/example/ExampleDefaultAcc.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    using Dim = alpaka::DimInt<1u>;
+    using Idx = std::uint64_t;
+    using Data = double;
+    using Setup = vikunja::test::
+        TestAlpakaSetup<Dim, Idx, alpaka::AccCpuSerial, alpaka::ExampleDefaultAcc, alpaka::Blocking>;
+    using Acc = typename Setup::Acc;
+
+    //! Compares two vectors element wise with a relative tolerance.
+    void requireApprox(std::vector<Data> const& result, std::vector<Data> const& expected)
+    {
+        REQUIRE(result.size() == expected.size());
+        for(std::size_t i = 0; i < result.size(); ++i)
+        {
+            INFO("index: " << i);
+            REQUIRE(result[i] == Approx(expected[i]));
+        }
+    }
+} // namespace
+
+TEST_CASE("Test blas1", "[blas1]")
+{
+    auto size = GENERATE(1, 777, 100'000);
+
+    INFO((vikunja::test::print_acc_info<Dim>(size)));
+
+    Setup setup;
+    Idx const n = static_cast<Idx>(size);
+    std::mt19937 generator(static_cast<std::mt19937::result_type>(size));
+    std::uniform_real_distribution<Data> distribution(-1., 1.);
+    std::vector<Data> x(static_cast<std::size_t>(size));
+    std::vector<Data> y(static_cast<std::size_t>(size));
+    std::vector<Data> z(static_cast<std::size_t>(size));
+    std::generate(x.begin(), x.end(), [&] { return distribution(generator); });
+    std::generate(y.begin(), y.end(), [&] { return distribution(generator); });
+    std::generate(z.begin(), z.end(), [&] { return distribution(generator); });
+    auto devX = vikunja::test::toDevice(setup, x);
+    auto devY = vikunja::test::toDevice(setup, y);
+    auto devZ = vikunja::test::toDevice(setup, z);
+    Data const alpha = 1.5;
+    Data const beta = -0.25;
+
+    SECTION("scal")
+    {
+        vikunja::blas1::deviceScal<Acc>(setup.devAcc, setup.queueAcc, n, alpha, alpaka::getPtrNative(devX));
+        std::vector<Data> expected(x);
+        std::transform(x.begin(), x.end(), expected.begin(), [&](Data v) { return alpha * v; });
+        requireApprox(vikunja::test::toHost<Data>(setup, devX, n), expected);
+    }
+
+    SECTION("axpy")
+    {
+        vikunja::blas1::deviceAxpy<Acc>(
+            setup.devAcc,
+            setup.queueAcc,
+            n,
+            alpha,
+            alpaka::getPtrNative(devX),
+            alpaka::getPtrNative(devY));
+        std::vector<Data> expected(y);
+        for(std::size_t i = 0; i < expected.size(); ++i)
+        {
+            expected[i] = alpha * x[i] + y[i];
+        }
+        requireApprox(vikunja::test::toHost<Data>(setup, devY, n), expected);
+    }
+
+    SECTION("axpby")
+    {
+        vikunja::blas1::deviceAxpby<Acc>(
+            setup.devAcc,
+            setup.queueAcc,
+            n,
+            alpha,
+            alpaka::getPtrNative(devX),
+            beta,
+            alpaka::getPtrNative(devY));
+        std::vector<Data> expected(y);
+        for(std::size_t i = 0; i < expected.size(); ++i)
+        {
+            expected[i] = alpha * x[i] + beta * y[i];
+        }
+        requireApprox(vikunja::test::toHost<Data>(setup, devY, n), expected);
+    }
+
+    SECTION("dot")
+    {
+        Data const result = vikunja::blas1::deviceDot<Acc>(
+            setup.devAcc,
+            setup.devHost,
+            setup.queueAcc,
+            n,
+            alpaka::getPtrNative(devX),
+            alpaka::getPtrNative(devY));
+        Data expected = 0.;
+        for(std::size_t i = 0; i < x.size(); ++i)
+        {
+            expected += x[i] * y[i];
+        }
+        REQUIRE(result == Approx(expected).margin(1e-9));
+    }
+
+    SECTION("axpy and dot")
+    {
+        Data const result = vikunja::blas1::deviceAxpyDot<Acc>(
+            setup.devAcc,
+            setup.devHost,
+            setup.queueAcc,
+            n,
+            alpha,
+            alpaka::getPtrNative(devX),
+            alpaka::getPtrNative(devY),
+            alpaka::getPtrNative(devZ));
+        std::vector<Data> expected(y);
+        Data expectedDot = 0.;
+        for(std::size_t i = 0; i < expected.size(); ++i)
+        {
+            expected[i] = alpha * x[i] + y[i];
+            expectedDot += expected[i] * z[i];
+        }
+        requireApprox(vikunja::test::toHost<Data>(setup, devY, n), expected);
+        REQUIRE(result == Approx(expectedDot).margin(1e-9));
+    }
+
+    SECTION("axpy and squared norm")
+    {
+        Data const result = vikunja::blas1::deviceAxpyDot<Acc>(
+            setup.devAcc,
+            setup.devHost,
+            setup.queueAcc,
+            n,
+            alpha,
+            alpaka::getPtrNative(devX),
+            alpaka::getPtrNative(devY),
+            alpaka::getPtrNative(devY));
+        Data expectedDot = 0.;
+        for(std::size_t i = 0; i < y.size(); ++i)
+        {
+            Data const value = alpha * x[i] + y[i];
+            expectedDot += value * value;
+        }
+        REQUIRE(result == Approx(expectedDot));
+    }
+
+    SECTION("asum")
+    {
+        Data const result = vikunja::blas1::deviceAsum<Acc>(
+            setup.devAcc,
+            setup.devHost,
+            setup.queueAcc,
+            n,
+            alpaka::getPtrNative(devX));
+        Data expected = 0.;
+        for(Data const v : x)
+        {
+            expected += std::abs(v);
+        }
+        REQUIRE(result == Approx(expected));
+    }
+
+    SECTION("nrm2")
+    {
+        Data const result = vikunja::blas1::deviceNrm2<Acc>(
+            setup.devAcc,
+            setup.devHost,
+            setup.queueAcc,
+            n,
+            alpaka::getPtrNative(devX));
+        Data expected = 0.;
+        for(Data const v : x)
+        {
+            expected += v * v;
+        }
+        REQUIRE(result == Approx(std::sqrt(expected)));
+    }
+}
+
+TEST_CASE("Test blas1 nrm2 without overflow and underflow", "[blas1]")
+{
+    auto size = GENERATE(1, 777, 100'000);
+    // the squares of these values overflow or underflow
+    auto scale = GENERATE(1e200, 1e-200);
+
+    INFO((vikunja::test::print_acc_info<Dim>(size)));
+    INFO("scale: " << scale);
+
+    Setup setup;
+    Idx const n = static_cast<Idx>(size);
+    std::mt19937 generator(static_cast<std::mt19937::result_type>(size));
+    std::uniform_real_distribution<Data> distribution(-1., 1.);
+    std::vector<Data> x(static_cast<std::size_t>(size));
+    std::generate(x.begin(), x.end(), [&] { return distribution(generator); });
+    // zeros must not disturb the scaling
+    x[0] = 0.;
+    Data expected = 0.;
+    for(Data const v : x)
+    {
+        expected += v * v;
+    }
+    expected = std::sqrt(expected) * scale;
+    std::transform(x.begin(), x.end(), x.begin(), [&](Data v) { return v * scale; });
+
+    auto devX = vikunja::test::toDevice(setup, x);
+    Data const result
+        = vikunja::blas1::deviceNrm2<Acc>(setup.devAcc, setup.devHost, setup.queueAcc, n, alpaka::getPtrNative(devX));
+    REQUIRE(result == Approx(expected));
+}
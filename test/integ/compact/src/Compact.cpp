@@ -0,0 +1,101 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <vikunja/compact/compact.hpp>
+#include <vikunja/test/AlpakaSetup.hpp>
+#include <vikunja/test/utility.hpp>
+
+#include <alpaka/alpaka.hpp>
+#include <alpaka/example/ExampleDefaultAcc.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+TEST_CASE("Test copy if and where", "[compact]")
+{
+    using Dim = alpaka::DimInt<1u>;
+    using Idx = std::uint64_t;
+    using Data = std::int32_t;
+    using Setup = vikunja::test::
+        TestAlpakaSetup<Dim, Idx, alpaka::AccCpuSerial, alpaka::ExampleDefaultAcc, alpaka::Blocking>;
+
+    auto size = GENERATE(1, 2, 10, 777, 1 << 16, (1 << 16) + 3);
+    // select every element, no element or a small fraction
+    auto modulo = GENERATE(1, 7, 1 << 20);
+
+    INFO((vikunja::test::print_acc_info<Dim>(size)));
+    INFO("modulo: " << modulo);
+
+    Setup setup;
+    auto const extent = alpaka::Vec<Dim, Idx>::all(static_cast<Idx>(size));
+    auto hostInput = setup.allocHost<Data>(static_cast<Idx>(size));
+    auto hostOutput = setup.allocHost<Data>(static_cast<Idx>(size));
+    auto hostIndices = setup.allocHost<Idx>(static_cast<Idx>(size));
+    auto devInput = setup.allocDev<Data>(static_cast<Idx>(size));
+    auto devOutput = setup.allocDev<Data>(static_cast<Idx>(size));
+    auto devIndices = setup.allocDev<Idx>(static_cast<Idx>(size));
+
+    Data* const input = alpaka::getPtrNative(hostInput);
+    std::iota(input, input + size, -size / 2);
+    alpaka::memcpy(setup.queueAcc, devInput, hostInput, extent);
+
+    auto predicate = [modulo] ALPAKA_FN_HOST_ACC(Data const i) { return (i + (1 << 20)) % modulo == 0; };
+
+    std::vector<Data> expected;
+    std::vector<Idx> expectedIndices;
+    for(Idx i = 0; i < static_cast<Idx>(size); ++i)
+    {
+        if(predicate(input[i]))
+        {
+            expected.push_back(input[i]);
+            expectedIndices.push_back(i);
+        }
+    }
+
+    SECTION("copy if")
+    {
+        Idx const count = vikunja::compact::deviceCopyIf<typename Setup::Acc>(
+            setup.devAcc,
+            setup.devHost,
+            setup.queueAcc,
+            static_cast<Idx>(size),
+            alpaka::getPtrNative(devInput),
+            alpaka::getPtrNative(devOutput),
+            predicate);
+        REQUIRE(count == expected.size());
+
+        alpaka::memcpy(setup.queueAcc, hostOutput, devOutput, extent);
+        alpaka::wait(setup.queueAcc);
+        Data const* const output = alpaka::getPtrNative(hostOutput);
+        REQUIRE(std::vector<Data>(output, output + count) == expected);
+    }
+
+    SECTION("where")
+    {
+        Data* const begin = alpaka::getPtrNative(devInput);
+        Idx const count = vikunja::compact::deviceWhere<typename Setup::Acc>(
+            setup.devAcc,
+            setup.devHost,
+            setup.queueAcc,
+            begin,
+            begin + size,
+            alpaka::getPtrNative(devIndices),
+            predicate);
+        REQUIRE(count == expectedIndices.size());
+
+        alpaka::memcpy(setup.queueAcc, hostIndices, devIndices, extent);
+        alpaka::wait(setup.queueAcc);
+        Idx const* const indices = alpaka::getPtrNative(hostIndices);
+        REQUIRE(std::vector<Idx>(indices, indices + count) == expectedIndices);
+    }
+}
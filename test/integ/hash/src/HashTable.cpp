@@ -0,0 +1,174 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <vikunja/hash/hashTable.hpp>
+#include <vikunja/operators/functors.hpp>
+#include <vikunja/test/AlpakaSetup.hpp>
+#include <vikunja/test/DeviceMemory.hpp>
+#include <vikunja/test/utility.hpp>
+
+#include <alpaka/alpaka.hpp>
+#include <alpaka/example/ExampleDefaultAcc.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    using Dim = alpaka::DimInt<1u>;
+    using Idx = std::uint64_t;
+    using Key = std::int64_t;
+    using Value = std::int32_t;
+    using Setup = vikunja::test::
+        TestAlpakaSetup<Dim, Idx, alpaka::AccCpuSerial, alpaka::ExampleDefaultAcc, alpaka::Blocking>;
+    using Acc = typename Setup::Acc;
+} // namespace
+
+TEST_CASE("Test hash table", "[hash]")
+{
+    auto size = GENERATE(1, 777, 100'000);
+    // many duplicates or mostly distinct keys
+    auto maxKey = GENERATE(100, 1'000'000);
+
+    INFO((vikunja::test::print_acc_info<Dim>(size)));
+    INFO("max key: " << maxKey);
+
+    Setup setup;
+    std::mt19937 generator(static_cast<std::mt19937::result_type>(size));
+    std::uniform_int_distribution<Key> keyDistribution(0, maxKey);
+    std::uniform_int_distribution<Value> valueDistribution(-1000, 1000);
+    std::vector<Key> keys(static_cast<std::size_t>(size));
+    std::vector<Value> values(static_cast<std::size_t>(size));
+    std::generate(keys.begin(), keys.end(), [&] { return keyDistribution(generator); });
+    std::generate(values.begin(), values.end(), [&] { return valueDistribution(generator); });
+
+    // load factor of at most 0.5
+    Idx const capacity = 2 * static_cast<Idx>(size) + 1;
+    auto devTableKeys = setup.allocDev<Key>(capacity);
+    auto devTableValues = setup.allocDev<Value>(capacity);
+    vikunja::hash::HashTable<Key, Value, Idx> const table{
+        alpaka::getPtrNative(devTableKeys),
+        alpaka::getPtrNative(devTableValues),
+        capacity,
+        Key{-1}};
+
+    auto devKeys = vikunja::test::toDevice(setup, keys);
+    auto devValues = vikunja::test::toDevice(setup, values);
+
+    // the queries contain all keys and keys, which are not in the table
+    std::vector<Key> queries = keys;
+    queries.push_back(maxKey + 1);
+    queries.push_back(maxKey + 12345);
+    Idx const numQueries = static_cast<Idx>(queries.size());
+    auto devQueries = vikunja::test::toDevice(setup, queries);
+    auto devFound = setup.allocDev<Value>(numQueries);
+    Value const notFound = 1 << 30;
+
+    SECTION("insert and find")
+    {
+        vikunja::hash::deviceHashTableClear<Acc>(setup.devAcc, setup.queueAcc, table);
+        vikunja::hash::deviceHashInsert<Acc>(
+            setup.devAcc,
+            setup.queueAcc,
+            table,
+            static_cast<Idx>(size),
+            alpaka::getPtrNative(devKeys),
+            alpaka::getPtrNative(devValues));
+        vikunja::hash::deviceHashFind<Acc>(
+            setup.devAcc,
+            setup.queueAcc,
+            table,
+            numQueries,
+            alpaka::getPtrNative(devQueries),
+            alpaka::getPtrNative(devFound),
+            notFound);
+        std::vector<Value> found = vikunja::test::toHost<Value>(setup, devFound, numQueries);
+
+        // one of the values of each key is inserted
+        std::multimap<Key, Value> pairs;
+        for(std::size_t i = 0; i < keys.size(); ++i)
+        {
+            pairs.emplace(keys[i], values[i]);
+        }
+        bool allFound = true;
+        for(std::size_t i = 0; i < keys.size(); ++i)
+        {
+            auto const range = pairs.equal_range(queries[i]);
+            allFound = allFound
+                && std::any_of(range.first, range.second, [&](auto const& pair) { return pair.second == found[i]; });
+        }
+        REQUIRE(allFound);
+        REQUIRE(found[keys.size()] == notFound);
+        REQUIRE(found[keys.size() + 1] == notFound);
+    }
+
+    SECTION("insert or reduce")
+    {
+        std::map<Key, Value> sums;
+        std::map<Key, Value> maxima;
+        for(std::size_t i = 0; i < keys.size(); ++i)
+        {
+            sums[keys[i]] += values[i];
+            auto const it = maxima.find(keys[i]);
+            maxima[keys[i]] = (it == maxima.end()) ? values[i] : std::max(it->second, values[i]);
+        }
+        std::vector<Value> expectedSums;
+        std::vector<Value> expectedMaxima;
+        for(Key const key : keys)
+        {
+            expectedSums.push_back(sums[key]);
+            expectedMaxima.push_back(maxima[key]);
+        }
+
+        // the sum uses the atomic add
+        vikunja::hash::deviceHashTableClear<Acc>(setup.devAcc, setup.queueAcc, table, Value{0});
+        vikunja::hash::deviceHashInsertOrReduce<Acc>(
+            setup.devAcc,
+            setup.queueAcc,
+            table,
+            static_cast<Idx>(size),
+            alpaka::getPtrNative(devKeys),
+            alpaka::getPtrNative(devValues),
+            vikunja::operators::Plus<Value>());
+        vikunja::hash::deviceHashFind<Acc>(
+            setup.devAcc,
+            setup.queueAcc,
+            table,
+            static_cast<Idx>(size),
+            alpaka::getPtrNative(devQueries),
+            alpaka::getPtrNative(devFound),
+            notFound);
+        REQUIRE(vikunja::test::toHost<Value>(setup, devFound, static_cast<Idx>(size)) == expectedSums);
+
+        // the maximum uses the compare and swap loop
+        vikunja::hash::deviceHashTableClear<Acc>(setup.devAcc, setup.queueAcc, table, Value{-(1 << 30)});
+        vikunja::hash::deviceHashInsertOrReduce<Acc>(
+            setup.devAcc,
+            setup.queueAcc,
+            table,
+            static_cast<Idx>(size),
+            alpaka::getPtrNative(devKeys),
+            alpaka::getPtrNative(devValues),
+            [] ALPAKA_FN_HOST_ACC(Value const a, Value const b) { return (a < b) ? b : a; });
+        vikunja::hash::deviceHashFind<Acc>(
+            setup.devAcc,
+            setup.queueAcc,
+            table,
+            static_cast<Idx>(size),
+            alpaka::getPtrNative(devQueries),
+            alpaka::getPtrNative(devFound),
+            notFound);
+        REQUIRE(vikunja::test::toHost<Value>(setup, devFound, static_cast<Idx>(size)) == expectedMaxima);
+    }
+}
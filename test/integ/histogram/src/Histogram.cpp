@@ -0,0 +1,184 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <vikunja/histogram/histogram.hpp>
+#include <vikunja/test/AlpakaSetup.hpp>
+#include <vikunja/test/DeviceMemory.hpp>
+#include <vikunja/test/utility.hpp>
+
+#include <alpaka/alpaka.hpp>
+#include <alpaka/example/ExampleDefaultAcc.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    using Dim = alpaka::DimInt<1u>;
+    using Idx = std::uint64_t;
+    using Count = std::uint32_t;
+    using Setup = vikunja::test::
+        TestAlpakaSetup<Dim, Idx, alpaka::AccCpuSerial, alpaka::ExampleDefaultAcc, alpaka::Blocking>;
+    using Acc = typename Setup::Acc;
+
+    //! Counts the samples in the bins of the sorted levels on the host.
+    template<typename TSample, typename TLevel>
+    std::vector<Count> referenceHistogram(std::vector<TSample> const& samples, std::vector<TLevel> const& levels)
+    {
+        std::vector<Count> histogram(levels.size() - 1, 0);
+        for(TSample const sample : samples)
+        {
+            TLevel const value = static_cast<TLevel>(sample);
+            if(value >= levels.front() && value < levels.back())
+            {
+                auto const bin = std::upper_bound(levels.begin(), levels.end(), value) - levels.begin() - 1;
+                ++histogram[static_cast<std::size_t>(bin)];
+            }
+        }
+        return histogram;
+    }
+} // namespace
+
+TEST_CASE("Test histogram even", "[histogram]")
+{
+    auto size = GENERATE(1, 777, 100'000);
+    // privatized bins and bins in the global memory
+    auto numBins = GENERATE(Idx{1}, Idx{7}, Idx{256}, Idx{5000});
+
+    INFO((vikunja::test::print_acc_info<Dim>(size)));
+    INFO("bins: " << numBins);
+
+    Setup setup;
+    std::mt19937 generator(static_cast<std::mt19937::result_type>(size));
+
+    SECTION("integral samples")
+    {
+        using Sample = std::int32_t;
+        Sample const lower = -1000;
+        Sample const upper = 9000;
+        // some samples are out of range
+        std::uniform_int_distribution<Sample> distribution(-1100, 9100);
+        std::vector<Sample> samples(static_cast<std::size_t>(size));
+        std::generate(samples.begin(), samples.end(), [&] { return distribution(generator); });
+
+        auto devSamples = vikunja::test::toDevice(setup, samples);
+        auto devHistogram = setup.allocDev<Count>(numBins);
+        vikunja::histogram::deviceHistogramEven<Acc>(
+            setup.devAcc,
+            setup.queueAcc,
+            static_cast<Idx>(size),
+            alpaka::getPtrNative(devSamples),
+            alpaka::getPtrNative(devHistogram),
+            numBins,
+            lower,
+            upper);
+
+        // the integer bin of the implementation
+        std::vector<Count> expected(numBins, 0);
+        for(Sample const sample : samples)
+        {
+            if(sample >= lower && sample < upper)
+            {
+                auto const bin = static_cast<std::int64_t>(sample - lower) * static_cast<std::int64_t>(numBins)
+                    / static_cast<std::int64_t>(upper - lower);
+                ++expected[static_cast<std::size_t>(bin)];
+            }
+        }
+        REQUIRE(vikunja::test::toHost<Count>(setup, devHistogram, numBins) == expected);
+    }
+
+    SECTION("floating point samples")
+    {
+        using Sample = float;
+        std::normal_distribution<Sample> distribution(0.f, 2.f);
+        std::vector<Sample> samples(static_cast<std::size_t>(size));
+        std::generate(samples.begin(), samples.end(), [&] { return distribution(generator); });
+
+        auto devSamples = vikunja::test::toDevice(setup, samples);
+        auto devHistogram = setup.allocDev<Count>(numBins);
+        vikunja::histogram::deviceHistogramEven<Acc>(
+            setup.devAcc,
+            setup.queueAcc,
+            static_cast<Idx>(size),
+            alpaka::getPtrNative(devSamples),
+            alpaka::getPtrNative(devHistogram),
+            numBins,
+            -4.f,
+            4.f);
+
+        std::vector<Count> result = vikunja::test::toHost<Count>(setup, devHistogram, numBins);
+        // samples close to a bin boundary can be counted in both neighbours because of rounding, therefore only
+        // the total count and the counts of the clearly inside samples are checked
+        Count expectedTotal = 0;
+        std::vector<Count> minimum(numBins, 0);
+        float const width = 8.f / static_cast<float>(numBins);
+        for(Sample const sample : samples)
+        {
+            if(sample >= -4.f && sample < 4.f)
+            {
+                ++expectedTotal;
+                float const position = (sample + 4.f) / width;
+                auto const bin = static_cast<std::size_t>(position);
+                if(position - static_cast<float>(bin) > 0.01f && position - static_cast<float>(bin) < 0.99f)
+                {
+                    ++minimum[bin];
+                }
+            }
+        }
+        Count total = 0;
+        for(Idx b = 0; b < numBins; ++b)
+        {
+            total += result[b];
+            REQUIRE(result[b] >= minimum[b]);
+        }
+        REQUIRE(total == expectedTotal);
+    }
+}
+
+TEST_CASE("Test histogram range", "[histogram]")
+{
+    auto size = GENERATE(1, 777, 100'000);
+    auto numBins = GENERATE(Idx{1}, Idx{7}, Idx{256}, Idx{5000});
+
+    INFO((vikunja::test::print_acc_info<Dim>(size)));
+    INFO("bins: " << numBins);
+
+    Setup setup;
+    std::mt19937 generator(static_cast<std::mt19937::result_type>(size));
+    using Sample = std::int32_t;
+    using Level = std::int32_t;
+
+    // bins of increasing width
+    std::vector<Level> levels(static_cast<std::size_t>(numBins + 1));
+    for(std::size_t i = 0; i < levels.size(); ++i)
+    {
+        levels[i] = static_cast<Level>(i * i) - 50;
+    }
+    std::uniform_int_distribution<Sample> distribution(-100, levels.back() + 100);
+    std::vector<Sample> samples(static_cast<std::size_t>(size));
+    std::generate(samples.begin(), samples.end(), [&] { return distribution(generator); });
+
+    auto devSamples = vikunja::test::toDevice(setup, samples);
+    auto devLevels = vikunja::test::toDevice(setup, levels);
+    auto devHistogram = setup.allocDev<Count>(numBins);
+    vikunja::histogram::deviceHistogramRange<Acc>(
+        setup.devAcc,
+        setup.queueAcc,
+        static_cast<Idx>(size),
+        alpaka::getPtrNative(devSamples),
+        alpaka::getPtrNative(devHistogram),
+        numBins,
+        alpaka::getPtrNative(devLevels));
+
+    REQUIRE(vikunja::test::toHost<Count>(setup, devHistogram, numBins) == referenceHistogram(samples, levels));
+}
@@ -0,0 +1,148 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <vikunja/join/join.hpp>
+#include <vikunja/test/AlpakaSetup.hpp>
+#include <vikunja/test/DeviceMemory.hpp>
+#include <vikunja/test/utility.hpp>
+
+#include <alpaka/alpaka.hpp>
+#include <alpaka/example/ExampleDefaultAcc.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    using Dim = alpaka::DimInt<1u>;
+    using Idx = std::uint64_t;
+    using Data = std::int32_t;
+    using Setup = vikunja::test::
+        TestAlpakaSetup<Dim, Idx, alpaka::AccCpuSerial, alpaka::ExampleDefaultAcc, alpaka::Blocking>;
+    using Acc = typename Setup::Acc;
+
+    std::vector<Data> sortedRandomData(std::size_t const size, Data const max, unsigned const seed)
+    {
+        std::mt19937 generator(seed);
+        std::uniform_int_distribution<Data> distribution(0, max);
+        std::vector<Data> data(size);
+        std::generate(data.begin(), data.end(), [&] { return distribution(generator); });
+        std::sort(data.begin(), data.end());
+        return data;
+    }
+} // namespace
+
+TEST_CASE("Test sort-merge join", "[join]")
+{
+    auto leftSize = GENERATE(1, 100, 50'000);
+    auto rightSize = GENERATE(1, 777, 50'000);
+    // many matches per key or few matches
+    auto maxKey = GENERATE(30, 200'000);
+
+    INFO((vikunja::test::print_acc_info<Dim>(leftSize)));
+    INFO("right size: " << rightSize << " max key: " << maxKey);
+
+    Setup setup;
+    std::vector<Data> left = sortedRandomData(static_cast<std::size_t>(leftSize), maxKey, 1u);
+    std::vector<Data> right = sortedRandomData(static_cast<std::size_t>(rightSize), maxKey, 2u);
+
+    std::vector<Idx> expectedLeft;
+    std::vector<Idx> expectedRight;
+    std::vector<bool> expectedMatch;
+    for(std::size_t i = 0; i < left.size(); ++i)
+    {
+        auto const range = std::equal_range(right.begin(), right.end(), left[i]);
+        for(auto it = range.first; it != range.second; ++it)
+        {
+            expectedLeft.push_back(static_cast<Idx>(i));
+            expectedRight.push_back(static_cast<Idx>(it - right.begin()));
+        }
+        expectedMatch.push_back(range.first != range.second);
+    }
+    Idx const expectedPairs = static_cast<Idx>(expectedLeft.size());
+
+    auto devLeft = vikunja::test::toDevice(setup, left);
+    auto devRight = vikunja::test::toDevice(setup, right);
+    Data* const leftPtr = alpaka::getPtrNative(devLeft);
+    Data* const rightPtr = alpaka::getPtrNative(devRight);
+
+    SECTION("inner join")
+    {
+        Idx const numPairs = vikunja::join::deviceInnerJoinSize<Acc>(
+            setup.devAcc,
+            setup.devHost,
+            setup.queueAcc,
+            leftPtr,
+            static_cast<Idx>(leftSize),
+            rightPtr,
+            static_cast<Idx>(rightSize));
+        REQUIRE(numPairs == expectedPairs);
+
+        // allocate at least one element
+        Idx const outputSize = std::max(numPairs, Idx{1});
+        auto devLeftIndices = setup.allocDev<Idx>(outputSize);
+        auto devRightIndices = setup.allocDev<Idx>(outputSize);
+        Idx const writtenPairs = vikunja::join::deviceInnerJoin<Acc>(
+            setup.devAcc,
+            setup.devHost,
+            setup.queueAcc,
+            leftPtr,
+            static_cast<Idx>(leftSize),
+            rightPtr,
+            static_cast<Idx>(rightSize),
+            alpaka::getPtrNative(devLeftIndices),
+            alpaka::getPtrNative(devRightIndices));
+        REQUIRE(writtenPairs == expectedPairs);
+        std::vector<Idx> leftIndices = vikunja::test::toHost<Idx>(setup, devLeftIndices, outputSize);
+        std::vector<Idx> rightIndices = vikunja::test::toHost<Idx>(setup, devRightIndices, outputSize);
+        leftIndices.resize(numPairs);
+        rightIndices.resize(numPairs);
+        REQUIRE(leftIndices == expectedLeft);
+        REQUIRE(rightIndices == expectedRight);
+    }
+
+    SECTION("semi join and anti join")
+    {
+        auto devFlags = setup.allocDev<std::uint8_t>(static_cast<Idx>(leftSize));
+        vikunja::join::deviceSemiJoin<Acc>(
+            setup.devAcc,
+            setup.queueAcc,
+            leftPtr,
+            static_cast<Idx>(leftSize),
+            rightPtr,
+            static_cast<Idx>(rightSize),
+            alpaka::getPtrNative(devFlags));
+        std::vector<bool> flags;
+        for(std::uint8_t const flag : vikunja::test::toHost<std::uint8_t>(setup, devFlags, static_cast<Idx>(leftSize)))
+        {
+            flags.push_back(flag != 0);
+        }
+        REQUIRE(flags == expectedMatch);
+
+        vikunja::join::deviceAntiJoin<Acc>(
+            setup.devAcc,
+            setup.queueAcc,
+            leftPtr,
+            static_cast<Idx>(leftSize),
+            rightPtr,
+            static_cast<Idx>(rightSize),
+            alpaka::getPtrNative(devFlags));
+        flags.clear();
+        for(std::uint8_t const flag : vikunja::test::toHost<std::uint8_t>(setup, devFlags, static_cast<Idx>(leftSize)))
+        {
+            flags.push_back(flag == 0);
+        }
+        REQUIRE(flags == expectedMatch);
+    }
+}
@@ -0,0 +1,167 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <vikunja/merge/merge.hpp>
+#include <vikunja/test/AlpakaSetup.hpp>
+#include <vikunja/test/DeviceMemory.hpp>
+#include <vikunja/test/utility.hpp>
+
+#include <alpaka/alpaka.hpp>
+#include <alpaka/example/ExampleDefaultAcc.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    using Dim = alpaka::DimInt<1u>;
+    using Idx = std::uint64_t;
+    using Setup = vikunja::test::
+        TestAlpakaSetup<Dim, Idx, alpaka::AccCpuSerial, alpaka::ExampleDefaultAcc, alpaka::Blocking>;
+
+    struct Less
+    {
+        ALPAKA_FN_HOST_ACC bool operator()(std::int32_t const a, std::int32_t const b) const
+        {
+            return a < b;
+        }
+    };
+
+    //! Ascending order, which takes the accelerator.
+    struct AccLess
+    {
+        template<typename TAcc>
+        ALPAKA_FN_HOST_ACC bool operator()(TAcc const&, std::int32_t const a, std::int32_t const b) const
+        {
+            return a < b;
+        }
+    };
+
+    //! Returns sorted random keys between min and max.
+    std::vector<std::int32_t> sortedKeys(std::size_t const size, std::int32_t const min, std::int32_t const max)
+    {
+        std::mt19937 generator(static_cast<std::mt19937::result_type>(size + static_cast<std::size_t>(max)));
+        std::uniform_int_distribution<std::int32_t> distribution(min, max);
+        std::vector<std::int32_t> keys(size);
+        std::generate(keys.begin(), keys.end(), [&] { return distribution(generator); });
+        std::sort(keys.begin(), keys.end());
+        return keys;
+    }
+} // namespace
+
+TEST_CASE("Test merge", "[merge]")
+{
+    // sizes of the inputs and range of the keys of b, the keys of a are between 0 and 1000
+    using Case = std::tuple<std::size_t, std::size_t, std::int32_t, std::int32_t>;
+    auto testCase = GENERATE(
+        Case{0, 0, 0, 1000},
+        Case{0, 10, 0, 1000},
+        Case{10, 0, 0, 1000},
+        Case{1, 1, 0, 1000},
+        Case{777, 5, 0, 1000},
+        Case{5, 777, 0, 1000},
+        Case{100'000, 100'001, 0, 1000},
+        // all elements of b are behind all elements of a
+        Case{50'000, 70'000, 2000, 3000},
+        // all elements of b are in front of all elements of a
+        Case{70'000, 50'000, -3000, -2000});
+    auto const [na, nb, bMin, bMax] = testCase;
+
+    INFO((vikunja::test::print_acc_info<Dim>(na + nb)));
+
+    Setup setup;
+    std::vector<std::int32_t> const a = sortedKeys(na, 0, 1000);
+    std::vector<std::int32_t> const b = sortedKeys(nb, bMin, bMax);
+    auto devA = vikunja::test::toDevice(setup, a);
+    auto devB = vikunja::test::toDevice(setup, b);
+    auto devOut = vikunja::test::toDevice(setup, std::vector<std::int32_t>(na + nb));
+
+    vikunja::merge::deviceMerge<typename Setup::Acc>(
+        setup.devAcc,
+        setup.queueAcc,
+        alpaka::getPtrNative(devA),
+        static_cast<Idx>(na),
+        alpaka::getPtrNative(devB),
+        static_cast<Idx>(nb),
+        alpaka::getPtrNative(devOut),
+        Less{});
+
+    std::vector<std::int32_t> expected(na + nb);
+    std::merge(a.begin(), a.end(), b.begin(), b.end(), expected.begin());
+    REQUIRE(vikunja::test::toHost<std::int32_t>(setup, devOut, static_cast<Idx>(na + nb)) == expected);
+}
+
+TEST_CASE("Test merge by key", "[merge]")
+{
+    using Pair = std::pair<std::int32_t, std::uint32_t>;
+
+    auto sizes = GENERATE(std::make_pair(1, 1), std::make_pair(777, 5), std::make_pair(100'000, 30'000));
+    std::size_t const na = static_cast<std::size_t>(sizes.first);
+    std::size_t const nb = static_cast<std::size_t>(sizes.second);
+
+    INFO((vikunja::test::print_acc_info<Dim>(na + nb)));
+
+    Setup setup;
+    // many equal keys check, that the elements of a are written first
+    std::vector<std::int32_t> const aKeys = sortedKeys(na, 0, 50);
+    std::vector<std::int32_t> const bKeys = sortedKeys(nb, 0, 50);
+    std::vector<std::uint32_t> aValues(na);
+    std::vector<std::uint32_t> bValues(nb);
+    std::vector<Pair> expected;
+    for(std::size_t i = 0; i < na; ++i)
+    {
+        aValues[i] = static_cast<std::uint32_t>(i);
+        expected.emplace_back(aKeys[i], aValues[i]);
+    }
+    for(std::size_t i = 0; i < nb; ++i)
+    {
+        bValues[i] = static_cast<std::uint32_t>(na + i);
+        expected.emplace_back(bKeys[i], bValues[i]);
+    }
+    std::stable_sort(
+        expected.begin(),
+        expected.end(),
+        [](Pair const& x, Pair const& y) { return x.first < y.first; });
+
+    auto devAKeys = vikunja::test::toDevice(setup, aKeys);
+    auto devAValues = vikunja::test::toDevice(setup, aValues);
+    auto devBKeys = vikunja::test::toDevice(setup, bKeys);
+    auto devBValues = vikunja::test::toDevice(setup, bValues);
+    auto devKeysOut = vikunja::test::toDevice(setup, std::vector<std::int32_t>(na + nb));
+    auto devValuesOut = vikunja::test::toDevice(setup, std::vector<std::uint32_t>(na + nb));
+
+    vikunja::merge::deviceMergeByKey<typename Setup::Acc>(
+        setup.devAcc,
+        setup.queueAcc,
+        alpaka::getPtrNative(devAKeys),
+        alpaka::getPtrNative(devAValues),
+        static_cast<Idx>(na),
+        alpaka::getPtrNative(devBKeys),
+        alpaka::getPtrNative(devBValues),
+        static_cast<Idx>(nb),
+        alpaka::getPtrNative(devKeysOut),
+        alpaka::getPtrNative(devValuesOut),
+        AccLess{});
+
+    std::vector<std::int32_t> const keysOut
+        = vikunja::test::toHost<std::int32_t>(setup, devKeysOut, static_cast<Idx>(na + nb));
+    std::vector<std::uint32_t> const valuesOut
+        = vikunja::test::toHost<std::uint32_t>(setup, devValuesOut, static_cast<Idx>(na + nb));
+    for(std::size_t i = 0; i < na + nb; ++i)
+    {
+        REQUIRE(keysOut[i] == expected[i].first);
+        REQUIRE(valuesOut[i] == expected[i].second);
+    }
+}
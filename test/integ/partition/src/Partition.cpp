@@ -0,0 +1,139 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <vikunja/partition/partition.hpp>
+#include <vikunja/test/AlpakaSetup.hpp>
+#include <vikunja/test/utility.hpp>
+
+#include <alpaka/alpaka.hpp>
+#include <alpaka/example/ExampleDefaultAcc.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+TEST_CASE("Test partition and stable partition", "[partition]")
+{
+    using Dim = alpaka::DimInt<1u>;
+    using Idx = std::uint64_t;
+    using Data = std::int32_t;
+    using Setup = vikunja::test::
+        TestAlpakaSetup<Dim, Idx, alpaka::AccCpuSerial, alpaka::ExampleDefaultAcc, alpaka::Blocking>;
+
+    auto size = GENERATE(1, 2, 10, 777, 1 << 16, (1 << 16) + 3);
+    // select every element, a fraction of the elements or no element
+    auto modulo = GENERATE(1, 3, 1 << 20);
+
+    INFO((vikunja::test::print_acc_info<Dim>(size)));
+    INFO("modulo: " << modulo);
+
+    Setup setup;
+    auto const extent = alpaka::Vec<Dim, Idx>::all(static_cast<Idx>(size));
+    auto hostInput = setup.allocHost<Data>(static_cast<Idx>(size));
+    auto hostOutput = setup.allocHost<Data>(static_cast<Idx>(size));
+    auto devInput = setup.allocDev<Data>(static_cast<Idx>(size));
+    auto devOutput = setup.allocDev<Data>(static_cast<Idx>(size));
+
+    Data* const input = alpaka::getPtrNative(hostInput);
+    // shuffle the values, so that selected and rejected elements alternate
+    for(Data i = 0; i < size; ++i)
+    {
+        input[i] = static_cast<Data>((static_cast<std::int64_t>(i) * 7919) % size) - size / 2;
+    }
+    alpaka::memcpy(setup.queueAcc, devInput, hostInput, extent);
+
+    auto predicate = [modulo] ALPAKA_FN_HOST_ACC(Data const i) { return (i + (1 << 20)) % modulo == 0; };
+
+    std::vector<Data> expected(input, input + size);
+    Idx const expectedPoint = static_cast<Idx>(
+        std::stable_partition(expected.begin(), expected.end(), predicate) - expected.begin());
+
+    SECTION("stable partition")
+    {
+        Idx const point = vikunja::partition::deviceStablePartition<typename Setup::Acc>(
+            setup.devAcc,
+            setup.devHost,
+            setup.queueAcc,
+            static_cast<Idx>(size),
+            alpaka::getPtrNative(devInput),
+            alpaka::getPtrNative(devOutput),
+            predicate);
+        REQUIRE(point == expectedPoint);
+
+        alpaka::memcpy(setup.queueAcc, hostOutput, devOutput, extent);
+        alpaka::wait(setup.queueAcc);
+        Data const* const output = alpaka::getPtrNative(hostOutput);
+        REQUIRE(std::vector<Data>(output, output + size) == expected);
+    }
+
+    SECTION("stable partition in place")
+    {
+        Data* const begin = alpaka::getPtrNative(devInput);
+        Idx const point = vikunja::partition::deviceStablePartition<typename Setup::Acc>(
+            setup.devAcc,
+            setup.devHost,
+            setup.queueAcc,
+            static_cast<Idx>(size),
+            begin,
+            predicate);
+        REQUIRE(point == expectedPoint);
+
+        alpaka::memcpy(setup.queueAcc, hostOutput, devInput, extent);
+        alpaka::wait(setup.queueAcc);
+        Data const* const output = alpaka::getPtrNative(hostOutput);
+        REQUIRE(std::vector<Data>(output, output + size) == expected);
+    }
+
+    SECTION("partition")
+    {
+        Data* const begin = alpaka::getPtrNative(devInput);
+        Idx const point = vikunja::partition::devicePartition<typename Setup::Acc>(
+            setup.devAcc,
+            setup.devHost,
+            setup.queueAcc,
+            begin,
+            begin + size,
+            alpaka::getPtrNative(devOutput),
+            predicate);
+        REQUIRE(point == expectedPoint);
+
+        alpaka::memcpy(setup.queueAcc, hostOutput, devOutput, extent);
+        alpaka::wait(setup.queueAcc);
+        std::vector<Data> output(alpaka::getPtrNative(hostOutput), alpaka::getPtrNative(hostOutput) + size);
+        REQUIRE(std::all_of(output.begin(), output.begin() + point, predicate));
+        REQUIRE(std::none_of(output.begin() + point, output.end(), predicate));
+        std::sort(output.begin(), output.end());
+        std::sort(expected.begin(), expected.end());
+        REQUIRE(output == expected);
+    }
+
+    SECTION("partition in place")
+    {
+        Idx const point = vikunja::partition::devicePartition<typename Setup::Acc>(
+            setup.devAcc,
+            setup.devHost,
+            setup.queueAcc,
+            static_cast<Idx>(size),
+            alpaka::getPtrNative(devInput),
+            predicate);
+        REQUIRE(point == expectedPoint);
+
+        alpaka::memcpy(setup.queueAcc, hostOutput, devInput, extent);
+        alpaka::wait(setup.queueAcc);
+        std::vector<Data> output(alpaka::getPtrNative(hostOutput), alpaka::getPtrNative(hostOutput) + size);
+        REQUIRE(std::all_of(output.begin(), output.begin() + point, predicate));
+        REQUIRE(std::none_of(output.begin() + point, output.end(), predicate));
+        std::sort(output.begin(), output.end());
+        std::sort(expected.begin(), expected.end());
+        REQUIRE(output == expected);
+    }
+}
@@ -0,0 +1,270 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <vikunja/pipeline/pipeline.hpp>
+#include <vikunja/test/AlpakaSetup.hpp>
+#include <vikunja/test/DeviceMemory.hpp>
+#include <vikunja/test/utility.hpp>
+
+#include <alpaka/alpaka.hpp>
+#include <alpaka/example/ExampleDefaultAcc.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    using Dim = alpaka::DimInt<1u>;
+    using Idx = std::uint64_t;
+    using Setup = vikunja::test::
+        TestAlpakaSetup<Dim, Idx, alpaka::AccCpuSerial, alpaka::ExampleDefaultAcc, alpaka::Blocking>;
+    using Acc = typename Setup::Acc;
+
+    //! Returns the log-sum-exp of the data in long double.
+    long double logSumExp(std::vector<float> const& data)
+    {
+        long double const max = *std::max_element(data.begin(), data.end());
+        long double sum = 0;
+        for(float const v : data)
+        {
+            sum += std::exp(static_cast<long double>(v) - max);
+        }
+        return max + std::log(sum);
+    }
+} // namespace
+
+TEST_CASE("Test reduce then transform", "[pipeline]")
+{
+    // 16'384 floats are the largest input of the single launch
+    auto size = GENERATE(1, 777, 16'384, 16'385, 100'000);
+
+    INFO((vikunja::test::print_acc_info<Dim>(size)));
+
+    Setup setup;
+    Idx const n = static_cast<Idx>(size);
+    std::vector<std::int64_t> data(static_cast<std::size_t>(size));
+    for(std::size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = static_cast<std::int64_t>(i % 100) - 30;
+    }
+    auto devData = vikunja::test::toDevice(setup, data);
+    auto devOutput = setup.allocDev<double>(n);
+    auto devScalar = setup.allocDev<std::int64_t>(static_cast<Idx>(1u));
+
+    // subtract the sum of the squares from each element
+    auto square = [] ALPAKA_FN_HOST_ACC(std::int64_t const& x) -> std::int64_t { return x * x; };
+    auto sum = [] ALPAKA_FN_HOST_ACC(std::int64_t const& a, std::int64_t const& b) -> std::int64_t { return a + b; };
+    auto shift = [] ALPAKA_FN_HOST_ACC(std::int64_t const& x, std::int64_t const& squareSum) -> double
+    { return static_cast<double>(x - squareSum); };
+    vikunja::pipeline::deviceReduceThenTransform<Acc>(
+        setup.devAcc,
+        setup.queueAcc,
+        n,
+        alpaka::getPtrNative(devData),
+        alpaka::getPtrNative(devOutput),
+        square,
+        sum,
+        shift,
+        alpaka::getPtrNative(devScalar));
+
+    std::int64_t expected = 0;
+    for(std::int64_t const v : data)
+    {
+        expected += v * v;
+    }
+    REQUIRE(vikunja::test::toHost<std::int64_t>(setup, devScalar, 1u)[0] == expected);
+    std::vector<double> const output = vikunja::test::toHost<double>(setup, devOutput, n);
+    for(std::size_t i = 0; i < data.size(); ++i)
+    {
+        REQUIRE(output[i] == static_cast<double>(data[i] - expected));
+    }
+}
+
+TEST_CASE("Test normalize", "[pipeline]")
+{
+    auto size = GENERATE(1, 777, 100'000);
+
+    INFO((vikunja::test::print_acc_info<Dim>(size)));
+
+    Setup setup;
+    Idx const n = static_cast<Idx>(size);
+    std::mt19937 generator(static_cast<std::mt19937::result_type>(size));
+    std::uniform_real_distribution<double> distribution(-1., 1.);
+    // the squares of the elements overflow
+    std::vector<double> data(static_cast<std::size_t>(size));
+    std::generate(data.begin(), data.end(), [&] { return 1e200 * distribution(generator); });
+    auto devData = vikunja::test::toDevice(setup, data);
+
+    vikunja::pipeline::deviceNormalize<Acc>(
+        setup.devAcc,
+        setup.queueAcc,
+        n,
+        alpaka::getPtrNative(devData),
+        alpaka::getPtrNative(devData));
+
+    std::vector<double> const output = vikunja::test::toHost<double>(setup, devData, n);
+    long double squareSum = 0;
+    for(std::size_t i = 0; i < data.size(); ++i)
+    {
+        squareSum += static_cast<long double>(output[i]) * output[i];
+        REQUIRE(output[i] * data[0] / output[0] == Approx(data[i]));
+    }
+    REQUIRE(static_cast<double>(squareSum) == Approx(1.));
+}
+
+TEST_CASE("Test softmax", "[pipeline]")
+{
+    auto size = GENERATE(1, 777, 100'000);
+
+    INFO((vikunja::test::print_acc_info<Dim>(size)));
+
+    Setup setup;
+    Idx const n = static_cast<Idx>(size);
+    std::mt19937 generator(static_cast<std::mt19937::result_type>(size));
+    // exp(x) overflows in single precision for large x
+    std::uniform_real_distribution<float> distribution(50.f, 150.f);
+    std::vector<float> data(static_cast<std::size_t>(size));
+    std::generate(data.begin(), data.end(), [&] { return distribution(generator); });
+    auto devData = vikunja::test::toDevice(setup, data);
+    auto devOutput = setup.allocDev<float>(n);
+    long double const expectedLogSumExp = logSumExp(data);
+
+    SECTION("softmax")
+    {
+        vikunja::pipeline::deviceSoftmax<Acc>(
+            setup.devAcc,
+            setup.queueAcc,
+            n,
+            alpaka::getPtrNative(devData),
+            alpaka::getPtrNative(devOutput));
+
+        std::vector<float> const output = vikunja::test::toHost<float>(setup, devOutput, n);
+        long double sum = 0;
+        for(std::size_t i = 0; i < data.size(); ++i)
+        {
+            sum += output[i];
+            float const expected = static_cast<float>(std::exp(data[i] - expectedLogSumExp));
+            REQUIRE(output[i] == Approx(expected).epsilon(1e-3).margin(1e-30));
+        }
+        REQUIRE(static_cast<double>(sum) == Approx(1.).epsilon(1e-4));
+    }
+
+    SECTION("log softmax")
+    {
+        vikunja::pipeline::deviceLogSoftmax<Acc>(
+            setup.devAcc,
+            setup.queueAcc,
+            n,
+            alpaka::getPtrNative(devData),
+            alpaka::getPtrNative(devOutput));
+
+        std::vector<float> const output = vikunja::test::toHost<float>(setup, devOutput, n);
+        for(std::size_t i = 0; i < data.size(); ++i)
+        {
+            float const expected = static_cast<float>(data[i] - expectedLogSumExp);
+            REQUIRE(output[i] == Approx(expected).epsilon(1e-5).margin(1e-3));
+        }
+    }
+
+    SECTION("log-sum-exp")
+    {
+        float const result = vikunja::pipeline::deviceLogSumExp<Acc>(
+            setup.devAcc,
+            setup.devHost,
+            setup.queueAcc,
+            n,
+            alpaka::getPtrNative(devData));
+        REQUIRE(result == Approx(static_cast<float>(expectedLogSumExp)).epsilon(1e-5));
+    }
+}
+
+TEST_CASE("Test quantize", "[pipeline]")
+{
+    auto size = GENERATE(1, 777, 100'000);
+
+    INFO((vikunja::test::print_acc_info<Dim>(size)));
+
+    Setup setup;
+    Idx const n = static_cast<Idx>(size);
+    std::mt19937 generator(static_cast<std::mt19937::result_type>(size));
+    std::normal_distribution<float> distribution(0.f, 3.f);
+    std::vector<float> data(static_cast<std::size_t>(size));
+    std::generate(data.begin(), data.end(), [&] { return distribution(generator); });
+    auto devData = vikunja::test::toDevice(setup, data);
+    auto devOutput = setup.allocDev<std::int8_t>(n);
+    auto devMaxAbs = setup.allocDev<float>(static_cast<Idx>(1u));
+
+    vikunja::pipeline::deviceQuantize<Acc>(
+        setup.devAcc,
+        setup.queueAcc,
+        n,
+        alpaka::getPtrNative(devData),
+        alpaka::getPtrNative(devOutput),
+        alpaka::getPtrNative(devMaxAbs));
+
+    float maxAbs = 0.f;
+    for(float const v : data)
+    {
+        maxAbs = std::max(maxAbs, std::abs(v));
+    }
+    REQUIRE(vikunja::test::toHost<float>(setup, devMaxAbs, 1u)[0] == maxAbs);
+    std::vector<std::int8_t> const output = vikunja::test::toHost<std::int8_t>(setup, devOutput, n);
+    float const step = maxAbs / 127.f;
+    for(std::size_t i = 0; i < data.size(); ++i)
+    {
+        REQUIRE(std::abs(static_cast<float>(output[i]) * step - data[i]) <= 0.5001f * step);
+    }
+}
+
+TEST_CASE("Test quantize to int64", "[pipeline]")
+{
+    using Levels = std::int64_t;
+    // the maximum of int64_t is not representable in float and double
+    constexpr Levels floatLevels = vikunja::pipeline::detail::quantizeLevels<float, std::int64_t>();
+    constexpr Levels doubleLevels = vikunja::pipeline::detail::quantizeLevels<double, std::int64_t>();
+    constexpr Levels max = std::numeric_limits<Levels>::max();
+    // 2^63 - 2^39 and 2^63 - 2^10
+    STATIC_REQUIRE(floatLevels == max - ((Levels{1} << 39u) - 1));
+    STATIC_REQUIRE(doubleLevels == max - ((Levels{1} << 10u) - 1));
+    STATIC_REQUIRE(vikunja::pipeline::detail::quantizeLevels<float, std::int8_t>() == 127);
+
+    auto size = GENERATE(1, 777, 100'000);
+
+    INFO((vikunja::test::print_acc_info<Dim>(size)));
+
+    Setup setup;
+    Idx const n = static_cast<Idx>(size);
+    std::vector<float> data(static_cast<std::size_t>(size));
+    for(std::size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = (i % 2 == 0) ? -4.f : 2.f;
+    }
+    auto devData = vikunja::test::toDevice(setup, data);
+    auto devOutput = setup.allocDev<std::int64_t>(n);
+
+    vikunja::pipeline::deviceQuantize<Acc>(
+        setup.devAcc,
+        setup.queueAcc,
+        n,
+        alpaka::getPtrNative(devData),
+        alpaka::getPtrNative(devOutput));
+
+    // the extreme elements are quantized to the levels without overflow
+    std::vector<std::int64_t> const output = vikunja::test::toHost<std::int64_t>(setup, devOutput, n);
+    for(std::size_t i = 0; i < data.size(); ++i)
+    {
+        REQUIRE(output[i] == ((i % 2 == 0) ? -floatLevels : floatLevels / 2));
+    }
+}
@@ -16,9 +16,11 @@
 #include <alpaka/example/ExampleDefaultAcc.hpp>
 
 #include <algorithm>
+#include <functional>
 #include <limits>
 #include <numeric>
 #include <random>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -593,3 +595,103 @@ TEMPLATE_TEST_CASE(
     REQUIRE(setup.get_result().first == expectedResult.first);
     REQUIRE(setup.get_result().second == expectedResult.second);
 }
+
+TEMPLATE_TEST_CASE(
+    "Test reduce with associative operators",
+    "[reduce][associative][noAcc]",
+    (alpaka::DimInt<1u>),
+    (alpaka::DimInt<2u>),
+    (alpaka::DimInt<3u>) )
+{
+    using Dim = TestType;
+    using Data = std::uint64_t;
+
+    auto size = GENERATE(1, 10, 777, 1 << 10);
+
+    INFO((vikunja::test::print_acc_info<Dim>(size)));
+
+    vikunja::test::reduce::TestSetupReduce<Dim, alpaka::ExampleDefaultAcc, Data> setup(size);
+
+    // setup initial values
+    Data* const host_mem_ptr = setup.get_host_mem_ptr();
+    std::iota(host_mem_ptr, host_mem_ptr + size, 1);
+
+    Data const n = static_cast<Data>(size);
+    Data expectedResult = (n * (n + 1) / 2);
+
+    SECTION("std::plus")
+    {
+        setup.run(std::plus<Data>{});
+        REQUIRE(setup.get_result() == expectedResult);
+    }
+
+    SECTION("lambda marked as associative")
+    {
+        auto reduce = vikunja::operators::associative([] ALPAKA_FN_HOST_ACC(Data const i, Data const j)
+                                                      { return i + j; });
+        setup.run(reduce);
+        REQUIRE(setup.get_result() == expectedResult);
+    }
+}
+
+TEMPLATE_TEST_CASE(
+    "Test reduceTransform with associative operator",
+    "[reduceTransform][associative][noAcc]",
+    (alpaka::DimInt<1u>),
+    (alpaka::DimInt<2u>),
+    (alpaka::DimInt<3u>) )
+{
+    using Dim = TestType;
+    using Data = std::uint64_t;
+
+    auto size = GENERATE(1, 10, 777, 1 << 10);
+
+    INFO((vikunja::test::print_acc_info<Dim>(size)));
+
+    using ReturnType = MyPair<Data, Data>;
+
+    vikunja::test::reduce::TestSetupReduceTransformPtr<Dim, alpaka::ExampleDefaultAcc, Data, ReturnType> setup(size);
+
+    // setup initial values
+    Data* const host_mem_ptr = setup.get_host_mem_ptr();
+    std::iota(host_mem_ptr, host_mem_ptr + size, 1);
+
+    auto reduce = vikunja::operators::associative(
+        [] ALPAKA_FN_HOST_ACC(ReturnType const& x, ReturnType const& y)
+        { return ReturnType(x.first + y.first, (x.second < y.second) ? y.second : x.second); });
+    MakePairUnaryOp transform;
+
+    setup.run(reduce, transform);
+
+    Data const n = static_cast<Data>(size);
+    REQUIRE(setup.get_result().first == (n * (n + 1) / 2));
+    REQUIRE(setup.get_result().second == n);
+}
+
+TEST_CASE("Test OpenMP reduce is only used with the default policies", "[reduce][associative]")
+{
+    using Acc = alpaka::ExampleDefaultAcc<alpaka::DimInt<1u>, std::uint64_t>;
+    using Data = std::uint64_t;
+    using Transform = vikunja::reduce::detail::Identity<Data>;
+    using Reduce = std::plus<Data>;
+    using DefaultWorkDiv = vikunja::workdiv::BlockBasedPolicy<Acc>;
+    using DefaultMemAccess = vikunja::MemAccess::MemAccessPolicy<Acc>;
+    using OtherWorkDiv = std::conditional_t<
+        std::is_same_v<DefaultWorkDiv, vikunja::workdiv::policies::BlockBasedBlockThreadPolicy>,
+        vikunja::workdiv::policies::BlockBasedGridBlockPolicy,
+        vikunja::workdiv::policies::BlockBasedBlockThreadPolicy>;
+    using OtherMemAccess = std::conditional_t<
+        std::is_same_v<DefaultMemAccess, vikunja::MemAccess::policies::LinearMemAccessPolicy>,
+        vikunja::MemAccess::policies::GridStridingMemAccessPolicy,
+        vikunja::MemAccess::policies::LinearMemAccessPolicy>;
+
+    constexpr bool isOmpAcc = vikunja::affinity::traits::IsOmpAcc<Acc>::value;
+    STATIC_REQUIRE(
+        vikunja::reduce::detail::useOmpReduce<Acc, DefaultWorkDiv, DefaultMemAccess, Transform, Reduce, Data, Data>
+        == isOmpAcc);
+    // explicitly passed policies, e.g. the candidates of the autotuner, are executed by the kernels
+    STATIC_REQUIRE_FALSE(
+        vikunja::reduce::detail::useOmpReduce<Acc, OtherWorkDiv, DefaultMemAccess, Transform, Reduce, Data, Data>);
+    STATIC_REQUIRE_FALSE(
+        vikunja::reduce::detail::useOmpReduce<Acc, DefaultWorkDiv, OtherMemAccess, Transform, Reduce, Data, Data>);
+}
@@ -0,0 +1,221 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <vikunja/reduce/reduceByKey.hpp>
+#include <vikunja/test/AlpakaSetup.hpp>
+#include <vikunja/test/DeviceMemory.hpp>
+#include <vikunja/test/utility.hpp>
+
+#include <alpaka/alpaka.hpp>
+#include <alpaka/example/ExampleDefaultAcc.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    using Dim = alpaka::DimInt<1u>;
+    using Idx = std::uint64_t;
+    using Setup = vikunja::test::
+        TestAlpakaSetup<Dim, Idx, alpaka::AccCpuSerial, alpaka::ExampleDefaultAcc, alpaka::Blocking>;
+
+    //! Range of indices. The combination of two ranges is associative, but not commutative.
+    struct Range
+    {
+        std::uint64_t first;
+        std::uint64_t last;
+    };
+
+    struct CombineRange
+    {
+        ALPAKA_FN_HOST_ACC Range operator()(Range const& a, Range const& b) const
+        {
+            return Range{a.first, b.last};
+        }
+    };
+
+    //! Maximum, which takes the accelerator.
+    struct AccMax
+    {
+        template<typename TAcc>
+        ALPAKA_FN_HOST_ACC std::int64_t operator()(TAcc const& acc, std::int64_t const a, std::int64_t const b) const
+        {
+            return alpaka::math::max(acc, a, b);
+        }
+    };
+
+    /**
+     * Creates keys with segments of random length between 1 and maxLength. Neighboring segments have different
+     * keys, but a key can appear in several segments.
+     */
+    std::vector<std::int32_t> segmentedKeys(std::size_t const size, std::size_t const maxLength)
+    {
+        std::mt19937 generator(static_cast<std::mt19937::result_type>(size + maxLength));
+        std::uniform_int_distribution<std::size_t> lengthDistribution(1, maxLength);
+        std::vector<std::int32_t> keys;
+        std::int32_t key = 0;
+        while(keys.size() < size)
+        {
+            std::size_t const length = std::min(lengthDistribution(generator), size - keys.size());
+            keys.insert(keys.end(), length, key);
+            key = (key + 1) % 3;
+        }
+        return keys;
+    }
+} // namespace
+
+TEST_CASE("Test reduce by key with sum", "[reduce][reduceByKey]")
+{
+    auto size = GENERATE(1, 10, 777, 100'000);
+    std::size_t const maxLength = GENERATE(1, 5, 1000);
+
+    INFO((vikunja::test::print_acc_info<Dim>(size)));
+    INFO("maximum segment length: " << maxLength);
+
+    Setup setup;
+    std::vector<std::int32_t> const keys = segmentedKeys(static_cast<std::size_t>(size), maxLength);
+    std::vector<std::int64_t> values(keys.size());
+    for(std::size_t i = 0; i < values.size(); ++i)
+    {
+        values[i] = static_cast<std::int64_t>(i % 13) - 6;
+    }
+
+    std::vector<std::int32_t> expectedKeys;
+    std::vector<std::int64_t> expectedValues;
+    for(std::size_t i = 0; i < keys.size(); ++i)
+    {
+        if(i == 0 || keys[i] != keys[i - 1])
+        {
+            expectedKeys.push_back(keys[i]);
+            expectedValues.push_back(values[i]);
+        }
+        else
+        {
+            expectedValues.back() += values[i];
+        }
+    }
+
+    auto devKeys = vikunja::test::toDevice(setup, keys);
+    auto devValues = vikunja::test::toDevice(setup, values);
+    auto devKeysOut = setup.allocDev<std::int32_t>(static_cast<Idx>(size));
+    auto devValuesOut = setup.allocDev<std::int64_t>(static_cast<Idx>(size));
+
+    std::int32_t* const keysBegin = alpaka::getPtrNative(devKeys);
+    Idx const numSegments = vikunja::reduce::deviceReduceByKey<typename Setup::Acc>(
+        setup.devAcc,
+        setup.devHost,
+        setup.queueAcc,
+        keysBegin,
+        keysBegin + size,
+        alpaka::getPtrNative(devValues),
+        alpaka::getPtrNative(devKeysOut),
+        alpaka::getPtrNative(devValuesOut),
+        [] ALPAKA_FN_HOST_ACC(std::int64_t const a, std::int64_t const b) { return a + b; });
+
+    REQUIRE(numSegments == expectedKeys.size());
+    REQUIRE(vikunja::test::toHost<std::int32_t>(setup, devKeysOut, numSegments) == expectedKeys);
+    REQUIRE(vikunja::test::toHost<std::int64_t>(setup, devValuesOut, numSegments) == expectedValues);
+}
+
+TEST_CASE("Test reduce by key with non-commutative function", "[reduce][reduceByKey]")
+{
+    auto size = GENERATE(10, 777, 100'000);
+    std::size_t const maxLength = GENERATE(3, 1000);
+
+    INFO((vikunja::test::print_acc_info<Dim>(size)));
+    INFO("maximum segment length: " << maxLength);
+
+    Setup setup;
+    std::vector<std::int32_t> const keys = segmentedKeys(static_cast<std::size_t>(size), maxLength);
+    std::vector<Range> values(keys.size());
+    std::vector<std::uint64_t> expectedFirst;
+    for(std::size_t i = 0; i < values.size(); ++i)
+    {
+        values[i] = Range{i, i};
+        if(i == 0 || keys[i] != keys[i - 1])
+        {
+            expectedFirst.push_back(i);
+        }
+    }
+
+    auto devKeys = vikunja::test::toDevice(setup, keys);
+    auto devValues = vikunja::test::toDevice(setup, values);
+    auto devKeysOut = setup.allocDev<std::int32_t>(static_cast<Idx>(size));
+    auto devValuesOut = setup.allocDev<Range>(static_cast<Idx>(size));
+
+    Idx const numSegments = vikunja::reduce::deviceReduceByKey<typename Setup::Acc>(
+        setup.devAcc,
+        setup.devHost,
+        setup.queueAcc,
+        static_cast<Idx>(size),
+        alpaka::getPtrNative(devKeys),
+        alpaka::getPtrNative(devValues),
+        alpaka::getPtrNative(devKeysOut),
+        alpaka::getPtrNative(devValuesOut),
+        CombineRange{});
+
+    REQUIRE(numSegments == expectedFirst.size());
+    std::vector<Range> const result = vikunja::test::toHost<Range>(setup, devValuesOut, numSegments);
+    for(std::size_t s = 0; s < numSegments; ++s)
+    {
+        std::uint64_t const expectedLast = (s + 1 < numSegments) ? expectedFirst[s + 1] - 1 : keys.size() - 1;
+        REQUIRE(result[s].first == expectedFirst[s]);
+        REQUIRE(result[s].last == expectedLast);
+    }
+}
+
+TEST_CASE("Test reduce by key with function taking the accelerator", "[reduce][reduceByKey]")
+{
+    auto size = GENERATE(777, 100'000);
+
+    INFO((vikunja::test::print_acc_info<Dim>(size)));
+
+    Setup setup;
+    std::vector<std::int32_t> const keys = segmentedKeys(static_cast<std::size_t>(size), 50);
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<std::int64_t> distribution(-1000, 1000);
+    std::vector<std::int64_t> values(keys.size());
+    std::generate(values.begin(), values.end(), [&] { return distribution(generator); });
+
+    std::vector<std::int64_t> expectedValues;
+    for(std::size_t i = 0; i < keys.size(); ++i)
+    {
+        if(i == 0 || keys[i] != keys[i - 1])
+        {
+            expectedValues.push_back(values[i]);
+        }
+        else
+        {
+            expectedValues.back() = std::max(expectedValues.back(), values[i]);
+        }
+    }
+
+    auto devKeys = vikunja::test::toDevice(setup, keys);
+    auto devValues = vikunja::test::toDevice(setup, values);
+    auto devKeysOut = setup.allocDev<std::int32_t>(static_cast<Idx>(size));
+    auto devValuesOut = setup.allocDev<std::int64_t>(static_cast<Idx>(size));
+
+    Idx const numSegments = vikunja::reduce::deviceReduceByKey<typename Setup::Acc>(
+        setup.devAcc,
+        setup.devHost,
+        setup.queueAcc,
+        static_cast<Idx>(size),
+        alpaka::getPtrNative(devKeys),
+        alpaka::getPtrNative(devValues),
+        alpaka::getPtrNative(devKeysOut),
+        alpaka::getPtrNative(devValuesOut),
+        AccMax{});
+
+    REQUIRE(numSegments == expectedValues.size());
+    REQUIRE(vikunja::test::toHost<std::int64_t>(setup, devValuesOut, numSegments) == expectedValues);
+}
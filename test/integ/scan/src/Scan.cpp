@@ -0,0 +1,267 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <vikunja/scan/scan.hpp>
+#include <vikunja/test/AlpakaSetup.hpp>
+#include <vikunja/test/utility.hpp>
+
+#include <alpaka/alpaka.hpp>
+#include <alpaka/example/ExampleDefaultAcc.hpp>
+
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    using Dim = alpaka::DimInt<1u>;
+    using Idx = std::uint64_t;
+    using Setup = vikunja::test::
+        TestAlpakaSetup<Dim, Idx, alpaka::AccCpuSerial, alpaka::ExampleDefaultAcc, alpaka::Blocking>;
+
+    /**
+     * The affine function x -> a * x + b. The composition of affine functions is associative, but not commutative.
+     */
+    struct Affine
+    {
+        std::uint64_t a;
+        std::uint64_t b;
+
+        bool operator==(Affine const& other) const
+        {
+            return a == other.a && b == other.b;
+        }
+    };
+
+    //! Applies first f and then g.
+    struct Compose
+    {
+        ALPAKA_FN_HOST_ACC Affine operator()(Affine const& f, Affine const& g) const
+        {
+            return Affine{g.a * f.a, g.a * f.b + g.b};
+        }
+    };
+
+    /**
+     * Copies the input to the device input and output, executes the scan on the device and returns the result.
+     * @param scan Functor, which is called with the device input and output pointer.
+     */
+    template<typename TData, typename TResult, typename TScan>
+    std::vector<TResult> runOnDevice(Setup& setup, std::vector<TData> const& input, TScan const& scan)
+    {
+        Idx const size = static_cast<Idx>(input.size());
+        auto const extent = alpaka::Vec<Dim, Idx>::all(size);
+        auto hostInput = setup.allocHost<TData>(size);
+        auto hostOutput = setup.allocHost<TResult>(size);
+        auto devInput = setup.allocDev<TData>(size);
+        auto devOutput = setup.allocDev<TResult>(size);
+        std::copy(input.begin(), input.end(), alpaka::getPtrNative(hostInput));
+        alpaka::memcpy(setup.queueAcc, devInput, hostInput, extent);
+        // allows in place scans on the output
+        alpaka::memcpy(setup.queueAcc, devOutput, hostInput, extent);
+
+        scan(alpaka::getPtrNative(devInput), alpaka::getPtrNative(devOutput));
+
+        alpaka::memcpy(setup.queueAcc, hostOutput, devOutput, extent);
+        alpaka::wait(setup.queueAcc);
+        TResult const* const result = alpaka::getPtrNative(hostOutput);
+        return std::vector<TResult>(result, result + size);
+    }
+} // namespace
+
+TEST_CASE("Test inclusive and exclusive scan", "[scan]")
+{
+    using Data = std::uint64_t;
+
+    auto size = GENERATE(1, 2, 10, 777, 1 << 16, (1 << 16) + 3);
+
+    INFO((vikunja::test::print_acc_info<Dim>(size)));
+
+    Setup setup;
+    std::vector<Data> input(static_cast<std::size_t>(size));
+    std::iota(input.begin(), input.end(), 1);
+
+    auto sum = [] ALPAKA_FN_HOST_ACC(Data const i, Data const j) { return i + j; };
+    auto square = [] ALPAKA_FN_HOST_ACC(Data const i) { return i * i; };
+    std::vector<Data> expected(input.size());
+
+    SECTION("inclusive")
+    {
+        std::inclusive_scan(input.begin(), input.end(), expected.begin());
+        auto result = runOnDevice<Data, Data>(
+            setup,
+            input,
+            [&](Data* in, Data* out)
+            {
+                vikunja::scan::deviceInclusiveScan<typename Setup::Acc>(
+                    setup.devAcc,
+                    setup.queueAcc,
+                    in,
+                    in + size,
+                    out,
+                    sum);
+            });
+        REQUIRE(result == expected);
+    }
+
+    SECTION("exclusive")
+    {
+        std::exclusive_scan(input.begin(), input.end(), expected.begin(), Data{10});
+        auto result = runOnDevice<Data, Data>(
+            setup,
+            input,
+            [&](Data* in, Data* out)
+            {
+                vikunja::scan::deviceExclusiveScan<typename Setup::Acc>(
+                    setup.devAcc,
+                    setup.queueAcc,
+                    static_cast<Idx>(size),
+                    in,
+                    out,
+                    10,
+                    sum);
+            });
+        REQUIRE(result == expected);
+    }
+
+    SECTION("transform inclusive")
+    {
+        std::transform_inclusive_scan(input.begin(), input.end(), expected.begin(), std::plus<Data>{}, square);
+        auto result = runOnDevice<Data, Data>(
+            setup,
+            input,
+            [&](Data* in, Data* out)
+            {
+                vikunja::scan::deviceTransformInclusiveScan<typename Setup::Acc>(
+                    setup.devAcc,
+                    setup.queueAcc,
+                    static_cast<Idx>(size),
+                    in,
+                    out,
+                    square,
+                    sum);
+            });
+        REQUIRE(result == expected);
+    }
+
+    SECTION("transform exclusive")
+    {
+        std::transform_exclusive_scan(
+            input.begin(),
+            input.end(),
+            expected.begin(),
+            Data{0},
+            std::plus<Data>{},
+            square);
+        auto result = runOnDevice<Data, Data>(
+            setup,
+            input,
+            [&](Data* in, Data* out)
+            {
+                vikunja::scan::deviceTransformExclusiveScan<typename Setup::Acc>(
+                    setup.devAcc,
+                    setup.queueAcc,
+                    in,
+                    in + size,
+                    out,
+                    0,
+                    square,
+                    sum);
+            });
+        REQUIRE(result == expected);
+    }
+
+    SECTION("in place")
+    {
+        std::inclusive_scan(input.begin(), input.end(), expected.begin());
+        auto result = runOnDevice<Data, Data>(
+            setup,
+            input,
+            [&](Data*, Data* out)
+            {
+                vikunja::scan::deviceInclusiveScan<typename Setup::Acc>(
+                    setup.devAcc,
+                    setup.queueAcc,
+                    static_cast<Idx>(size),
+                    out,
+                    out,
+                    sum);
+            });
+        REQUIRE(result == expected);
+    }
+}
+
+TEST_CASE("Test scan with not commutative operator", "[scan]")
+{
+    auto size = GENERATE(1, 3, 777, 1 << 14);
+
+    INFO((vikunja::test::print_acc_info<Dim>(size)));
+
+    Setup setup;
+    std::vector<Affine> input;
+    for(int i = 0; i < size; ++i)
+    {
+        input.push_back(Affine{static_cast<std::uint64_t>(i % 7 + 1), static_cast<std::uint64_t>(i)});
+    }
+    std::vector<Affine> expected(input.size());
+    std::inclusive_scan(input.begin(), input.end(), expected.begin(), Compose{});
+
+    auto result = runOnDevice<Affine, Affine>(
+        setup,
+        input,
+        [&](Affine* in, Affine* out)
+        {
+            vikunja::scan::deviceInclusiveScan<typename Setup::Acc>(
+                setup.devAcc,
+                setup.queueAcc,
+                static_cast<Idx>(size),
+                in,
+                out,
+                Compose{});
+        });
+    REQUIRE(result == expected);
+}
+
+TEST_CASE("Test scan with operator taking the accelerator", "[scan]")
+{
+    using Data = std::int64_t;
+
+    auto size = GENERATE(5, 1 << 12);
+
+    INFO((vikunja::test::print_acc_info<Dim>(size)));
+
+    Setup setup;
+    std::vector<Data> input(static_cast<std::size_t>(size));
+    std::iota(input.begin(), input.end(), -100);
+    std::vector<Data> expected(input.size());
+    std::inclusive_scan(
+        input.begin(),
+        input.end(),
+        expected.begin(),
+        [](Data const i, Data const j) { return std::max(i, j); });
+
+    auto max = [] ALPAKA_FN_HOST_ACC(typename Setup::Acc const& acc, Data const i, Data const j)
+    { return alpaka::math::max(acc, i, j); };
+    auto result = runOnDevice<Data, Data>(
+        setup,
+        input,
+        [&](Data* in, Data* out)
+        {
+            vikunja::scan::deviceInclusiveScan<typename Setup::Acc>(
+                setup.devAcc,
+                setup.queueAcc,
+                static_cast<Idx>(size),
+                in,
+                out,
+                max);
+        });
+    REQUIRE(result == expected);
+}
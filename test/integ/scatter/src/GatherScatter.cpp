@@ -0,0 +1,143 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <vikunja/scatter/scatter.hpp>
+#include <vikunja/test/AlpakaSetup.hpp>
+#include <vikunja/test/DeviceMemory.hpp>
+#include <vikunja/test/utility.hpp>
+
+#include <alpaka/alpaka.hpp>
+#include <alpaka/example/ExampleDefaultAcc.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    using Dim = alpaka::DimInt<1u>;
+    using Idx = std::uint64_t;
+    using Index = std::uint32_t;
+    using Data = double;
+    using Setup = vikunja::test::
+        TestAlpakaSetup<Dim, Idx, alpaka::AccCpuSerial, alpaka::ExampleDefaultAcc, alpaka::Blocking>;
+    using Acc = typename Setup::Acc;
+
+    struct IsOdd
+    {
+        ALPAKA_FN_HOST_ACC bool operator()(Index const& value) const
+        {
+            return (value % 2u) == 1u;
+        }
+    };
+} // namespace
+
+TEST_CASE("Test gather and scatter", "[scatter]")
+{
+    auto size = GENERATE(1, 777, 100'000);
+
+    INFO((vikunja::test::print_acc_info<Dim>(size)));
+
+    Setup setup;
+    std::mt19937 generator(static_cast<std::mt19937::result_type>(size));
+    std::uniform_real_distribution<Data> distribution(-1000., 1000.);
+    std::vector<Data> source(static_cast<std::size_t>(size));
+    std::generate(source.begin(), source.end(), [&] { return distribution(generator); });
+    std::vector<Data> initial(static_cast<std::size_t>(size));
+    std::generate(initial.begin(), initial.end(), [&] { return distribution(generator); });
+    // random permutation
+    std::vector<Index> permutation(static_cast<std::size_t>(size));
+    std::iota(permutation.begin(), permutation.end(), Index{0});
+    std::shuffle(permutation.begin(), permutation.end(), generator);
+    // stencil with random values, the odd ones are selected
+    std::vector<Index> stencil(static_cast<std::size_t>(size));
+    std::generate(stencil.begin(), stencil.end(), [&] { return static_cast<Index>(generator()); });
+
+    auto devSource = vikunja::test::toDevice(setup, source);
+    auto devPermutation = vikunja::test::toDevice(setup, permutation);
+    auto devStencil = vikunja::test::toDevice(setup, stencil);
+    auto devDestination = vikunja::test::toDevice(setup, initial);
+    std::vector<Data> expected(initial);
+
+    SECTION("gather")
+    {
+        vikunja::scatter::deviceGather<Acc>(
+            setup.devAcc,
+            setup.queueAcc,
+            alpaka::getPtrNative(devPermutation),
+            alpaka::getPtrNative(devSource),
+            alpaka::getPtrNative(devDestination),
+            static_cast<Idx>(size));
+        for(std::size_t i = 0; i < expected.size(); ++i)
+        {
+            expected[i] = source[permutation[i]];
+        }
+    }
+
+    SECTION("gather if")
+    {
+        vikunja::scatter::deviceGatherIf<Acc>(
+            setup.devAcc,
+            setup.queueAcc,
+            alpaka::getPtrNative(devPermutation),
+            alpaka::getPtrNative(devSource),
+            alpaka::getPtrNative(devDestination),
+            static_cast<Idx>(size),
+            alpaka::getPtrNative(devStencil),
+            IsOdd());
+        for(std::size_t i = 0; i < expected.size(); ++i)
+        {
+            if(IsOdd()(stencil[i]))
+            {
+                expected[i] = source[permutation[i]];
+            }
+        }
+    }
+
+    SECTION("scatter")
+    {
+        vikunja::scatter::deviceScatter<Acc>(
+            setup.devAcc,
+            setup.queueAcc,
+            alpaka::getPtrNative(devSource),
+            alpaka::getPtrNative(devPermutation),
+            alpaka::getPtrNative(devDestination),
+            static_cast<Idx>(size));
+        for(std::size_t i = 0; i < expected.size(); ++i)
+        {
+            expected[permutation[i]] = source[i];
+        }
+    }
+
+    SECTION("scatter if")
+    {
+        vikunja::scatter::deviceScatterIf<Acc>(
+            setup.devAcc,
+            setup.queueAcc,
+            alpaka::getPtrNative(devSource),
+            alpaka::getPtrNative(devPermutation),
+            alpaka::getPtrNative(devDestination),
+            static_cast<Idx>(size),
+            alpaka::getPtrNative(devStencil),
+            IsOdd());
+        for(std::size_t i = 0; i < expected.size(); ++i)
+        {
+            if(IsOdd()(stencil[i]))
+            {
+                expected[permutation[i]] = source[i];
+            }
+        }
+    }
+
+    REQUIRE(vikunja::test::toHost<Data>(setup, devDestination, static_cast<Idx>(size)) == expected);
+}
@@ -0,0 +1,167 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <vikunja/operators/functors.hpp>
+#include <vikunja/scatter/scatterReduce.hpp>
+#include <vikunja/test/AlpakaSetup.hpp>
+#include <vikunja/test/DeviceMemory.hpp>
+#include <vikunja/test/utility.hpp>
+
+#include <alpaka/alpaka.hpp>
+#include <alpaka/example/ExampleDefaultAcc.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    using Dim = alpaka::DimInt<1u>;
+    using Idx = std::uint64_t;
+    using Index = std::uint32_t;
+    using Value = std::int32_t;
+    using Setup = vikunja::test::
+        TestAlpakaSetup<Dim, Idx, alpaka::AccCpuSerial, alpaka::ExampleDefaultAcc, alpaka::Blocking>;
+    using Acc = typename Setup::Acc;
+    using vikunja::scatter::ScatterReduceStrategy;
+
+    struct Max
+    {
+        static constexpr bool isCommutative = true;
+
+        ALPAKA_FN_HOST_ACC Value operator()(Value const& a, Value const& b) const
+        {
+            return (a < b) ? b : a;
+        }
+    };
+
+    //! Associative, but not commutative: keeps the last value.
+    struct Last
+    {
+        ALPAKA_FN_HOST_ACC Value operator()(Value const&, Value const& b) const
+        {
+            return b;
+        }
+    };
+} // namespace
+
+TEST_CASE("Test scatter reduce", "[scatter]")
+{
+    auto size = GENERATE(1, 777, 100'000);
+    // many conflicts or few conflicts
+    auto numTargets = GENERATE(Idx{10}, Idx{1'000'000});
+    auto strategy
+        = GENERATE(ScatterReduceStrategy::automatic, ScatterReduceStrategy::atomic, ScatterReduceStrategy::sort);
+
+    INFO((vikunja::test::print_acc_info<Dim>(size)));
+    INFO("targets: " << numTargets << " strategy: " << static_cast<int>(strategy));
+
+    Setup setup;
+    std::mt19937 generator(static_cast<std::mt19937::result_type>(size));
+    std::uniform_int_distribution<Index> indexDistribution(0, static_cast<Index>(numTargets - 1));
+    std::uniform_int_distribution<Value> valueDistribution(-1000, 1000);
+    std::vector<Index> indices(static_cast<std::size_t>(size));
+    std::vector<Value> values(static_cast<std::size_t>(size));
+    std::vector<Value> target(static_cast<std::size_t>(numTargets));
+    std::generate(indices.begin(), indices.end(), [&] { return indexDistribution(generator); });
+    std::generate(values.begin(), values.end(), [&] { return valueDistribution(generator); });
+    std::generate(target.begin(), target.end(), [&] { return valueDistribution(generator); });
+
+    auto devIndices = vikunja::test::toDevice(setup, indices);
+    auto devValues = vikunja::test::toDevice(setup, values);
+
+    SECTION("sum")
+    {
+        auto devTarget = vikunja::test::toDevice(setup, target);
+        vikunja::scatter::deviceScatterReduce<Acc>(
+            setup.devAcc,
+            setup.devHost,
+            setup.queueAcc,
+            alpaka::getPtrNative(devValues),
+            alpaka::getPtrNative(devIndices),
+            static_cast<Idx>(size),
+            alpaka::getPtrNative(devTarget),
+            vikunja::operators::Plus<Value>(),
+            strategy);
+
+        for(std::size_t i = 0; i < indices.size(); ++i)
+        {
+            target[indices[i]] += values[i];
+        }
+        REQUIRE(vikunja::test::toHost<Value>(setup, devTarget, numTargets) == target);
+    }
+
+    SECTION("maximum")
+    {
+        auto devTarget = vikunja::test::toDevice(setup, target);
+        vikunja::scatter::deviceScatterReduce<Acc>(
+            setup.devAcc,
+            setup.devHost,
+            setup.queueAcc,
+            alpaka::getPtrNative(devValues),
+            alpaka::getPtrNative(devIndices),
+            static_cast<Idx>(size),
+            alpaka::getPtrNative(devTarget),
+            Max(),
+            strategy);
+
+        for(std::size_t i = 0; i < indices.size(); ++i)
+        {
+            target[indices[i]] = std::max(target[indices[i]], values[i]);
+        }
+        REQUIRE(vikunja::test::toHost<Value>(setup, devTarget, numTargets) == target);
+    }
+}
+
+TEST_CASE("Test scatter reduce not commutative", "[scatter]")
+{
+    auto size = GENERATE(1, 777, 100'000);
+    // the automatic strategy must not select the atomic strategy for few conflicts
+    auto numTargets = GENERATE(Idx{100}, Idx{1'000'000});
+    auto strategy = GENERATE(ScatterReduceStrategy::automatic, ScatterReduceStrategy::sort);
+
+    INFO((vikunja::test::print_acc_info<Dim>(size)));
+    INFO("targets: " << numTargets << " strategy: " << static_cast<int>(strategy));
+
+    Setup setup;
+    std::mt19937 generator(static_cast<std::mt19937::result_type>(size));
+    std::uniform_int_distribution<Index> indexDistribution(0, static_cast<Index>(numTargets - 1));
+    std::vector<Index> indices(static_cast<std::size_t>(size));
+    std::vector<Value> values(static_cast<std::size_t>(size));
+    std::vector<Value> target(static_cast<std::size_t>(numTargets), -1);
+    std::generate(indices.begin(), indices.end(), [&] { return indexDistribution(generator); });
+    for(std::size_t i = 0; i < values.size(); ++i)
+    {
+        values[i] = static_cast<Value>(i);
+    }
+
+    auto devIndices = vikunja::test::toDevice(setup, indices);
+    auto devValues = vikunja::test::toDevice(setup, values);
+    auto devTarget = vikunja::test::toDevice(setup, target);
+    vikunja::scatter::deviceScatterReduce<Acc>(
+        setup.devAcc,
+        setup.devHost,
+        setup.queueAcc,
+        alpaka::getPtrNative(devValues),
+        alpaka::getPtrNative(devIndices),
+        static_cast<Idx>(size),
+        alpaka::getPtrNative(devTarget),
+        Last(),
+        strategy);
+
+    // the target of each index contains the value of its last occurrence
+    for(std::size_t i = 0; i < indices.size(); ++i)
+    {
+        target[indices[i]] = values[i];
+    }
+    REQUIRE(vikunja::test::toHost<Value>(setup, devTarget, numTargets) == target);
+}
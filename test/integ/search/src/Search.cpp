@@ -0,0 +1,198 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <vikunja/search/search.hpp>
+#include <vikunja/test/AlpakaSetup.hpp>
+#include <vikunja/test/DeviceMemory.hpp>
+#include <vikunja/test/utility.hpp>
+
+#include <alpaka/alpaka.hpp>
+#include <alpaka/example/ExampleDefaultAcc.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    using Dim = alpaka::DimInt<1u>;
+    using Idx = std::uint64_t;
+    using Data = std::int32_t;
+    using Setup = vikunja::test::
+        TestAlpakaSetup<Dim, Idx, alpaka::AccCpuSerial, alpaka::ExampleDefaultAcc, alpaka::Blocking>;
+    using Acc = typename Setup::Acc;
+    using WorkDivPolicy = vikunja::workdiv::BlockBasedPolicy<Acc>;
+    using MemAccessPolicy = vikunja::MemAccess::MemAccessPolicy<Acc>;
+
+    std::vector<Data> randomData(std::size_t const size, Data const min, Data const max, unsigned const seed)
+    {
+        std::mt19937 generator(seed);
+        std::uniform_int_distribution<Data> distribution(min, max);
+        std::vector<Data> data(size);
+        std::generate(data.begin(), data.end(), [&] { return distribution(generator); });
+        return data;
+    }
+} // namespace
+
+TEST_CASE("Test lower bound and upper bound", "[search]")
+{
+    auto size = GENERATE(1, 100, 100'000);
+    auto numQueries = GENERATE(1, 777, 100'000);
+    // few distinct values check equal elements
+    auto range = GENERATE(50, 1'000'000);
+
+    INFO((vikunja::test::print_acc_info<Dim>(size)));
+    INFO("queries: " << numQueries << " range: " << range);
+
+    Setup setup;
+    std::vector<Data> sorted = randomData(static_cast<std::size_t>(size), -range, range, 1u);
+    std::sort(sorted.begin(), sorted.end());
+    // the queries are also outside of the range of the sorted data
+    std::vector<Data> queries = randomData(static_cast<std::size_t>(numQueries), -2 * range, 2 * range, 2u);
+
+    std::vector<Idx> expectedLower;
+    std::vector<Idx> expectedUpper;
+    auto computeExpected = [&]()
+    {
+        expectedLower.clear();
+        expectedUpper.clear();
+        for(Data const query : queries)
+        {
+            expectedLower.push_back(
+                static_cast<Idx>(std::lower_bound(sorted.begin(), sorted.end(), query) - sorted.begin()));
+            expectedUpper.push_back(
+                static_cast<Idx>(std::upper_bound(sorted.begin(), sorted.end(), query) - sorted.begin()));
+        }
+    };
+
+    auto devSorted = vikunja::test::toDevice(setup, sorted);
+    auto devOutput = setup.allocDev<Idx>(static_cast<Idx>(numQueries));
+    Data* const begin = alpaka::getPtrNative(devSorted);
+    Data* const end = begin + size;
+    Idx* const output = alpaka::getPtrNative(devOutput);
+
+    SECTION("binary search")
+    {
+        computeExpected();
+        auto devQueries = vikunja::test::toDevice(setup, queries);
+        Data* const queryPtr = alpaka::getPtrNative(devQueries);
+        vikunja::search::deviceLowerBound<Acc>(
+            setup.devAcc,
+            setup.queueAcc,
+            begin,
+            end,
+            queryPtr,
+            static_cast<Idx>(numQueries),
+            output);
+        REQUIRE(vikunja::test::toHost<Idx>(setup, devOutput, static_cast<Idx>(numQueries)) == expectedLower);
+
+        vikunja::search::deviceUpperBound<Acc>(
+            setup.devAcc,
+            setup.queueAcc,
+            begin,
+            end,
+            queryPtr,
+            static_cast<Idx>(numQueries),
+            output);
+        REQUIRE(vikunja::test::toHost<Idx>(setup, devOutput, static_cast<Idx>(numQueries)) == expectedUpper);
+    }
+
+    SECTION("binary search with cached tree levels")
+    {
+        computeExpected();
+        auto devQueries = vikunja::test::toDevice(setup, queries);
+        Data* const queryPtr = alpaka::getPtrNative(devQueries);
+        vikunja::search::deviceLowerBound<Acc, WorkDivPolicy, MemAccessPolicy, 6u>(
+            setup.devAcc,
+            setup.queueAcc,
+            begin,
+            end,
+            queryPtr,
+            static_cast<Idx>(numQueries),
+            output);
+        REQUIRE(vikunja::test::toHost<Idx>(setup, devOutput, static_cast<Idx>(numQueries)) == expectedLower);
+
+        vikunja::search::deviceUpperBound<Acc, WorkDivPolicy, MemAccessPolicy, 6u>(
+            setup.devAcc,
+            setup.queueAcc,
+            begin,
+            end,
+            queryPtr,
+            static_cast<Idx>(numQueries),
+            output);
+        REQUIRE(vikunja::test::toHost<Idx>(setup, devOutput, static_cast<Idx>(numQueries)) == expectedUpper);
+    }
+
+    SECTION("sorted queries")
+    {
+        std::sort(queries.begin(), queries.end());
+        computeExpected();
+        auto devQueries = vikunja::test::toDevice(setup, queries);
+        Data* const queryPtr = alpaka::getPtrNative(devQueries);
+        vikunja::search::deviceSortedLowerBound<Acc>(
+            setup.devAcc,
+            setup.queueAcc,
+            begin,
+            end,
+            queryPtr,
+            static_cast<Idx>(numQueries),
+            output);
+        REQUIRE(vikunja::test::toHost<Idx>(setup, devOutput, static_cast<Idx>(numQueries)) == expectedLower);
+
+        vikunja::search::deviceSortedUpperBound<Acc>(
+            setup.devAcc,
+            setup.queueAcc,
+            begin,
+            end,
+            queryPtr,
+            static_cast<Idx>(numQueries),
+            output);
+        REQUIRE(vikunja::test::toHost<Idx>(setup, devOutput, static_cast<Idx>(numQueries)) == expectedUpper);
+    }
+}
+
+TEST_CASE("Test lower bound with a custom comparator", "[search]")
+{
+    auto size = GENERATE(100, 100'000);
+
+    INFO((vikunja::test::print_acc_info<Dim>(size)));
+
+    Setup setup;
+    std::vector<Data> sorted = randomData(static_cast<std::size_t>(size), -1000, 1000, 3u);
+    std::sort(sorted.begin(), sorted.end(), std::greater<Data>());
+    std::vector<Data> queries = randomData(10'000u, -2000, 2000, 4u);
+
+    std::vector<Idx> expected;
+    for(Data const query : queries)
+    {
+        expected.push_back(static_cast<Idx>(
+            std::lower_bound(sorted.begin(), sorted.end(), query, std::greater<Data>()) - sorted.begin()));
+    }
+
+    auto devSorted = vikunja::test::toDevice(setup, sorted);
+    auto devQueries = vikunja::test::toDevice(setup, queries);
+    auto devOutput = setup.allocDev<Idx>(static_cast<Idx>(queries.size()));
+    Data* const begin = alpaka::getPtrNative(devSorted);
+
+    auto greater = [] ALPAKA_FN_HOST_ACC(Data const a, Data const b) { return a > b; };
+    vikunja::search::deviceLowerBound<Acc, WorkDivPolicy, MemAccessPolicy, 4u>(
+        setup.devAcc,
+        setup.queueAcc,
+        begin,
+        begin + size,
+        alpaka::getPtrNative(devQueries),
+        static_cast<Idx>(queries.size()),
+        alpaka::getPtrNative(devOutput),
+        greater);
+    REQUIRE(vikunja::test::toHost<Idx>(setup, devOutput, static_cast<Idx>(queries.size())) == expected);
+}
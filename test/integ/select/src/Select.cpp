@@ -0,0 +1,135 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <vikunja/select/select.hpp>
+#include <vikunja/test/AlpakaSetup.hpp>
+#include <vikunja/test/DeviceMemory.hpp>
+#include <vikunja/test/utility.hpp>
+
+#include <alpaka/alpaka.hpp>
+#include <alpaka/example/ExampleDefaultAcc.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    using Dim = alpaka::DimInt<1u>;
+    using Idx = std::uint64_t;
+    using Setup = vikunja::test::
+        TestAlpakaSetup<Dim, Idx, alpaka::AccCpuSerial, alpaka::ExampleDefaultAcc, alpaka::Blocking>;
+
+    template<typename TKey>
+    std::vector<TKey> randomKeys(std::size_t const size, double const min, double const max)
+    {
+        std::mt19937 generator(static_cast<std::mt19937::result_type>(size));
+        std::vector<TKey> keys(size);
+        if constexpr(std::is_floating_point_v<TKey>)
+        {
+            std::uniform_real_distribution<TKey> distribution(static_cast<TKey>(min), static_cast<TKey>(max));
+            std::generate(keys.begin(), keys.end(), [&] { return distribution(generator); });
+        }
+        else
+        {
+            std::uniform_int_distribution<TKey> distribution(static_cast<TKey>(min), static_cast<TKey>(max));
+            std::generate(keys.begin(), keys.end(), [&] { return distribution(generator); });
+        }
+        return keys;
+    }
+} // namespace
+
+TEMPLATE_TEST_CASE("Test nth element", "[select]", std::uint8_t, std::int32_t, std::uint64_t, float, double)
+{
+    using Key = TestType;
+
+    auto size = GENERATE(1, 2, 15, 777, 100'000);
+    // wide range and many equal keys
+    auto range = GENERATE(20.0, 1'000'000.0);
+
+    INFO((vikunja::test::print_acc_info<Dim>(size)));
+    INFO("range: " << range);
+
+    Setup setup;
+    double const min = std::is_signed_v<Key> ? -range : 0.0;
+    double const max = std::is_same_v<Key, std::uint8_t> ? 255.0 : range;
+    std::vector<Key> keys = randomKeys<Key>(static_cast<std::size_t>(size), min, max);
+    auto devKeys = vikunja::test::toDevice(setup, keys);
+    std::vector<Key> sorted = keys;
+    std::sort(sorted.begin(), sorted.end());
+
+    for(Idx const nth : {Idx{0}, static_cast<Idx>(size) / 2, static_cast<Idx>(size) - 1})
+    {
+        INFO("nth: " << nth);
+        Key* const begin = alpaka::getPtrNative(devKeys);
+        Key const result = vikunja::select::deviceNthElement<typename Setup::Acc>(
+            setup.devAcc,
+            setup.devHost,
+            setup.queueAcc,
+            begin,
+            begin + size,
+            nth);
+        REQUIRE(result == sorted[nth]);
+    }
+    // the input is not changed
+    REQUIRE(vikunja::test::toHost<Key>(setup, devKeys, static_cast<Idx>(size)) == keys);
+}
+
+TEMPLATE_TEST_CASE("Test top k", "[select]", std::int32_t, float)
+{
+    using Key = TestType;
+
+    auto size = GENERATE(1, 15, 777, 100'000);
+    auto range = GENERATE(20.0, 1'000'000.0);
+
+    INFO((vikunja::test::print_acc_info<Dim>(size)));
+    INFO("range: " << range);
+
+    Setup setup;
+    std::vector<Key> keys = randomKeys<Key>(static_cast<std::size_t>(size), -range, range);
+    auto devKeys = vikunja::test::toDevice(setup, keys);
+    std::vector<Key> sorted = keys;
+    std::sort(sorted.begin(), sorted.end(), std::greater<Key>());
+
+    for(Idx const k : {Idx{1}, std::min(static_cast<Idx>(size), Idx{10}), static_cast<Idx>(size)})
+    {
+        INFO("k: " << k);
+        auto devValues = setup.allocDev<Key>(k);
+        auto devIndices = setup.allocDev<Idx>(k);
+        vikunja::select::deviceTopK<typename Setup::Acc>(
+            setup.devAcc,
+            setup.devHost,
+            setup.queueAcc,
+            static_cast<Idx>(size),
+            alpaka::getPtrNative(devKeys),
+            k,
+            alpaka::getPtrNative(devValues),
+            alpaka::getPtrNative(devIndices));
+
+        std::vector<Key> values = vikunja::test::toHost<Key>(setup, devValues, k);
+        std::vector<Idx> indices = vikunja::test::toHost<Idx>(setup, devIndices, k);
+        std::vector<Key> indexedKeys;
+        for(Idx const index : indices)
+        {
+            indexedKeys.push_back(keys[index]);
+        }
+        REQUIRE(indexedKeys == values);
+        // each index is selected once
+        std::sort(indices.begin(), indices.end());
+        REQUIRE(std::adjacent_find(indices.begin(), indices.end()) == indices.end());
+
+        std::sort(values.begin(), values.end(), std::greater<Key>());
+        REQUIRE(values == std::vector<Key>(sorted.begin(), sorted.begin() + k));
+    }
+}
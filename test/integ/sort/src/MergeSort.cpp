@@ -0,0 +1,144 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <vikunja/sort/mergeSort.hpp>
+#include <vikunja/test/AlpakaSetup.hpp>
+#include <vikunja/test/DeviceMemory.hpp>
+#include <vikunja/test/utility.hpp>
+
+#include <alpaka/alpaka.hpp>
+#include <alpaka/example/ExampleDefaultAcc.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    using Dim = alpaka::DimInt<1u>;
+    using Idx = std::uint64_t;
+    using Setup = vikunja::test::
+        TestAlpakaSetup<Dim, Idx, alpaka::AccCpuSerial, alpaka::ExampleDefaultAcc, alpaka::Blocking>;
+
+    //! Key with a payload, which is not part of the comparison.
+    struct Record
+    {
+        std::int32_t key;
+        std::uint32_t index;
+
+        bool operator==(Record const& other) const
+        {
+            return key == other.key && index == other.index;
+        }
+    };
+
+    struct RecordLess
+    {
+        ALPAKA_FN_HOST_ACC bool operator()(Record const& a, Record const& b) const
+        {
+            return a.key < b.key;
+        }
+    };
+
+    //! Descending order, which takes the accelerator.
+    struct AccGreater
+    {
+        template<typename TAcc>
+        ALPAKA_FN_HOST_ACC bool operator()(TAcc const&, std::int64_t const a, std::int64_t const b) const
+        {
+            return a > b;
+        }
+    };
+
+    std::vector<Record> randomRecords(std::size_t const size, std::int32_t const maxKey)
+    {
+        std::mt19937 generator(static_cast<std::mt19937::result_type>(size));
+        std::uniform_int_distribution<std::int32_t> distribution(-maxKey, maxKey);
+        std::vector<Record> records(size);
+        for(std::size_t i = 0; i < size; ++i)
+        {
+            records[i] = Record{distribution(generator), static_cast<std::uint32_t>(i)};
+        }
+        return records;
+    }
+} // namespace
+
+TEST_CASE("Test merge sort with custom comparator", "[sort][mergeSort]")
+{
+    auto size = GENERATE(1, 2, 15, 16, 17, 777, 100'000);
+
+    INFO((vikunja::test::print_acc_info<Dim>(size)));
+
+    Setup setup;
+    std::vector<Record> records = randomRecords(static_cast<std::size_t>(size), 1'000'000);
+    auto devRecords = vikunja::test::toDevice(setup, records);
+
+    Record* const begin = alpaka::getPtrNative(devRecords);
+    vikunja::sort::deviceSort<typename Setup::Acc>(setup.devAcc, setup.queueAcc, begin, begin + size, RecordLess{});
+
+    std::vector<Record> const result = vikunja::test::toHost<Record>(setup, devRecords, static_cast<Idx>(size));
+    REQUIRE(std::is_sorted(result.begin(), result.end(), RecordLess{}));
+    // the sort is a permutation of the input
+    std::vector<bool> seen(records.size(), false);
+    for(Record const& record : result)
+    {
+        REQUIRE(record == records[record.index]);
+        REQUIRE_FALSE(seen[record.index]);
+        seen[record.index] = true;
+    }
+}
+
+TEST_CASE("Test stable merge sort", "[sort][mergeSort]")
+{
+    auto size = GENERATE(1, 15, 16, 17, 777, 100'000);
+
+    INFO((vikunja::test::print_acc_info<Dim>(size)));
+
+    Setup setup;
+    // many equal keys check the stability
+    std::vector<Record> records = randomRecords(static_cast<std::size_t>(size), 20);
+    auto devRecords = vikunja::test::toDevice(setup, records);
+
+    vikunja::sort::deviceStableSort<typename Setup::Acc>(
+        setup.devAcc,
+        setup.queueAcc,
+        static_cast<Idx>(size),
+        alpaka::getPtrNative(devRecords),
+        RecordLess{});
+
+    std::stable_sort(records.begin(), records.end(), RecordLess{});
+    REQUIRE(vikunja::test::toHost<Record>(setup, devRecords, static_cast<Idx>(size)) == records);
+}
+
+TEST_CASE("Test merge sort with comparator taking the accelerator", "[sort][mergeSort]")
+{
+    auto size = GENERATE(10, 100'000);
+
+    INFO((vikunja::test::print_acc_info<Dim>(size)));
+
+    Setup setup;
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<std::int64_t> distribution(-1'000'000, 1'000'000);
+    std::vector<std::int64_t> data(static_cast<std::size_t>(size));
+    std::generate(data.begin(), data.end(), [&] { return distribution(generator); });
+    auto devData = vikunja::test::toDevice(setup, data);
+
+    vikunja::sort::deviceSort<typename Setup::Acc>(
+        setup.devAcc,
+        setup.queueAcc,
+        static_cast<Idx>(size),
+        alpaka::getPtrNative(devData),
+        AccGreater{});
+
+    std::sort(data.begin(), data.end(), [](std::int64_t const a, std::int64_t const b) { return a > b; });
+    REQUIRE(vikunja::test::toHost<std::int64_t>(setup, devData, static_cast<Idx>(size)) == data);
+}
@@ -0,0 +1,145 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <vikunja/sort/radixSort.hpp>
+#include <vikunja/test/AlpakaSetup.hpp>
+#include <vikunja/test/DeviceMemory.hpp>
+#include <vikunja/test/utility.hpp>
+
+#include <alpaka/alpaka.hpp>
+#include <alpaka/example/ExampleDefaultAcc.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    using Dim = alpaka::DimInt<1u>;
+    using Idx = std::uint64_t;
+    using Setup = vikunja::test::
+        TestAlpakaSetup<Dim, Idx, alpaka::AccCpuSerial, alpaka::ExampleDefaultAcc, alpaka::Blocking>;
+
+    template<typename TKey>
+    std::vector<TKey> randomKeys(std::size_t const size, double const min, double const max)
+    {
+        std::mt19937 generator(static_cast<std::mt19937::result_type>(size));
+        std::vector<TKey> keys(size);
+        if constexpr(std::is_floating_point_v<TKey>)
+        {
+            std::uniform_real_distribution<TKey> distribution(static_cast<TKey>(min), static_cast<TKey>(max));
+            std::generate(keys.begin(), keys.end(), [&] { return distribution(generator); });
+        }
+        else
+        {
+            std::uniform_int_distribution<TKey> distribution(static_cast<TKey>(min), static_cast<TKey>(max));
+            std::generate(keys.begin(), keys.end(), [&] { return distribution(generator); });
+        }
+        return keys;
+    }
+} // namespace
+
+TEMPLATE_TEST_CASE(
+    "Test radix sort",
+    "[sort][radixSort]",
+    std::uint8_t,
+    std::uint32_t,
+    std::int32_t,
+    std::int64_t,
+    float,
+    double)
+{
+    using Key = TestType;
+
+    auto size = GENERATE(1, 2, 15, 777, 100'000);
+
+    INFO((vikunja::test::print_acc_info<Dim>(size)));
+
+    Setup setup;
+    double const min = std::is_signed_v<Key> ? -1'000'000.0 : 0.0;
+    double const max = std::is_same_v<Key, std::uint8_t> ? 255.0 : 1'000'000.0;
+    std::vector<Key> keys = randomKeys<Key>(static_cast<std::size_t>(size), min, max);
+    auto devKeys = vikunja::test::toDevice(setup, keys);
+
+    Key* const begin = alpaka::getPtrNative(devKeys);
+    vikunja::sort::deviceRadixSort<typename Setup::Acc>(setup.devAcc, setup.queueAcc, begin, begin + size);
+
+    std::sort(keys.begin(), keys.end());
+    REQUIRE(vikunja::test::toHost<Key>(setup, devKeys, static_cast<Idx>(size)) == keys);
+}
+
+TEST_CASE("Test radix sort of key value pairs", "[sort][radixSort]")
+{
+    using Key = std::int32_t;
+    using Value = std::uint64_t;
+
+    auto size = GENERATE(1, 15, 777, 100'000);
+
+    INFO((vikunja::test::print_acc_info<Dim>(size)));
+
+    Setup setup;
+    // many equal keys check the stability
+    std::vector<Key> keys = randomKeys<Key>(static_cast<std::size_t>(size), -20.0, 20.0);
+    std::vector<Value> values(keys.size());
+    std::iota(values.begin(), values.end(), 0);
+    auto devKeys = vikunja::test::toDevice(setup, keys);
+    auto devValues = vikunja::test::toDevice(setup, values);
+
+    vikunja::sort::deviceRadixSortPairs<typename Setup::Acc>(
+        setup.devAcc,
+        setup.queueAcc,
+        static_cast<Idx>(size),
+        alpaka::getPtrNative(devKeys),
+        alpaka::getPtrNative(devValues));
+
+    std::vector<Value> expectedValues = values;
+    std::stable_sort(
+        expectedValues.begin(),
+        expectedValues.end(),
+        [&](Value const a, Value const b) { return keys[a] < keys[b]; });
+    std::vector<Key> expectedKeys;
+    for(Value const v : expectedValues)
+    {
+        expectedKeys.push_back(keys[v]);
+    }
+
+    REQUIRE(vikunja::test::toHost<Key>(setup, devKeys, static_cast<Idx>(size)) == expectedKeys);
+    REQUIRE(vikunja::test::toHost<Value>(setup, devValues, static_cast<Idx>(size)) == expectedValues);
+}
+
+TEST_CASE("Test radix sort with a subset of the key bits", "[sort][radixSort]")
+{
+    using Key = std::uint32_t;
+
+    auto size = GENERATE(10, 100'000);
+    // one and two passes
+    auto endBit = GENERATE(5u, 12u);
+
+    INFO((vikunja::test::print_acc_info<Dim>(size)));
+
+    Setup setup;
+    std::vector<Key> keys = randomKeys<Key>(static_cast<std::size_t>(size), 0.0, (1u << endBit) - 1.0);
+    auto devKeys = vikunja::test::toDevice(setup, keys);
+
+    vikunja::sort::deviceRadixSort<typename Setup::Acc>(
+        setup.devAcc,
+        setup.queueAcc,
+        static_cast<Idx>(size),
+        alpaka::getPtrNative(devKeys),
+        0u,
+        endBit);
+
+    std::sort(keys.begin(), keys.end());
+    REQUIRE(vikunja::test::toHost<Key>(setup, devKeys, static_cast<Idx>(size)) == keys);
+}
@@ -0,0 +1,153 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <vikunja/sort/segmentedSort.hpp>
+#include <vikunja/test/AlpakaSetup.hpp>
+#include <vikunja/test/DeviceMemory.hpp>
+#include <vikunja/test/utility.hpp>
+
+#include <alpaka/alpaka.hpp>
+#include <alpaka/example/ExampleDefaultAcc.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    using Dim = alpaka::DimInt<1u>;
+    using Idx = std::uint64_t;
+    using Setup = vikunja::test::
+        TestAlpakaSetup<Dim, Idx, alpaka::AccCpuSerial, alpaka::ExampleDefaultAcc, alpaka::Blocking>;
+
+    //! Key with a payload, which is not part of the comparison.
+    struct Record
+    {
+        std::int32_t key;
+        std::uint32_t index;
+
+        bool operator==(Record const& other) const
+        {
+            return key == other.key && index == other.index;
+        }
+    };
+
+    struct RecordLess
+    {
+        ALPAKA_FN_HOST_ACC bool operator()(Record const& a, Record const& b) const
+        {
+            return a.key < b.key;
+        }
+    };
+
+    /**
+     * Creates the offsets of segments with random lengths between 0 and maxLength. Additionally, some segments
+     * with longLength elements are inserted. The first segment begins at the element 3, so that the elements in
+     * front of the first and behind the last segment are not sorted.
+     */
+    std::vector<Idx> randomOffsets(Idx const numSegments, Idx const maxLength, Idx const longLength)
+    {
+        std::mt19937 generator(static_cast<std::mt19937::result_type>(numSegments));
+        std::uniform_int_distribution<Idx> distribution(0, maxLength);
+        std::vector<Idx> offsets{3};
+        for(Idx i = 0; i < numSegments; ++i)
+        {
+            Idx const length = (i % 97 == 50) ? longLength : distribution(generator);
+            offsets.push_back(offsets.back() + length);
+        }
+        return offsets;
+    }
+
+    std::vector<Record> randomRecords(std::size_t const size, std::int32_t const maxKey)
+    {
+        std::mt19937 generator(static_cast<std::mt19937::result_type>(size));
+        std::uniform_int_distribution<std::int32_t> distribution(-maxKey, maxKey);
+        std::vector<Record> records(size);
+        for(std::size_t i = 0; i < size; ++i)
+        {
+            records[i] = Record{distribution(generator), static_cast<std::uint32_t>(i)};
+        }
+        return records;
+    }
+} // namespace
+
+TEST_CASE("Test segmented sort", "[sort][segmentedSort]")
+{
+    using Case = std::tuple<Idx, Idx, Idx>;
+    // number of segments, maximum length of the short segments and length of the long segments
+    auto const [numSegments, maxLength, longLength] = GENERATE(
+        Case{1, 0, 0},
+        Case{1, 1, 1},
+        Case{10, 20, 5000},
+        Case{2'000, 16, 16},
+        Case{1'000, 500, 129},
+        Case{200, 500, 3000});
+    bool const stable = GENERATE(false, true);
+
+    std::vector<Idx> const offsets = randomOffsets(numSegments, maxLength, longLength);
+    std::size_t const size = static_cast<std::size_t>(offsets.back() + 3);
+
+    INFO((vikunja::test::print_acc_info<Dim>(size)));
+    INFO("stable: " << stable);
+
+    Setup setup;
+    // many equal keys check the stability
+    std::vector<Record> records = randomRecords(size, stable ? 10 : 1'000'000);
+    auto devRecords = vikunja::test::toDevice(setup, records);
+    auto devOffsets = vikunja::test::toDevice(setup, offsets);
+
+    if(stable)
+    {
+        vikunja::sort::deviceStableSegmentedSort<typename Setup::Acc>(
+            setup.devAcc,
+            setup.queueAcc,
+            static_cast<Idx>(size),
+            alpaka::getPtrNative(devRecords),
+            numSegments,
+            alpaka::getPtrNative(devOffsets),
+            RecordLess{});
+    }
+    else
+    {
+        vikunja::sort::deviceSegmentedSort<typename Setup::Acc>(
+            setup.devAcc,
+            setup.queueAcc,
+            static_cast<Idx>(size),
+            alpaka::getPtrNative(devRecords),
+            numSegments,
+            alpaka::getPtrNative(devOffsets),
+            RecordLess{});
+    }
+
+    std::vector<Record> const result = vikunja::test::toHost<Record>(setup, devRecords, static_cast<Idx>(size));
+    for(Idx segment = 0; segment < numSegments; ++segment)
+    {
+        auto const begin = static_cast<std::ptrdiff_t>(offsets[segment]);
+        auto const end = static_cast<std::ptrdiff_t>(offsets[segment + 1]);
+        if(stable)
+        {
+            std::stable_sort(records.begin() + begin, records.begin() + end, RecordLess{});
+        }
+        else
+        {
+            std::sort(records.begin() + begin, records.begin() + end, RecordLess{});
+            // the order of equal keys is unspecified, therefore the keys are compared
+            for(auto i = begin; i < end; ++i)
+            {
+                REQUIRE(result[static_cast<std::size_t>(i)].key == records[static_cast<std::size_t>(i)].key);
+            }
+            std::copy(result.begin() + begin, result.begin() + end, records.begin() + begin);
+        }
+    }
+    REQUIRE(result == records);
+}
@@ -0,0 +1,113 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <vikunja/sparse/spmv.hpp>
+#include <vikunja/test/AlpakaSetup.hpp>
+#include <vikunja/test/DeviceMemory.hpp>
+#include <vikunja/test/utility.hpp>
+
+#include <alpaka/alpaka.hpp>
+#include <alpaka/example/ExampleDefaultAcc.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    using Dim = alpaka::DimInt<1u>;
+    using Idx = std::uint64_t;
+    using Offset = std::uint32_t;
+    using Data = double;
+    using Setup = vikunja::test::
+        TestAlpakaSetup<Dim, Idx, alpaka::AccCpuSerial, alpaka::ExampleDefaultAcc, alpaka::Blocking>;
+    using Acc = typename Setup::Acc;
+} // namespace
+
+TEST_CASE("Test sparse matrix vector multiplication", "[sparse]")
+{
+    auto numRows = GENERATE(Idx{1}, Idx{777}, Idx{20'000});
+    // beta zero must not read y
+    auto beta = GENERATE(0., 0.5);
+
+    INFO((vikunja::test::print_acc_info<Dim>(numRows)));
+    INFO("beta: " << beta);
+
+    Setup setup;
+    std::mt19937 generator(static_cast<std::mt19937::result_type>(numRows));
+    Idx const numColumns = 1000;
+    Data const alpha = 2.;
+
+    // mostly short and empty rows and a few very long rows
+    std::uniform_int_distribution<Offset> shortRow(0, 4);
+    std::uniform_int_distribution<Offset> longRow(0, 50'000);
+    std::bernoulli_distribution isLong(0.002);
+    std::uniform_int_distribution<Offset> columnDistribution(0, static_cast<Offset>(numColumns - 1));
+    std::uniform_real_distribution<Data> valueDistribution(-1., 1.);
+
+    std::vector<Offset> rowOffsets(static_cast<std::size_t>(numRows + 1), 0);
+    for(std::size_t row = 0; row < numRows; ++row)
+    {
+        bool const isLongRow = isLong(generator) || (row == 0 && numRows > 1);
+        Offset const length = isLongRow ? longRow(generator) : shortRow(generator);
+        rowOffsets[row + 1] = rowOffsets[row] + length;
+    }
+    std::size_t const nnz = rowOffsets.back();
+    std::vector<Offset> columns(std::max(nnz, std::size_t{1}));
+    std::vector<Data> values(std::max(nnz, std::size_t{1}));
+    std::generate(columns.begin(), columns.end(), [&] { return columnDistribution(generator); });
+    std::generate(values.begin(), values.end(), [&] { return valueDistribution(generator); });
+    std::vector<Data> x(static_cast<std::size_t>(numColumns));
+    std::generate(x.begin(), x.end(), [&] { return valueDistribution(generator); });
+    std::vector<Data> y(static_cast<std::size_t>(numRows));
+    if(beta == 0.)
+    {
+        std::fill(y.begin(), y.end(), std::numeric_limits<Data>::quiet_NaN());
+    }
+    else
+    {
+        std::generate(y.begin(), y.end(), [&] { return valueDistribution(generator); });
+    }
+
+    auto devRowOffsets = vikunja::test::toDevice(setup, rowOffsets);
+    auto devColumns = vikunja::test::toDevice(setup, columns);
+    auto devValues = vikunja::test::toDevice(setup, values);
+    auto devX = vikunja::test::toDevice(setup, x);
+    auto devY = vikunja::test::toDevice(setup, y);
+    vikunja::sparse::deviceSpMV<Acc>(
+        setup.devAcc,
+        setup.devHost,
+        setup.queueAcc,
+        numRows,
+        alpaka::getPtrNative(devRowOffsets),
+        alpaka::getPtrNative(devColumns),
+        alpaka::getPtrNative(devValues),
+        alpaka::getPtrNative(devX),
+        alpaka::getPtrNative(devY),
+        alpha,
+        beta);
+
+    std::vector<Data> const result = vikunja::test::toHost<Data>(setup, devY, numRows);
+    for(std::size_t row = 0; row < numRows; ++row)
+    {
+        Data sum = 0.;
+        for(Offset k = rowOffsets[row]; k < rowOffsets[row + 1]; ++k)
+        {
+            sum += values[k] * x[columns[k]];
+        }
+        Data const expected = (beta == 0.) ? alpha * sum : alpha * sum + beta * y[row];
+        INFO("row: " << row << " length: " << rowOffsets[row + 1] - rowOffsets[row]);
+        REQUIRE(result[row] == Approx(expected).margin(1e-9));
+    }
+}
@@ -0,0 +1,230 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <vikunja/statistics/statistics.hpp>
+#include <vikunja/test/AlpakaSetup.hpp>
+#include <vikunja/test/DeviceMemory.hpp>
+#include <vikunja/test/utility.hpp>
+
+#include <alpaka/alpaka.hpp>
+#include <alpaka/example/ExampleDefaultAcc.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    using Dim = alpaka::DimInt<1u>;
+    using Idx = std::uint64_t;
+    using Setup = vikunja::test::
+        TestAlpakaSetup<Dim, Idx, alpaka::AccCpuSerial, alpaka::ExampleDefaultAcc, alpaka::Blocking>;
+    using Acc = typename Setup::Acc;
+
+    //! Returns the sum of the p-th powers of the deviations from the mean with two passes in long double.
+    template<typename TData>
+    long double centralSum(std::vector<TData> const& data, int const p)
+    {
+        long double mean = 0;
+        for(TData const v : data)
+        {
+            mean += static_cast<long double>(v);
+        }
+        mean /= static_cast<long double>(data.size());
+        long double sum = 0;
+        for(TData const v : data)
+        {
+            long double const delta = static_cast<long double>(v) - mean;
+            long double power = 1;
+            for(int i = 0; i < p; ++i)
+            {
+                power *= delta;
+            }
+            sum += power;
+        }
+        return sum;
+    }
+} // namespace
+
+TEST_CASE("Test moments", "[statistics]")
+{
+    auto size = GENERATE(1, 777, 100'000);
+
+    INFO((vikunja::test::print_acc_info<Dim>(size)));
+
+    Setup setup;
+    Idx const n = static_cast<Idx>(size);
+    std::mt19937 generator(static_cast<std::mt19937::result_type>(size));
+
+    SECTION("floating point input with a large mean")
+    {
+        // the sum of squares minus the squared sum loses all digits of this variance in double precision
+        std::gamma_distribution<double> distribution(2., 1.);
+        std::vector<double> data(static_cast<std::size_t>(size));
+        std::generate(data.begin(), data.end(), [&] { return 1e8 + distribution(generator); });
+        auto devData = vikunja::test::toDevice(setup, data);
+
+        auto const moments = vikunja::statistics::deviceMoments<Acc>(
+            setup.devAcc,
+            setup.devHost,
+            setup.queueAcc,
+            n,
+            alpaka::getPtrNative(devData));
+        REQUIRE(moments.count == static_cast<std::uint64_t>(size));
+        long double mean = 0;
+        for(double const v : data)
+        {
+            mean += v;
+        }
+        REQUIRE(moments.mean == Approx(static_cast<double>(mean / size)).epsilon(1e-12));
+        REQUIRE(moments.m2 == Approx(static_cast<double>(centralSum(data, 2))).epsilon(1e-6).margin(1e-6));
+
+        auto const higher = vikunja::statistics::deviceHigherMoments<Acc>(
+            setup.devAcc,
+            setup.devHost,
+            setup.queueAcc,
+            n,
+            alpaka::getPtrNative(devData));
+        REQUIRE(higher.count == static_cast<std::uint64_t>(size));
+        REQUIRE(higher.m2 == Approx(moments.m2));
+        REQUIRE(higher.m3 == Approx(static_cast<double>(centralSum(data, 3))).epsilon(1e-6).margin(1e-6));
+        REQUIRE(higher.m4 == Approx(static_cast<double>(centralSum(data, 4))).epsilon(1e-6).margin(1e-6));
+        if(size > 1)
+        {
+            // the skewness and excess kurtosis of the gamma distribution with shape 2 are 1.41 and 3
+            REQUIRE(higher.skewness() > 0.);
+            if(size == 100'000)
+            {
+                REQUIRE(higher.skewness() == Approx(1.41).margin(0.1));
+                REQUIRE(higher.kurtosis() == Approx(3.).margin(0.5));
+            }
+        }
+    }
+
+    SECTION("integral input")
+    {
+        std::uniform_int_distribution<std::int32_t> distribution(-1000, 1000);
+        std::vector<std::int32_t> data(static_cast<std::size_t>(size));
+        std::generate(data.begin(), data.end(), [&] { return distribution(generator); });
+        auto devData = vikunja::test::toDevice(setup, data);
+
+        vikunja::statistics::Moments<double> const moments = vikunja::statistics::deviceMoments<Acc>(
+            setup.devAcc,
+            setup.devHost,
+            setup.queueAcc,
+            n,
+            alpaka::getPtrNative(devData));
+        REQUIRE(moments.count == static_cast<std::uint64_t>(size));
+        REQUIRE(moments.m2 == Approx(static_cast<double>(centralSum(data, 2))).margin(1e-6));
+        REQUIRE(moments.variance() == Approx(static_cast<double>(centralSum(data, 2) / size)).margin(1e-6));
+    }
+}
+
+TEST_CASE("Test co-moments", "[statistics]")
+{
+    auto size = GENERATE(1, 777, 100'000);
+
+    INFO((vikunja::test::print_acc_info<Dim>(size)));
+
+    Setup setup;
+    Idx const n = static_cast<Idx>(size);
+    std::mt19937 generator(static_cast<std::mt19937::result_type>(size));
+    std::normal_distribution<float> distribution(0.f, 1.f);
+    std::vector<float> x(static_cast<std::size_t>(size));
+    std::vector<float> y(static_cast<std::size_t>(size));
+    for(std::size_t i = 0; i < x.size(); ++i)
+    {
+        x[i] = 100.f + distribution(generator);
+        y[i] = -2.f * x[i] + 0.5f * distribution(generator);
+    }
+    auto devX = vikunja::test::toDevice(setup, x);
+    auto devY = vikunja::test::toDevice(setup, y);
+
+    auto const moments = vikunja::statistics::deviceCoMoments<Acc>(
+        setup.devAcc,
+        setup.devHost,
+        setup.queueAcc,
+        n,
+        alpaka::getPtrNative(devX),
+        alpaka::getPtrNative(devY));
+
+    long double meanX = 0;
+    long double meanY = 0;
+    for(std::size_t i = 0; i < x.size(); ++i)
+    {
+        meanX += x[i];
+        meanY += y[i];
+    }
+    meanX /= size;
+    meanY /= size;
+    long double c = 0;
+    for(std::size_t i = 0; i < x.size(); ++i)
+    {
+        c += (x[i] - meanX) * (y[i] - meanY);
+    }
+
+    REQUIRE(moments.count == static_cast<std::uint64_t>(size));
+    REQUIRE(moments.meanX == Approx(static_cast<float>(meanX)).epsilon(1e-5));
+    REQUIRE(moments.meanY == Approx(static_cast<float>(meanY)).epsilon(1e-5));
+    REQUIRE(moments.m2X == Approx(static_cast<float>(centralSum(x, 2))).epsilon(1e-3).margin(1e-3));
+    REQUIRE(moments.m2Y == Approx(static_cast<float>(centralSum(y, 2))).epsilon(1e-3).margin(1e-3));
+    REQUIRE(moments.c == Approx(static_cast<float>(c)).epsilon(1e-3).margin(1e-3));
+    if(size > 1)
+    {
+        // y depends almost linearly on x with a negative slope
+        float const correlation = static_cast<float>(c / std::sqrt(centralSum(x, 2) * centralSum(y, 2)));
+        REQUIRE(moments.correlation() == Approx(correlation).epsilon(1e-3));
+        REQUIRE(moments.correlation() < -0.9f);
+    }
+}
+
+TEST_CASE("Test moments of a float input longer than 2^24", "[statistics]")
+{
+    // a float count stops growing at 2^24, e.g. in the serial accumulation of a single thread
+    Idx const n = (Idx{1} << 24) + (Idx{1} << 20);
+
+    INFO((vikunja::test::print_acc_info<Dim>(n)));
+
+    std::vector<float> data(static_cast<std::size_t>(n));
+    for(std::size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = (i % 2 == 0) ? 1.f : 3.f;
+    }
+
+    SECTION("serial accumulation")
+    {
+        vikunja::statistics::detail::MomentsFunc<float> const transform;
+        vikunja::statistics::detail::MomentsMerge<float> const merge;
+        vikunja::statistics::Moments<float> moments = transform(data[0]);
+        for(std::size_t i = 1; i < data.size(); ++i)
+        {
+            moments = merge(moments, transform(data[i]));
+        }
+        REQUIRE(moments.count == n);
+        REQUIRE(moments.mean == Approx(2.f));
+    }
+
+    SECTION("device")
+    {
+        Setup setup;
+        auto devData = vikunja::test::toDevice(setup, data);
+        auto const moments = vikunja::statistics::deviceMoments<Acc>(
+            setup.devAcc,
+            setup.devHost,
+            setup.queueAcc,
+            n,
+            alpaka::getPtrNative(devData));
+        REQUIRE(moments.count == n);
+        REQUIRE(moments.mean == Approx(2.f));
+    }
+}
@@ -0,0 +1,159 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <vikunja/reduce/reduce.hpp>
+#include <vikunja/test/AlpakaSetup.hpp>
+#include <vikunja/test/utility.hpp>
+#include <vikunja/threadpool/ThreadPool.hpp>
+#include <vikunja/transform/transform.hpp>
+
+#include <alpaka/alpaka.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+using Dim = alpaka::DimInt<1u>;
+using Idx = std::uint64_t;
+using Data = std::uint64_t;
+using Setup = vikunja::test::TestAlpakaSetup<Dim, Idx, alpaka::AccCpuSerial, alpaka::AccCpuSerial, alpaka::Blocking>;
+using Policy = vikunja::workdiv::policies::HostThreadPoolPolicy;
+
+TEST_CASE("ThreadPool chunks", "[threadpool]")
+{
+    auto n = GENERATE(Idx{0}, Idx{1}, Idx{7}, Idx{1000});
+    auto numTasks = GENERATE(std::size_t{1}, std::size_t{3}, std::size_t{8});
+
+    Idx expectedBegin = 0;
+    for(std::size_t task = 0; task < numTasks; ++task)
+    {
+        auto const chunk = vikunja::threadpool::ThreadPool::getChunk(n, task, numTasks);
+        REQUIRE(chunk.first == expectedBegin);
+        REQUIRE(chunk.second >= chunk.first);
+        // the chunk sizes differ by at most one element
+        REQUIRE(chunk.second - chunk.first <= n / numTasks + 1);
+        expectedBegin = chunk.second;
+    }
+    REQUIRE(expectedBegin == n);
+}
+
+TEST_CASE("ThreadPool runs each task once", "[threadpool]")
+{
+    auto& pool = vikunja::threadpool::ThreadPool::instance();
+    std::vector<std::atomic<int>> counter(pool.size());
+    // Catch2 is not thread safe, therefore the workers only record the number of tasks
+    std::atomic<int> wrongNumTasks{0};
+
+    // repeated jobs check the reuse of the persistent workers
+    for(int job = 0; job < 100; ++job)
+    {
+        pool.run(
+            [&](std::size_t const taskIndex, std::size_t const numTasks)
+            {
+                if(numTasks != pool.size())
+                {
+                    wrongNumTasks.fetch_add(1);
+                }
+                counter[taskIndex].fetch_add(1);
+            });
+    }
+
+    REQUIRE(wrongNumTasks.load() == 0);
+    for(auto const& c : counter)
+    {
+        REQUIRE(c.load() == 100);
+    }
+}
+
+TEST_CASE("Test reduce with HostThreadPoolPolicy", "[threadpool][reduce]")
+{
+    auto size = GENERATE(1, 10, 777, 1 << 16);
+
+    INFO((vikunja::test::print_acc_info<Dim, alpaka::AccCpuSerial>(size)));
+
+    Setup setup;
+    auto devMem = setup.allocDev<Data>(static_cast<Idx>(size));
+    Data* const devMemPtr = alpaka::getPtrNative(devMem);
+    std::iota(devMemPtr, devMemPtr + size, 1);
+
+    auto sum = [](Data const i, Data const j) { return i + j; };
+    auto doubleNum = [](Data const i) { return 2 * i; };
+    Data const n = static_cast<Data>(size);
+
+    REQUIRE(
+        vikunja::reduce::deviceReduce<typename Setup::Acc, Policy>(
+            setup.devAcc,
+            setup.devHost,
+            setup.queueAcc,
+            static_cast<Idx>(size),
+            devMemPtr,
+            sum)
+        == n * (n + 1) / 2);
+
+    REQUIRE(
+        vikunja::reduce::deviceTransformReduce<typename Setup::Acc, Policy>(
+            setup.devAcc,
+            setup.devHost,
+            setup.queueAcc,
+            devMemPtr,
+            devMemPtr + size,
+            doubleNum,
+            sum)
+        == n * (n + 1));
+}
+
+TEST_CASE("Test transform with HostThreadPoolPolicy", "[threadpool][transform]")
+{
+    auto size = GENERATE(1, 10, 777, 1 << 16);
+
+    INFO((vikunja::test::print_acc_info<Dim, alpaka::AccCpuSerial>(size)));
+
+    Setup setup;
+    auto devInputMem = setup.allocDev<Data>(static_cast<Idx>(size));
+    auto devOutputMem = setup.allocDev<Data>(static_cast<Idx>(size));
+    Data* const inputPtr = alpaka::getPtrNative(devInputMem);
+    Data* const outputPtr = alpaka::getPtrNative(devOutputMem);
+    std::iota(inputPtr, inputPtr + size, 0);
+
+    SECTION("one input")
+    {
+        vikunja::transform::deviceTransform<typename Setup::Acc, Policy>(
+            setup.devAcc,
+            setup.queueAcc,
+            static_cast<Idx>(size),
+            inputPtr,
+            outputPtr,
+            [](Data const i) { return i + 1; });
+
+        for(Idx i = 0; i < static_cast<Idx>(size); ++i)
+        {
+            REQUIRE(outputPtr[i] == i + 1);
+        }
+    }
+
+    SECTION("two inputs")
+    {
+        vikunja::transform::deviceTransform<typename Setup::Acc, Policy>(
+            setup.devAcc,
+            setup.queueAcc,
+            inputPtr,
+            inputPtr + size,
+            inputPtr,
+            outputPtr,
+            [](Data const i, Data const j) { return i * j; });
+
+        for(Idx i = 0; i < static_cast<Idx>(size); ++i)
+        {
+            REQUIRE(outputPtr[i] == i * i);
+        }
+    }
+}
@@ -0,0 +1,216 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <vikunja/test/AlpakaSetup.hpp>
+#include <vikunja/test/DeviceMemory.hpp>
+#include <vikunja/test/utility.hpp>
+#include <vikunja/unique/unique.hpp>
+
+#include <alpaka/alpaka.hpp>
+#include <alpaka/example/ExampleDefaultAcc.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+namespace
+{
+    using Dim = alpaka::DimInt<1u>;
+    using Idx = std::uint64_t;
+    using Setup = vikunja::test::
+        TestAlpakaSetup<Dim, Idx, alpaka::AccCpuSerial, alpaka::ExampleDefaultAcc, alpaka::Blocking>;
+
+    //! Two values are equal, if they are in the same bucket of ten values.
+    struct SameBucket
+    {
+        ALPAKA_FN_HOST_ACC bool operator()(std::int32_t const a, std::int32_t const b) const
+        {
+            return a / 10 == b / 10;
+        }
+    };
+
+    //! Equality, which takes the accelerator.
+    struct AccEqual
+    {
+        template<typename TAcc>
+        ALPAKA_FN_HOST_ACC bool operator()(TAcc const&, std::int32_t const a, std::int32_t const b) const
+        {
+            return a == b;
+        }
+    };
+
+    //! Creates ascending values with runs of random length between 1 and maxLength.
+    std::vector<std::int32_t> runs(std::size_t const size, std::size_t const maxLength)
+    {
+        std::mt19937 generator(static_cast<std::mt19937::result_type>(size + maxLength));
+        std::uniform_int_distribution<std::size_t> lengthDistribution(1, maxLength);
+        std::uniform_int_distribution<std::int32_t> stepDistribution(1, 15);
+        std::vector<std::int32_t> data;
+        std::int32_t value = 0;
+        while(data.size() < size)
+        {
+            std::size_t const length = std::min(lengthDistribution(generator), size - data.size());
+            data.insert(data.end(), length, value);
+            value += stepDistribution(generator);
+        }
+        return data;
+    }
+
+    //! Reference run length encoding.
+    template<typename TEqual>
+    void runLengthEncode(
+        std::vector<std::int32_t> const& data,
+        TEqual const& equal,
+        std::vector<std::int32_t>& values,
+        std::vector<Idx>& counts)
+    {
+        for(std::size_t i = 0; i < data.size(); ++i)
+        {
+            if(i == 0 || !equal(data[i - 1], data[i]))
+            {
+                values.push_back(data[i]);
+                counts.push_back(1);
+            }
+            else
+            {
+                ++counts.back();
+            }
+        }
+    }
+} // namespace
+
+TEST_CASE("Test unique", "[unique]")
+{
+    auto size = GENERATE(1, 10, 777, 100'000);
+    std::size_t const maxLength = GENERATE(1, 5, 1000);
+
+    INFO((vikunja::test::print_acc_info<Dim>(size)));
+    INFO("maximum run length: " << maxLength);
+
+    Setup setup;
+    std::vector<std::int32_t> const data = runs(static_cast<std::size_t>(size), maxLength);
+    auto devData = vikunja::test::toDevice(setup, data);
+    auto devOut = setup.allocDev<std::int32_t>(static_cast<Idx>(size));
+
+    std::vector<std::int32_t> expected;
+    std::unique_copy(data.begin(), data.end(), std::back_inserter(expected));
+
+    std::int32_t* const begin = alpaka::getPtrNative(devData);
+    Idx const count = vikunja::unique::deviceUnique<typename Setup::Acc>(
+        setup.devAcc,
+        setup.devHost,
+        setup.queueAcc,
+        begin,
+        begin + size,
+        alpaka::getPtrNative(devOut));
+    REQUIRE(count == expected.size());
+    REQUIRE(vikunja::test::toHost<std::int32_t>(setup, devOut, count) == expected);
+
+    Idx const uniqueCount = vikunja::unique::deviceUniqueCount<typename Setup::Acc>(
+        setup.devAcc,
+        setup.devHost,
+        setup.queueAcc,
+        begin,
+        begin + size);
+    REQUIRE(uniqueCount == expected.size());
+}
+
+TEST_CASE("Test unique with custom equality", "[unique]")
+{
+    auto size = GENERATE(10, 100'000);
+
+    INFO((vikunja::test::print_acc_info<Dim>(size)));
+
+    Setup setup;
+    std::vector<std::int32_t> const data = runs(static_cast<std::size_t>(size), 7);
+    auto devData = vikunja::test::toDevice(setup, data);
+    auto devOut = setup.allocDev<std::int32_t>(static_cast<Idx>(size));
+
+    std::vector<std::int32_t> expected;
+    std::unique_copy(data.begin(), data.end(), std::back_inserter(expected), SameBucket{});
+
+    Idx const count = vikunja::unique::deviceUnique<typename Setup::Acc>(
+        setup.devAcc,
+        setup.devHost,
+        setup.queueAcc,
+        static_cast<Idx>(size),
+        alpaka::getPtrNative(devData),
+        alpaka::getPtrNative(devOut),
+        SameBucket{});
+    REQUIRE(count == expected.size());
+    REQUIRE(vikunja::test::toHost<std::int32_t>(setup, devOut, count) == expected);
+
+    Idx const uniqueCount = vikunja::unique::deviceUniqueCount<typename Setup::Acc>(
+        setup.devAcc,
+        setup.devHost,
+        setup.queueAcc,
+        static_cast<Idx>(size),
+        alpaka::getPtrNative(devData),
+        AccEqual{});
+    std::vector<std::int32_t> uniqueData = data;
+    uniqueData.erase(std::unique(uniqueData.begin(), uniqueData.end()), uniqueData.end());
+    REQUIRE(uniqueCount == uniqueData.size());
+}
+
+TEST_CASE("Test run length encoding", "[unique][runLengthEncode]")
+{
+    auto size = GENERATE(1, 10, 777, 100'000);
+    std::size_t const maxLength = GENERATE(1, 5, 1000);
+    bool const bucketed = GENERATE(false, true);
+
+    INFO((vikunja::test::print_acc_info<Dim>(size)));
+    INFO("maximum run length: " << maxLength << ", bucketed: " << bucketed);
+
+    Setup setup;
+    std::vector<std::int32_t> const data = runs(static_cast<std::size_t>(size), maxLength);
+    auto devData = vikunja::test::toDevice(setup, data);
+    auto devValues = setup.allocDev<std::int32_t>(static_cast<Idx>(size));
+    auto devCounts = setup.allocDev<Idx>(static_cast<Idx>(size));
+
+    std::vector<std::int32_t> expectedValues;
+    std::vector<Idx> expectedCounts;
+    Idx count = 0;
+    if(bucketed)
+    {
+        runLengthEncode(data, SameBucket{}, expectedValues, expectedCounts);
+        count = vikunja::unique::deviceRunLengthEncode<typename Setup::Acc>(
+            setup.devAcc,
+            setup.devHost,
+            setup.queueAcc,
+            static_cast<Idx>(size),
+            alpaka::getPtrNative(devData),
+            alpaka::getPtrNative(devValues),
+            alpaka::getPtrNative(devCounts),
+            SameBucket{});
+    }
+    else
+    {
+        runLengthEncode(
+            data,
+            [](std::int32_t const a, std::int32_t const b) { return a == b; },
+            expectedValues,
+            expectedCounts);
+        count = vikunja::unique::deviceRunLengthEncode<typename Setup::Acc>(
+            setup.devAcc,
+            setup.devHost,
+            setup.queueAcc,
+            static_cast<Idx>(size),
+            alpaka::getPtrNative(devData),
+            alpaka::getPtrNative(devValues),
+            alpaka::getPtrNative(devCounts));
+    }
+
+    REQUIRE(count == expectedValues.size());
+    REQUIRE(vikunja::test::toHost<std::int32_t>(setup, devValues, count) == expectedValues);
+    REQUIRE(vikunja::test::toHost<Idx>(setup, devCounts, count) == expectedCounts);
+}
@@ -0,0 +1,139 @@
+/* Copyright 2022 Simeon Ehrig
+ *
+ * This file is part of vikunja.
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <vikunja/affinity/Affinity.hpp>
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+using vikunja::affinity::AffinityPolicy;
+
+namespace
+{
+    std::vector<int> getCpus(AffinityPolicy const& policy, std::size_t const numThreads)
+    {
+        std::vector<int> cpus;
+        for(std::size_t i = 0; i < numThreads; ++i)
+        {
+            cpus.push_back(policy.getCpu(i).value());
+        }
+        return cpus;
+    }
+} // namespace
+
+TEST_CASE("AffinityPolicy from string", "[affinity]")
+{
+    REQUIRE(AffinityPolicy::fromString("none").getKind() == AffinityPolicy::Kind::none);
+    REQUIRE(AffinityPolicy::fromString("compact").getKind() == AffinityPolicy::Kind::compact);
+    REQUIRE(AffinityPolicy::fromString("scatter").getKind() == AffinityPolicy::Kind::scatter);
+    REQUIRE(AffinityPolicy::fromString("").getKind() == AffinityPolicy::Kind::none);
+    REQUIRE(AffinityPolicy::fromString("0,a").getKind() == AffinityPolicy::Kind::none);
+    REQUIRE(AffinityPolicy::fromString("1,,2").getKind() == AffinityPolicy::Kind::none);
+    REQUIRE(AffinityPolicy::fromString("0,-1").getKind() == AffinityPolicy::Kind::none);
+    REQUIRE(AffinityPolicy::fromString("99999999999999999999").getKind() == AffinityPolicy::Kind::none);
+#if defined(__linux__)
+    REQUIRE(AffinityPolicy::fromString(std::to_string(CPU_SETSIZE)).getKind() == AffinityPolicy::Kind::none);
+#endif
+
+    AffinityPolicy const policy = AffinityPolicy::fromString("3,1,2");
+    REQUIRE(policy.getKind() == AffinityPolicy::Kind::list);
+    REQUIRE(getCpus(policy, 5) == std::vector<int>{3, 1, 2, 3, 1});
+
+    REQUIRE_FALSE(AffinityPolicy::none().getCpu(0).has_value());
+}
+
+TEST_CASE("AffinityPolicy list removes invalid CPUs", "[affinity]")
+{
+    REQUIRE(getCpus(AffinityPolicy::list({-1, 2, -5, 0}), 3) == std::vector<int>{2, 0, 2});
+    REQUIRE_FALSE(AffinityPolicy::list({-1}).getCpu(0).has_value());
+#if defined(__linux__)
+    REQUIRE(getCpus(AffinityPolicy::list({CPU_SETSIZE, 1}), 2) == std::vector<int>{1, 1});
+#endif
+}
+
+TEST_CASE("compact and scatter use all available CPUs", "[affinity]")
+{
+    auto const& available = vikunja::affinity::detail::getAvailableCpus();
+    std::vector<int> expected;
+    for(auto const& info : available)
+    {
+        expected.push_back(info.cpu);
+    }
+    std::sort(expected.begin(), expected.end());
+
+    for(auto const& policy : {AffinityPolicy::compact(), AffinityPolicy::scatter()})
+    {
+        if(expected.empty())
+        {
+            REQUIRE_FALSE(policy.getCpu(0).has_value());
+            continue;
+        }
+        std::vector<int> cpus = getCpus(policy, expected.size());
+        std::sort(cpus.begin(), cpus.end());
+        REQUIRE(cpus == expected);
+    }
+}
+
+TEST_CASE("scatter spreads over packages and cores", "[affinity]")
+{
+    using vikunja::affinity::detail::CpuInfo;
+    // 2 packages with 2 cores and 2 hardware threads each
+    std::vector<CpuInfo> const cpus{
+        {0, 0, 0},
+        {4, 0, 0},
+        {1, 0, 1},
+        {5, 0, 1},
+        {2, 1, 0},
+        {6, 1, 0},
+        {3, 1, 1},
+        {7, 1, 1}};
+    REQUIRE(vikunja::affinity::detail::scatterOrder(cpus) == std::vector<int>{0, 2, 1, 3, 4, 6, 5, 7});
+}
+
+#if defined(__linux__)
+TEST_CASE("pin current thread", "[affinity]")
+{
+    auto const& available = vikunja::affinity::detail::getAvailableCpus();
+    REQUIRE_FALSE(available.empty());
+    int const targetCpu = available.back().cpu;
+
+    vikunja::affinity::setAffinityPolicy(AffinityPolicy::list({targetCpu}));
+
+    // Catch2 is not thread safe, therefore the masks are checked after the join
+    cpu_set_t pinnedSet;
+    cpu_set_t releasedSet;
+    CPU_ZERO(&pinnedSet);
+    CPU_ZERO(&releasedSet);
+    std::thread thread(
+        [&]
+        {
+            vikunja::affinity::pinCurrentThread(0);
+            pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &pinnedSet);
+
+            // the thread is released, if the policy is changed to none
+            vikunja::affinity::setAffinityPolicy(AffinityPolicy::none());
+            vikunja::affinity::pinCurrentThread(0);
+            pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &releasedSet);
+        });
+    thread.join();
+
+    REQUIRE(CPU_COUNT(&pinnedSet) == 1);
+    REQUIRE(CPU_ISSET(targetCpu, &pinnedSet));
+    REQUIRE(CPU_COUNT(&releasedSet) == static_cast<int>(available.size()));
+
+    // an explicit policy replaces the default of the thread pool
+    REQUIRE(
+        vikunja::affinity::getAffinityPolicy(vikunja::affinity::ThreadKind::threadPool).getKind()
+        == AffinityPolicy::Kind::none);
+}
+#endif
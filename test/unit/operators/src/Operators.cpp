@@ -11,6 +11,7 @@
 
 #include <alpaka/alpaka.hpp>
 
+#include <functional>
 #include <utility>
 
 #include <catch2/catch.hpp>
@@ -235,3 +236,69 @@ TEST_CASE("BinaryOp", "[operators]")
     REQUIRE(binaryRunner<DummyAcc>(dummyAcc, bStruct2, 3, 1.2) == 1.0);
     REQUIRE(binaryRunner<DummyAcc>(dummyAcc, makePair, 1, 3.4f) == std::make_pair(1, 3.4f));
 }
+
+struct AssociativeStruct
+{
+    static constexpr bool isAssociative = true;
+
+    int operator()(int const a, int const b) const
+    {
+        return a + b;
+    }
+};
+
+TEST_CASE("IsAssociative", "[operators]")
+{
+    DummyAcc dummyAcc;
+
+    auto bLambda = [] ALPAKA_FN_HOST_ACC(int const a, int const b) { return a + b; };
+    auto bLambdaAcc = [] ALPAKA_FN_HOST_ACC(DummyAcc const& acc, int const a, int const b) { return acc.iMax(a, b); };
+
+    STATIC_REQUIRE(vikunja::operators::isAssociative<std::plus<int>>);
+    STATIC_REQUIRE(vikunja::operators::isAssociative<std::multiplies<>>);
+    STATIC_REQUIRE(vikunja::operators::isAssociative<std::bit_xor<unsigned int>>);
+    STATIC_REQUIRE(vikunja::operators::isAssociative<AssociativeStruct>);
+    STATIC_REQUIRE_FALSE(vikunja::operators::isAssociative<std::minus<int>>);
+    STATIC_REQUIRE_FALSE(vikunja::operators::isAssociative<BStruct1>);
+    STATIC_REQUIRE_FALSE(vikunja::operators::isAssociative<decltype(bLambda)>);
+
+    auto associativeLambda = vikunja::operators::associative(bLambda);
+    auto associativeLambdaAcc = vikunja::operators::associative(bLambdaAcc);
+    STATIC_REQUIRE(vikunja::operators::isAssociative<decltype(associativeLambda)>);
+    STATIC_REQUIRE(vikunja::operators::isAssociative<decltype(associativeLambdaAcc)>);
+
+    // the wrapper keeps the interface of the wrapped functor
+    REQUIRE(binaryRunner<DummyAcc>(dummyAcc, associativeLambda, 3, 4) == 7);
+    REQUIRE(binaryRunner<DummyAcc>(dummyAcc, associativeLambdaAcc, 3, 4) == 4);
+    REQUIRE(binaryRunner<DummyAcc>(dummyAcc, std::plus<int>{}, 3, 4) == 7);
+}
+
+TEST_CASE("IsCommutative", "[operators]")
+{
+    DummyAcc dummyAcc;
+
+    auto bLambda = [] ALPAKA_FN_HOST_ACC(int const a, int const b) { return a + b; };
+    auto bLambdaAcc = [] ALPAKA_FN_HOST_ACC(DummyAcc const& acc, int const a, int const b) { return acc.iMax(a, b); };
+
+    STATIC_REQUIRE(vikunja::operators::isCommutative<std::plus<int>>);
+    STATIC_REQUIRE(vikunja::operators::isCommutative<std::logical_or<bool>>);
+    STATIC_REQUIRE_FALSE(vikunja::operators::isCommutative<std::minus<int>>);
+    STATIC_REQUIRE_FALSE(vikunja::operators::isCommutative<AssociativeStruct>);
+    STATIC_REQUIRE_FALSE(vikunja::operators::isCommutative<decltype(bLambda)>);
+
+    auto commutativeLambda = vikunja::operators::commutative(bLambda);
+    auto commutativeLambdaAcc = vikunja::operators::commutative(bLambdaAcc);
+    STATIC_REQUIRE(vikunja::operators::isCommutative<decltype(commutativeLambda)>);
+    STATIC_REQUIRE(vikunja::operators::isCommutative<decltype(commutativeLambdaAcc)>);
+    STATIC_REQUIRE_FALSE(vikunja::operators::isAssociative<decltype(commutativeLambda)>);
+
+    // both wrappers keep the marks of the wrapped functor
+    auto both = vikunja::operators::commutative(vikunja::operators::associative(bLambda));
+    STATIC_REQUIRE(vikunja::operators::isCommutative<decltype(both)>);
+    STATIC_REQUIRE(vikunja::operators::isAssociative<decltype(both)>);
+    STATIC_REQUIRE(vikunja::operators::isCommutative<decltype(vikunja::operators::associative(commutativeLambda))>);
+
+    REQUIRE(binaryRunner<DummyAcc>(dummyAcc, commutativeLambda, 3, 4) == 7);
+    REQUIRE(binaryRunner<DummyAcc>(dummyAcc, commutativeLambdaAcc, 3, 4) == 4);
+    REQUIRE(binaryRunner<DummyAcc>(dummyAcc, both, 3, 4) == 7);
+}